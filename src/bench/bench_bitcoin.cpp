@@ -4,6 +4,7 @@
 
 #include <bench/bench.h>
 
+#include <chainparams.h>
 #include <crypto/sha256.h>
 #include <key.h>
 #include <util/system.h>
@@ -65,6 +66,7 @@ int main(int argc, char** argv)
     SHA256AutoDetect();
     ECC_Start();
     SetupEnvironment();
+    SelectParams(CBaseChainParams::REGTEST); // benchmarks selecting other params restore these
 
     int64_t evaluations = gArgs.GetArg("-evals", DEFAULT_BENCH_EVALUATIONS);
     std::string regex_filter = gArgs.GetArg("-filter", DEFAULT_BENCH_FILTER);
@@ -0,0 +1,602 @@
+static unsigned const char block413567[] = {
+0x03, 0x00, 0x00, 0x00, 0xce, 0x7e, 0x80, 0x08, 
+0x28, 0xa4, 0x9a, 0x39, 0x71, 0x7c, 0x2f, 0x91, 
+0x1a, 0x69, 0xa0, 0xf1, 0x64, 0xfb, 0x1a, 0x3a, 
+0xa3, 0x48, 0x9e, 0x2d, 0xfc, 0x7b, 0x30, 0xf6, 
+0x01, 0x00, 0x00, 0x00, 0x70, 0x3d, 0xbc, 0x96, 
+0xf7, 0x7a, 0xb9, 0xa3, 0x43, 0x36, 0x44, 0x28, 
+0xdf, 0x12, 0xb7, 0x8b, 0xd9, 0x49, 0x74, 0x49, 
+0x4c, 0x86, 0x09, 0xa0, 0x60, 0x9b, 0x2f, 0x09, 
+0x3e, 0xaa, 0xc3, 0xee, 0x01, 0xe5, 0x8b, 0x59, 
+0xdc, 0xea, 0x00, 0x1e, 0xe7, 0xac, 0x1b, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x15, 0x01, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x05, 0x02, 
+0xd0, 0x07, 0x01, 0x0d, 0xff, 0xff, 0xff, 0xff, 
+0x02, 0xe4, 0x6f, 0xc5, 0x04, 0x00, 0x00, 0x00, 
+0x00, 0x23, 0x21, 0x03, 0x60, 0x9d, 0x4b, 0x22, 
+0x7c, 0x1e, 0xc4, 0xff, 0xe5, 0x84, 0x2d, 0x12, 
+0x4a, 0x23, 0x52, 0x9e, 0x23, 0x2c, 0x4c, 0xc8, 
+0x9d, 0x10, 0xdb, 0x6e, 0xad, 0xfc, 0x1f, 0x7a, 
+0x3b, 0x3c, 0x78, 0x6b, 0xac, 0xf8, 0x5b, 0x31, 
+0x01, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 0xa9, 
+0x14, 0x1d, 0x33, 0xcf, 0xd3, 0x1e, 0xc8, 0xcc, 
+0x70, 0x06, 0x1f, 0xde, 0x51, 0x65, 0xd2, 0x17, 
+0x8d, 0xcf, 0xd5, 0xf7, 0x7a, 0x88, 0xac, 0x00, 
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 
+0xb9, 0x1b, 0xd9, 0x85, 0xe0, 0x2e, 0xbc, 0x0f, 
+0xf0, 0xc3, 0xea, 0xbf, 0x1b, 0xad, 0x59, 0x89, 
+0x7f, 0xf7, 0x55, 0x2c, 0x05, 0x7c, 0x81, 0xf8, 
+0xee, 0x96, 0x62, 0x55, 0x71, 0x1c, 0x4d, 0x62, 
+0x01, 0x00, 0x00, 0x00, 0x6a, 0x47, 0x30, 0x44, 
+0x02, 0x20, 0x03, 0xbc, 0xb1, 0x31, 0xff, 0xf9, 
+0xc7, 0xbd, 0x2a, 0x9d, 0xe1, 0xa6, 0x1e, 0xcb, 
+0xc4, 0x5a, 0x1a, 0xf4, 0x95, 0x66, 0x4f, 0xb3, 
+0xa0, 0x9d, 0x60, 0x0d, 0x77, 0xf8, 0xbc, 0x99, 
+0x49, 0x16, 0x02, 0x20, 0x2a, 0x3f, 0x8d, 0x00, 
+0x04, 0x4b, 0xe8, 0xca, 0xc6, 0xf6, 0x13, 0x9d, 
+0x13, 0x4a, 0x9f, 0xbd, 0x81, 0x4e, 0x83, 0xea, 
+0x2b, 0x1f, 0x01, 0xbc, 0x4c, 0x95, 0xd2, 0x79, 
+0x9c, 0x5d, 0xbc, 0x22, 0x01, 0x21, 0x02, 0x3e, 
+0xf7, 0x90, 0xae, 0xad, 0xef, 0x02, 0xfc, 0xc8, 
+0xd9, 0x1b, 0xba, 0xd2, 0x05, 0x50, 0xe8, 0x99, 
+0xfe, 0xf5, 0x7d, 0x55, 0x25, 0x0d, 0x6e, 0x30, 
+0x8c, 0x39, 0xde, 0x50, 0x3d, 0x31, 0x5e, 0xff, 
+0xff, 0xff, 0xff, 0x02, 0x1b, 0x78, 0xd0, 0xcb, 
+0xe8, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0x68, 0x2e, 0xf3, 0xcd, 0x0a, 0x31, 0xca, 0xcd, 
+0x8e, 0x91, 0x81, 0xf7, 0x84, 0x5b, 0x20, 0xe5, 
+0x9c, 0xe4, 0x64, 0x4a, 0x88, 0xac, 0x00, 0xca, 
+0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0x9c, 0x57, 0x81, 0x27, 0x8b, 0x71, 
+0x6c, 0x04, 0x7e, 0xe6, 0x0e, 0x5a, 0x3f, 0x29, 
+0xa9, 0x8f, 0x55, 0xc5, 0xef, 0x3f, 0x88, 0xac, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
+0x01, 0xcf, 0x0f, 0xf0, 0xb6, 0x50, 0x54, 0xe8, 
+0x86, 0x33, 0xb2, 0x4c, 0xa1, 0x19, 0x20, 0xad, 
+0x10, 0x0b, 0xfc, 0xe5, 0xbb, 0xc0, 0x59, 0x3b, 
+0xdd, 0x44, 0x16, 0xf0, 0x20, 0x7c, 0xd2, 0x63, 
+0xb8, 0x00, 0x00, 0x00, 0x00, 0x6a, 0x47, 0x30, 
+0x44, 0x02, 0x20, 0x03, 0xed, 0x39, 0xba, 0x92, 
+0xd7, 0x3e, 0x06, 0x6d, 0xf9, 0x47, 0xb0, 0xf7, 
+0xdf, 0x38, 0x03, 0xe0, 0x66, 0x70, 0x12, 0xbe, 
+0xd4, 0x11, 0x6c, 0x4f, 0x54, 0xd1, 0xd9, 0x6c, 
+0x99, 0xb1, 0xe3, 0x02, 0x20, 0x51, 0x06, 0x2b, 
+0xfd, 0x84, 0x2b, 0x4a, 0x76, 0x9b, 0x04, 0xcb, 
+0x37, 0x10, 0x76, 0xae, 0x44, 0xf7, 0xda, 0x0b, 
+0x2e, 0xd6, 0x90, 0x50, 0x0d, 0x80, 0x05, 0xda, 
+0xb1, 0xd6, 0x01, 0x0c, 0xd1, 0x01, 0x21, 0x03, 
+0x8a, 0x7b, 0xb3, 0x17, 0xe5, 0xb6, 0xd3, 0xdc, 
+0xcd, 0x50, 0x5a, 0x15, 0x10, 0x52, 0x83, 0x6f, 
+0x11, 0xb5, 0x93, 0xfe, 0xc9, 0x0c, 0xb1, 0x14, 
+0xe7, 0xbf, 0x90, 0xfc, 0x45, 0x4b, 0x17, 0x2d, 
+0xff, 0xff, 0xff, 0xff, 0x02, 0x00, 0xca, 0x9a, 
+0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 0xa9, 
+0x14, 0xba, 0x7f, 0xc8, 0xf8, 0xcc, 0xaa, 0x75, 
+0xe0, 0x78, 0x96, 0x1c, 0x88, 0x88, 0xe9, 0x8c, 
+0x89, 0x21, 0x3d, 0x85, 0xa8, 0x88, 0xac, 0x5a, 
+0xa2, 0x35, 0x90, 0xe8, 0x01, 0x00, 0x00, 0x19, 
+0x76, 0xa9, 0x14, 0x7a, 0x3a, 0xb8, 0x60, 0x99, 
+0x39, 0x25, 0x40, 0xfb, 0xb1, 0xfb, 0xfe, 0xa7, 
+0x80, 0x1f, 0xc2, 0x78, 0x53, 0x31, 0x3b, 0x88, 
+0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x00, 0x01, 0xee, 0x30, 0xf8, 0x47, 0x37, 0xa3, 
+0xae, 0xe7, 0xf9, 0x01, 0x4e, 0x10, 0xa8, 0x78, 
+0xb1, 0x18, 0xb0, 0xa0, 0x83, 0xae, 0xf0, 0x83, 
+0x12, 0x27, 0x8d, 0xf8, 0xc5, 0x4a, 0x80, 0x9a, 
+0x8e, 0x3a, 0x01, 0x00, 0x00, 0x00, 0x6a, 0x47, 
+0x30, 0x44, 0x02, 0x20, 0x23, 0x6d, 0xe6, 0x68, 
+0x10, 0xd8, 0xdf, 0xf5, 0x27, 0x16, 0x58, 0x28, 
+0x79, 0x7b, 0xbe, 0x1b, 0xb8, 0x73, 0x42, 0xaa, 
+0xb6, 0x4d, 0x96, 0xe8, 0xe4, 0x26, 0xfb, 0x4b, 
+0x25, 0x99, 0x31, 0x7b, 0x02, 0x20, 0x42, 0xef, 
+0x44, 0xb4, 0x38, 0xcd, 0x10, 0xb2, 0xdf, 0x00, 
+0xde, 0xa3, 0x54, 0xb5, 0x75, 0x36, 0x53, 0x79, 
+0x3d, 0xed, 0x09, 0x99, 0xb7, 0x34, 0x98, 0xa8, 
+0x9e, 0xeb, 0xb3, 0xe5, 0x04, 0x53, 0x01, 0x21, 
+0x02, 0x9c, 0x80, 0xbd, 0x78, 0xc8, 0x27, 0xf1, 
+0x39, 0xdd, 0xa5, 0x85, 0x06, 0x95, 0x42, 0x60, 
+0xe3, 0xba, 0xea, 0x61, 0x8f, 0xa6, 0x88, 0xd0, 
+0x04, 0xa5, 0x42, 0x0b, 0xa3, 0xc0, 0xf5, 0xee, 
+0xb5, 0xff, 0xff, 0xff, 0xff, 0x02, 0x00, 0xca, 
+0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0x99, 0x5f, 0x27, 0x3d, 0xaa, 0xa1, 
+0x49, 0x4b, 0xba, 0xac, 0xbe, 0x58, 0x3f, 0x42, 
+0xd9, 0x97, 0x29, 0x12, 0x82, 0x90, 0x88, 0xac, 
+0x99, 0xcc, 0x9a, 0x54, 0xe8, 0x01, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0x23, 0x66, 0xb4, 0x26, 
+0xa4, 0x27, 0xb5, 0xcc, 0x33, 0x31, 0xd5, 0x06, 
+0x96, 0x4c, 0xb2, 0xe1, 0xd8, 0xdd, 0xb1, 0xef, 
+0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 
+0x00, 0x00, 0x01, 0x22, 0x83, 0xa2, 0x6f, 0x7c, 
+0x2d, 0xd0, 0x30, 0x35, 0xed, 0x55, 0xb5, 0x60, 
+0xa1, 0x4b, 0xc2, 0xde, 0x54, 0x5b, 0xda, 0xff, 
+0x26, 0x1b, 0x80, 0x41, 0x02, 0xff, 0xdc, 0xf0, 
+0x6b, 0x92, 0xfa, 0x01, 0x00, 0x00, 0x00, 0x6b, 
+0x48, 0x30, 0x45, 0x02, 0x21, 0x00, 0xc0, 0xcf, 
+0xbd, 0x1a, 0x91, 0x2c, 0x62, 0x0a, 0x26, 0xb8, 
+0x0b, 0x00, 0x4a, 0xc4, 0x58, 0x51, 0xff, 0x18, 
+0xe3, 0x0d, 0x88, 0x2a, 0xd5, 0x9e, 0xce, 0x98, 
+0x34, 0x36, 0xe8, 0xdc, 0xb9, 0xdf, 0x02, 0x20, 
+0x2f, 0xeb, 0x7d, 0xde, 0x98, 0x0a, 0x66, 0xd9, 
+0x5b, 0x17, 0x41, 0xbd, 0x27, 0x08, 0xed, 0x56, 
+0xf9, 0xd2, 0x19, 0xc7, 0xf8, 0x74, 0x4e, 0x57, 
+0x07, 0x86, 0x13, 0x80, 0xdc, 0x82, 0x28, 0x82, 
+0x01, 0x21, 0x02, 0xcd, 0xab, 0x7f, 0x68, 0xc5, 
+0x3b, 0xd4, 0x16, 0xc0, 0x58, 0x4a, 0xca, 0xfa, 
+0x50, 0xad, 0x3b, 0x81, 0x37, 0x19, 0x6c, 0x18, 
+0xfc, 0x05, 0xdc, 0x00, 0x21, 0xfa, 0x12, 0xc3, 
+0x5f, 0x30, 0x81, 0xff, 0xff, 0xff, 0xff, 0x02, 
+0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0xef, 0x5a, 0xcb, 0xda, 
+0x31, 0x41, 0xf7, 0xf4, 0xcb, 0xb8, 0x17, 0x75, 
+0xb1, 0xaf, 0xa4, 0x6d, 0x8d, 0xde, 0x6a, 0x6e, 
+0x88, 0xac, 0xd8, 0xf6, 0xff, 0x18, 0xe8, 0x01, 
+0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0xf2, 0x30, 
+0xad, 0x8e, 0x8d, 0xb2, 0x52, 0x23, 0xd3, 0xf8, 
+0x83, 0x80, 0xe5, 0x15, 0x0e, 0x00, 0xee, 0x06, 
+0x8e, 0xca, 0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 
+0x01, 0x00, 0x00, 0x00, 0x01, 0x42, 0x7c, 0xaf, 
+0xfe, 0xb5, 0xb5, 0xee, 0xe4, 0xfe, 0x64, 0x44, 
+0x9c, 0xdd, 0xc4, 0xd7, 0x35, 0xde, 0xf1, 0xb0, 
+0x2c, 0x70, 0xbf, 0xe3, 0x0b, 0x59, 0xdd, 0x99, 
+0x5d, 0xff, 0x27, 0x14, 0xa6, 0x01, 0x00, 0x00, 
+0x00, 0x6b, 0x48, 0x30, 0x45, 0x02, 0x21, 0x00, 
+0xd7, 0xd5, 0x57, 0x4d, 0x11, 0x2b, 0xb0, 0xe0, 
+0x95, 0xf0, 0x8b, 0x56, 0xb6, 0xc6, 0x7c, 0x9c, 
+0x1d, 0x03, 0x48, 0xfc, 0xff, 0xb3, 0x20, 0xe1, 
+0xc1, 0x12, 0x59, 0xbb, 0xa4, 0x38, 0x9c, 0x9c, 
+0x02, 0x20, 0x7c, 0xe5, 0xf6, 0xa4, 0xd7, 0xd5, 
+0x1a, 0x0b, 0xd1, 0xdd, 0x07, 0x39, 0xdc, 0x94, 
+0x95, 0xa3, 0x96, 0x14, 0x59, 0x6e, 0xc1, 0x02, 
+0x85, 0xc7, 0x30, 0xdf, 0xdc, 0x78, 0x08, 0x49, 
+0x00, 0x92, 0x01, 0x21, 0x02, 0xd7, 0x58, 0x19, 
+0x2b, 0x8a, 0x18, 0x15, 0x5b, 0x03, 0x9b, 0x76, 
+0x8c, 0xeb, 0x44, 0x20, 0x63, 0xa4, 0x87, 0xde, 
+0xd3, 0xb8, 0x47, 0x75, 0x9c, 0x86, 0xcb, 0x1a, 
+0x8e, 0xe6, 0x20, 0x72, 0x3f, 0xff, 0xff, 0xff, 
+0xff, 0x02, 0x17, 0x21, 0x65, 0xdd, 0xe7, 0x01, 
+0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0xe5, 0x51, 
+0x0b, 0xd4, 0x59, 0x8b, 0xd0, 0x6e, 0x78, 0x66, 
+0x8f, 0x9c, 0xcd, 0xf0, 0x10, 0x68, 0x65, 0x8b, 
+0xd4, 0x08, 0x88, 0xac, 0x00, 0xca, 0x9a, 0x3b, 
+0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0x9c, 0x57, 0x81, 0x27, 0x8b, 0x71, 0x6c, 0x04, 
+0x7e, 0xe6, 0x0e, 0x5a, 0x3f, 0x29, 0xa9, 0x8f, 
+0x55, 0xc5, 0xef, 0x3f, 0x88, 0xac, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x94, 
+0x9f, 0x3b, 0x6f, 0xc3, 0xdb, 0x9b, 0x2f, 0xba, 
+0x91, 0x1a, 0x5c, 0x25, 0xb1, 0x8e, 0xd5, 0x1b, 
+0x54, 0x5a, 0x88, 0xd2, 0xed, 0xce, 0xa7, 0x17, 
+0x1d, 0x58, 0x6b, 0xdf, 0x0e, 0xe5, 0x67, 0x00, 
+0x00, 0x00, 0x00, 0x6b, 0x48, 0x30, 0x45, 0x02, 
+0x21, 0x00, 0x99, 0x5b, 0xbf, 0x29, 0x83, 0x79, 
+0x81, 0xda, 0x23, 0x3a, 0x79, 0x53, 0x46, 0x42, 
+0xc7, 0xf8, 0xd4, 0x2a, 0x53, 0xaf, 0x0d, 0x97, 
+0xef, 0x6b, 0x5a, 0x87, 0xd5, 0xac, 0xa0, 0xb1, 
+0x38, 0x24, 0x02, 0x20, 0x24, 0x69, 0xba, 0x4b, 
+0x96, 0xb9, 0xcd, 0xf6, 0xbd, 0xe3, 0xe9, 0x93, 
+0xbb, 0x58, 0x33, 0xca, 0x55, 0x91, 0xfe, 0x94, 
+0x09, 0xe9, 0x36, 0xc0, 0x40, 0x32, 0xa5, 0xbe, 
+0xea, 0x74, 0x25, 0xae, 0x01, 0x21, 0x02, 0x48, 
+0x53, 0x5f, 0xe8, 0xd0, 0x26, 0x54, 0xa3, 0xd1, 
+0xcc, 0xc6, 0x0a, 0x3d, 0xf9, 0x09, 0x3a, 0xad, 
+0xaa, 0xd5, 0x84, 0x4f, 0x1c, 0x59, 0x4c, 0x5a, 
+0xdd, 0x31, 0xf0, 0xf3, 0xf6, 0x22, 0x3b, 0xff, 
+0xff, 0xff, 0xff, 0x02, 0x56, 0x4b, 0xca, 0xa1, 
+0xe7, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0xb0, 0x74, 0x1a, 0x39, 0xc8, 0xcd, 0x85, 0x88, 
+0x74, 0xfb, 0x61, 0x38, 0xd7, 0x14, 0x9c, 0x10, 
+0x18, 0x9d, 0x8a, 0x04, 0x88, 0xac, 0x00, 0xca, 
+0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0xba, 0x7f, 0xc8, 0xf8, 0xcc, 0xaa, 
+0x75, 0xe0, 0x78, 0x96, 0x1c, 0x88, 0x88, 0xe9, 
+0x8c, 0x89, 0x21, 0x3d, 0x85, 0xa8, 0x88, 0xac, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
+0x01, 0xe0, 0xce, 0xc1, 0x46, 0x2e, 0xce, 0xfc, 
+0xae, 0x11, 0xdd, 0x5e, 0xdc, 0xd7, 0x6c, 0x73, 
+0xc7, 0x53, 0x75, 0x76, 0x3a, 0x8c, 0x78, 0x25, 
+0x51, 0x56, 0x98, 0x62, 0xd0, 0xb1, 0x30, 0x1c, 
+0xce, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x48, 0x30, 
+0x45, 0x02, 0x21, 0x00, 0xe3, 0xaf, 0xa1, 0xb5, 
+0x17, 0x68, 0x5a, 0xb4, 0x48, 0x46, 0xee, 0x3f, 
+0x58, 0xc6, 0x74, 0xce, 0xc8, 0xdd, 0x47, 0x7b, 
+0xd9, 0xa4, 0x64, 0x76, 0x30, 0x65, 0x04, 0x2a, 
+0x96, 0x55, 0xd3, 0x5f, 0x02, 0x20, 0x4d, 0x33, 
+0x5c, 0xb7, 0xe7, 0xad, 0x57, 0x5d, 0x18, 0xde, 
+0xe5, 0xc5, 0xbf, 0xdc, 0xa2, 0x5b, 0x29, 0x8c, 
+0x4c, 0x97, 0x93, 0xd2, 0x56, 0x25, 0x95, 0x3c, 
+0x61, 0x41, 0x10, 0xc9, 0x67, 0x5c, 0x01, 0x21, 
+0x03, 0x51, 0x7a, 0x65, 0x60, 0x13, 0x05, 0x4d, 
+0x2f, 0xc0, 0x1c, 0xaf, 0x7c, 0x7a, 0x9a, 0xe9, 
+0xef, 0xb8, 0x2a, 0x94, 0xc3, 0x4d, 0x7e, 0x0f, 
+0x5f, 0xb9, 0x12, 0xf8, 0x1c, 0x0d, 0x12, 0x56, 
+0x86, 0xff, 0xff, 0xff, 0xff, 0x02, 0x00, 0xca, 
+0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0x99, 0x5f, 0x27, 0x3d, 0xaa, 0xa1, 
+0x49, 0x4b, 0xba, 0xac, 0xbe, 0x58, 0x3f, 0x42, 
+0xd9, 0x97, 0x29, 0x12, 0x82, 0x90, 0x88, 0xac, 
+0x95, 0x75, 0x2f, 0x66, 0xe7, 0x01, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0xf2, 0x3f, 0x1e, 0xc3, 
+0x93, 0x54, 0x84, 0xce, 0x0b, 0x3e, 0x24, 0xe1, 
+0x8a, 0x43, 0x1b, 0xb8, 0x4e, 0xd5, 0x2a, 0x53, 
+0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 
+0x00, 0x00, 0x01, 0x47, 0x28, 0xf4, 0xe7, 0x67, 
+0xbc, 0x0e, 0xe4, 0xac, 0x94, 0xe0, 0xe3, 0xac, 
+0x05, 0x88, 0x8f, 0x6f, 0x05, 0xba, 0x3c, 0xf1, 
+0x09, 0x50, 0xb5, 0x58, 0xe4, 0x0f, 0xe1, 0x56, 
+0x10, 0x87, 0x32, 0x01, 0x00, 0x00, 0x00, 0x6b, 
+0x48, 0x30, 0x45, 0x02, 0x21, 0x00, 0xc6, 0xbf, 
+0x29, 0xa7, 0x7d, 0xea, 0x36, 0xd4, 0x6b, 0xcf, 
+0xd2, 0x9b, 0x76, 0x0b, 0x73, 0xfc, 0x18, 0xff, 
+0x14, 0xf2, 0xe0, 0xc3, 0xa1, 0xd0, 0x9a, 0x56, 
+0x9c, 0x51, 0xdf, 0xef, 0x77, 0x40, 0x02, 0x20, 
+0x60, 0x87, 0x61, 0xc0, 0xae, 0xf6, 0x15, 0x58, 
+0x0c, 0xcc, 0x3f, 0x95, 0xd5, 0xee, 0x0e, 0xed, 
+0x04, 0xee, 0x04, 0xe0, 0x27, 0xd8, 0xe6, 0xc8, 
+0x2e, 0x0a, 0x50, 0xf1, 0xc6, 0xd0, 0x49, 0x72, 
+0x01, 0x21, 0x02, 0x8b, 0x57, 0x9d, 0xa5, 0xf0, 
+0xe6, 0xcd, 0x4f, 0x21, 0x58, 0x39, 0xe8, 0xff, 
+0xa5, 0x81, 0x97, 0x2f, 0xbc, 0x8f, 0x54, 0x38, 
+0xd6, 0xb0, 0x26, 0x20, 0x94, 0xf0, 0x9a, 0x86, 
+0xcf, 0xc3, 0x3e, 0xff, 0xff, 0xff, 0xff, 0x02, 
+0xd4, 0x9f, 0x94, 0x2a, 0xe7, 0x01, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0x01, 0xf7, 0xc2, 0x69, 
+0x25, 0x1c, 0x8e, 0x93, 0xb3, 0xda, 0x25, 0x8c, 
+0xa6, 0xa3, 0x73, 0xd7, 0xd9, 0x0c, 0x02, 0xc2, 
+0x88, 0xac, 0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 
+0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0xef, 0x5a, 
+0xcb, 0xda, 0x31, 0x41, 0xf7, 0xf4, 0xcb, 0xb8, 
+0x17, 0x75, 0xb1, 0xaf, 0xa4, 0x6d, 0x8d, 0xde, 
+0x6a, 0x6e, 0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 
+0x01, 0x00, 0x00, 0x00, 0x01, 0x5c, 0xe0, 0xb4, 
+0x30, 0xa8, 0xcd, 0x9f, 0x99, 0xfa, 0x6a, 0x51, 
+0x4f, 0xcd, 0xc0, 0x94, 0xf5, 0x82, 0x62, 0x44, 
+0x5b, 0x13, 0xd6, 0x54, 0xc1, 0x22, 0x51, 0x8c, 
+0x75, 0xd6, 0x91, 0x16, 0xd0, 0x00, 0x00, 0x00, 
+0x00, 0x6b, 0x48, 0x30, 0x45, 0x02, 0x21, 0x00, 
+0xfd, 0xf2, 0xc3, 0x6d, 0x76, 0xd7, 0xb9, 0x3b, 
+0x15, 0x59, 0x1c, 0xa0, 0xda, 0xb3, 0x88, 0x59, 
+0x30, 0xca, 0xeb, 0x36, 0x8b, 0x76, 0x0a, 0x12, 
+0xc6, 0xbf, 0x23, 0x4b, 0x4a, 0x06, 0x6a, 0x98, 
+0x02, 0x20, 0x61, 0x0c, 0xd7, 0xb6, 0xd8, 0x19, 
+0x15, 0xbb, 0x65, 0x26, 0x8e, 0xaa, 0xae, 0x9e, 
+0xcc, 0x8b, 0x88, 0x5b, 0xd3, 0x85, 0x94, 0xdf, 
+0xf1, 0xc0, 0xd3, 0xd8, 0x27, 0x99, 0x20, 0x50, 
+0x48, 0x20, 0x01, 0x21, 0x02, 0xc4, 0xab, 0x1c, 
+0xd0, 0x70, 0x44, 0x8b, 0x11, 0x85, 0xd7, 0xc1, 
+0x7b, 0x69, 0x29, 0xc2, 0xc3, 0x6a, 0x03, 0xf5, 
+0xcf, 0x5e, 0xf3, 0x8c, 0x84, 0x49, 0x2a, 0x98, 
+0x3e, 0x6d, 0x7e, 0xae, 0x9d, 0xff, 0xff, 0xff, 
+0xff, 0x02, 0x13, 0xca, 0xf9, 0xee, 0xe6, 0x01, 
+0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0x73, 0x37, 
+0xd0, 0xf6, 0xb3, 0xee, 0x09, 0x1b, 0xe5, 0xb5, 
+0xf7, 0x97, 0x5a, 0x7b, 0x0a, 0x71, 0x54, 0x81, 
+0x66, 0x7d, 0x88, 0xac, 0x00, 0xca, 0x9a, 0x3b, 
+0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0x9c, 0x57, 0x81, 0x27, 0x8b, 0x71, 0x6c, 0x04, 
+0x7e, 0xe6, 0x0e, 0x5a, 0x3f, 0x29, 0xa9, 0x8f, 
+0x55, 0xc5, 0xef, 0x3f, 0x88, 0xac, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x64, 
+0xfb, 0x77, 0x41, 0xf3, 0xd0, 0x71, 0x73, 0x73, 
+0xc0, 0x2f, 0x08, 0x76, 0x9b, 0xc0, 0xa4, 0x48, 
+0x94, 0x28, 0x2a, 0x1f, 0xd5, 0x1a, 0x49, 0x81, 
+0xc0, 0xb7, 0x23, 0xc5, 0xbb, 0x13, 0x31, 0x00, 
+0x00, 0x00, 0x00, 0x6b, 0x48, 0x30, 0x45, 0x02, 
+0x21, 0x00, 0xaf, 0x23, 0x60, 0xdb, 0xe6, 0xad, 
+0x3d, 0x8a, 0x12, 0x8c, 0x05, 0x19, 0x46, 0xc3, 
+0x89, 0xdb, 0xa1, 0x66, 0x45, 0x4b, 0x37, 0x78, 
+0x6c, 0x05, 0x3e, 0x7f, 0x2c, 0x8c, 0x5b, 0x31, 
+0xa4, 0x87, 0x02, 0x20, 0x7e, 0x5c, 0xb9, 0xab, 
+0x3c, 0x86, 0x66, 0xa5, 0xfc, 0xbe, 0x70, 0x88, 
+0xba, 0x9d, 0xe8, 0x69, 0x25, 0xde, 0x3a, 0x5b, 
+0x8f, 0x29, 0x64, 0x2a, 0x31, 0x2b, 0x1d, 0x8c, 
+0x24, 0x3f, 0x24, 0x9c, 0x01, 0x21, 0x03, 0x8d, 
+0x50, 0x08, 0xd6, 0x75, 0x28, 0xd1, 0xf1, 0x15, 
+0x5a, 0xb5, 0xd7, 0x2d, 0xd7, 0xcb, 0xe2, 0xe4, 
+0x9b, 0x51, 0xa7, 0x5e, 0x3b, 0xb2, 0x86, 0xdb, 
+0x51, 0xf6, 0x42, 0xa9, 0xe3, 0x09, 0xf4, 0xff, 
+0xff, 0xff, 0xff, 0x02, 0x52, 0xf4, 0x5e, 0xb3, 
+0xe6, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0xe2, 0x80, 0x16, 0x62, 0xba, 0xa9, 0x07, 0x59, 
+0x63, 0x4b, 0x45, 0xd7, 0xeb, 0xfe, 0x3f, 0x6a, 
+0x72, 0x8f, 0x22, 0x5a, 0x88, 0xac, 0x00, 0xca, 
+0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0xba, 0x7f, 0xc8, 0xf8, 0xcc, 0xaa, 
+0x75, 0xe0, 0x78, 0x96, 0x1c, 0x88, 0x88, 0xe9, 
+0x8c, 0x89, 0x21, 0x3d, 0x85, 0xa8, 0x88, 0xac, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
+0x01, 0x9a, 0x6a, 0xf7, 0xfa, 0x9d, 0xba, 0x29, 
+0xdf, 0x7f, 0xa6, 0xfa, 0x97, 0x5e, 0xba, 0x35, 
+0x8f, 0x5d, 0x6a, 0x0a, 0xfb, 0x1e, 0xd6, 0xad, 
+0x6e, 0x45, 0x56, 0xc9, 0xf2, 0x41, 0x6d, 0x92, 
+0x86, 0x00, 0x00, 0x00, 0x00, 0x6a, 0x47, 0x30, 
+0x44, 0x02, 0x20, 0x13, 0xdb, 0x2c, 0xc3, 0x3b, 
+0xe3, 0xe7, 0xaf, 0xf5, 0x03, 0x7c, 0xd4, 0xae, 
+0xe1, 0x96, 0x5f, 0xfb, 0x77, 0x64, 0xf8, 0x56, 
+0xd7, 0x54, 0xbe, 0x55, 0xde, 0xa8, 0xa2, 0x5f, 
+0x7d, 0x46, 0x27, 0x02, 0x20, 0x55, 0x87, 0x93, 
+0xe4, 0x8b, 0xd3, 0x4f, 0x4e, 0xad, 0xfa, 0x74, 
+0x54, 0x4b, 0x21, 0xf8, 0xcc, 0x60, 0x71, 0x4e, 
+0x92, 0x2f, 0xea, 0xf1, 0x96, 0x78, 0xbc, 0x39, 
+0xf4, 0x61, 0x7d, 0x0c, 0x77, 0x01, 0x21, 0x02, 
+0x3c, 0xae, 0xf8, 0x2c, 0x31, 0xaf, 0xc8, 0xda, 
+0x8f, 0xe4, 0xb4, 0x0d, 0xc1, 0x4f, 0x8b, 0xed, 
+0xd0, 0x2c, 0xd9, 0x72, 0x44, 0x44, 0xfa, 0x35, 
+0x35, 0xd3, 0x60, 0x3f, 0x79, 0xf5, 0xe4, 0xc4, 
+0xff, 0xff, 0xff, 0xff, 0x02, 0x00, 0xca, 0x9a, 
+0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 0xa9, 
+0x14, 0x99, 0x5f, 0x27, 0x3d, 0xaa, 0xa1, 0x49, 
+0x4b, 0xba, 0xac, 0xbe, 0x58, 0x3f, 0x42, 0xd9, 
+0x97, 0x29, 0x12, 0x82, 0x90, 0x88, 0xac, 0x91, 
+0x1e, 0xc4, 0x77, 0xe6, 0x01, 0x00, 0x00, 0x19, 
+0x76, 0xa9, 0x14, 0xbd, 0xd3, 0x18, 0x01, 0xe8, 
+0xc4, 0xc2, 0x58, 0x93, 0xb8, 0xef, 0x74, 0x10, 
+0x58, 0x64, 0x6c, 0x52, 0x0b, 0xd5, 0x5a, 0x88, 
+0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x00, 0x01, 0x9a, 0xbb, 0xd1, 0xe2, 0x37, 0xaa, 
+0x06, 0x0b, 0x92, 0x82, 0x0f, 0x6f, 0xff, 0xb6, 
+0xf7, 0x0f, 0x13, 0xf4, 0x1a, 0xd0, 0x04, 0x91, 
+0x1f, 0x80, 0x5e, 0x92, 0xfa, 0x8e, 0xd0, 0x47, 
+0x00, 0x31, 0x01, 0x00, 0x00, 0x00, 0x6a, 0x47, 
+0x30, 0x44, 0x02, 0x20, 0x57, 0xde, 0x9b, 0xfd, 
+0xf2, 0x6a, 0xb7, 0x2e, 0xa7, 0x08, 0x12, 0x3a, 
+0xc7, 0x2f, 0x22, 0xb0, 0x29, 0x26, 0x75, 0x52, 
+0xa2, 0x62, 0xf0, 0x52, 0x1d, 0xb5, 0xe0, 0xc8, 
+0xe2, 0x9e, 0x56, 0x5e, 0x02, 0x20, 0x2e, 0xa5, 
+0x79, 0xf4, 0xd6, 0x95, 0x5c, 0x84, 0xb6, 0x58, 
+0x4c, 0xb0, 0x19, 0xe7, 0xc4, 0x00, 0x7d, 0xc1, 
+0x88, 0x03, 0xc7, 0x54, 0x62, 0x4a, 0x03, 0x55, 
+0xd0, 0x03, 0x73, 0xfb, 0x2d, 0x8d, 0x01, 0x21, 
+0x02, 0x89, 0x25, 0x15, 0x24, 0x73, 0x5b, 0x56, 
+0xf3, 0x5d, 0x4c, 0x74, 0xa4, 0x0b, 0x33, 0x35, 
+0xc2, 0x06, 0x4f, 0xb2, 0xad, 0xdb, 0xe3, 0x53, 
+0x46, 0xed, 0x94, 0x73, 0xfb, 0xf4, 0xb0, 0x26, 
+0xc0, 0xff, 0xff, 0xff, 0xff, 0x02, 0xd0, 0x48, 
+0x29, 0x3c, 0xe6, 0x01, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0x00, 0x12, 0x99, 0x83, 0x60, 0x98, 
+0xd2, 0x02, 0x74, 0xcf, 0x8e, 0x4b, 0x98, 0x1c, 
+0xbb, 0x8c, 0x96, 0xb5, 0xfb, 0xc4, 0x88, 0xac, 
+0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0xef, 0x5a, 0xcb, 0xda, 
+0x31, 0x41, 0xf7, 0xf4, 0xcb, 0xb8, 0x17, 0x75, 
+0xb1, 0xaf, 0xa4, 0x6d, 0x8d, 0xde, 0x6a, 0x6e, 
+0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 
+0x00, 0x00, 0x01, 0x1e, 0x42, 0x37, 0x35, 0x97, 
+0x41, 0x1f, 0x59, 0xcd, 0x57, 0xb0, 0xd8, 0x7f, 
+0xbb, 0x84, 0xa7, 0x8b, 0xb6, 0x58, 0x41, 0xe2, 
+0x09, 0xfc, 0x13, 0xa8, 0xc6, 0xf4, 0x8b, 0xca, 
+0x2d, 0xb4, 0x92, 0x00, 0x00, 0x00, 0x00, 0x6a, 
+0x47, 0x30, 0x44, 0x02, 0x20, 0x55, 0x14, 0x01, 
+0xd5, 0x66, 0x71, 0x05, 0x84, 0x14, 0xb4, 0x33, 
+0xed, 0x22, 0x52, 0x67, 0x28, 0x0c, 0x3d, 0x87, 
+0xed, 0x3f, 0x2f, 0x40, 0x0b, 0x46, 0x7a, 0xf8, 
+0x9f, 0x60, 0xe0, 0xd2, 0xd8, 0x02, 0x20, 0x46, 
+0x30, 0x98, 0x6a, 0xda, 0xea, 0x14, 0x4a, 0xe9, 
+0x49, 0x44, 0x88, 0xfc, 0xea, 0x5a, 0x2e, 0x3f, 
+0xef, 0x79, 0x65, 0x6a, 0xc3, 0x12, 0x46, 0x05, 
+0x78, 0xff, 0xf2, 0xa7, 0x24, 0x0a, 0xe4, 0x01, 
+0x21, 0x02, 0x1a, 0x68, 0xf8, 0x41, 0x32, 0x6e, 
+0x78, 0x20, 0x10, 0xa0, 0xd8, 0xe9, 0x46, 0x01, 
+0xe5, 0x98, 0x34, 0x49, 0xa0, 0xf2, 0x83, 0xbf, 
+0x7e, 0xf0, 0x46, 0x03, 0x1a, 0x31, 0xe9, 0xb4, 
+0x2a, 0xaa, 0xff, 0xff, 0xff, 0xff, 0x02, 0x0f, 
+0x73, 0x8e, 0x00, 0xe6, 0x01, 0x00, 0x00, 0x19, 
+0x76, 0xa9, 0x14, 0x19, 0x1e, 0xe9, 0x13, 0x79, 
+0x39, 0xcc, 0x85, 0xf8, 0x3b, 0xb4, 0x4d, 0x2a, 
+0x28, 0xb6, 0x42, 0x23, 0xba, 0x6c, 0x20, 0x88, 
+0xac, 0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 
+0x00, 0x19, 0x76, 0xa9, 0x14, 0x9c, 0x57, 0x81, 
+0x27, 0x8b, 0x71, 0x6c, 0x04, 0x7e, 0xe6, 0x0e, 
+0x5a, 0x3f, 0x29, 0xa9, 0x8f, 0x55, 0xc5, 0xef, 
+0x3f, 0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x01, 0x4f, 0x48, 0x3b, 0x6a, 
+0xee, 0xc1, 0x8c, 0xa3, 0x1f, 0x02, 0x8b, 0x93, 
+0x05, 0xab, 0x2f, 0xbc, 0xe3, 0x2b, 0xeb, 0xce, 
+0x08, 0x95, 0x5a, 0x1e, 0xb5, 0xb1, 0x43, 0x66, 
+0x44, 0xfc, 0x94, 0x02, 0x00, 0x00, 0x00, 0x00, 
+0x6a, 0x47, 0x30, 0x44, 0x02, 0x20, 0x46, 0xf7, 
+0x7a, 0x8d, 0xb1, 0x26, 0xb2, 0x9b, 0xcd, 0x14, 
+0xca, 0xe4, 0x3a, 0xd1, 0xa0, 0xd3, 0x07, 0x42, 
+0x2d, 0xc1, 0x15, 0x22, 0x41, 0x0c, 0x5b, 0x0e, 
+0x59, 0xa1, 0xb8, 0xf5, 0xb0, 0x2c, 0x02, 0x20, 
+0x5f, 0xb4, 0x18, 0x67, 0x98, 0xa2, 0x3a, 0x3c, 
+0x96, 0x3c, 0x2e, 0x19, 0xb4, 0xa8, 0x0a, 0x18, 
+0x72, 0x67, 0x82, 0x22, 0x39, 0x4b, 0xd3, 0x1d, 
+0xdd, 0xc8, 0xba, 0x96, 0x54, 0x8a, 0x60, 0x24, 
+0x01, 0x21, 0x03, 0x80, 0x1f, 0xe9, 0x23, 0x4a, 
+0xdf, 0x9c, 0x86, 0x70, 0xf1, 0x08, 0xec, 0x05, 
+0x7a, 0xf5, 0xe8, 0xb1, 0xf8, 0x7d, 0xcf, 0x41, 
+0xe9, 0xba, 0x13, 0x59, 0x5d, 0xee, 0x3d, 0x7e, 
+0x43, 0x33, 0x66, 0xff, 0xff, 0xff, 0xff, 0x02, 
+0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0xba, 0x7f, 0xc8, 0xf8, 
+0xcc, 0xaa, 0x75, 0xe0, 0x78, 0x96, 0x1c, 0x88, 
+0x88, 0xe9, 0x8c, 0x89, 0x21, 0x3d, 0x85, 0xa8, 
+0x88, 0xac, 0x5c, 0x9d, 0xf3, 0xc4, 0xe5, 0x01, 
+0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0x3c, 0x6a, 
+0xef, 0x58, 0xe5, 0xcb, 0x9e, 0x31, 0xbb, 0x43, 
+0xd9, 0xb8, 0x81, 0x5c, 0x88, 0x1c, 0x31, 0x7c, 
+0x1e, 0xf6, 0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 
+0x01, 0x00, 0x00, 0x00, 0x01, 0x1e, 0xb5, 0xe0, 
+0x84, 0x22, 0x94, 0xd7, 0xd6, 0xe2, 0x2e, 0x53, 
+0xeb, 0x23, 0x5f, 0xf4, 0x4d, 0xbc, 0xe9, 0x24, 
+0xef, 0x06, 0x9c, 0x47, 0xa7, 0xda, 0x6c, 0xf1, 
+0xaf, 0xf6, 0x7a, 0x25, 0xf3, 0x01, 0x00, 0x00, 
+0x00, 0x6a, 0x47, 0x30, 0x44, 0x02, 0x20, 0x66, 
+0x71, 0x6c, 0x47, 0xec, 0x57, 0x95, 0x9e, 0x3e, 
+0x0c, 0x0c, 0x28, 0x37, 0x45, 0xc0, 0xbe, 0xd0, 
+0xe7, 0x59, 0x50, 0xc3, 0x94, 0x63, 0x9b, 0xf8, 
+0x70, 0x98, 0x5f, 0xbd, 0xdd, 0xdd, 0x90, 0x02, 
+0x20, 0x3c, 0x78, 0xbf, 0x51, 0x8a, 0x14, 0x8e, 
+0x8b, 0xed, 0xb8, 0x01, 0xb9, 0xb8, 0x90, 0x04, 
+0x84, 0x5b, 0xbf, 0xdd, 0x27, 0x06, 0x8b, 0x50, 
+0xfa, 0xda, 0x54, 0x69, 0xcf, 0x90, 0x6c, 0x28, 
+0xed, 0x01, 0x21, 0x03, 0x60, 0x99, 0xf3, 0xd2, 
+0x85, 0xb0, 0x2c, 0x17, 0x7b, 0x5c, 0xb8, 0x14, 
+0x67, 0x87, 0xca, 0x35, 0x99, 0x9a, 0xac, 0x15, 
+0x92, 0x4f, 0xfe, 0x1b, 0x3e, 0xb5, 0xae, 0xda, 
+0xde, 0xd7, 0x0b, 0x26, 0xff, 0xff, 0xff, 0xff, 
+0x02, 0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 
+0x00, 0x19, 0x76, 0xa9, 0x14, 0x99, 0x5f, 0x27, 
+0x3d, 0xaa, 0xa1, 0x49, 0x4b, 0xba, 0xac, 0xbe, 
+0x58, 0x3f, 0x42, 0xd9, 0x97, 0x29, 0x12, 0x82, 
+0x90, 0x88, 0xac, 0x9b, 0xc7, 0x58, 0x89, 0xe5, 
+0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0x3d, 
+0xe8, 0x2f, 0x26, 0x41, 0x3e, 0x5d, 0x5f, 0xeb, 
+0xbb, 0x9a, 0x4c, 0x73, 0x2f, 0xeb, 0xfb, 0xb5, 
+0xf1, 0xde, 0x88, 0x88, 0xac, 0x00, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x45, 0x9c, 
+0x9f, 0xcd, 0x00, 0x9d, 0xf3, 0xf0, 0xfd, 0x8d, 
+0x4f, 0xa9, 0x85, 0xa2, 0x89, 0xb3, 0xa4, 0x58, 
+0x68, 0xf1, 0x18, 0xa1, 0x2b, 0xb5, 0x27, 0x17, 
+0x85, 0xcc, 0x3c, 0x31, 0x76, 0xdd, 0x01, 0x00, 
+0x00, 0x00, 0x6a, 0x47, 0x30, 0x44, 0x02, 0x20, 
+0x16, 0x78, 0x18, 0xf9, 0x4f, 0xfb, 0x24, 0xa4, 
+0x94, 0xb3, 0x48, 0x78, 0x0c, 0xc2, 0xdf, 0x8b, 
+0x8a, 0x87, 0xc9, 0xdb, 0x46, 0xc0, 0xa7, 0xff, 
+0xdd, 0xb0, 0xa6, 0xa4, 0x3c, 0xa5, 0xba, 0xfd, 
+0x02, 0x20, 0x36, 0xb2, 0xdd, 0xa6, 0x44, 0xbd, 
+0xa0, 0x94, 0xeb, 0x94, 0x83, 0x40, 0x46, 0x49, 
+0x75, 0xb5, 0x29, 0x4b, 0x15, 0x94, 0xad, 0xb7, 
+0xcd, 0xcf, 0xab, 0x4a, 0x7b, 0x71, 0xaf, 0xeb, 
+0x11, 0xa7, 0x01, 0x21, 0x03, 0x9a, 0x86, 0xb0, 
+0x2a, 0x9e, 0x83, 0xed, 0x4b, 0x4f, 0x16, 0x03, 
+0xc5, 0x6c, 0x09, 0x7b, 0xa2, 0xf8, 0xad, 0xd3, 
+0x00, 0xfe, 0x95, 0x4d, 0x24, 0x76, 0x5c, 0xd2, 
+0x10, 0x34, 0xef, 0x81, 0x03, 0xff, 0xff, 0xff, 
+0xff, 0x02, 0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 
+0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0xef, 0x5a, 
+0xcb, 0xda, 0x31, 0x41, 0xf7, 0xf4, 0xcb, 0xb8, 
+0x17, 0x75, 0xb1, 0xaf, 0xa4, 0x6d, 0x8d, 0xde, 
+0x6a, 0x6e, 0x88, 0xac, 0xe8, 0xf1, 0xbd, 0x4d, 
+0xe5, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0xb7, 0xaa, 0x17, 0xb5, 0x18, 0xcc, 0x41, 0xec, 
+0x00, 0xdc, 0x82, 0xed, 0xf1, 0x0e, 0xc8, 0x2d, 
+0x46, 0x18, 0x2c, 0xa4, 0x88, 0xac, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0xd7, 
+0x96, 0x4b, 0x6d, 0xec, 0x92, 0x63, 0x31, 0x3d, 
+0x0e, 0x83, 0xe8, 0xef, 0x6c, 0x0c, 0xad, 0xa7, 
+0x60, 0xc3, 0x4c, 0x88, 0x9b, 0x97, 0x99, 0xb7, 
+0xbd, 0x88, 0x0d, 0x7f, 0x44, 0x65, 0xa8, 0x01, 
+0x00, 0x00, 0x00, 0x6a, 0x47, 0x30, 0x44, 0x02, 
+0x20, 0x13, 0xce, 0xc7, 0xc7, 0x0f, 0xfa, 0x7a, 
+0x5e, 0x75, 0x52, 0x7f, 0x6f, 0x3d, 0x79, 0xa8, 
+0xa0, 0x92, 0x51, 0x9f, 0xa7, 0x4d, 0xb4, 0x98, 
+0x58, 0xaa, 0x05, 0x9f, 0x54, 0x79, 0x97, 0x21, 
+0x9b, 0x02, 0x20, 0x06, 0xc2, 0x7a, 0x2e, 0x80, 
+0x6b, 0x30, 0xeb, 0x27, 0x03, 0x6d, 0x23, 0x3f, 
+0x9b, 0x56, 0x44, 0xf8, 0x8e, 0xbb, 0x19, 0xcd, 
+0xb8, 0xb7, 0x11, 0x0a, 0x40, 0x4e, 0xc8, 0x28, 
+0xe2, 0xd5, 0xd8, 0x01, 0x21, 0x03, 0x37, 0x4a, 
+0x71, 0x32, 0xca, 0x5b, 0xca, 0xfb, 0x92, 0x75, 
+0x11, 0x3a, 0xf8, 0xd6, 0x71, 0x2f, 0x84, 0x27, 
+0x78, 0x22, 0x16, 0x3c, 0x1b, 0x2d, 0x80, 0xa4, 
+0xd3, 0x7c, 0xf6, 0x1e, 0xf0, 0x06, 0xff, 0xff, 
+0xff, 0xff, 0x02, 0x00, 0xca, 0x9a, 0x3b, 0x00, 
+0x00, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 0x9c, 
+0x57, 0x81, 0x27, 0x8b, 0x71, 0x6c, 0x04, 0x7e, 
+0xe6, 0x0e, 0x5a, 0x3f, 0x29, 0xa9, 0x8f, 0x55, 
+0xc5, 0xef, 0x3f, 0x88, 0xac, 0x27, 0x1c, 0x23, 
+0x12, 0xe5, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 
+0x14, 0x88, 0x7c, 0x2d, 0xac, 0x23, 0x52, 0x90, 
+0xbf, 0xb8, 0x85, 0x4e, 0x88, 0x5c, 0x52, 0xcb, 
+0x5b, 0x13, 0x0d, 0xf3, 0x1c, 0x88, 0xac, 0x00, 
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 
+0x0f, 0x4d, 0x99, 0x84, 0x9e, 0xc2, 0xe1, 0x6a, 
+0x90, 0x11, 0x4d, 0x27, 0x74, 0xb0, 0x99, 0x76, 
+0x1e, 0x46, 0x0e, 0x9f, 0x3f, 0x34, 0xb9, 0xb0, 
+0x0a, 0x55, 0xf9, 0xe8, 0x9f, 0x5e, 0x1f, 0xc5, 
+0x01, 0x00, 0x00, 0x00, 0x6a, 0x47, 0x30, 0x44, 
+0x02, 0x20, 0x62, 0xe1, 0x02, 0x97, 0x34, 0x8d, 
+0x7f, 0x2e, 0x96, 0x86, 0x93, 0xff, 0x3f, 0xd3, 
+0xa0, 0x5b, 0xa7, 0xdb, 0x4f, 0x10, 0x4c, 0xe3, 
+0x9e, 0xea, 0xa2, 0x0f, 0x32, 0x81, 0x73, 0xae, 
+0x5a, 0xf1, 0x02, 0x20, 0x46, 0xd0, 0xb1, 0x55, 
+0xfd, 0xc6, 0xbe, 0x0c, 0x11, 0x63, 0xe0, 0x6b, 
+0xe6, 0x08, 0x56, 0xc0, 0xdf, 0x81, 0xcb, 0x2d, 
+0x0f, 0x74, 0xe6, 0xa8, 0xda, 0x86, 0x28, 0x83, 
+0x32, 0x92, 0x08, 0x38, 0x01, 0x21, 0x03, 0x35, 
+0x2a, 0x3b, 0x82, 0x93, 0xc1, 0xd4, 0x91, 0xd0, 
+0x3a, 0xb7, 0x8a, 0x7b, 0xd3, 0x8f, 0x80, 0x66, 
+0xdc, 0xa4, 0x7f, 0x93, 0x93, 0x0f, 0x72, 0x59, 
+0x2c, 0x0b, 0x02, 0xb1, 0xf9, 0xa9, 0x2c, 0xff, 
+0xff, 0xff, 0xff, 0x02, 0x66, 0x46, 0x88, 0xd6, 
+0xe4, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 0x14, 
+0x02, 0x75, 0x2f, 0xe8, 0x64, 0x97, 0x4a, 0x00, 
+0xa5, 0x4b, 0xa2, 0xb3, 0xe8, 0x40, 0x63, 0xee, 
+0x63, 0x87, 0x80, 0x30, 0x88, 0xac, 0x00, 0xca, 
+0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0xba, 0x7f, 0xc8, 0xf8, 0xcc, 0xaa, 
+0x75, 0xe0, 0x78, 0x96, 0x1c, 0x88, 0x88, 0xe9, 
+0x8c, 0x89, 0x21, 0x3d, 0x85, 0xa8, 0x88, 0xac, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
+0x01, 0x74, 0xd5, 0x84, 0x4d, 0x12, 0xea, 0x7d, 
+0x56, 0x6e, 0x7f, 0xb3, 0x0d, 0x3c, 0x0e, 0x60, 
+0x46, 0x78, 0xeb, 0xdc, 0x71, 0x53, 0xc3, 0x49, 
+0x42, 0x08, 0xfa, 0x38, 0xb5, 0xf9, 0x20, 0x47, 
+0xef, 0x00, 0x00, 0x00, 0x00, 0x6a, 0x47, 0x30, 
+0x44, 0x02, 0x20, 0x2e, 0x40, 0x03, 0x4c, 0x43, 
+0x62, 0x3b, 0xcf, 0xef, 0x86, 0xfb, 0xea, 0x24, 
+0x63, 0xe9, 0x13, 0xf9, 0x30, 0x33, 0x62, 0xdc, 
+0x46, 0xa5, 0x0d, 0x5d, 0x91, 0xc7, 0x19, 0xdb, 
+0x5a, 0x36, 0xb8, 0x02, 0x20, 0x1e, 0xd8, 0xa7, 
+0xa0, 0xd4, 0x05, 0x50, 0x10, 0xe0, 0x18, 0x90, 
+0xeb, 0x1d, 0x95, 0xb7, 0x23, 0x73, 0xe3, 0xb8, 
+0x6d, 0x25, 0x49, 0x6b, 0x38, 0xee, 0x77, 0x0c, 
+0x32, 0x93, 0x03, 0x05, 0xb8, 0x01, 0x21, 0x03, 
+0xe4, 0x13, 0x12, 0xf1, 0xb0, 0x17, 0x8e, 0x0b, 
+0xa2, 0xb3, 0xb5, 0x4a, 0x5c, 0xf2, 0xad, 0x91, 
+0xd1, 0xea, 0x15, 0x18, 0x34, 0x73, 0x11, 0x4f, 
+0x18, 0x26, 0x85, 0x3e, 0xad, 0x24, 0x5b, 0x9c, 
+0xff, 0xff, 0xff, 0xff, 0x02, 0xa5, 0x70, 0xed, 
+0x9a, 0xe4, 0x01, 0x00, 0x00, 0x19, 0x76, 0xa9, 
+0x14, 0x3d, 0x77, 0xd3, 0x7d, 0x91, 0xa4, 0x61, 
+0x85, 0x9d, 0xf3, 0xf7, 0x1d, 0x5b, 0xb3, 0xb9, 
+0x6f, 0x31, 0x02, 0xc9, 0xbd, 0x88, 0xac, 0x00, 
+0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x19, 
+0x76, 0xa9, 0x14, 0x99, 0x5f, 0x27, 0x3d, 0xaa, 
+0xa1, 0x49, 0x4b, 0xba, 0xac, 0xbe, 0x58, 0x3f, 
+0x42, 0xd9, 0x97, 0x29, 0x12, 0x82, 0x90, 0x88, 
+0xac, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x00, 0x01, 0x6b, 0x7e, 0x02, 0x7b, 0x51, 0x27, 
+0xbd, 0x7b, 0x1a, 0xdc, 0x52, 0xe9, 0x81, 0xb7, 
+0xc5, 0xd5, 0x61, 0x4f, 0x7b, 0x95, 0x64, 0xfc, 
+0x7e, 0x60, 0x5f, 0xd7, 0x52, 0x2c, 0xef, 0xc7, 
+0x9f, 0x21, 0x00, 0x00, 0x00, 0x00, 0x6a, 0x47, 
+0x30, 0x44, 0x02, 0x20, 0x10, 0x3b, 0x9c, 0x40, 
+0xc7, 0xc2, 0x27, 0xb4, 0xe2, 0xb4, 0x67, 0x7c, 
+0xaa, 0xbe, 0x98, 0x77, 0x55, 0xd7, 0xe8, 0x8a, 
+0xe6, 0xd1, 0xdf, 0xd0, 0x1a, 0x4b, 0xfb, 0x8d, 
+0xc3, 0x71, 0xc3, 0x29, 0x02, 0x20, 0x16, 0x24, 
+0x10, 0x1d, 0x02, 0x4e, 0xd9, 0x3c, 0xf1, 0x43, 
+0x35, 0xd4, 0xf1, 0xde, 0x80, 0x57, 0xdc, 0xa9, 
+0x53, 0xf3, 0xf6, 0xe2, 0xfe, 0xef, 0xc8, 0xdb, 
+0x92, 0x6f, 0xb6, 0x2e, 0x25, 0xf6, 0x01, 0x21, 
+0x02, 0x40, 0x6e, 0x4e, 0xc3, 0x63, 0x77, 0xe5, 
+0xc4, 0xee, 0xc2, 0x39, 0x2a, 0xcf, 0x5d, 0xa7, 
+0x26, 0x06, 0xd6, 0xa8, 0x14, 0x28, 0x15, 0x53, 
+0x48, 0x88, 0x12, 0x2d, 0xc9, 0xa6, 0x7d, 0xa1, 
+0xa9, 0xff, 0xff, 0xff, 0xff, 0x02, 0xf2, 0x9a, 
+0x52, 0x5f, 0xe4, 0x01, 0x00, 0x00, 0x19, 0x76, 
+0xa9, 0x14, 0x40, 0x6b, 0x99, 0xea, 0xe0, 0xcc, 
+0xcd, 0x8f, 0x25, 0xed, 0x23, 0x54, 0xd2, 0xe4, 
+0x7c, 0xfb, 0x68, 0x5d, 0x1b, 0x71, 0x88, 0xac, 
+0x00, 0xca, 0x9a, 0x3b, 0x00, 0x00, 0x00, 0x00, 
+0x19, 0x76, 0xa9, 0x14, 0xef, 0x5a, 0xcb, 0xda, 
+0x31, 0x41, 0xf7, 0xf4, 0xcb, 0xb8, 0x17, 0x75, 
+0xb1, 0xaf, 0xa4, 0x6d, 0x8d, 0xde, 0x6a, 0x6e, 
+0x88, 0xac, 0x00, 0x00, 0x00, 0x00, 
+};
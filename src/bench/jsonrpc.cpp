@@ -0,0 +1,160 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <xbridge/util/xutil.h>
+
+#include <univalue.h>
+
+#include <json/json_spirit_reader_template.h>
+#include <json/json_spirit_writer_template.h>
+
+#include <string>
+#include <vector>
+
+static const int JSONRPC_BENCH_TXS = 500;
+static const int JSONRPC_BENCH_BATCH = 50;
+static const size_t JSONRPC_BENCH_RAWTX_SIZE = 100000;
+
+/**
+ * Wallet reply shaped like a getblock (verbosity 2) reply, each transaction
+ * includes its raw hex.
+ */
+static std::string VerboseBlockReply(int id)
+{
+    UniValue txs(UniValue::VARR);
+    for (int i = 0; i < JSONRPC_BENCH_TXS; ++i) {
+        UniValue addresses(UniValue::VARR);
+        addresses.push_back("BmEVXq7HSiCRrmEz2RuzZjXQEg5JoPvYg3");
+        UniValue script(UniValue::VOBJ);
+        script.pushKV("hex", std::string(50, 'a'));
+        script.pushKV("addresses", addresses);
+        UniValue vout(UniValue::VOBJ);
+        vout.pushKV("value", UniValue(UniValue::VNUM, "1.50000000"));
+        vout.pushKV("n", 0);
+        vout.pushKV("scriptPubKey", script);
+        UniValue vouts(UniValue::VARR);
+        vouts.push_back(vout);
+        UniValue tx(UniValue::VOBJ);
+        tx.pushKV("txid", std::string(64, 'b'));
+        tx.pushKV("vout", vouts);
+        tx.pushKV("hex", std::string(450, 'c'));
+        txs.push_back(tx);
+    }
+    UniValue block(UniValue::VOBJ);
+    block.pushKV("hash", std::string(64, 'd'));
+    block.pushKV("height", 1000000 + id);
+    block.pushKV("tx", txs);
+    UniValue reply(UniValue::VOBJ);
+    reply.pushKV("result", block);
+    reply.pushKV("error", NullUniValue);
+    reply.pushKV("id", id);
+    return reply.write();
+}
+
+static const std::string & BatchReply()
+{
+    static const std::string reply = [] {
+        std::string batch = "[";
+        for (int i = JSONRPC_BENCH_BATCH - 1; i >= 0; --i) // replies may be out of order
+            batch += VerboseBlockReply(i) + (i > 0 ? "," : "]");
+        return batch;
+    }();
+    return reply;
+}
+
+static const json_spirit::Array & RawTxParams()
+{
+    static const json_spirit::Array params{ std::string(JSONRPC_BENCH_RAWTX_SIZE, 'e'), 1.5, true };
+    return params;
+}
+
+// Request body built by converting the json_spirit params to univalue
+static void JSONRPCRequestUniValue(benchmark::State& state)
+{
+    const auto & params = RawTxParams();
+    while (state.KeepRunning()) {
+        const auto tostring = json_spirit::write_string(json_spirit::Value(params), json_spirit::none, 8);
+        UniValue toval;
+        toval.read(tostring);
+        UniValue request(UniValue::VOBJ);
+        request.pushKV("method", "sendrawtransaction");
+        request.pushKV("params", toval);
+        request.pushKV("id", 1);
+        const auto body = request.write() + "\n";
+        assert(body.size() > JSONRPC_BENCH_RAWTX_SIZE);
+    }
+}
+
+// Request body written directly from the json_spirit params
+static void JSONRPCRequestDirect(benchmark::State& state)
+{
+    const auto & params = RawTxParams();
+    while (state.KeepRunning()) {
+        const auto body = xbridge::jsonrpcRequest("sendrawtransaction", params, 1);
+        assert(body.size() > JSONRPC_BENCH_RAWTX_SIZE);
+    }
+}
+
+// Batch reply split by parsing and re-writing each reply
+static void JSONRPCBatchReplyUniValue(benchmark::State& state)
+{
+    const auto & batch = BatchReply();
+    while (state.KeepRunning()) {
+        UniValue replies;
+        replies.read(batch);
+        std::vector<std::string> split(replies.size());
+        for (size_t i = 0; i < replies.size(); ++i)
+            split[find_value(replies[i], "id").get_int()] = replies[i].write();
+        assert(split.size() == JSONRPC_BENCH_BATCH);
+    }
+}
+
+// Batch reply split into the raw replies, only the ids are read
+static void JSONRPCBatchReplyRaw(benchmark::State& state)
+{
+    const auto & batch = BatchReply();
+    while (state.KeepRunning()) {
+        std::vector<std::string> elements;
+        xbridge::splitJsonArray(batch, elements);
+        std::vector<std::string> split(elements.size());
+        for (auto & reply : elements) {
+            std::string id;
+            xbridge::findJsonMember(reply, "id", id);
+            split[std::stoi(id)] = std::move(reply);
+        }
+        assert(split.size() == JSONRPC_BENCH_BATCH);
+    }
+}
+
+// XRouter server result extraction by parsing the reply and writing the result
+static void JSONRPCResultParsed(benchmark::State& state)
+{
+    const auto reply = VerboseBlockReply(1);
+    while (state.KeepRunning()) {
+        json_spirit::Value val;
+        json_spirit::read_string(reply, val);
+        const auto result = json_spirit::write_string(json_spirit::find_value(val.get_obj(), "result"));
+        assert(!result.empty());
+    }
+}
+
+// XRouter server result extraction passing through the raw result
+static void JSONRPCResultRaw(benchmark::State& state)
+{
+    const auto reply = VerboseBlockReply(1);
+    while (state.KeepRunning()) {
+        std::string result;
+        xbridge::findJsonMember(reply, "result", result);
+        assert(!result.empty());
+    }
+}
+
+BENCHMARK(JSONRPCRequestUniValue, 500);
+BENCHMARK(JSONRPCRequestDirect, 500);
+BENCHMARK(JSONRPCBatchReplyUniValue, 2);
+BENCHMARK(JSONRPCBatchReplyRaw, 2);
+BENCHMARK(JSONRPCResultParsed, 5);
+BENCHMARK(JSONRPCResultRaw, 5);
@@ -0,0 +1,244 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <chain.h>
+#include <chainparams.h>
+#include <hash.h>
+#include <kernel.h>
+#include <primitives/block.h>
+#include <validation.h>
+
+#ifdef ENABLE_WALLET
+#include <stakemgr.h>
+#include <wallet/wallet.h>
+#endif
+
+#include <deque>
+#include <vector>
+
+static const int POS_BENCH_BLOCKS = 1000;
+static const unsigned int POS_BENCH_BITS = 0x1d00ffff;
+static const CAmount POS_BENCH_STAKE_AMOUNT = 5000 * COIN;
+
+/**
+ * Selects the mainnet params while in scope, the params of the other benchmarks are
+ * restored afterwards.
+ */
+class MainParamsScope {
+public:
+    MainParamsScope() : previous(Params().NetworkIDString()) {
+        SelectParams(CBaseChainParams::MAIN);
+    }
+    ~MainParamsScope() {
+        SelectParams(previous);
+    }
+private:
+    const std::string previous;
+};
+
+/**
+ * Synthetic proof-of-stake chain on mainnet consensus rules. Blocks are spaced by the
+ * target spacing and start after the v06 staking protocol upgrade. Stake modifiers
+ * are computed the same way as AddToBlockIndex.
+ */
+struct PoSBenchChain {
+    std::deque<uint256> hashes;
+    std::deque<CBlockIndex> blocks;
+
+    PoSBenchChain() {
+        const auto & consensus = Params().GetConsensus();
+        const int64_t startTime = consensus.stakingV06UpgradeTime + 86400;
+        for (int i = 0; i < POS_BENCH_BLOCKS; ++i) {
+            hashes.push_back(SerializeHash(i));
+            blocks.emplace_back();
+            auto & pindex = blocks.back();
+            pindex.phashBlock = &hashes.back();
+            pindex.pprev = i > 0 ? &blocks[i-1] : nullptr;
+            pindex.nHeight = i;
+            pindex.nTime = static_cast<uint32_t>(startTime + i * consensus.nPowTargetSpacing);
+            pindex.nBits = POS_BENCH_BITS;
+            pindex.BuildSkip();
+            pindex.hashProofOfStake = SerializeHash(hashes.back());
+            if (IsProofOfStake(i, consensus))
+                pindex.SetProofOfStake();
+            pindex.SetStakeEntropyBit(GetStakeEntropyBit(hashes.back(), pindex.GetBlockTime()));
+            uint64_t stakeModifier{0};
+            bool generated{false};
+            ComputeNextStakeModifier(pindex.pprev, stakeModifier, generated, consensus);
+            pindex.SetStakeModifier(stakeModifier, generated);
+        }
+    }
+
+    const CBlockIndex* Tip() const {
+        return &blocks.back();
+    }
+
+    // Stake input old enough to stake on the tip
+    const CBlockIndex* StakeBlock() const {
+        return &blocks[POS_BENCH_BLOCKS / 2];
+    }
+
+    // Stake prevout in the stake block
+    COutPoint StakePrevout() const {
+        return COutPoint{SerializeHash(StakeBlock()->GetBlockHash()), 1};
+    }
+
+    // Returns a timestamp after the tip that meets the stake target
+    int64_t StakeTime() const {
+        const auto & consensus = Params().GetConsensus();
+        for (int64_t t = Tip()->GetBlockTime() + 1; ; ++t) {
+            uint256 hashProofOfStake;
+            if (CheckStakeKernelHash(Tip(), StakeBlock(), POS_BENCH_BITS, POS_BENCH_STAKE_AMOUNT, StakePrevout(), t,
+                                     static_cast<unsigned int>(t), hashProofOfStake, consensus))
+                return t;
+        }
+    }
+};
+
+// Requires the mainnet params
+static const PoSBenchChain & GetPoSBenchChain() {
+    static const PoSBenchChain chain;
+    return chain;
+}
+
+// Scalar stake kernel hashing, a batch of timestamps per iteration
+static void PoSStakeHashV06(benchmark::State& state)
+{
+    const MainParamsScope mainParams;
+    const auto & chain = GetPoSBenchChain();
+    const auto pindexStake = chain.StakeBlock();
+    const auto stakeHeight = chain.Tip()->nHeight + 1;
+    auto nTimeTx = static_cast<unsigned int>(chain.Tip()->GetBlockTime());
+    CDataStream ss(SER_GETHASH, 0);
+    ss << chain.Tip()->nStakeModifier;
+    uint256 hash;
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < StakeKernelHasher::BATCH_SIZE; ++i)
+            hash = stakeHashV06(ss, pindexStake->GetBlockHash(), pindexStake->GetBlockTime(), stakeHeight, 1, nTimeTx++);
+    }
+}
+
+// Batched stake kernel hashing used by the staker
+static void PoSStakeKernelHasherBatch(benchmark::State& state)
+{
+    const MainParamsScope mainParams;
+    const auto & chain = GetPoSBenchChain();
+    const auto pindexStake = chain.StakeBlock();
+    const auto stakeHeight = chain.Tip()->nHeight + 1;
+    auto nTimeTx = static_cast<unsigned int>(chain.Tip()->GetBlockTime());
+    std::vector<uint256> hashes(StakeKernelHasher::BATCH_SIZE);
+    while (state.KeepRunning()) {
+        const StakeKernelHasher hasher(chain.Tip()->nStakeModifier, pindexStake->GetBlockHash(),
+                                       pindexStake->GetBlockTime(), stakeHeight, 1);
+        hasher.HashBatch(nTimeTx, hashes.size(), hashes.data());
+        nTimeTx += hashes.size();
+    }
+}
+
+static void PoSComputeNextStakeModifier(benchmark::State& state)
+{
+    const MainParamsScope mainParams;
+    const auto & chain = GetPoSBenchChain();
+    const auto & consensus = Params().GetConsensus();
+    // Use a block that didn't generate a modifier, the next block will generate one
+    const CBlockIndex *pindexPrev = chain.Tip();
+    while (pindexPrev->GeneratedStakeModifier())
+        pindexPrev = pindexPrev->pprev;
+    uint64_t stakeModifier{0};
+    bool generated{false};
+    while (state.KeepRunning()) {
+        ComputeNextStakeModifier(pindexPrev, stakeModifier, generated, consensus);
+        assert(generated);
+    }
+}
+
+static void PoSCheckStakeKernelHash(benchmark::State& state)
+{
+    const MainParamsScope mainParams;
+    const auto & chain = GetPoSBenchChain();
+    const auto & consensus = Params().GetConsensus();
+    const auto stakeTime = chain.StakeTime();
+    uint256 hashProofOfStake;
+    while (state.KeepRunning()) {
+        bool hit = CheckStakeKernelHash(chain.Tip(), chain.StakeBlock(), POS_BENCH_BITS, POS_BENCH_STAKE_AMOUNT,
+                chain.StakePrevout(), stakeTime, static_cast<unsigned int>(stakeTime), hashProofOfStake, consensus);
+        assert(hit);
+    }
+}
+
+// Proof-of-stake block header validation, including the stake block lookup
+static void PoSCheckProofOfStake(benchmark::State& state)
+{
+    const MainParamsScope mainParams;
+    const auto & chain = GetPoSBenchChain();
+    const auto & consensus = Params().GetConsensus();
+    const auto stakeTime = chain.StakeTime();
+    const auto prevout = chain.StakePrevout();
+
+    CBlockHeader header;
+    header.hashPrevBlock = chain.Tip()->GetBlockHash();
+    header.nTime = static_cast<uint32_t>(stakeTime);
+    header.nBits = POS_BENCH_BITS;
+    header.nNonce = static_cast<uint32_t>(stakeTime);
+    header.hashStake = prevout.hash;
+    header.nStakeIndex = prevout.n;
+    header.nStakeAmount = POS_BENCH_STAKE_AMOUNT;
+    header.hashStakeBlock = chain.StakeBlock()->GetBlockHash();
+
+    const auto pindexStake = const_cast<CBlockIndex*>(chain.StakeBlock());
+    {
+        LOCK(cs_main);
+        mapBlockIndex[pindexStake->GetBlockHash()] = pindexStake;
+    }
+    uint256 hashProofOfStake;
+    while (state.KeepRunning()) {
+        bool valid = CheckProofOfStake(header, chain.Tip(), hashProofOfStake, consensus);
+        assert(valid);
+    }
+    {
+        LOCK(cs_main);
+        mapBlockIndex.erase(pindexStake->GetBlockHash());
+    }
+}
+
+#ifdef ENABLE_WALLET
+// Stake search over a one minute window, per staking input
+static void PoSGetStakesMeetingTarget(benchmark::State& state)
+{
+    const MainParamsScope mainParams;
+    const auto & chain = GetPoSBenchChain();
+    const auto & consensus = Params().GetConsensus();
+    const auto pindexStake = chain.StakeBlock();
+
+    CMutableTransaction mtx;
+    mtx.vin.resize(1);
+    mtx.vout.resize(2);
+    mtx.vout[1].nValue = POS_BENCH_STAKE_AMOUNT;
+    CWalletTx wtx(nullptr, MakeTransactionRef(mtx));
+    wtx.hashBlock = pindexStake->GetBlockHash();
+    wtx.nTimeReceived = static_cast<unsigned int>(pindexStake->GetBlockTime());
+    auto coin = std::make_shared<COutput>(&wtx, 1, 100, true, true, true);
+    std::shared_ptr<CWallet> wallet;
+
+    StakeMgr staker;
+    const auto fromTime = chain.Tip()->GetBlockTime() + 1;
+    const auto blockTime = fromTime;
+    while (state.KeepRunning()) {
+        std::map<int64_t, std::vector<StakeMgr::StakeCoin>> stakes;
+        staker.GetStakesMeetingTarget(coin, wallet, chain.Tip(), pindexStake, blockTime, blockTime, fromTime,
+                                      fromTime + 60, stakes, consensus);
+    }
+}
+#endif
+
+BENCHMARK(PoSStakeHashV06, 2000);
+BENCHMARK(PoSStakeKernelHasherBatch, 2000);
+BENCHMARK(PoSComputeNextStakeModifier, 100);
+BENCHMARK(PoSCheckStakeKernelHash, 50000);
+BENCHMARK(PoSCheckProofOfStake, 50000);
+#ifdef ENABLE_WALLET
+BENCHMARK(PoSGetStakesMeetingTarget, 2000);
+#endif
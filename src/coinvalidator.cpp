@@ -10,6 +10,7 @@
 #include <script/standard.h>
 #include <util/system.h>
 
+#include <algorithm>
 #include <fstream>
 
 /**
@@ -17,6 +18,27 @@
  */
 const int CoinValidator::CHAIN_HEIGHT = 101651;
 
+InfractionSet::InfractionSet(std::vector<uint256> ids) : filter((1 << FILTER_BITS) / 64, 0), txIds(std::move(ids)) {
+    std::sort(txIds.begin(), txIds.end());
+    txIds.erase(std::unique(txIds.begin(), txIds.end()), txIds.end());
+    for (const auto &txId : txIds) {
+        const uint64_t bit = txId.GetUint64(0) & ((1 << FILTER_BITS) - 1);
+        filter[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+}
+
+/**
+ * Returns true if the txid is in the set.
+ * @param txId
+ * @return
+ */
+bool InfractionSet::Contains(const uint256 &txId) const {
+    const uint64_t bit = txId.GetUint64(0) & ((1 << FILTER_BITS) - 1);
+    if (!(filter[bit / 64] & (uint64_t(1) << (bit % 64))))
+        return false;
+    return std::binary_search(txIds.begin(), txIds.end(), txId);
+}
+
 /**
  * Returns true if the tx is not associated with any infractions.
  * @param txId
@@ -24,12 +46,11 @@ const int CoinValidator::CHAIN_HEIGHT = 101651;
  */
 bool CoinValidator::IsCoinValid(const uint256 &txId) const {
     // A coin is valid if its tx is not in the infractions list
-    boost::mutex::scoped_lock l(lock);
-    return infMap.count(txId.ToString()) == 0;
+    const InfractionSet *infs = infSet.load(std::memory_order_acquire);
+    return infs == nullptr || !infs->Contains(txId);
 }
 bool CoinValidator::IsCoinValid(uint256 &txId) const {
-    boost::mutex::scoped_lock l(lock);
-    return infMap.count(txId.ToString()) == 0;
+    return IsCoinValid(static_cast<const uint256&>(txId));
 }
 bool CoinValidator::IsCoinValid(const std::string &txId) const {
     boost::mutex::scoped_lock l(lock);
@@ -121,6 +142,7 @@ bool CoinValidator::IsLoaded() const {
 void CoinValidator::Clear() {
     boost::mutex::scoped_lock l(lock);
     infMap.clear();
+    publish();
     lastLoadH = 0;
     infMapLoaded = false;
     downloadErr = false;
@@ -132,11 +154,13 @@ void CoinValidator::Clear() {
  */
 std::vector<InfractionData> CoinValidator::GetInfractions(const uint256 &txId) {
     boost::mutex::scoped_lock l(lock);
-    return infMap[txId.ToString()];
+    auto it = infMap.find(txId.ToString());
+    if (it == infMap.end())
+        return {};
+    return it->second;
 }
 std::vector<InfractionData> CoinValidator::GetInfractions(uint256 &txId) {
-    boost::mutex::scoped_lock l(lock);
-    return infMap[txId.ToString()];
+    return GetInfractions(static_cast<const uint256&>(txId));
 }
 std::vector<InfractionData> CoinValidator::GetInfractions(const std::string &address) {
     boost::mutex::scoped_lock l(lock);
@@ -203,6 +227,7 @@ bool CoinValidator::Load(int loadHeight) {
 
                     // If we didn't fail return, otherwise proceed to load from network
                     if (!failed) {
+                        publish();
                         LogPrintf("Coin Validator: Loading from cache: %u\n", lastLoadH);
                         return true;
                     }
@@ -219,6 +244,7 @@ bool CoinValidator::Load(int loadHeight) {
     std::list<std::string> lst;
     if (!downloadList(lst, err) || lst.empty()) {
         LogPrintf("Coin Validator: Failed to load from network: %s\n", err);
+        publish();
         infMapLoaded = false;
         return false;
     }
@@ -227,6 +253,7 @@ bool CoinValidator::Load(int loadHeight) {
     for (std::string &line : lst) {
         addLine(line, infMap);
     }
+    publish();
 
     // Save to disk
     std::ofstream file(getExplPath().string(), std::ios::out | std::ofstream::binary);
@@ -269,12 +296,27 @@ bool CoinValidator::LoadStatic() {
             assert(result);
         }
     }
+    publish();
 
     lastLoadH = CHAIN_HEIGHT;
     LogPrintf("Coin Validator: Ready: %u\n", lastLoadH);
     return true;
 }
 
+/**
+ * Publishes the txids of the infraction map for lock-free lookups. Requires the lock.
+ */
+void CoinValidator::publish() {
+    std::vector<uint256> txIds;
+    txIds.reserve(infMap.size());
+    for (const auto &item : infMap) {
+        if (!item.second.empty())
+            txIds.push_back(uint256S(item.first));
+    }
+    infSets.emplace_back(new InfractionSet(std::move(txIds)));
+    infSet.store(infSets.back().get(), std::memory_order_release);
+}
+
 /**
  * Return cached file path.
  * @return
@@ -11,6 +11,9 @@
 #include <script/script.h>
 #include <uint256.h>
 
+#include <atomic>
+#include <memory>
+
 #include <boost/thread/mutex.hpp>
 #include <boost/filesystem/path.hpp>
 
@@ -40,6 +43,21 @@ struct RedeemData {
     }
 };
 
+/**
+ * Immutable set of the txids with infractions. A sorted array with a bitmap
+ * prefilter on the low bits of the txid, lookups don't allocate and most
+ * valid txids are rejected by the prefilter without searching the array.
+ */
+class InfractionSet {
+public:
+    explicit InfractionSet(std::vector<uint256> txIds);
+    bool Contains(const uint256 &txId) const;
+private:
+    static const int FILTER_BITS = 16;
+    std::vector<uint64_t> filter;
+    std::vector<uint256> txIds;
+};
+
 /**
  * Manages coin infractions.
  */
@@ -66,6 +84,9 @@ private:
     int lastLoadH = 0;
     bool downloadErr = false;
     mutable boost::mutex lock;
+    std::atomic<const InfractionSet*> infSet{nullptr}; // Published infraction txids, read without locking
+    std::vector<std::unique_ptr<const InfractionSet>> infSets; // Owns all published sets, readers may still hold old ones
+    void publish();
     boost::filesystem::path getExplPath();
     bool addLine(std::string &line, std::map<std::string, std::vector<InfractionData>> &map);
     int getBlockHeight(std::string &line);
@@ -24,6 +24,7 @@
 
 #include <regex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 #include <boost/algorithm/string.hpp>
@@ -47,6 +48,7 @@ static const uint8_t NETWORK_VERSION = 0x01;
 static const CAmount VOTING_UTXO_INPUT_AMOUNT = 1 * COIN;
 static const int VINHASH_SIZE = 12;
 static const int PROPOSAL_USERDEFINED_LIMIT = 139;
+static const int DEFAULT_GOVLOADTHREADS = 0; // 0 = number of cores
 typedef std::array<unsigned char, VINHASH_SIZE> VinHash;
 
 /**
@@ -627,6 +629,28 @@ public:
         return keyid;
     }
 
+    /**
+     * Serializes the vote including the memory only fields that were derived
+     * from the chain (outpoint, time, utxo amount, utxo keyid, block number).
+     * Used by the governance index to persist votes.
+     * @param s
+     */
+    template <typename Stream>
+    void SerializeWithState(Stream & s) const {
+        s << *this;
+        s << outpoint << time << amount << keyid << blockNumber;
+    }
+
+    /**
+     * Unserializes a vote that was serialized with SerializeWithState.
+     * @param s
+     */
+    template <typename Stream>
+    void UnserializeWithState(Stream & s) {
+        s >> *this;
+        s >> outpoint >> time >> amount >> keyid >> blockNumber;
+    }
+
     ADD_SERIALIZE_METHODS;
 
     template <typename Stream, typename Operation>
@@ -747,6 +771,57 @@ struct Hasher {
     size_t operator()(const COutPoint & out) const { return (CHashWriter(SER_GETHASH, 0) << out).GetCheapHash(); }
 };
 
+/**
+ * Governance data accepted from a single block. The governance index stores one
+ * of these per block that contains proposals or votes, which allows the governance
+ * state to be restored without reading blocks from disk.
+ */
+struct BlockData {
+    uint256 blockHash;
+    int blockHeight{0};
+    std::vector<Proposal> proposals;
+    std::vector<Vote> votes;
+    std::map<uint256, std::set<VinHash>> vinHashes; // vote hash -> vin hashes of the vote tx
+
+    BlockData() = default;
+    explicit BlockData(const uint256 & blockHash, const int & blockHeight) : blockHash(blockHash),
+                                                                             blockHeight(blockHeight) {}
+
+    bool isNull() const {
+        return proposals.empty() && votes.empty();
+    }
+
+    template <typename Stream>
+    void Serialize(Stream & s) const {
+        s << blockHash << blockHeight;
+        WriteCompactSize(s, proposals.size());
+        for (const auto & proposal : proposals)
+            s << proposal;
+        WriteCompactSize(s, votes.size());
+        for (const auto & vote : votes)
+            vote.SerializeWithState(s);
+        s << vinHashes;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream & s) {
+        s >> blockHash >> blockHeight;
+        proposals.clear();
+        votes.clear();
+        const auto nproposals = ReadCompactSize(s);
+        for (uint64_t i = 0; i < nproposals; ++i) {
+            Proposal proposal(blockHeight); s >> proposal;
+            proposals.push_back(proposal);
+        }
+        const auto nvotes = ReadCompactSize(s);
+        for (uint64_t i = 0; i < nvotes; ++i) {
+            Vote vote; vote.UnserializeWithState(s);
+            votes.push_back(vote);
+        }
+        s >> vinHashes;
+    }
+};
+
 /**
  * Manages related servicenode functions including handling network messages and storing an active list
  * of valid servicenodes.
@@ -813,14 +888,13 @@ public:
         if (!proposals.count(proposal))
             return false; // no proposal
 
-        const auto & prop = proposals[proposal];
-        if (!sbvotes.count(prop.getSuperblock()))
-            return false; // no superblock proposal
+        auto it = utxoVotes.find(utxo);
+        if (it == utxoVotes.end())
+            return false; // no votes for utxo
 
-        const auto & vs = sbvotes[prop.getSuperblock()];
-        for (const auto & item : vs) {
-            const auto & vote = item.second;
-            if (vote.getUtxo() == utxo && vote.getProposal() == proposal && vote.getVote() == voteType)
+        for (const auto & voteHash : it->second) {
+            const auto & vote = votes[voteHash];
+            if (vote.getProposal() == proposal && vote.getVote() == voteType)
                 return true;
         }
         return false;
@@ -836,16 +910,22 @@ public:
         votes.clear();
         stackvotes.clear();
         sbvotes.clear();
+        proposalVotes.clear();
+        utxoVotes.clear();
+        voterVotes.clear();
+        tallies.clear();
+        sbtallies.clear();
         return true;
     }
 
     /**
-     * TODO Blocknet use governance leveldb dat
-     * Loads the governance data from the blockchain ledger. It's possible to optimize
-     * this further by creating a separate leveldb for goverance data. Currently, this
-     * method will read every block on the chain beginning with the governance start
-     * block and search for goverance data. Requires the entire chainstate to be loaded
-     * at this point, including the transaction index.
+     * Loads the governance data from the blockchain ledger. This method will read every
+     * block on the chain beginning with the governance start block and search for
+     * goverance data. Requires the entire chainstate to be loaded at this point, including
+     * the transaction index. Prefer loading from the governance index (see GovernanceIndex)
+     * which does not require reading blocks from disk, this is used as the fallback.
+     * Blocks are sharded across nthreads (0 = number of cores) and the results are merged
+     * in block order, the resulting state is identical to a single threaded load.
      * @return
      */
     bool loadGovernanceData(const CChain & chain, CCriticalSection & chainMutex, const Consensus::Params & consensus,
@@ -863,23 +943,36 @@ public:
 
         boost::thread_group tg;
         Mutex mut; // manage access to shared data
-        const auto cores = nthreads == 0 ? GetNumCores() : nthreads;
         std::unordered_map<COutPoint, std::pair<uint256, int>, Hasher> spentPrevouts; // pair<txhash, blockheight>
         std::unordered_set<COutPoint, Hasher> chainVouts;
         bool useThreadGroup{false};
 
         // Shard the blocks into num equivalent to available cores
         const int totalBlocks = blockHeight - consensus.governanceBlock;
+        const auto cores = std::max(1, std::min(nthreads <= 0 ? GetNumCores() : nthreads, totalBlocks + 1));
         int slice = totalBlocks / cores;
         bool failed{false};
 
-        auto p1 = [&spentPrevouts,&chainVouts,&failed,&failReasonRet,&chain,&chainMutex,&mut,this]
-                  (const int start, const int end, const Consensus::Params & consensus) -> bool
+        // Each worker extracts the governance data, vin prevouts and vouts of its
+        // shard of blocks into its own buffer, no shared state is modified. The
+        // buffers are merged in block order after all workers complete which
+        // produces the same state as loading the blocks serially.
+        struct Shard {
+            int start{0};
+            int end{0};
+            bool failed{false};
+            std::string failReason;
+            std::vector<BlockData> blocks;
+            std::vector<std::pair<COutPoint, std::pair<uint256, int>>> prevouts;
+            std::vector<COutPoint> vouts;
+        };
+        std::vector<Shard> shards(cores);
+
+        auto p1 = [&chain,&chainMutex,this](Shard & shard, const Consensus::Params & consensus) -> bool
         {
-            for (int blockNumber = start; blockNumber < end; ++blockNumber) {
+            for (int blockNumber = shard.start; blockNumber < shard.end; ++blockNumber) {
                 if (ShutdownRequested()) { // don't hold up shutdown requests
-                    LOCK(mut);
-                    failed = true;
+                    shard.failed = true;
                     return false;
                 }
 
@@ -889,55 +982,60 @@ public:
                     blockIndex = chain[blockNumber];
                 }
                 if (!blockIndex) {
-                    LOCK(mut);
-                    failed = true;
-                    failReasonRet += strprintf("Failed to read block index for block %d\n", blockNumber);
+                    shard.failed = true;
+                    shard.failReason += strprintf("Failed to read block index for block %d\n", blockNumber);
                     return false;
                 }
 
                 CBlock block;
                 if (!ReadBlockFromDisk(block, blockIndex, consensus)) {
-                    LOCK(mut);
-                    failed = true;
-                    failReasonRet += strprintf("Failed to read block from disk for block %d\n", blockNumber);
+                    shard.failed = true;
+                    shard.failReason += strprintf("Failed to read block from disk for block %d\n", blockNumber);
                     return false;
                 }
                 // Store all vins in order to use as a lookup for spent votes
                 for (const auto & tx : block.vtx) {
-                    LOCK(mut);
                     const auto & txhash = tx->GetHash();
                     for (const auto & vin : tx->vin)
-                        spentPrevouts[vin.prevout] = {txhash, blockIndex->nHeight};
-                    for (int i = 0; i < tx->vout.size(); ++i)
-                        chainVouts.insert(COutPoint{txhash, static_cast<uint32_t>(i)});
+                        shard.prevouts.emplace_back(vin.prevout, std::make_pair(txhash, blockIndex->nHeight));
+                    for (int i = 0; i < static_cast<int>(tx->vout.size()); ++i)
+                        shard.vouts.emplace_back(txhash, static_cast<uint32_t>(i));
                 }
-                // Process block
-                processBlock(&block, blockIndex->nHeight, consensus, false);
+                // Extract block governance data
+                BlockData data;
+                blockData(&block, blockIndex->nHeight, consensus, data);
+                if (!data.isNull())
+                    shard.blocks.push_back(std::move(data));
             }
             return true;
         };
 
         for (int k = 0; k < cores; ++k) {
-            const int start = consensus.governanceBlock + k*slice;
-            const int end = k == cores-1 ? blockHeight+1 // check bounds, +1 due to "<" logic below, ensure inclusion of last block
-                                         : start+slice;
+            auto & shard = shards[k];
+            shard.start = consensus.governanceBlock + k*slice;
+            shard.end = k == cores-1 ? blockHeight+1 // check bounds, +1 due to "<" logic below, ensure inclusion of last block
+                                     : shard.start+slice;
             // try single threaded on failure
             try {
-                // TODO Blocknet governance: concurrency causing state issues
-//                if (cores > 1) {
-//                    tg.create_thread([start,end,consensus,&p1] {
-//                        RenameThread("blocknet-governance");
-//                        p1(start, end, consensus);
-//                    });
-//                    useThreadGroup = true;
-//                } else
-                    p1(start, end, consensus);
+                if (cores > 1) {
+                    tg.create_thread([&shard,consensus,&p1] {
+                        RenameThread("blocknet-governance");
+                        p1(shard, consensus);
+                    });
+                    useThreadGroup = true;
+                } else
+                    p1(shard, consensus);
             } catch (...) {
                 try {
-                    p1(start, end, consensus);
+                    shard = Shard{};
+                    shard.start = consensus.governanceBlock + k*slice;
+                    shard.end = k == cores-1 ? blockHeight+1 : shard.start+slice;
+                    p1(shard, consensus);
                 } catch (std::exception & e) {
                     failed = true;
                     failReasonRet += strprintf("Failed to create thread to load governance data: %s\n", e.what());
+                    if (useThreadGroup)
+                        tg.join_all();
                     return false; // fatal error
                 }
             }
@@ -947,6 +1045,27 @@ public:
         if (useThreadGroup)
             tg.join_all();
 
+        // Merge the shards in block order
+        for (auto & shard : shards) {
+            if (shard.failed) {
+                failed = true;
+                failReasonRet += shard.failReason;
+                continue;
+            }
+            for (const auto & prevout : shard.prevouts)
+                spentPrevouts[prevout.first] = prevout.second; // later spends overwrite earlier spends
+            chainVouts.insert(shard.vouts.begin(), shard.vouts.end());
+            LOCK(mu);
+            for (const auto & data : shard.blocks) {
+                // Proposals first because votes require an existing proposal
+                for (const auto & proposal : data.proposals)
+                    addProposal(proposal);
+                for (const auto & vote : data.votes)
+                    addVote(vote);
+            }
+            shard = Shard{}; // release memory
+        }
+
         {
             LOCK(mu);
             if (votes.empty() || failed)
@@ -976,27 +1095,9 @@ public:
 
                 const auto & vote = tmpvotes[i].second;
 
-                // Remove votes that are not associated with a proposal
-                if (!hasProposal(vote.getProposal(), vote.getBlockNumber())) {
-                    LOCK(mu);
-                    removeVote(vote, true);
+                // Remove votes without proposals or inside the cutoff, spend votes with spent utxos
+                if (checkLoadedVote(vote, spentPrevouts, consensus))
                     continue;
-                }
-
-                // Remove votes that are inside the cutoff
-                const auto & proposal = getProposal(vote.getProposal());
-                if (!outsideVotingCutoff(proposal, vote.getBlockNumber(), consensus)) {
-                    LOCK(mu);
-                    removeVote(vote, true);
-                    continue;
-                }
-
-                // Mark vote as spent if its utxo is spent before or on the associated proposal's superblock.
-                if (spentPrevouts.count(vote.getUtxo()) && spentPrevouts[vote.getUtxo()].second <= proposal.getSuperblock()) {
-                    LOCK(mu);
-                    spendVote(vote.getHash(), spentPrevouts[vote.getUtxo()].second, spentPrevouts[vote.getUtxo()].first);
-                    continue;
-                }
 
                 // Prevent voting on utxos in the future, all votes must reference utxos already confirmed on-chain.
                 // a) Find the block height where vote utxo was included on chain.
@@ -1079,6 +1180,79 @@ public:
         return !failed;
     }
 
+    /**
+     * Loads the governance data from the records stored in the governance index. Unlike
+     * loadGovernanceData(chain) no blocks are read from disk, the proposals and votes
+     * were already parsed and validated against their utxos when the index was written.
+     * @param blocks Governance data in ascending block order
+     * @param spentPrevouts Spent vote utxos, pair<txhash, blockheight> of the spending tx
+     * @param consensus
+     * @param failReasonRet
+     * @return
+     */
+    bool loadGovernanceData(const std::vector<BlockData> & blocks,
+                            const std::unordered_map<COutPoint, std::pair<uint256, int>, Hasher> & spentPrevouts,
+                            const Consensus::Params & consensus, std::string & failReasonRet)
+    {
+        {
+            LOCK(mu);
+            for (const auto & data : blocks) {
+                // Proposals first because votes require an existing proposal
+                for (const auto & proposal : data.proposals)
+                    addProposal(proposal);
+                for (const auto & vote : data.votes)
+                    addVote(vote);
+            }
+            if (votes.empty())
+                return true;
+        }
+
+        std::vector<Vote> tmpvotes;
+        {
+            LOCK(mu);
+            tmpvotes.reserve(votes.size());
+            for (const auto & item : votes)
+                tmpvotes.push_back(item.second);
+        }
+
+        for (const auto & vote : tmpvotes) {
+            if (ShutdownRequested()) { // don't hold up shutdown requests
+                failReasonRet += "Shutdown requested while loading governance votes\n";
+                return false;
+            }
+            checkLoadedVote(vote, spentPrevouts, consensus);
+        }
+
+        return true;
+    }
+
+    /**
+     * Parses the governance data in the specified block and applies the context free
+     * validation rules (proposal cutoff, vote utxo and vin hash checks). This is the
+     * data persisted by the governance index.
+     * @param block
+     * @param blockHeight
+     * @param params
+     * @param dataRet
+     */
+    void blockData(const CBlock *block, const int & blockHeight, const Consensus::Params & params, BlockData & dataRet) {
+        std::set<Proposal> ps;
+        std::set<Vote> vs;
+        std::map<uint256,std::set<VinHash>> vh;
+        dataFromBlock(block, ps, vs, vh, params, blockHeight);
+        filterDataFromBlock(ps, vs, vh, params, blockHeight, false);
+
+        dataRet = BlockData{block->GetHash(), blockHeight};
+        dataRet.proposals.assign(ps.begin(), ps.end());
+        dataRet.votes.assign(vs.begin(), vs.end());
+        for (const auto & vote : dataRet.votes) {
+            const auto & voteHash = vote.getHash();
+            auto it = vh.find(voteHash);
+            if (it != vh.end())
+                dataRet.vinHashes[voteHash] = it->second;
+        }
+    }
+
     /**
      * Fetch the specified proposal.
      * @param hash Proposal hash
@@ -1190,14 +1364,61 @@ public:
         if (!proposals.count(proposalHash))
             return vos;
 
-        const auto & proposal = proposals[proposalHash];
-        if (!sbvotes.count(proposal.getSuperblock()))
+        auto it = proposalVotes.find(proposalHash);
+        if (it == proposalVotes.end())
             return vos;
 
-        auto & vs = sbvotes[proposal.getSuperblock()];
-        for (auto & item : vs) {
-            if (item.second.getProposal() == proposalHash && (returnSpent || !item.second.spent()))
-                vos.push_back(item.second);
+        vos.reserve(it->second.size());
+        for (const auto & voteHash : it->second) {
+            const auto & vote = votes[voteHash];
+            if (returnSpent || !vote.spent())
+                vos.push_back(vote);
+        }
+        return vos;
+    }
+
+    /**
+     * Fetch all votes casted by the specified voter (public key id of the vote utxos) that
+     * haven't been spent. Optionally return spent votes.
+     * @param voter Public key id of the vote utxo
+     * @param returnSpent Includes spent votes, defaults to false
+     * @return
+     */
+    std::vector<Vote> getVotes(const CKeyID & voter, const bool & returnSpent = false) {
+        LOCK(mu);
+        std::vector<Vote> vos;
+        auto it = voterVotes.find(voter);
+        if (it == voterVotes.end())
+            return vos;
+
+        vos.reserve(it->second.size());
+        for (const auto & voteHash : it->second) {
+            const auto & vote = votes[voteHash];
+            if (returnSpent || !vote.spent())
+                vos.push_back(vote);
+        }
+        return vos;
+    }
+
+    /**
+     * Fetch all votes associated with the specified utxo that haven't been spent. Optionally
+     * return spent votes.
+     * @param utxo Vote utxo
+     * @param returnSpent Includes spent votes, defaults to false
+     * @return
+     */
+    std::vector<Vote> getVotes(const COutPoint & utxo, const bool & returnSpent = false) {
+        LOCK(mu);
+        std::vector<Vote> vos;
+        auto it = utxoVotes.find(utxo);
+        if (it == utxoVotes.end())
+            return vos;
+
+        vos.reserve(it->second.size());
+        for (const auto & voteHash : it->second) {
+            const auto & vote = votes[voteHash];
+            if (returnSpent || !vote.spent())
+                vos.push_back(vote);
         }
         return vos;
     }
@@ -1242,7 +1463,9 @@ public:
             return; // do not spend a vote on a block that's after the vote's superblock
 
         // Update current vote
+        tallyVote(voteHash, false);
         vote.spend(block, txhash);
+        tallyVote(voteHash, true);
         // Update sbvotes data provider
         if (sbvotes.count(proposals[vote.getProposal()].getSuperblock())) {
             auto & mv = sbvotes[proposals[vote.getProposal()].getSuperblock()];
@@ -1274,7 +1497,9 @@ public:
             return; // do not unspend votes who's superblocks are after the specified block
 
         // Update current vote
+        tallyVote(voteHash, false);
         vote.unspend(block, txhash);
+        tallyVote(voteHash, true);
         // Update sbvotes data provider
         if (sbvotes.count(proposals[vote.getProposal()].getSuperblock())) {
             auto & mv = sbvotes[proposals[vote.getProposal()].getSuperblock()];
@@ -1453,22 +1678,18 @@ public:
         if (!isSuperblock(superblock, params))
             return r;
 
-        std::set<COutPoint> unique;
-        std::vector<Proposal> ps;
-        std::vector<Vote> vs;
-        getProposalsForSuperblock(superblock, ps, vs);
-
-        CAmount uniqueAmount{0};
-        for (const auto & vote : vs) { // count all the unique voting utxos
-            if (unique.count(vote.getUtxo()))
-                continue;
-            unique.insert(vote.getUtxo());
-            uniqueAmount += vote.getAmount();
+        int uniqueVotes{0};
+        {
+            LOCK(mu);
+            // Amount of all the unique voting utxos is tracked as votes change
+            auto it = sbtallies.find(superblock);
+            if (it != sbtallies.end())
+                uniqueVotes = static_cast<int>(it->second.uniqueAmount / params.voteBalance);
+            for (const auto & item : proposals) { // get results for each proposal
+                if (item.second.getSuperblock() == superblock)
+                    r[item.second] = proposalTally(item.first, params);
+            }
         }
-        const auto uniqueVotes = static_cast<int>(uniqueAmount / params.voteBalance);
-
-        for (const auto & proposal : ps) // get results for each proposal
-            r[proposal] = getTally(proposal.getHash(), vs, params);
 
         // a) Exclude proposals that don't have the required yes votes.
         //    60% of votes must be "yes" on a passing proposal.
@@ -1495,6 +1716,19 @@ public:
         return r;
     }
 
+    /**
+     * Returns the tally of all unspent votes on the specified proposal. Equivalent to
+     * getTally(proposal, getVotes(proposal), params) without recounting votes that
+     * haven't changed since the last call.
+     * @param proposal
+     * @param params
+     * @return
+     */
+    Tally getTally(const uint256 & proposal, const Consensus::Params & params) {
+        LOCK(mu);
+        return proposalTally(proposal, params);
+    }
+
     /**
      * Fetch the list of proposals scheduled for the specified superblock. Requires loadGovernanceData to have been run
      * on chain load.
@@ -1589,16 +1823,10 @@ public:
             return false; // if tip isn't in the non-voting period then return
 
         // Check if the utxo is in a valid proposal who's voting period has ended
-        std::vector<Proposal> sproposals;
-        std::vector<Vote> svotes;
-        getProposalsForSuperblock(superblock, sproposals, svotes);
-
-        for (const auto & vote : svotes) {
-            if (utxo == vote.getUtxo())
-                return true;
-        }
-
-        return false;
+        LOCK(mu);
+        return utxoInVote(utxo, [superblock](const Proposal & proposal) -> bool {
+            return proposal.getSuperblock() == superblock;
+        });
     }
 
     /**
@@ -1609,15 +1837,10 @@ public:
      * @return
      */
     bool utxoInVote(const COutPoint & utxo, const int & blockHeight, const Consensus::Params & params) {
-        const auto sproposals = getProposalsSince(blockHeight);
-        for (const auto & proposal : sproposals) {
-            const auto svotes = getVotes(proposal.getHash());
-            for (const auto & vote : svotes) {
-                if (utxo == vote.getUtxo())
-                    return true;
-            }
-        }
-        return false;
+        LOCK(mu);
+        return utxoInVote(utxo, [blockHeight](const Proposal & proposal) -> bool {
+            return proposal.getSuperblock() >= blockHeight;
+        });
     }
 
     /**
@@ -1630,13 +1853,12 @@ public:
      */
     void utxosInVotes(const std::set<COutPoint> & utxos, const int & blockHeight, std::set<COutPoint> & utxosRet, const Consensus::Params & params) {
         utxosRet.clear();
-        const auto sproposals = getProposalsSince(blockHeight);
-        for (const auto & proposal : sproposals) {
-            const auto svotes = getVotes(proposal.getHash());
-            for (const auto & vote : svotes) {
-                if (utxos.count(vote.getUtxo()))
-                    utxosRet.insert(vote.getUtxo());
-            }
+        LOCK(mu);
+        for (const auto & utxo : utxos) {
+            if (utxoInVote(utxo, [blockHeight](const Proposal & proposal) -> bool {
+                return proposal.getSuperblock() >= blockHeight;
+            }))
+                utxosRet.insert(utxo);
         }
     }
 
@@ -2020,24 +2242,13 @@ protected:
                 prevouts[vin.prevout] = tx->GetHash();
         }
 
-        // Get a list of all proposals with a superblock that is on or
-        // after the current block index.
-        auto sprops = getProposalsSince(blockHeight);
-        // Obtain all votes for these proposals
-        std::vector<Vote> svotes;
-        for (const auto & p : sprops) {
-            auto s = getVotes(p.getHash(), true);
-            svotes.insert(svotes.end(), s.begin(), s.end());
-        }
-        // Unspend votes that match spent vins
-        if (!svotes.empty()) {
-            LOCK(mu);
-            for (auto & v : svotes) {
-                if (!prevouts.count(v.getUtxo()))
-                    continue;
-                // Unspend this vote if it was spent in this block
-                unspendVote(v.getHash(), blockHeight, prevouts[v.getUtxo()]);
-            }
+        // Unspend votes that match spent vins, only votes for proposals
+        // with a superblock that is on or after the current block index.
+        LOCK(mu);
+        for (const auto & voteHash : votesForUtxos(prevouts, blockHeight, true)) {
+            const auto & utxo = votes[voteHash].getUtxo();
+            // Unspend this vote if it was spent in this block
+            unspendVote(voteHash, blockHeight, prevouts[utxo]);
         }
     }
 
@@ -2081,25 +2292,14 @@ protected:
             for (const auto & vin : tx->vin)
                 prevouts[vin.prevout] = tx->GetHash();
         }
-        // Get a list of all proposals with a superblock that is on or
-        // after the current block index.
-        auto sprops = getProposalsSince(blockHeight);
-        // Obtain all votes for these proposals
-        std::vector<Vote> svotes;
-        for (const auto & p : sprops) {
-            auto s = getVotes(p.getHash(), false);
-            svotes.insert(svotes.end(), s.begin(), s.end());
-        }
-        // Spend votes that match spent vins
-        if (!svotes.empty()) {
-            LOCK(mu);
-            for (auto & v : svotes) {
-                if (!prevouts.count(v.getUtxo()))
-                    continue;
-                // Only mark the vote as spent if it happens before or on its
-                // proposal's superblock.
-                spendVote(v.getHash(), blockHeight, prevouts[v.getUtxo()]);
-            }
+        // Spend votes that match spent vins, only unspent votes for proposals
+        // with a superblock that is on or after the current block index.
+        LOCK(mu);
+        for (const auto & voteHash : votesForUtxos(prevouts, blockHeight, false)) {
+            const auto & utxo = votes[voteHash].getUtxo();
+            // Only mark the vote as spent if it happens before or on its
+            // proposal's superblock.
+            spendVote(voteHash, blockHeight, prevouts[utxo]);
         }
     }
 
@@ -2112,8 +2312,15 @@ protected:
             return;
 
         const auto & voteHash = vote.getHash();
+        tallyVote(voteHash, false); // remove the contribution of a prior vote (vote change)
         stackvotes[voteHash].push_back(vote);
         votes[voteHash] = vote; // add to votes data provider
+        tallyVote(voteHash, true);
+        // Add to the lookup indexes. The vote hash is derived from the proposal
+        // and utxo, therefore vote changes do not alter the indexes.
+        proposalVotes[vote.getProposal()].insert(voteHash);
+        utxoVotes[vote.getUtxo()].insert(voteHash);
+        voterVotes[vote.getKeyID()].insert(voteHash);
 
         const auto & proposal = proposals[vote.getProposal()];
         auto & vs = sbvotes[proposal.getSuperblock()];
@@ -2132,17 +2339,19 @@ protected:
 
         // Remove from votes data provider. If force is set, remove all vote history
         // under all circumstances. Useful for initial blockchain load.
+        tallyVote(voteHash, false);
         if (!force) {
             stackvotes[voteHash].pop_back();
             if (stackvotes[voteHash].empty()) {
                 stackvotes.erase(voteHash);
-                votes.erase(voteHash);
+                eraseVote(voteHash);
             } else
                 votes[voteHash] = stackvotes[voteHash].back();
         } else {
             stackvotes.erase(voteHash);
-            votes.erase(voteHash);
+            eraseVote(voteHash);
         }
+        tallyVote(voteHash, true); // count the prior vote if one exists
 
         if (!proposals.count(vote.getProposal()))
             return;
@@ -2161,13 +2370,219 @@ protected:
             vs[voteHash] = stackvotes[voteHash].back();
     }
 
+    /**
+     * Checks a vote loaded from chain data against the loaded proposals. Votes that are
+     * not associated with a proposal in a prior block and votes inside the voting cutoff
+     * are removed. Votes are marked spent if their utxo was spent before or on the
+     * associated proposal's superblock. Returns true if the vote was removed or spent.
+     * Make sure mutex (mu) is not held.
+     * @param vote
+     * @param spentPrevouts
+     * @param consensus
+     * @return
+     */
+    bool checkLoadedVote(const Vote & vote, const std::unordered_map<COutPoint, std::pair<uint256, int>, Hasher> & spentPrevouts,
+                         const Consensus::Params & consensus)
+    {
+        // Remove votes that are not associated with a proposal
+        if (!hasProposal(vote.getProposal(), vote.getBlockNumber())) {
+            LOCK(mu);
+            removeVote(vote, true);
+            return true;
+        }
+
+        // Remove votes that are inside the cutoff
+        const auto & proposal = getProposal(vote.getProposal());
+        if (!outsideVotingCutoff(proposal, vote.getBlockNumber(), consensus)) {
+            LOCK(mu);
+            removeVote(vote, true);
+            return true;
+        }
+
+        // Mark vote as spent if its utxo is spent before or on the associated proposal's superblock.
+        auto it = spentPrevouts.find(vote.getUtxo());
+        if (it != spentPrevouts.end() && it->second.second <= proposal.getSuperblock()) {
+            LOCK(mu);
+            spendVote(vote.getHash(), it->second.second, it->second.first);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Erases the vote from the votes data provider and the lookup indexes.
+     * @param voteHash
+     */
+    void eraseVote(const uint256 & voteHash) EXCLUSIVE_LOCKS_REQUIRED(mu) {
+        auto it = votes.find(voteHash);
+        if (it == votes.end())
+            return;
+        const auto & vote = it->second;
+        eraseFromIndex(proposalVotes, vote.getProposal(), voteHash);
+        eraseFromIndex(utxoVotes, vote.getUtxo(), voteHash);
+        eraseFromIndex(voterVotes, vote.getKeyID(), voteHash);
+        votes.erase(it);
+    }
+
+    /**
+     * Removes the vote hash from the lookup index entry, the entry is erased if empty.
+     * @param index
+     * @param key
+     * @param voteHash
+     */
+    template <typename Index, typename Key>
+    static void eraseFromIndex(Index & index, const Key & key, const uint256 & voteHash) {
+        auto it = index.find(key);
+        if (it == index.end())
+            return;
+        it->second.erase(voteHash);
+        if (it->second.empty())
+            index.erase(it);
+    }
+
+    /**
+     * Returns true if the utxo is associated with an unspent vote on a proposal
+     * matching the specified predicate.
+     * @param utxo
+     * @param pred
+     * @return
+     */
+    template <typename Pred>
+    bool utxoInVote(const COutPoint & utxo, Pred pred) EXCLUSIVE_LOCKS_REQUIRED(mu) {
+        auto it = utxoVotes.find(utxo);
+        if (it == utxoVotes.end())
+            return false;
+        for (const auto & voteHash : it->second) {
+            const auto & vote = votes[voteHash];
+            if (vote.spent())
+                continue;
+            auto pit = proposals.find(vote.getProposal());
+            if (pit != proposals.end() && pred(pit->second))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Returns the hashes of votes associated with the specified utxos on proposals
+     * with a superblock on or after the specified block.
+     * @param utxos
+     * @param blockHeight
+     * @param includeSpent
+     * @return
+     */
+    std::vector<uint256> votesForUtxos(const std::map<COutPoint, uint256> & utxos, const int & blockHeight,
+                                       const bool & includeSpent) EXCLUSIVE_LOCKS_REQUIRED(mu)
+    {
+        std::vector<uint256> r;
+        for (const auto & item : utxos) {
+            auto it = utxoVotes.find(item.first);
+            if (it == utxoVotes.end())
+                continue;
+            for (const auto & voteHash : it->second) {
+                const auto & vote = votes[voteHash];
+                if (!includeSpent && vote.spent())
+                    continue;
+                auto pit = proposals.find(vote.getProposal());
+                if (pit != proposals.end() && pit->second.getSuperblock() >= blockHeight)
+                    r.push_back(voteHash);
+            }
+        }
+        return r;
+    }
+
+    /**
+     * Adds or removes the contribution of the specified vote to the running tallies
+     * of its proposal and superblock. Must be called with add=false prior to changing
+     * a vote and with add=true afterwards. Only unspent votes on known proposals are
+     * counted.
+     * @param voteHash
+     * @param add
+     */
+    void tallyVote(const uint256 & voteHash, const bool & add) EXCLUSIVE_LOCKS_REQUIRED(mu) {
+        auto it = votes.find(voteHash);
+        if (it == votes.end())
+            return;
+        const auto & vote = it->second;
+        tallies.erase(vote.getProposal()); // proposal tally must be recounted
+        if (vote.spent())
+            return;
+        auto pit = proposals.find(vote.getProposal());
+        if (pit == proposals.end())
+            return;
+
+        auto & sbtally = sbtallies[pit->second.getSuperblock()];
+        if (add) {
+            auto & utxo = sbtally.utxos[vote.getUtxo()];
+            if (utxo.first++ == 0) {
+                utxo.second = vote.getAmount();
+                sbtally.uniqueAmount += utxo.second;
+            }
+        } else {
+            auto uit = sbtally.utxos.find(vote.getUtxo());
+            if (uit == sbtally.utxos.end())
+                return;
+            if (--uit->second.first <= 0) {
+                sbtally.uniqueAmount -= uit->second.second;
+                sbtally.utxos.erase(uit);
+            }
+        }
+    }
+
+    /**
+     * Adds or removes the contribution of all votes on the specified proposal to the
+     * running tallies.
+     * @param proposal
+     * @param add
+     */
+    void tallyProposal(const uint256 & proposal, const bool & add) EXCLUSIVE_LOCKS_REQUIRED(mu) {
+        tallies.erase(proposal);
+        auto it = proposalVotes.find(proposal);
+        if (it == proposalVotes.end())
+            return;
+        for (const auto & voteHash : it->second)
+            tallyVote(voteHash, add);
+    }
+
+    /**
+     * Returns the tally of all unspent votes on the proposal. Tallies are cached until
+     * a vote on the proposal changes.
+     * @param proposal
+     * @param params
+     * @return
+     */
+    Tally proposalTally(const uint256 & proposal, const Consensus::Params & params) EXCLUSIVE_LOCKS_REQUIRED(mu) {
+        auto it = tallies.find(proposal);
+        if (it != tallies.end() && it->second.first == params.voteBalance)
+            return it->second.second;
+
+        std::vector<Vote> vs;
+        auto pit = proposalVotes.find(proposal);
+        if (pit != proposalVotes.end()) {
+            vs.reserve(pit->second.size());
+            for (const auto & voteHash : pit->second) {
+                const auto & vote = votes[voteHash];
+                if (!vote.spent())
+                    vs.push_back(vote);
+            }
+        }
+        const auto tally = getTally(proposal, vs, params);
+        tallies[proposal] = std::make_pair(params.voteBalance, tally);
+        return tally;
+    }
+
     void addProposal(const Proposal & proposal) EXCLUSIVE_LOCKS_REQUIRED(mu) {
         if (proposals.count(proposal.getHash()))
             return; // do not overwrite existing proposals
         proposals[proposal.getHash()] = proposal;
+        tallyProposal(proposal.getHash(), true);
     }
 
     void removeProposal(const Proposal & proposal) EXCLUSIVE_LOCKS_REQUIRED(mu) {
+        if (!proposals.count(proposal.getHash()))
+            return;
+        tallyProposal(proposal.getHash(), false);
         proposals.erase(proposal.getHash());
     }
 
@@ -2177,6 +2592,20 @@ protected:
     std::unordered_map<uint256, Vote, Hasher> votes GUARDED_BY(mu);
     std::unordered_map<uint256, std::vector<Vote>, Hasher> stackvotes GUARDED_BY(mu);
     std::unordered_map<int, std::unordered_map<uint256, Vote, Hasher>> sbvotes GUARDED_BY(mu);
+    std::unordered_map<uint256, std::unordered_set<uint256, Hasher>, Hasher> proposalVotes GUARDED_BY(mu); // proposal hash -> vote hashes
+    std::unordered_map<COutPoint, std::unordered_set<uint256, Hasher>, Hasher> utxoVotes GUARDED_BY(mu); // vote utxo -> vote hashes
+    std::unordered_map<CKeyID, std::unordered_set<uint256, Hasher>, Hasher> voterVotes GUARDED_BY(mu); // vote utxo keyid -> vote hashes
+
+    /**
+     * Running superblock tally, tracks the unique utxos of all unspent votes on the
+     * superblock's proposals.
+     */
+    struct SuperblockTally {
+        std::unordered_map<COutPoint, std::pair<int, CAmount>, Hasher> utxos; // utxo -> (vote count, amount)
+        CAmount uniqueAmount{0};
+    };
+    std::unordered_map<uint256, std::pair<CAmount, Tally>, Hasher> tallies GUARDED_BY(mu); // proposal -> (vote balance, tally)
+    std::unordered_map<int, SuperblockTally> sbtallies GUARDED_BY(mu);
 };
 
 }
@@ -0,0 +1,365 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/governanceindex.h>
+#include <compat/endian.h>
+#include <shutdown.h>
+#include <util/system.h>
+#include <validation.h>
+
+#include <set>
+
+constexpr char DB_BEST_BLOCK = 'B';
+constexpr char DB_GOVBLOCK = 'g';
+constexpr char DB_SPENT = 's';
+constexpr char DB_VOTEUTXO = 'v';
+constexpr char DB_VERSION = 'V';
+
+/// Version of the database records, older databases are rebuilt.
+constexpr int DB_CURRENT_VERSION = 2;
+
+std::unique_ptr<GovernanceIndex> g_governanceindex;
+
+/**
+ * Block height database key, serialized big-endian so that LevelDB iterates
+ * governance records in ascending block order.
+ */
+struct DBHeightKey {
+    int height{0};
+
+    DBHeightKey() = default;
+    explicit DBHeightKey(int height) : height(height) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const {
+        const uint32_t v = htobe32(static_cast<uint32_t>(height));
+        s.write((char*)&v, sizeof(v));
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s) {
+        uint32_t v;
+        s.read((char*)&v, sizeof(v));
+        height = static_cast<int>(be32toh(v));
+    }
+};
+
+/**
+ * Access to the governance index database (indexes/governance/)
+ *
+ * The database stores the governance data of each block keyed by block height,
+ * the height of the first vote on each vote utxo keyed by outpoint and the
+ * spending transaction of each vote utxo keyed by outpoint. Only utxos that were
+ * voted with before or in the block spending them are stored. Blocks without any
+ * governance data are not stored.
+ */
+class GovernanceIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    /// Read the governance data of the block at the specified height.
+    bool ReadBlockData(int height, gov::BlockData& data) const;
+
+    /// Read the spending transaction of the specified prevout.
+    bool ReadSpend(const COutPoint& outpoint, std::pair<uint256, int>& spend) const;
+
+    /// Read the height of the first block containing a vote on the specified utxo.
+    bool ReadVoteUtxo(const COutPoint& outpoint, int& height) const;
+
+    /// Returns true if a vote on the specified utxo was indexed.
+    bool HasVoteUtxo(const COutPoint& outpoint) const;
+
+    /// Write the governance data, new vote utxos and spent vote utxos of a block to the DB.
+    bool WriteBlock(const gov::BlockData& data, const std::vector<COutPoint>& voteUtxos,
+                    const std::vector<std::pair<COutPoint, std::pair<uint256, int>>>& spends);
+
+    /// Erase the governance data and spent prevouts of a disconnected block.
+    bool EraseBlock(const CBlock& block, int height);
+
+    /// Read all governance data in ascending block order from the specified height.
+    bool ReadBlocks(int from, int to, std::vector<gov::BlockData>& blocks);
+
+    /// Erase all records if they were written by an older version of the index.
+    bool Upgrade();
+
+private:
+    /// Erase all records with the specified key prefix.
+    template <typename K>
+    bool EraseRecords(char prefix);
+};
+
+GovernanceIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(GetDataDir() / "indexes" / "governance", n_cache_size, f_memory, f_wipe)
+{}
+
+bool GovernanceIndex::DB::ReadBlockData(int height, gov::BlockData& data) const
+{
+    return Read(std::make_pair(DB_GOVBLOCK, DBHeightKey(height)), data);
+}
+
+bool GovernanceIndex::DB::ReadSpend(const COutPoint& outpoint, std::pair<uint256, int>& spend) const
+{
+    return Read(std::make_pair(DB_SPENT, outpoint), spend);
+}
+
+bool GovernanceIndex::DB::ReadVoteUtxo(const COutPoint& outpoint, int& height) const
+{
+    return Read(std::make_pair(DB_VOTEUTXO, outpoint), height);
+}
+
+bool GovernanceIndex::DB::HasVoteUtxo(const COutPoint& outpoint) const
+{
+    return Exists(std::make_pair(DB_VOTEUTXO, outpoint));
+}
+
+bool GovernanceIndex::DB::WriteBlock(const gov::BlockData& data, const std::vector<COutPoint>& voteUtxos,
+                                     const std::vector<std::pair<COutPoint, std::pair<uint256, int>>>& spends)
+{
+    CDBBatch batch(*this);
+    // Erase empty blocks in case a stale block at this height was previously indexed
+    if (data.isNull())
+        batch.Erase(std::make_pair(DB_GOVBLOCK, DBHeightKey(data.blockHeight)));
+    else
+        batch.Write(std::make_pair(DB_GOVBLOCK, DBHeightKey(data.blockHeight)), data);
+    for (const auto& utxo : voteUtxos)
+        batch.Write(std::make_pair(DB_VOTEUTXO, utxo), data.blockHeight);
+    for (const auto& spend : spends)
+        batch.Write(std::make_pair(DB_SPENT, spend.first), spend.second);
+    return WriteBatch(batch);
+}
+
+bool GovernanceIndex::DB::EraseBlock(const CBlock& block, int height)
+{
+    CDBBatch batch(*this);
+    gov::BlockData data;
+    if (ReadBlockData(height, data) && data.blockHash == block.GetHash()) {
+        batch.Erase(std::make_pair(DB_GOVBLOCK, DBHeightKey(height)));
+        // Blocks are disconnected from the tip, vote utxos first voted on in this
+        // block have no votes left in the active chain.
+        for (const auto& vote : data.votes) {
+            int voteHeight;
+            if (ReadVoteUtxo(vote.getUtxo(), voteHeight) && voteHeight == height)
+                batch.Erase(std::make_pair(DB_VOTEUTXO, vote.getUtxo()));
+        }
+    }
+    // Only erase spends that were recorded by this block
+    for (const auto& tx : block.vtx) {
+        if (tx->IsCoinBase())
+            continue;
+        for (const auto& vin : tx->vin) {
+            std::pair<uint256, int> spend;
+            if (ReadSpend(vin.prevout, spend) && spend.first == tx->GetHash() && spend.second == height)
+                batch.Erase(std::make_pair(DB_SPENT, vin.prevout));
+        }
+    }
+    return WriteBatch(batch);
+}
+
+bool GovernanceIndex::DB::ReadBlocks(int from, int to, std::vector<gov::BlockData>& blocks)
+{
+    std::unique_ptr<CDBIterator> cursor(NewIterator());
+    for (cursor->Seek(std::make_pair(DB_GOVBLOCK, DBHeightKey(from))); cursor->Valid(); cursor->Next()) {
+        if (ShutdownRequested())
+            return false;
+        std::pair<char, DBHeightKey> key;
+        if (!cursor->GetKey(key) || key.first != DB_GOVBLOCK || key.second.height > to)
+            break;
+        gov::BlockData data;
+        if (!cursor->GetValue(data))
+            return error("%s: cannot parse governance index record at height %d", __func__, key.second.height);
+        blocks.push_back(std::move(data));
+    }
+    return true;
+}
+
+template <typename K>
+bool GovernanceIndex::DB::EraseRecords(char prefix)
+{
+    std::unique_ptr<CDBIterator> cursor(NewIterator());
+    CDBBatch batch(*this);
+    for (cursor->Seek(prefix); cursor->Valid(); cursor->Next()) {
+        std::pair<char, K> key;
+        if (!cursor->GetKey(key) || key.first != prefix)
+            break;
+        batch.Erase(key);
+        if (batch.SizeEstimate() > (1 << 24)) {
+            if (!WriteBatch(batch))
+                return false;
+            batch.Clear();
+        }
+    }
+    return WriteBatch(batch);
+}
+
+bool GovernanceIndex::DB::Upgrade()
+{
+    int version{0};
+    if (Read(DB_VERSION, version) && version == DB_CURRENT_VERSION)
+        return true;
+
+    // Version 1 databases stored every spent prevout and no vote utxos, rebuild
+    if (!EraseRecords<DBHeightKey>(DB_GOVBLOCK) || !EraseRecords<COutPoint>(DB_SPENT)
+        || !EraseRecords<COutPoint>(DB_VOTEUTXO) || !Erase(DB_BEST_BLOCK))
+        return false;
+    return Write(DB_VERSION, DB_CURRENT_VERSION, true);
+}
+
+GovernanceIndex::GovernanceIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+    : m_db(MakeUnique<GovernanceIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+GovernanceIndex::~GovernanceIndex() {}
+
+bool GovernanceIndex::Init()
+{
+    if (!m_db->Upgrade())
+        return error("%s: failed to upgrade %s", __func__, GetName());
+
+    if (!BaseIndex::Init())
+        return false;
+
+    // Blocks prior to the governance start block do not contain governance
+    // data, start syncing from the governance block on new databases.
+    const auto & consensus = Params().GetConsensus();
+    LOCK(cs_main);
+    if (!m_best_block_index.load() && consensus.governanceBlock > 0 && chainActive.Height() >= consensus.governanceBlock) {
+        m_best_block_index = chainActive[consensus.governanceBlock - 1];
+        m_synced = m_best_block_index.load() == chainActive.Tip();
+    }
+    return true;
+}
+
+bool GovernanceIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    const auto & consensus = Params().GetConsensus();
+    if (pindex->nHeight < consensus.governanceBlock)
+        return true;
+
+    gov::BlockData data;
+    gov::Governance::instance().blockData(&block, pindex->nHeight, consensus, data);
+
+    // Record the utxos voted with for the first time
+    std::set<COutPoint> blockVoteUtxos;
+    std::vector<COutPoint> voteUtxos;
+    for (const auto& vote : data.votes) {
+        if (blockVoteUtxos.insert(vote.getUtxo()).second && !m_db->HasVoteUtxo(vote.getUtxo()))
+            voteUtxos.push_back(vote.getUtxo());
+    }
+
+    // Only spends of vote utxos are required to restore the spent state of votes
+    std::vector<std::pair<COutPoint, std::pair<uint256, int>>> spends;
+    for (const auto& tx : block.vtx) {
+        if (tx->IsCoinBase())
+            continue;
+        const auto & txhash = tx->GetHash();
+        for (const auto& vin : tx->vin) {
+            if (blockVoteUtxos.count(vin.prevout) || m_db->HasVoteUtxo(vin.prevout))
+                spends.emplace_back(vin.prevout, std::make_pair(txhash, pindex->nHeight));
+        }
+    }
+
+    return m_db->WriteBlock(data, voteUtxos, spends);
+}
+
+BaseIndex::DB& GovernanceIndex::GetDB() const { return *m_db; }
+
+void GovernanceIndex::BlockDisconnectedSync(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex)
+{
+    if (!m_db->EraseBlock(*block, pindex->nHeight)) {
+        FatalError("%s: Failed to erase block %s from index",
+                   __func__, pindex->GetBlockHash().ToString());
+        return;
+    }
+    if (m_best_block_index.load() == pindex)
+        m_best_block_index = pindex->pprev;
+}
+
+bool GovernanceIndex::FindBlockData(int height, gov::BlockData& data) const
+{
+    return m_db->ReadBlockData(height, data);
+}
+
+bool GovernanceIndex::FindSpend(const COutPoint& outpoint, std::pair<uint256, int>& spend) const
+{
+    return m_db->ReadSpend(outpoint, spend);
+}
+
+bool GovernanceIndex::LoadGovernanceData(gov::Governance& governance, const Consensus::Params& consensus,
+                                         std::string& failReasonRet) const
+{
+    if (!m_synced) {
+        failReasonRet += strprintf("%s is not in sync with the chain\n", GetName());
+        return false;
+    }
+    const CBlockIndex* best_block_index = m_best_block_index.load();
+    if (!best_block_index || best_block_index->nHeight < consensus.governanceBlock)
+        return true; // no governance data yet
+
+    std::vector<gov::BlockData> blocks;
+    if (!m_db->ReadBlocks(consensus.governanceBlock, best_block_index->nHeight, blocks)) {
+        failReasonRet += strprintf("Failed to read governance data from %s\n", GetName());
+        return false;
+    }
+
+    // Records must belong to the active chain
+    {
+        LOCK(cs_main);
+        for (const auto& data : blocks) {
+            const auto pindex = chainActive[data.blockHeight];
+            if (!pindex || pindex->GetBlockHash() != data.blockHash) {
+                failReasonRet += strprintf("%s block %d is not in the active chain\n", GetName(), data.blockHeight);
+                return false;
+            }
+        }
+    }
+
+    // Only the spent state of vote utxos is required
+    std::unordered_map<COutPoint, std::pair<uint256, int>, gov::Hasher> spentPrevouts;
+    std::set<COutPoint> unspent;
+    for (const auto& data : blocks) {
+        for (const auto& vote : data.votes) {
+            std::pair<uint256, int> spend;
+            if (spentPrevouts.count(vote.getUtxo()) || unspent.count(vote.getUtxo()))
+                continue;
+            if (m_db->ReadSpend(vote.getUtxo(), spend) && spend.second <= best_block_index->nHeight)
+                spentPrevouts[vote.getUtxo()] = spend;
+            else
+                unspent.insert(vote.getUtxo());
+        }
+    }
+
+    {
+        LOCK(cs_main);
+        if (chainActive.Tip() != best_block_index) {
+            failReasonRet += strprintf("%s is not in sync with the chain\n", GetName());
+            return false;
+        }
+        // Blocks disconnected while the index was syncing are not erased from the
+        // index, ignore their spends of utxos that are unspent in the active chain.
+        for (auto it = spentPrevouts.begin(); it != spentPrevouts.end(); ) {
+            if (pcoinsTip->HaveCoin(it->first)) {
+                unspent.insert(it->first);
+                it = spentPrevouts.erase(it);
+            } else
+                ++it;
+        }
+        // Spends are only recorded once a utxo was voted with. A vote utxo without
+        // a recorded spend that is missing from the coins view was spent before its
+        // first vote. The spend is attributed to the block before the first vote
+        // instead of the spending transaction, which results in the same state as
+        // loading from the chain: the spend is only compared with the proposal
+        // superblock, which is after the first vote, and a vote is only unspent when
+        // its spending block is disconnected, which removes the vote first.
+        for (const auto& utxo : unspent) {
+            int voteHeight;
+            if (pcoinsTip->HaveCoin(utxo) || !m_db->ReadVoteUtxo(utxo, voteHeight))
+                continue;
+            spentPrevouts[utxo] = std::make_pair(uint256(), std::max(voteHeight - 1, 1));
+        }
+    }
+
+    LogPrintf("Loading governance data from %s (%u blocks with governance data)\n", GetName(), blocks.size());
+    return governance.loadGovernanceData(blocks, spentPrevouts, consensus, failReasonRet);
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BLOCKNET_INDEX_GOVERNANCEINDEX_H
+#define BLOCKNET_INDEX_GOVERNANCEINDEX_H
+
+#include <chain.h>
+#include <governance/governance.h>
+#include <index/base.h>
+
+/**
+ * GovernanceIndex stores the governance data (proposals, votes and vin hashes)
+ * found in each block after the governance start block, as well as the spends
+ * of vote utxos required to determine the spent state of votes. This allows the
+ * governance state to be loaded on startup without reading blocks from disk.
+ * The index is written to a LevelDB database (indexes/governance/).
+ */
+class GovernanceIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+protected:
+    /// Override base class init to skip blocks prior to the governance start block.
+    bool Init() override;
+
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+    const char* GetName() const override { return "governanceindex"; }
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit GovernanceIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~GovernanceIndex() override;
+
+    /// Returns true if the index is in sync with the active chain.
+    bool IsSynced() const {
+        return m_synced;
+    }
+
+    /// Returns the governance index best block index
+    const CBlockIndex* BestBlockIndex() {
+        return m_best_block_index;
+    }
+
+    /// Connect block to the index
+    void BlockConnectedSync(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex,
+                            const std::vector<CTransactionRef>& txn_conflicted) {
+        BlockConnected(block, pindex, txn_conflicted);
+    }
+
+    /// Write block index
+    void ChainStateFlushedSync(const CBlockLocator& locator) {
+        ChainStateFlushed(locator);
+    }
+
+    /// Remove the governance data of a disconnected block from the index.
+    void BlockDisconnectedSync(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex);
+
+    /// Look up the governance data in the specified block.
+    ///
+    /// @param[in]   height  Height of the block.
+    /// @param[out]  data  Governance data in the block.
+    /// @return  true if the block contains governance data, false otherwise
+    bool FindBlockData(int height, gov::BlockData& data) const;
+
+    /// Look up the transaction that spent the specified vote utxo. Spends of
+    /// utxos that were never voted with are not indexed.
+    ///
+    /// @param[in]   outpoint  The spent vote utxo.
+    /// @param[out]  spend  pair<txhash, blockheight> of the spending transaction.
+    /// @return  true if the spend was found, false otherwise
+    bool FindSpend(const COutPoint& outpoint, std::pair<uint256, int>& spend) const;
+
+    /// Loads the governance state from the index. The index must be in sync
+    /// with the active chain.
+    bool LoadGovernanceData(gov::Governance& governance, const Consensus::Params& consensus,
+                            std::string& failReasonRet) const;
+};
+
+/// The global governance index. May be null.
+extern std::unique_ptr<GovernanceIndex> g_governanceindex;
+
+#endif // BLOCKNET_INDEX_GOVERNANCEINDEX_H
@@ -0,0 +1,243 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/xbridgetradeindex.h>
+#include <compat/endian.h>
+#include <shutdown.h>
+#include <util/system.h>
+#include <validation.h>
+#include <xbridge/util/xseries.h>
+#include <xbridge/util/xutil.h>
+#include <xbridge/xbridgetransactiondescr.h>
+
+#include <limits>
+
+constexpr char DB_TRADE = 'x';
+
+std::unique_ptr<XBridgeTradeIndex> g_xbridgetradeindex;
+
+/**
+ * Trade database key. The block time is serialized big-endian so that LevelDB
+ * iterates the trades of a currency pair in ascending time order.
+ */
+struct DBTradeKey {
+    std::string fromCurrency;
+    std::string toCurrency;
+    int64_t time{0};
+    uint256 txhash;
+
+    DBTradeKey() = default;
+    DBTradeKey(const std::string& fromCurrency, const std::string& toCurrency, int64_t time, const uint256& txhash)
+        : fromCurrency(fromCurrency), toCurrency(toCurrency), time(time), txhash(txhash) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const {
+        s << fromCurrency << toCurrency;
+        const uint64_t v = htobe64(static_cast<uint64_t>(time));
+        s.write((char*)&v, sizeof(v));
+        s << txhash;
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s) {
+        s >> fromCurrency >> toCurrency;
+        uint64_t v;
+        s.read((char*)&v, sizeof(v));
+        time = static_cast<int64_t>(be64toh(v));
+        s >> txhash;
+    }
+};
+
+/** Trade details and the block containing the fee transaction */
+struct DBTradeValue {
+    std::string xid;
+    uint64_t fromAmount{0};
+    uint64_t toAmount{0};
+    uint256 blockHash;
+    int height{0};
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(xid);
+        READWRITE(fromAmount);
+        READWRITE(toAmount);
+        READWRITE(blockHash);
+        READWRITE(height);
+    }
+};
+
+/// Returns the trades recorded in the block.
+static std::vector<std::pair<DBTradeKey, DBTradeValue>> BlockTrades(const CBlock& block, const uint256& blockHash, int height)
+{
+    std::vector<std::pair<DBTradeKey, DBTradeValue>> trades;
+    for (const auto& tx : block.vtx) {
+        std::string snode_pubkey;
+        const CurrencyPair p = xbridge::TxOutToCurrencyPair(tx->vout, snode_pubkey);
+        if (p.tag != CurrencyPair::Tag::Valid)
+            continue;
+        DBTradeValue value;
+        value.xid = p.xid();
+        value.fromAmount = p.from.accumulator();
+        value.toAmount = p.to.accumulator();
+        value.blockHash = blockHash;
+        value.height = height;
+        trades.emplace_back(DBTradeKey{p.from.currency().to_string(), p.to.currency().to_string(),
+                                       block.GetBlockTime(), tx->GetHash()}, value);
+    }
+    return trades;
+}
+
+/**
+ * Access to the xbridge trade index database (indexes/xbridgetrades/)
+ *
+ * The database stores the trades of each currency pair keyed by block time and
+ * fee transaction hash. Readers check that the block of each record is in the
+ * active chain, records of stale blocks may remain after an unclean shutdown or
+ * a reorg while the index was syncing.
+ */
+class XBridgeTradeIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    /// Write the trades of a block to the DB.
+    bool WriteTrades(const std::vector<std::pair<DBTradeKey, DBTradeValue>>& trades);
+
+    /// Erase the trades of a disconnected block from the DB.
+    bool EraseTrades(const std::vector<std::pair<DBTradeKey, DBTradeValue>>& trades);
+
+    /// Read the trades of all pairs with a block time in [begin, end).
+    bool ReadTrades(int64_t begin, int64_t end, std::vector<std::pair<DBTradeKey, DBTradeValue>>& trades);
+};
+
+XBridgeTradeIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(GetDataDir() / "indexes" / "xbridgetrades", n_cache_size, f_memory, f_wipe)
+{}
+
+bool XBridgeTradeIndex::DB::WriteTrades(const std::vector<std::pair<DBTradeKey, DBTradeValue>>& trades)
+{
+    CDBBatch batch(*this);
+    for (const auto& trade : trades)
+        batch.Write(std::make_pair(DB_TRADE, trade.first), trade.second);
+    return WriteBatch(batch);
+}
+
+bool XBridgeTradeIndex::DB::EraseTrades(const std::vector<std::pair<DBTradeKey, DBTradeValue>>& trades)
+{
+    CDBBatch batch(*this);
+    for (const auto& trade : trades)
+        batch.Erase(std::make_pair(DB_TRADE, trade.first));
+    return WriteBatch(batch);
+}
+
+bool XBridgeTradeIndex::DB::ReadTrades(int64_t begin, int64_t end,
+                                       std::vector<std::pair<DBTradeKey, DBTradeValue>>& trades)
+{
+    // Records are grouped by pair, skip to the time range of each pair
+    std::unique_ptr<CDBIterator> cursor(NewIterator());
+    for (cursor->Seek(std::make_pair(DB_TRADE, DBTradeKey{})); cursor->Valid(); ) {
+        if (ShutdownRequested())
+            return false;
+        std::pair<char, DBTradeKey> key;
+        if (!cursor->GetKey(key) || key.first != DB_TRADE)
+            break;
+        auto& k = key.second;
+        if (k.time < begin) {
+            cursor->Seek(std::make_pair(DB_TRADE, DBTradeKey{k.fromCurrency, k.toCurrency, begin, uint256()}));
+            continue;
+        }
+        if (k.time >= end) { // next pair
+            cursor->Seek(std::make_pair(DB_TRADE, DBTradeKey{k.fromCurrency, k.toCurrency,
+                                                             std::numeric_limits<int64_t>::max(), uint256()}));
+            continue;
+        }
+        DBTradeValue value;
+        if (!cursor->GetValue(value))
+            return error("%s: cannot parse xbridge trade index record %s", __func__, k.txhash.ToString());
+        trades.emplace_back(std::move(k), std::move(value));
+        cursor->Next();
+    }
+    return true;
+}
+
+XBridgeTradeIndex::XBridgeTradeIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+    : m_db(MakeUnique<XBridgeTradeIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+XBridgeTradeIndex::~XBridgeTradeIndex() {}
+
+bool XBridgeTradeIndex::Init()
+{
+    if (!BaseIndex::Init())
+        return false;
+
+    // Blocks prior to the first XBridge trades do not contain trade data, start
+    // syncing from the earliest order history time on new databases.
+    const auto earliest = (xQuery::earliestTime() - boost::posix_time::from_time_t(0)).total_seconds();
+    LOCK(cs_main);
+    if (!m_best_block_index.load()) {
+        const CBlockIndex* pindex = chainActive.FindEarliestAtLeast(earliest);
+        if (pindex && pindex->pprev) {
+            m_best_block_index = pindex->pprev;
+            m_synced = m_best_block_index.load() == chainActive.Tip();
+        }
+    }
+    return true;
+}
+
+bool XBridgeTradeIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    const auto trades = BlockTrades(block, pindex->GetBlockHash(), pindex->nHeight);
+    if (trades.empty())
+        return true;
+    return m_db->WriteTrades(trades);
+}
+
+BaseIndex::DB& XBridgeTradeIndex::GetDB() const { return *m_db; }
+
+void XBridgeTradeIndex::BlockDisconnectedSync(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex)
+{
+    const auto trades = BlockTrades(*block, pindex->GetBlockHash(), pindex->nHeight);
+    if (!trades.empty() && !m_db->EraseTrades(trades)) {
+        FatalError("%s: Failed to erase block %s from index",
+                   __func__, pindex->GetBlockHash().ToString());
+        return;
+    }
+    if (m_best_block_index.load() == pindex)
+        m_best_block_index = pindex->pprev;
+}
+
+bool XBridgeTradeIndex::FindTrades(int64_t begin, int64_t end, std::vector<CurrencyPair>& trades) const
+{
+    std::vector<std::pair<DBTradeKey, DBTradeValue>> records;
+    if (!m_db->ReadTrades(begin, end, records))
+        return false;
+    if (records.empty())
+        return true;
+
+    // Skip records of blocks that are no longer in the active chain
+    std::vector<bool> active(records.size(), false);
+    {
+        LOCK(cs_main);
+        for (size_t i = 0; i < records.size(); ++i) {
+            const auto pindex = chainActive[records[i].second.height];
+            active[i] = pindex && pindex->GetBlockHash() == records[i].second.blockHash;
+        }
+    }
+
+    trades.reserve(trades.size() + records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (!active[i])
+            continue;
+        const auto& key = records[i].first;
+        const auto& value = records[i].second;
+        trades.emplace_back(value.xid,
+                            ccy::Asset{ccy::Currency{key.fromCurrency, xbridge::TransactionDescr::COIN}, value.fromAmount},
+                            ccy::Asset{ccy::Currency{key.toCurrency, xbridge::TransactionDescr::COIN}, value.toAmount},
+                            boost::posix_time::from_time_t(key.time));
+    }
+    return true;
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BLOCKNET_INDEX_XBRIDGETRADEINDEX_H
+#define BLOCKNET_INDEX_XBRIDGETRADEINDEX_H
+
+#include <chain.h>
+#include <index/base.h>
+#include <xbridge/currencypair.h>
+
+#include <vector>
+
+/** Default for -xbridgetradeindex */
+static const bool DEFAULT_XBRIDGETRADEINDEX = false;
+
+/**
+ * XBridgeTradeIndex stores the XBridge trades recorded on chain by the fee
+ * transactions of completed orders, keyed by currency pair and block time.
+ * This allows the order history to be queried for a time range without
+ * reading blocks from disk or holding cs_main.
+ * The index is written to a LevelDB database (indexes/xbridgetrades/).
+ */
+class XBridgeTradeIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+protected:
+    /// Override base class init to skip blocks prior to the first XBridge trades.
+    bool Init() override;
+
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+    const char* GetName() const override { return "xbridgetradeindex"; }
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit XBridgeTradeIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~XBridgeTradeIndex() override;
+
+    /// Returns true if the index is in sync with the active chain.
+    bool IsSynced() const {
+        return m_synced;
+    }
+
+    /// Connect block to the index
+    void BlockConnectedSync(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex,
+                            const std::vector<CTransactionRef>& txn_conflicted) {
+        BlockConnected(block, pindex, txn_conflicted);
+    }
+
+    /// Write block index
+    void ChainStateFlushedSync(const CBlockLocator& locator) {
+        ChainStateFlushed(locator);
+    }
+
+    /// Remove the trades of a disconnected block from the index.
+    void BlockDisconnectedSync(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex);
+
+    /// Look up the trades of all currency pairs in blocks of the active chain
+    /// with a block time in the specified range.
+    ///
+    /// @param[in]   begin  First block time (inclusive).
+    /// @param[in]   end  Last block time (exclusive).
+    /// @param[out]  trades  Trades, time stamped with the block time.
+    /// @return  true if the trades were read from the index, false otherwise
+    bool FindTrades(int64_t begin, int64_t end, std::vector<CurrencyPair>& trades) const;
+};
+
+/// The global xbridge trade index. May be null.
+extern std::unique_ptr<XBridgeTradeIndex> g_xbridgetradeindex;
+
+#endif // BLOCKNET_INDEX_XBRIDGETRADEINDEX_H
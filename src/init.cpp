@@ -24,7 +24,9 @@
 #include <httpserver.h>
 #include <httprpc.h>
 #include <interfaces/chain.h>
+#include <index/governanceindex.h>
 #include <index/txindex.h>
+#include <index/xbridgetradeindex.h>
 #include <kernel.h>
 #include <key.h>
 #include <validation.h>
@@ -57,6 +59,8 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <xbridge/util/httpclientpool.h>
+#include <xbridge/util/logwriter.h>
 #include <xbridge/xbridgeapp.h>
 #include <xrouter/xrouterapp.h>
 #ifdef ENABLE_WALLET
@@ -200,6 +204,12 @@ void Interrupt()
     if (g_txindex) {
         g_txindex->Interrupt();
     }
+    if (g_governanceindex) {
+        g_governanceindex->Interrupt();
+    }
+    if (g_xbridgetradeindex) {
+        g_xbridgetradeindex->Interrupt();
+    }
 }
 
 void Shutdown(InitInterfaces& interfaces)
@@ -225,6 +235,12 @@ void Shutdown(InitInterfaces& interfaces)
     // Shutdown xrouter
     xrouter::App::instance().stop();
 
+    // Close wallet rpc connections
+    xbridge::HTTPClientPool::instance().clear();
+
+    // Write queued xbridge and xrouter log messages, later messages are written directly
+    xbridge::AsyncLogWriter::stopAll();
+
     StopHTTPRPC();
     StopREST();
     StopRPC();
@@ -239,6 +255,8 @@ void Shutdown(InitInterfaces& interfaces)
     if (peerLogic) UnregisterValidationInterface(peerLogic.get());
     if (g_connman) g_connman->Stop();
     if (g_txindex) g_txindex->Stop();
+    if (g_governanceindex) g_governanceindex->Stop();
+    if (g_xbridgetradeindex) g_xbridgetradeindex->Stop();
 
     StopTorControl();
 
@@ -253,6 +271,8 @@ void Shutdown(InitInterfaces& interfaces)
     g_connman.reset();
     g_banman.reset();
     g_txindex.reset();
+    g_governanceindex.reset();
+    g_xbridgetradeindex.reset();
 
     if (g_is_mempool_loaded && gArgs.GetArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
         DumpMempool();
@@ -402,6 +422,7 @@ void SetupServerArgs()
     gArgs.AddArg("-dbcache=<n>", strprintf("Maximum database cache size <n> MiB (%d to %d, default: %d). In addition, unused mempool memory is shared for this cache (see -maxmempool).", nMinDbCache, nMaxDbCache, nDefaultDbCache), false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-debuglogfile=<file>", strprintf("Specify location of debug log file. Relative paths will be prefixed by a net-specific datadir location. (-nodebuglogfile to disable; default: %s)", DEFAULT_DEBUGLOGFILE), false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-feefilter", strprintf("Tell other nodes to filter invs to us by our mempool min fee (default: %u)", DEFAULT_FEEFILTER), true, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-govloadthreads=<n>", strprintf("Number of threads used to load governance data from the chain when the governance index is unavailable (0 = auto, default: %d)", gov::DEFAULT_GOVLOADTHREADS), false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-includeconf=<file>", "Specify additional configuration file, relative to the -datadir path (only useable from configuration file, not command line)", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-loadblock=<file>", "Imports blocks from external blk000??.dat file on startup", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-maxmempool=<n>", strprintf("Keep the transaction memory pool below <n> megabytes (default: %u)", DEFAULT_MAX_MEMPOOL_SIZE), false, OptionsCategory::OPTIONS);
@@ -416,6 +437,11 @@ void SetupServerArgs()
     gArgs.AddArg("-reindex", "Rebuild chain state and block index from the blk*.dat files on disk", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-reindex-chainstate", "Rebuild chain state from the currently indexed blocks. When in pruning mode or if blocks on disk might be corrupted, use full -reindex instead.", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-staking", "Mine blocks on this node (default: 1). Can be used to specify search interval, staking=number_of_seconds (default: 15)", false, OptionsCategory::OPTIONS);
+#ifdef ENABLE_WALLET
+    gArgs.AddArg("-stakingthreads=<n>", strprintf("Number of threads used to search wallet inputs for stakes (0 = number of cores, default: %d)", DEFAULT_STAKINGTHREADS), false, OptionsCategory::OPTIONS);
+#else
+    gArgs.AddHiddenArgs({"-stakingthreads=<n>"});
+#endif
     gArgs.AddArg("-stakingwithoutpeers", "Proceeds with staking even though no peers were detected. Mainly used for testing, this could put you on a fork. (default: 0)", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-minstakeamount", strprintf("Only stakes UTXOs greater than or equal to this amount (default: %d)", 0), false, OptionsCategory::OPTIONS);
 #ifndef WIN32
@@ -423,6 +449,7 @@ void SetupServerArgs()
 #else
     hidden_args.emplace_back("-sysperms");
 #endif
+    hidden_args.emplace_back("-maxmempoolxbridge=<n>"); // deprecated, replaced by -xbridgeseenpackets
     gArgs.AddArg("-txindex", "Blocknet requires txindex to support the Proof of Stake protocol.", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-lowmemoryload", "Use less memory during initial load. This may result in longer load times, however, may improve loading on memory constrained devices if out of memory errors persist (e.g. Rasp Pi)", false, OptionsCategory::OPTIONS);
 
@@ -569,11 +596,20 @@ void SetupServerArgs()
     gArgs.AddArg("-servicenode", strprintf("Auto register this service node on application start (default: %u)", false), false, OptionsCategory::XBRIDGE);
     gArgs.AddArg("-enableexchange", strprintf("Enable exchange mode on this service node (default: %u)", false), false, OptionsCategory::XBRIDGE);
     gArgs.AddArg("-orderinputscheck", strprintf("Time interval for the utxo validity check on order inputs (default: %d seconds)", 900), false, OptionsCategory::XBRIDGE);
-    gArgs.AddArg("-maxmempoolxbridge", strprintf("Maximum size in MB (megabytes) for the xbridge mempool (default: %dMB)", 128), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-seenpacketsfprate=<n>", strprintf("False positive rate of the servicenode and xbridge seen packet filters (default: %g)", sn::DEFAULT_SEEN_PACKETS_FPRATE), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-servicenodeseenpackets=<n>", strprintf("Number of recent servicenode packets remembered to ignore duplicates (default: %u)", sn::DEFAULT_SEEN_PACKETS), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-xbridgeseenpackets=<n>", strprintf("Number of recent xbridge packets remembered to ignore duplicates (default: %u)", xbridge::DEFAULT_XBRIDGE_SEEN_PACKETS), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-xbridgepacketqueue=<n>", strprintf("Maximum number of xbridge network packets queued per worker thread before network message processing waits (default: %u)", xbridge::DEFAULT_XBRIDGE_PACKET_QUEUE), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-xbridgetradeindex", strprintf("Maintain an index of the XBridge trades recorded on chain, used by dxGetOrderHistory (default: %u)", DEFAULT_XBRIDGETRADEINDEX), false, OptionsCategory::XBRIDGE);
     gArgs.AddArg("-rpcxbridgetimeout", strprintf("Timeout for internal XBridge RPC calls (default: %d seconds)", 120), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-rpcpoolconnections=<n>", strprintf("Maximum number of connections to each XBridge and XRouter wallet RPC server (default: %u)", xbridge::DEFAULT_RPC_POOL_CONNECTIONS), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-rpcpoolidletimeout=<n>", strprintf("Seconds unused connections to XBridge and XRouter wallet RPC servers are kept open, 0 disables keep-alive (default: %d)", xbridge::DEFAULT_RPC_POOL_IDLE_TIMEOUT), false, OptionsCategory::XBRIDGE);
+    gArgs.AddArg("-xbridgeloglevel=<level>", strprintf("Minimum level of the messages written to the XBridge and XRouter log files: trace, info, warning or error (default: %s)", xbridge::DEFAULT_LOG_LEVEL), false, OptionsCategory::XBRIDGE);
 
     // XRouter
     gArgs.AddArg("-xrouter", strprintf("Enable XRouter services (default: %u)", true), false, OptionsCategory::XROUTER);
+    gArgs.AddArg("-xrouterthreads=<n>", strprintf("Number of threads processing XRouter requests (0 = number of cores, default: %d)", xrouter::DEFAULT_XROUTER_THREADS), false, OptionsCategory::XROUTER);
+    gArgs.AddArg("-xrouterqueuesize=<n>", strprintf("Maximum number of XRouter requests waiting to be processed, lower priority requests are rejected when full (default: %u)", xrouter::DEFAULT_XROUTER_REQUEST_QUEUE), false, OptionsCategory::XROUTER);
     gArgs.AddArg("-xrouterbanscore", strprintf("Ban XRouter nodes who's score is lower than this value (default: %u)", -200), false, OptionsCategory::XROUTER);
     gArgs.AddArg("-rpcxroutertimeout", strprintf("Timeout for internal XRouter RPC calls (default: %d seconds)", 60), false, OptionsCategory::XROUTER);
 
@@ -758,6 +794,13 @@ static void ThreadImport(std::vector<fs::path> vImportFiles)
     // Blocknet PoS sync txindex
     g_txindex->Sync();
 
+    // Governance index syncs in the background (requires txindex)
+    g_governanceindex->Start();
+
+    // XBridge trade index syncs in the background
+    if (g_xbridgetradeindex)
+        g_xbridgetradeindex->Start();
+
     // scan for better chains in the block chain database, that are not yet connected in the active best chain
     CValidationState state;
     if (!ActivateBestChain(state, chainparams)) {
@@ -1099,6 +1142,35 @@ bool AppInitParameterInteraction()
     int64_t nMempoolSizeMin = gArgs.GetArg("-limitdescendantsize", DEFAULT_DESCENDANT_SIZE_LIMIT) * 1000 * 40;
     if (nMempoolSizeMax < 0 || nMempoolSizeMax < nMempoolSizeMin)
         return InitError(strprintf(_("-maxmempool must be at least %d MB"), std::ceil(nMempoolSizeMin / 1000000.0)));
+
+    // servicenode and xbridge duplicate packet filters
+    double seenPacketsFpRate{sn::DEFAULT_SEEN_PACKETS_FPRATE};
+    if (gArgs.IsArgSet("-seenpacketsfprate")) {
+        if (!ParseDouble(gArgs.GetArg("-seenpacketsfprate", ""), &seenPacketsFpRate) || seenPacketsFpRate <= 0 || seenPacketsFpRate >= 1)
+            return InitError(strprintf("Invalid -seenpacketsfprate=%s, must be greater than 0 and less than 1", gArgs.GetArg("-seenpacketsfprate", "")));
+    }
+    if (gArgs.GetArg("-servicenodeseenpackets", sn::DEFAULT_SEEN_PACKETS) < 1 || gArgs.GetArg("-xbridgeseenpackets", xbridge::DEFAULT_XBRIDGE_SEEN_PACKETS) < 1)
+        return InitError("-servicenodeseenpackets and -xbridgeseenpackets must be at least 1");
+    if (gArgs.IsArgSet("-maxmempoolxbridge"))
+        InitWarning("-maxmempoolxbridge is deprecated and ignored, use -xbridgeseenpackets");
+    if (gArgs.IsArgSet("-servicenodeseenpackets") || gArgs.IsArgSet("-seenpacketsfprate"))
+        sn::ServiceNodeMgr::instance().setSeenPacketsFilter(
+                static_cast<unsigned int>(gArgs.GetArg("-servicenodeseenpackets", sn::DEFAULT_SEEN_PACKETS)), seenPacketsFpRate);
+
+    // xbridge and xrouter wallet rpc connection pool
+    if (gArgs.GetArg("-rpcpoolconnections", xbridge::DEFAULT_RPC_POOL_CONNECTIONS) < 1)
+        return InitError("-rpcpoolconnections must be at least 1");
+    if (gArgs.GetArg("-rpcpoolidletimeout", xbridge::DEFAULT_RPC_POOL_IDLE_TIMEOUT) < 0)
+        return InitError("-rpcpoolidletimeout must not be negative");
+    xbridge::HTTPClientPool::instance().setLimits(
+            static_cast<unsigned int>(gArgs.GetArg("-rpcpoolconnections", xbridge::DEFAULT_RPC_POOL_CONNECTIONS)),
+            gArgs.GetArg("-rpcpoolidletimeout", xbridge::DEFAULT_RPC_POOL_IDLE_TIMEOUT));
+
+    // xbridge and xrouter log files
+    if (!xbridge::setLogLevel(gArgs.GetArg("-xbridgeloglevel", xbridge::DEFAULT_LOG_LEVEL)))
+        return InitError(strprintf("Unknown -xbridgeloglevel value: %s", gArgs.GetArg("-xbridgeloglevel", "")));
+    xbridge::setLogDebug(gArgs.GetBoolArg("-debug", false));
+
     // incremental relay fee sets the minimum feerate increase necessary for BIP 125 replacement in the mempool
     // and the amount the mempool min fee increases above the feerate of txs evicted due to mempool limiting.
     if (gArgs.IsArgSet("-incrementalrelayfee"))
@@ -1521,6 +1593,10 @@ bool AppInitMain(InitInterfaces& interfaces)
     nTotalCache -= nBlockTreeDBCache;
     int64_t nTxIndexCache = std::min(nTotalCache / 2, nMaxTxIndexCache << 20); // Blocknet PoS requires txindex
     nTotalCache -= nTxIndexCache;
+    int64_t nGovIndexCache = std::min(nTotalCache / 8, nMaxGovIndexCache << 20);
+    nTotalCache -= nGovIndexCache;
+    int64_t nTradeIndexCache = gArgs.GetBoolArg("-xbridgetradeindex", DEFAULT_XBRIDGETRADEINDEX) ? std::min(nTotalCache / 8, nMaxTradeIndexCache << 20) : 0;
+    nTotalCache -= nTradeIndexCache;
     int64_t nCoinDBCache = std::min(nTotalCache / 2, (nTotalCache / 4) + (1 << 23)); // use 25%-50% of the remainder for disk cache
     nCoinDBCache = std::min(nCoinDBCache, nMaxCoinsDBCache << 20); // cap total coins db cache
     nTotalCache -= nCoinDBCache;
@@ -1530,11 +1606,17 @@ bool AppInitMain(InitInterfaces& interfaces)
     LogPrintf("* Using %.1f MiB for block index database\n", nBlockTreeDBCache * (1.0 / 1024 / 1024));
     // Blocknet PoS requires txindex
         LogPrintf("* Using %.1f MiB for transaction index database\n", nTxIndexCache * (1.0 / 1024 / 1024));
+    LogPrintf("* Using %.1f MiB for governance index database\n", nGovIndexCache * (1.0 / 1024 / 1024));
+    if (gArgs.GetBoolArg("-xbridgetradeindex", DEFAULT_XBRIDGETRADEINDEX))
+        LogPrintf("* Using %.1f MiB for xbridge trade index database\n", nTradeIndexCache * (1.0 / 1024 / 1024));
     LogPrintf("* Using %.1f MiB for chain state database\n", nCoinDBCache * (1.0 / 1024 / 1024));
     LogPrintf("* Using %.1f MiB for in-memory UTXO set (plus up to %.1f MiB of unused mempool space)\n", nCoinCacheUsage * (1.0 / 1024 / 1024), nMempoolSizeMax * (1.0 / 1024 / 1024));
 
     // Blocknet PoS requires txindex
     g_txindex = MakeUnique<TxIndex>(nTxIndexCache, false, fReindex);
+    g_governanceindex = MakeUnique<GovernanceIndex>(nGovIndexCache, false, fReindex);
+    if (gArgs.GetBoolArg("-xbridgetradeindex", DEFAULT_XBRIDGETRADEINDEX))
+        g_xbridgetradeindex = MakeUnique<XBridgeTradeIndex>(nTradeIndexCache, false, fReindex);
 
     bool fLoaded = false;
     while (!fLoaded && !ShutdownRequested()) {
@@ -1804,10 +1886,23 @@ bool AppInitMain(InitInterfaces& interfaces)
 
     // ********************************************************* Step 12: start node
 
-    // Load governance data from chain data
+    // Load governance data from the governance index, fallback to reading chain data
+    // while the index is being built.
     uiInterface.InitMessage(_("Loading Governance data..."));
     std::string failReason;
-    if (!gov::Governance::instance().loadGovernanceData(chainActive, cs_main, Params().GetConsensus(), failReason)) {
+    bool govIndexLoaded{false};
+    if (g_governanceindex->IsSynced()) {
+        govIndexLoaded = g_governanceindex->LoadGovernanceData(gov::Governance::instance(), Params().GetConsensus(), failReason);
+        if (!govIndexLoaded) {
+            LogPrintf("Failed to load Governance data from index, reading from chain instead: %s\n", failReason);
+            failReason.clear();
+            gov::Governance::instance().reset();
+        }
+    } else {
+        LogPrintf("Governance index is not in sync with the chain yet, reading Governance data from chain instead\n");
+    }
+    const int govLoadThreads = static_cast<int>(gArgs.GetArg("-govloadthreads", gov::DEFAULT_GOVLOADTHREADS));
+    if (!govIndexLoaded && !gov::Governance::instance().loadGovernanceData(chainActive, cs_main, Params().GetConsensus(), failReason, govLoadThreads)) {
         LogPrintf("ERROR: Failed to load Governance data: %s\n", failReason);
         uiInterface.InitMessage(_("Failed to load Governance data. If the problem continues please perform a chain reindex. See debug.log for more details"));
         return false;
@@ -3,12 +3,16 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <crypto/common.h>
 #include <hash.h>
 #include <kernel.h>
 #include <script/interpreter.h>
 #include <util/system.h>
 #include <validation.h>
 
+#include <atomic>
+#include <memory>
+
 #include <boost/assign/list_of.hpp>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
@@ -54,7 +58,7 @@ int64_t GetStakeModifierSelectionInterval() {
 // select a block from the candidate blocks in vSortedByTimestamp, excluding
 // already selected blocks in vSelectedBlocks, and with timestamp up to
 // nSelectionIntervalStop.
-static bool SelectBlockFromCandidates( vector<pair<int64_t, uint256> >& vSortedByTimestamp, map<uint256,
+static bool SelectBlockFromCandidates( vector<pair<int64_t, const CBlockIndex*> >& vSortedByTimestamp, map<uint256,
         const CBlockIndex*>& mapSelectedBlocks, int64_t nSelectionIntervalStop, uint64_t nStakeModifierPrev,
         const CBlockIndex** pindexSelected)
 {
@@ -65,13 +69,7 @@ static bool SelectBlockFromCandidates( vector<pair<int64_t, uint256> >& vSortedB
     arith_uint256 hashBest = 0;
     *pindexSelected = (const CBlockIndex*)0;
     BOOST_FOREACH (const auto & item, vSortedByTimestamp) {
-        const CBlockIndex* pindex = nullptr;
-        {
-            LOCK(cs_main);
-            pindex = LookupBlockIndex(item.second);
-        }
-        if (!pindex)
-            return error("SelectBlockFromCandidates: failed to find block index for candidate block %s", item.second.ToString().c_str());
+        const CBlockIndex* pindex = item.second;
         if (fSelected && pindex->GetBlockTime() > nSelectionIntervalStop)
             break;
 
@@ -161,15 +159,16 @@ bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nStakeMod
     if (nModifierTime / getInterval() >= pindexPrev->GetBlockTime() / getInterval())
         return true;
 
-    // Sort candidate blocks by timestamp
-    vector<pair<int64_t, uint256> > vSortedByTimestamp;
+    // Sort candidate blocks by timestamp. Candidates are ancestors of pindexPrev,
+    // keep their block index to avoid looking them up for each selection round.
+    vector<pair<int64_t, const CBlockIndex*> > vSortedByTimestamp;
     vSortedByTimestamp.reserve(64 * getInterval() / consensus.nPowTargetSpacing);
     int64_t nSelectionInterval = GetStakeModifierSelectionInterval();
     int64_t nSelectionIntervalStart = (pindexPrev->GetBlockTime() / getInterval()) * getInterval() - nSelectionInterval;
     const CBlockIndex* pindex = pindexPrev;
 
     while (pindex && pindex->GetBlockTime() >= nSelectionIntervalStart) {
-        vSortedByTimestamp.push_back(make_pair(pindex->GetBlockTime(), pindex->GetBlockHash()));
+        vSortedByTimestamp.push_back(make_pair(pindex->GetBlockTime(), pindex));
         pindex = pindex->pprev;
     }
 
@@ -179,9 +178,9 @@ bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, uint64_t& nStakeMod
     // breaks a tie based on hash instead of block number, see comparator below checking
     // for this case.
     sort(vSortedByTimestamp.begin(), vSortedByTimestamp.end(),
-            [](const pair<int64_t, uint256> & a, const pair<int64_t, uint256> & b) -> bool {
+            [](const pair<int64_t, const CBlockIndex*> & a, const pair<int64_t, const CBlockIndex*> & b) -> bool {
                 if (a.first == b.first)
-                    return UintToArith256(a.second) < UintToArith256(b.second);
+                    return UintToArith256(a.second->GetBlockHash()) < UintToArith256(b.second->GetBlockHash());
                 return a.first < b.first;
             });
 
@@ -280,6 +279,81 @@ bool GetKernelStakeModifierBlocknet(const CBlockIndex *pindexPrev, const CBlockI
     return true;
 }
 
+// Index of the v03 kernel stake modifiers by stake block height. Each entry is the
+// block that generated the modifier selected for a stake in the block at that height.
+// The index is built once from the best header chain after it has moved past the
+// v05 protocol upgrade, after which the v03 protocol modifiers can't change.
+static Mutex csLegacyStakeModifiers;
+static std::shared_ptr<const std::vector<const CBlockIndex*>> legacyStakeModifiers; // access with std::atomic_load/store
+static std::atomic<bool> legacyStakeModifiersBuilt{false};
+
+bool BuildLegacyStakeModifierIndex(const CBlockIndex *pindexTip) {
+    if (!pindexTip || !IsProtocolV05(pindexTip->GetBlockTime()))
+        return false; // chain hasn't moved past the v03 protocol
+
+    LOCK(csLegacyStakeModifiers);
+    if (legacyStakeModifiersBuilt)
+        return true;
+
+    const int64_t nStart = GetTimeMillis();
+    std::vector<const CBlockIndex*> chain(pindexTip->nHeight + 1, nullptr);
+    for (const CBlockIndex *pindex = pindexTip; pindex; pindex = pindex->pprev)
+        chain[pindex->nHeight] = pindex;
+
+    // Only blocks prior to the v05 upgrade can be used as v03 stakes
+    int lastHeight = -1;
+    for (int i = 0; i < static_cast<int>(chain.size()); ++i) {
+        if (!IsProtocolV05(chain[i]->GetBlockTime()))
+            lastHeight = i;
+    }
+    std::vector<int> generated; // heights of blocks that generated a stake modifier
+    for (int i = 0; i < static_cast<int>(chain.size()); ++i) {
+        if (chain[i]->GeneratedStakeModifier())
+            generated.push_back(i);
+    }
+
+    // Same selection as GetKernelStakeModifierV03: first modifier generated after the
+    // stake block at least a selection interval later than the stake block.
+    const int64_t nStakeModifierSelectionInterval = GetStakeModifierSelectionInterval();
+    auto modifiers = std::make_shared<std::vector<const CBlockIndex*>>(lastHeight + 1, nullptr);
+    for (int i = 0; i <= lastHeight; ++i) {
+        const int64_t nSelectionTime = chain[i]->GetBlockTime() + nStakeModifierSelectionInterval;
+        for (auto it = std::upper_bound(generated.begin(), generated.end(), i); it != generated.end(); ++it) {
+            if (chain[*it]->GetBlockTime() >= nSelectionTime) {
+                (*modifiers)[i] = chain[*it];
+                break;
+            }
+        }
+    }
+
+    std::atomic_store(&legacyStakeModifiers, std::shared_ptr<const std::vector<const CBlockIndex*>>(modifiers));
+    legacyStakeModifiersBuilt = true;
+    LogPrintf("Built v03 stake modifier index for %d blocks in %dms\n", lastHeight + 1, GetTimeMillis() - nStart);
+    return true;
+}
+
+void ResetLegacyStakeModifierIndex() {
+    LOCK(csLegacyStakeModifiers);
+    std::atomic_store(&legacyStakeModifiers, std::shared_ptr<const std::vector<const CBlockIndex*>>());
+    legacyStakeModifiersBuilt = false;
+}
+
+// Returns the v03 stake modifier from the index. The indexed modifier is only used
+// if the stake block is an ancestor of the block that generated the modifier.
+static bool GetLegacyStakeModifier(const CBlockIndex *pindexStake, uint64_t & nStakeModifier, int & nStakeModifierHeight, int64_t & nStakeModifierTime)
+{
+    const auto modifiers = std::atomic_load(&legacyStakeModifiers);
+    if (!modifiers || pindexStake->nHeight < 0 || pindexStake->nHeight >= static_cast<int>(modifiers->size()))
+        return false;
+    const CBlockIndex *pindex = (*modifiers)[pindexStake->nHeight];
+    if (!pindex || pindex->GetAncestor(pindexStake->nHeight) != pindexStake)
+        return false;
+    nStakeModifier = pindex->nStakeModifier;
+    nStakeModifierHeight = pindex->nHeight;
+    nStakeModifierTime = pindex->GetBlockTime();
+    return true;
+}
+
 // The stake modifier used to hash for a stake kernel is chosen as the stake
 // modifier about a selection interval later than the coin generating the kernel
 bool GetKernelStakeModifierV03(const CBlockIndex *pindexStake, uint64_t & nStakeModifier, int & nStakeModifierHeight, int64_t & nStakeModifierTime)
@@ -288,6 +362,21 @@ bool GetKernelStakeModifierV03(const CBlockIndex *pindexStake, uint64_t & nStake
     if (!pindexStake)
         return false;
 
+    // Use the precomputed modifier if available, the index is built the first
+    // time the best header chain is past the v03 protocol.
+    if (GetLegacyStakeModifier(pindexStake, nStakeModifier, nStakeModifierHeight, nStakeModifierTime))
+        return true;
+    if (!legacyStakeModifiersBuilt) {
+        const CBlockIndex *pindexBest = nullptr;
+        {
+            LOCK(cs_main);
+            pindexBest = pindexBestHeader;
+        }
+        if (BuildLegacyStakeModifierIndex(pindexBest)
+            && GetLegacyStakeModifier(pindexStake, nStakeModifier, nStakeModifierHeight, nStakeModifierTime))
+            return true;
+    }
+
     nStakeModifierHeight = pindexStake->nHeight;
     nStakeModifierTime = pindexStake->GetBlockTime();
     int64_t nStakeModifierSelectionInterval = GetStakeModifierSelectionInterval();
@@ -351,18 +440,69 @@ uint256 stakeHashV06(CDataStream ss, const uint256 & hashBlockFrom, const unsign
     return Hash(ss.begin(), ss.end());
 }
 
-bool stakeTargetHit(const uint256 & hashProofOfStake, const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay) {
+StakeKernelHasher::StakeKernelHasher(const uint64_t & stakeModifier, const uint256 & hashBlockFrom,
+                                     const unsigned int & nTimeBlockFrom, const int & blockHeight,
+                                     const unsigned int & prevoutIndex)
+{
+    // Same layout as stakeHashV06: modifier, hashBlockFrom, nTimeBlockFrom, blockHeight, prevoutIndex
+    unsigned char data[8 + 32 + 4 + 4 + 4];
+    WriteLE64(data, stakeModifier);
+    memcpy(data + 8, hashBlockFrom.begin(), 32);
+    WriteLE32(data + 40, nTimeBlockFrom);
+    WriteLE32(data + 44, static_cast<uint32_t>(blockHeight));
+    WriteLE32(data + 48, prevoutIndex);
+    prefix.Write(data, sizeof(data));
+}
+
+StakeKernelHasher::StakeKernelHasher(const uint64_t & stakeModifier, const unsigned int & nTimeBlockFrom,
+                                     const int & blockHeight, const unsigned int & prevoutIndex)
+{
+    // Same layout as stakeHashV05: modifier, nTimeBlockFrom, blockHeight, prevoutIndex
+    unsigned char data[8 + 4 + 4 + 4];
+    WriteLE64(data, stakeModifier);
+    WriteLE32(data + 8, nTimeBlockFrom);
+    WriteLE32(data + 12, static_cast<uint32_t>(blockHeight));
+    WriteLE32(data + 16, prevoutIndex);
+    prefix.Write(data, sizeof(data));
+}
+
+uint256 StakeKernelHasher::Hash(const unsigned int & nTimeTx) const {
+    uint256 result;
+    HashBatch(nTimeTx, 1, &result);
+    return result;
+}
+
+void StakeKernelHasher::HashBatch(const unsigned int & nTimeTx, const size_t & count, uint256 *hashesRet) const {
+    unsigned char time[4];
+    unsigned char buf[CSHA256::OUTPUT_SIZE];
+    for (size_t i = 0; i < count; ++i) {
+        WriteLE32(time, nTimeTx + static_cast<unsigned int>(i));
+        CSHA256 sha(prefix);
+        sha.Write(time, sizeof(time)).Finalize(buf);
+        CSHA256().Write(buf, sizeof(buf)).Finalize(hashesRet[i].begin());
+    }
+}
+
+arith_uint256 stakeTarget(const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay) {
     //get the stake weight - weight is equal to coin amount
     const auto bnCoinDayWeight = arith_uint256(nValueIn) / 100;
-    // Now check if proof-of-stake hash meets target protocol
-    return (UintToArith256(hashProofOfStake) < bnCoinDayWeight * bnTargetPerCoinDay);
+    return bnCoinDayWeight * bnTargetPerCoinDay;
 }
 
-bool stakeTargetHitV06(const uint256 & hashProofOfStake, const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay) {
+arith_uint256 stakeTargetV06(const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay) {
     // Stake weight is 1/200 of the staked input amount
     const auto bnCoinDayWeight = arith_uint256(nValueIn) / 200;
+    return bnCoinDayWeight * bnTargetPerCoinDay;
+}
+
+bool stakeTargetHit(const uint256 & hashProofOfStake, const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay) {
+    // Now check if proof-of-stake hash meets target protocol
+    return (UintToArith256(hashProofOfStake) < stakeTarget(nValueIn, bnTargetPerCoinDay));
+}
+
+bool stakeTargetHitV06(const uint256 & hashProofOfStake, const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay) {
     // Now check if proof-of-stake hash meets target protocol
-    return (UintToArith256(hashProofOfStake) < bnCoinDayWeight * bnTargetPerCoinDay);
+    return (UintToArith256(hashProofOfStake) < stakeTargetV06(nValueIn, bnTargetPerCoinDay));
 }
 
 bool CheckStakeKernelHash(const CBlockIndex *pindexPrev, const CBlockIndex *pindexStake, const unsigned int & nBits,
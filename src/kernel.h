@@ -7,6 +7,7 @@
 #define BITCOIN_KERNEL_H
 
 #include <chain.h>
+#include <crypto/sha256.h>
 #include <streams.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -25,6 +26,38 @@ uint256 stakeHash(unsigned int nTimeTx, CDataStream ss, unsigned int prevoutInde
 uint256 stakeHashV05(CDataStream ss, const unsigned int & nTimeBlockFrom, const int & blockHeight, const unsigned int & prevoutIndex, const unsigned int & nTimeTx);
 uint256 stakeHashV06(CDataStream ss, const uint256 & hashBlockFrom, const unsigned int & nTimeBlockFrom, const int & blockHeight, const unsigned int & prevoutIndex, const unsigned int & nTimeTx);
 
+/**
+ * Computes stake kernel hashes for many timestamps of the same stake input. The
+ * constant kernel prefix (stake modifier, stake block and prevout index) is
+ * serialized into the sha256 state once, only the timestamp is hashed for each
+ * kernel. Hashes are equivalent to stakeHashV05/stakeHashV06.
+ */
+class StakeKernelHasher {
+public:
+    // Number of timestamps hashed per batch by the staker
+    static constexpr size_t BATCH_SIZE = 64;
+
+    // Kernel hasher for the v06 staking protocol
+    StakeKernelHasher(const uint64_t & stakeModifier, const uint256 & hashBlockFrom, const unsigned int & nTimeBlockFrom,
+                      const int & blockHeight, const unsigned int & prevoutIndex);
+    // Kernel hasher for the v05 staking protocol
+    StakeKernelHasher(const uint64_t & stakeModifier, const unsigned int & nTimeBlockFrom, const int & blockHeight,
+                      const unsigned int & prevoutIndex);
+
+    // Returns the kernel hash for the specified timestamp.
+    uint256 Hash(const unsigned int & nTimeTx) const;
+    // Computes the kernel hashes for count timestamps starting at nTimeTx. hashesRet
+    // must have room for count hashes.
+    void HashBatch(const unsigned int & nTimeTx, const size_t & count, uint256 *hashesRet) const;
+
+private:
+    CSHA256 prefix; // sha256 state after writing the constant kernel prefix
+};
+
+// Stake target for the specified input amount
+arith_uint256 stakeTarget(const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay);
+arith_uint256 stakeTargetV06(const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay);
+
 // Check whether stake kernel meets hash target
 bool stakeTargetHit(const uint256 & hashProofOfStake, const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay);
 bool stakeTargetHitV06(const uint256 & hashProofOfStake, const int64_t & nValueIn, const arith_uint256 & bnTargetPerCoinDay);
@@ -34,6 +67,11 @@ bool CheckStakeKernelHash(const CBlockIndex *pindexPrev, const CBlockIndex *pind
         uint256 & hashProofOfStake, const Consensus::Params & consensus);
 bool GetKernelStakeModifier(const CBlockIndex *pindexPrev, const CBlockIndex *pindexStake, const int64_t & nBlockTime, uint64_t & nStakeModifier, int & nStakeModifierHeight, int64_t & nStakeModifierTime);
 bool GetKernelStakeModifierV03(const CBlockIndex *pindexStake, uint64_t & nStakeModifier, int & nStakeModifierHeight, int64_t & nStakeModifierTime);
+// Precompute the v03 stake modifiers from the chain ending at pindexTip. Returns false
+// if the chain hasn't moved past the v03 staking protocol.
+bool BuildLegacyStakeModifierIndex(const CBlockIndex *pindexTip);
+// Clear the v03 stake modifier index, must be called when the block index is unloaded.
+void ResetLegacyStakeModifierIndex();
 bool GetKernelStakeModifierBlocknet(const CBlockIndex *pindexPrev, const CBlockIndex *pindexStake, const int64_t & blockStakeTime, uint64_t & nStakeModifier, int & nStakeModifierHeight, int64_t & nStakeModifierTime);
 
 // Check kernel hash target and coinstake signature
@@ -729,6 +729,18 @@ public:
     std::vector<uint256> vBlockHashesToAnnounce GUARDED_BY(cs_inventory);
     // Used for BIP35 mempool sending
     bool fSendMempool GUARDED_BY(cs_inventory){false};
+    // XBridge packets known by the peer
+    CRollingBloomFilter filterXBridgeKnown GUARDED_BY(cs_inventory);
+    // List of xbridge packet hashes we still have to announce
+    std::vector<uint256> vInventoryXBridgeToSend GUARDED_BY(cs_inventory);
+    int64_t nNextXBridgeInvSend{0};
+    // Peer prefers xbridge packet announcements (XBRINV) over full packets
+    std::atomic<bool> fSendXBridgeInv{false};
+    // XBridge packets to request from the peer by request time, requested packets by reply
+    // deadline and the hashes of both, guarded by cs_xbridgerelay in net_processing
+    std::multimap<int64_t, uint256> mapXBridgeAskFor;
+    std::map<uint256, int64_t> mapXBridgeInFlight;
+    std::set<uint256> setXBridgeAskFor;
 
     // Last time a "MEMPOOL" request was serviced.
     std::atomic<int64_t> timeLastMempoolReq{0};
@@ -868,6 +880,19 @@ public:
         }
     }
 
+    void AddXBridgeKnown(const uint256& hash)
+    {
+        LOCK(cs_inventory);
+        filterXBridgeKnown.insert(hash);
+    }
+
+    void PushXBridgeInventory(const uint256& hash)
+    {
+        LOCK(cs_inventory);
+        if (!filterXBridgeKnown.contains(hash))
+            vInventoryXBridgeToSend.push_back(hash);
+    }
+
     void PushBlockHash(const uint256 &hash)
     {
         LOCK(cs_inventory);
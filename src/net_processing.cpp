@@ -95,6 +95,20 @@ static constexpr unsigned int INVENTORY_BROADCAST_MAX = 7 * INVENTORY_BROADCAST_
 static constexpr unsigned int AVG_FEEFILTER_BROADCAST_INTERVAL = 10 * 60;
 /** Maximum feefilter broadcast delay after significant change. */
 static constexpr unsigned int MAX_FEEFILTER_CHANGE_DELAY = 5 * 60;
+/** Average delay between xbridge packet announcements in seconds. */
+static constexpr unsigned int XBRIDGE_INVENTORY_BROADCAST_INTERVAL = 1;
+/** Time in seconds an announced xbridge packet can be requested from us. */
+static constexpr int64_t XBRIDGE_RELAY_EXPIRY = 5 * 60;
+/** Time in seconds before an xbridge packet requested from a peer is requested from another peer. */
+static constexpr int64_t XBRIDGE_GETDATA_TIMEOUT = 30;
+/** Maximum number of xbridge packets queued for request or requested from a peer. */
+static constexpr size_t MAX_PEER_XBRIDGE_ASKFOR = 1000;
+/** Maximum number of xbridge packets queued for request or requested from all peers. */
+static constexpr size_t MAX_XBRIDGE_ASKFOR = 10000;
+/** Maximum number of xbridge packets kept in the relay map. */
+static constexpr size_t MAX_XBRIDGE_RELAY_SZ = 10000;
+/** Maximum total size in bytes of the xbridge packets kept in the relay map. */
+static constexpr size_t MAX_XBRIDGE_RELAY_BYTES = 32 * 1000 * 1000;
 
 // Internal stuff
 namespace {
@@ -161,6 +175,19 @@ namespace {
     /** Expiration-time ordered list of (expire time, relay map entry) pairs. */
     std::deque<std::pair<int64_t, MapRelay::iterator>> vRelayExpiration GUARDED_BY(cs_main);
 
+    CCriticalSection cs_xbridgerelay;
+    /** XBridge relay map, raw packets by hash */
+    typedef std::map<uint256, std::vector<unsigned char>> MapXBridgeRelay;
+    MapXBridgeRelay mapXBridgeRelay GUARDED_BY(cs_xbridgerelay);
+    /** Expiration-time ordered list of (expire time, xbridge relay map entry) pairs. */
+    std::deque<std::pair<int64_t, MapXBridgeRelay::iterator>> vXBridgeRelayExpiration GUARDED_BY(cs_xbridgerelay);
+    /** Total size of the packets in the xbridge relay map. */
+    size_t nXBridgeRelayBytes GUARDED_BY(cs_xbridgerelay) = 0;
+    /** XBridge packets queued for request or requested from peers, by the time of the latest scheduled request. */
+    std::map<uint256, int64_t> mapXBridgeAlreadyAskedFor GUARDED_BY(cs_xbridgerelay);
+    /** Request time ordered (request time, hash) pairs of mapXBridgeAlreadyAskedFor. */
+    std::set<std::pair<int64_t, uint256>> setXBridgeAskForTime GUARDED_BY(cs_xbridgerelay);
+
     std::atomic<int64_t> nTimeBestReceived(0); // Used only to inform the wallet of when we last received a block
 
     struct IteratorComparator
@@ -677,6 +704,159 @@ bool GetNodeStateStats(NodeId nodeid, CNodeStateStats &stats) {
     return true;
 }
 
+static void EraseOldestXBridgeRelay() EXCLUSIVE_LOCKS_REQUIRED(cs_xbridgerelay)
+{
+    nXBridgeRelayBytes -= vXBridgeRelayExpiration.front().second->second.size();
+    mapXBridgeRelay.erase(vXBridgeRelayExpiration.front().second);
+    vXBridgeRelayExpiration.pop_front();
+}
+
+void AddXBridgeRelayPacket(const uint256& hash, const std::vector<unsigned char>& packet)
+{
+    LOCK(cs_xbridgerelay);
+    const int64_t nNow = GetTime();
+    while (!vXBridgeRelayExpiration.empty() && vXBridgeRelayExpiration.front().first < nNow)
+        EraseOldestXBridgeRelay();
+    auto ret = mapXBridgeRelay.insert(std::make_pair(hash, packet));
+    if (!ret.second)
+        return;
+    vXBridgeRelayExpiration.push_back(std::make_pair(nNow + XBRIDGE_RELAY_EXPIRY, ret.first));
+    nXBridgeRelayBytes += packet.size();
+    // Expiration order is insertion order, evict the oldest packets if the map is full
+    while (mapXBridgeRelay.size() > MAX_XBRIDGE_RELAY_SZ || nXBridgeRelayBytes > MAX_XBRIDGE_RELAY_BYTES)
+        EraseOldestXBridgeRelay();
+}
+
+std::vector<std::vector<unsigned char>> FindXBridgeRelayPackets(const std::vector<uint256>& vHashes)
+{
+    std::vector<std::vector<unsigned char>> packets;
+    LOCK(cs_xbridgerelay);
+    const int64_t nNow = GetTime();
+    while (!vXBridgeRelayExpiration.empty() && vXBridgeRelayExpiration.front().first < nNow)
+        EraseOldestXBridgeRelay();
+    for (const uint256& hash : vHashes) {
+        auto it = mapXBridgeRelay.find(hash);
+        if (it != mapXBridgeRelay.end())
+            packets.push_back(it->second);
+    }
+    return packets;
+}
+
+static bool AlreadyHaveXBridge(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_xbridgerelay)
+{
+    return mapXBridgeRelay.count(hash) || sn::ServiceNodeMgr::instance().hasSeenPacket(hash);
+}
+
+/** Erases timed out xbridge requests, expired packets can be requested again when announced. */
+static void EraseExpiredXBridgeAsks(CNode* pnode, const int64_t nNow) EXCLUSIVE_LOCKS_REQUIRED(cs_xbridgerelay)
+{
+    while (!setXBridgeAskForTime.empty() && setXBridgeAskForTime.begin()->first + XBRIDGE_GETDATA_TIMEOUT <= nNow) {
+        mapXBridgeAlreadyAskedFor.erase(setXBridgeAskForTime.begin()->second);
+        setXBridgeAskForTime.erase(setXBridgeAskForTime.begin());
+    }
+    for (auto it = pnode->mapXBridgeInFlight.begin(); it != pnode->mapXBridgeInFlight.end(); ) {
+        if (it->second <= nNow) {
+            pnode->setXBridgeAskFor.erase(it->first);
+            it = pnode->mapXBridgeInFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/** Queues the announced xbridge packet for request from the peer once earlier requests timed out. */
+static void XBridgeAskFor(CNode* pnode, const uint256& hash, const int64_t nNow) EXCLUSIVE_LOCKS_REQUIRED(cs_xbridgerelay)
+{
+    if (pnode->setXBridgeAskFor.size() >= MAX_PEER_XBRIDGE_ASKFOR)
+        return;
+    auto it = mapXBridgeAlreadyAskedFor.find(hash);
+    if (it == mapXBridgeAlreadyAskedFor.end() && mapXBridgeAlreadyAskedFor.size() >= MAX_XBRIDGE_ASKFOR)
+        return;
+    // a peer may not have multiple non-responded queue positions for a single packet
+    if (!pnode->setXBridgeAskFor.insert(hash).second)
+        return;
+
+    // Each retry is XBRIDGE_GETDATA_TIMEOUT after the last
+    int64_t nRequestTime = nNow;
+    if (it != mapXBridgeAlreadyAskedFor.end()) {
+        nRequestTime = std::max(it->second + XBRIDGE_GETDATA_TIMEOUT, nNow);
+        setXBridgeAskForTime.erase(std::make_pair(it->second, hash));
+        it->second = nRequestTime;
+    } else {
+        mapXBridgeAlreadyAskedFor.emplace(hash, nRequestTime);
+    }
+    setXBridgeAskForTime.emplace(nRequestTime, hash);
+    pnode->mapXBridgeAskFor.emplace(nRequestTime, hash);
+}
+
+/** Returns the queued xbridge packets due for request from the peer and marks them in flight. */
+static std::vector<uint256> PopXBridgeAsks(CNode* pnode, const int64_t nNow) EXCLUSIVE_LOCKS_REQUIRED(cs_xbridgerelay)
+{
+    std::vector<uint256> vGetData;
+    while (!pnode->mapXBridgeAskFor.empty() && pnode->mapXBridgeAskFor.begin()->first <= nNow) {
+        const uint256 hash = pnode->mapXBridgeAskFor.begin()->second;
+        pnode->mapXBridgeAskFor.erase(pnode->mapXBridgeAskFor.begin());
+        if (AlreadyHaveXBridge(hash)) {
+            // If we're not going to ask, don't expect a response
+            pnode->setXBridgeAskFor.erase(hash);
+            continue;
+        }
+        pnode->mapXBridgeInFlight[hash] = nNow + XBRIDGE_GETDATA_TIMEOUT;
+        vGetData.push_back(hash);
+    }
+    return vGetData;
+}
+
+std::vector<uint256> ProcessXBridgeInventory(CNode* pfrom, const std::vector<uint256>& vHashes)
+{
+    const int64_t nNow = GetTime();
+    LOCK(cs_xbridgerelay);
+    EraseExpiredXBridgeAsks(pfrom, nNow);
+    for (const uint256& hash : vHashes) {
+        pfrom->AddXBridgeKnown(hash);
+        if (!AlreadyHaveXBridge(hash))
+            XBridgeAskFor(pfrom, hash, nNow);
+    }
+    return PopXBridgeAsks(pfrom, nNow);
+}
+
+std::vector<uint256> GetXBridgeRequests(CNode* pnode)
+{
+    const int64_t nNow = GetTime();
+    LOCK(cs_xbridgerelay);
+    EraseExpiredXBridgeAsks(pnode, nNow);
+    return PopXBridgeAsks(pnode, nNow);
+}
+
+void XBridgePacketReceived(CNode* pfrom, const uint256& hash)
+{
+    LOCK(cs_xbridgerelay);
+    auto it = mapXBridgeAlreadyAskedFor.find(hash);
+    if (it != mapXBridgeAlreadyAskedFor.end()) {
+        setXBridgeAskForTime.erase(std::make_pair(it->second, hash));
+        mapXBridgeAlreadyAskedFor.erase(it);
+    }
+    if (pfrom->mapXBridgeInFlight.erase(hash))
+        pfrom->setXBridgeAskFor.erase(hash);
+}
+
+void RelayXBridgePacket(const std::vector<unsigned char>& packet, CConnman* connman, NodeId from)
+{
+    const uint256 hash = Hash(packet.begin(), packet.end());
+    AddXBridgeRelayPacket(hash, packet);
+
+    connman->ForEachNode([&](CNode* pnode) {
+        if (!pnode->fSuccessfullyConnected || pnode->fDisconnect)
+            return;
+        if (pnode->GetId() == from || pnode->fXRouter) // do not relay to xrouter nodes
+            return;
+        if (pnode->fSendXBridgeInv)
+            pnode->PushXBridgeInventory(hash);
+        else
+            connman->PushMessage(pnode, CNetMsgMaker(pnode->GetSendVersion()).Make(NetMsgType::XBRIDGE, packet));
+    });
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //
 // mapOrphanTransactions
@@ -1927,6 +2107,9 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
             nCMPCTBLOCKVersion = 1;
             connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::SENDCMPCT, fAnnounceUsingCMPCTBLOCK, nCMPCTBLOCKVersion));
         }
+        // Tell our peer we prefer xbridge packet announcements, peers that
+        // don't support announcements ignore this message.
+        connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::SENDXBRINV));
         pfrom->fSuccessfullyConnected = true;
 
         // Used for logging purposes, update the mean block height across connected nodes
@@ -2996,11 +3179,50 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
     auto & smgr = sn::ServiceNodeMgr::instance();
     auto & xapp = xbridge::App::instance();
 
+    if (strCommand == NetMsgType::SENDXBRINV) {
+        pfrom->fSendXBridgeInv = true;
+        return true;
+    }
+
+    if (strCommand == NetMsgType::XBRINV) { // request unknown xbridge packets
+        std::vector<uint256> vHashes;
+        vRecv >> vHashes;
+        if (vHashes.size() > MAX_INV_SZ) {
+            LOCK(cs_main);
+            Misbehaving(pfrom->GetId(), 20, strprintf("xbrinv message size = %u", vHashes.size()));
+            return false;
+        }
+
+        const std::vector<uint256> vGetData = ProcessXBridgeInventory(pfrom, vHashes);
+        if (!vGetData.empty())
+            connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::GETXBR, vGetData));
+        return true;
+    }
+
+    if (strCommand == NetMsgType::GETXBR) { // send requested xbridge packets
+        std::vector<uint256> vHashes;
+        vRecv >> vHashes;
+        if (vHashes.size() > MAX_INV_SZ) {
+            LOCK(cs_main);
+            Misbehaving(pfrom->GetId(), 20, strprintf("getxbr message size = %u", vHashes.size()));
+            return false;
+        }
+
+        for (const auto & packet : FindXBridgeRelayPackets(vHashes))
+            connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::XBRIDGE, packet));
+        return true;
+    }
+
     if (strCommand == NetMsgType::XBRIDGE) { // handle xbridge packets
         std::vector<unsigned char> raw;
         vRecv >> raw;
         auto rawcopy = raw;
 
+        // Don't announce the packet back to the peer
+        const uint256 hash = Hash(raw.begin(), raw.end());
+        pfrom->AddXBridgeKnown(hash);
+        XBridgePacketReceived(pfrom, hash);
+
         // Top-level validation checks
         if (raw.size() < (20 + sizeof(time_t))) {
             // bad packet, small penalty (don't relay)
@@ -3048,13 +3270,8 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         }
 
         // Relay xbridge packets only if state is good
-        if (dos <= 0) {
-            connman->ForEachNode([&](CNode *pnode) {
-                if (!pnode->fSuccessfullyConnected)
-                    return;
-                connman->PushMessage(pnode, msgMaker.Make(NetMsgType::XBRIDGE, rawcopy));
-            });
-        }
+        if (dos <= 0)
+            RelayXBridgePacket(rawcopy, connman, pfrom->GetId());
 
         return true;
     }
@@ -3873,6 +4090,37 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
         if (!vInv.empty())
             connman->PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
 
+        //
+        // Message: xbridge packet inventory
+        //
+        if (pto->fSendXBridgeInv) {
+            std::vector<uint256> vXBridgeInv;
+            LOCK(pto->cs_inventory);
+            if (!pto->vInventoryXBridgeToSend.empty() && (pto->fWhitelisted || pto->nNextXBridgeInvSend < nNow)) {
+                pto->nNextXBridgeInvSend = PoissonNextSend(nNow, XBRIDGE_INVENTORY_BROADCAST_INTERVAL);
+                for (const uint256 & hash : pto->vInventoryXBridgeToSend) {
+                    if (pto->filterXBridgeKnown.contains(hash))
+                        continue;
+                    pto->filterXBridgeKnown.insert(hash);
+                    vXBridgeInv.push_back(hash);
+                    if (vXBridgeInv.size() == MAX_INV_SZ) {
+                        connman->PushMessage(pto, msgMaker.Make(NetMsgType::XBRINV, vXBridgeInv));
+                        vXBridgeInv.clear();
+                    }
+                }
+                pto->vInventoryXBridgeToSend.clear();
+                if (!vXBridgeInv.empty())
+                    connman->PushMessage(pto, msgMaker.Make(NetMsgType::XBRINV, vXBridgeInv));
+            }
+        }
+
+        //
+        // Message: getxbr (packets announced by other peers that were not received in time)
+        //
+        const std::vector<uint256> vGetXBridge = GetXBridgeRequests(pto);
+        if (!vGetXBridge.empty())
+            connman->PushMessage(pto, msgMaker.Make(NetMsgType::GETXBR, vGetXBridge));
+
         // Detect whether we're stalling
         nNow = GetTimeMicros();
         if (state.nStallingSince && state.nStallingSince < nNow - 1000000 * BLOCK_STALLING_TIMEOUT) {
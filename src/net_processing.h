@@ -92,4 +92,13 @@ struct CNodeStateStats {
 /** Get statistics from node state */
 bool GetNodeStateStats(NodeId nodeid, CNodeStateStats &stats);
 
+/**
+ * Relay an xbridge packet. Peers that prefer xbridge inventory receive an
+ * announcement of the packet hash, other peers receive the full packet.
+ * @param packet raw xbridge packet (including the address and timestamp)
+ * @param connman
+ * @param from peer the packet was received from, it isn't relayed back to it
+ */
+void RelayXBridgePacket(const std::vector<unsigned char>& packet, CConnman* connman, NodeId from = -1);
+
 #endif // BITCOIN_NET_PROCESSING_H
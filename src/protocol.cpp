@@ -48,6 +48,9 @@ const char *SNPING="snp";
 const char *SNLIST="snl";
 const char *SNLISTPING="snlp";
 const char *XROUTER="xrouter";
+const char *SENDXBRINV="sendxbrinv";
+const char *XBRINV="xbrinv";
+const char *GETXBR="getxbr";
 } // namespace NetMsgType
 
 /** All known message types. Keep this in the same order as the list of
@@ -86,6 +89,9 @@ const static std::string allNetMessageTypes[] = {
     NetMsgType::SNLIST,
     NetMsgType::SNLISTPING,
     NetMsgType::XROUTER,
+    NetMsgType::SENDXBRINV,
+    NetMsgType::XBRINV,
+    NetMsgType::GETXBR,
 };
 const static std::vector<std::string> allNetMessageTypesVec(allNetMessageTypes, allNetMessageTypes+ARRAYLEN(allNetMessageTypes));
 
@@ -268,6 +268,22 @@ extern const char *SNLISTPING;
  * @since protocol version 70712
  */
 extern const char *XROUTER;
+/**
+ * Indicates that a node prefers to receive XBridge packet announcements
+ * (XBRINV) rather than full XBridge packets.
+ * @since protocol version 70713
+ */
+extern const char *SENDXBRINV;
+/**
+ * Announces the hashes of XBridge packets.
+ * @since protocol version 70713
+ */
+extern const char *XBRINV;
+/**
+ * Requests the XBridge packets announced with XBRINV.
+ * @since protocol version 70713
+ */
+extern const char *GETXBR;
 };
 
 /* Get a vector of all valid message types (see above) */
@@ -141,14 +141,7 @@ static UniValue listproposals(const JSONRPCRequest& request)
             throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("'sinceblock' is bad, cannot be greater than %d", chainActive.Height()));
     }
 
-    std::vector<gov::Proposal> proposals;
-    std::vector<gov::Vote> votes;
-    auto ps = gov::Governance::instance().getProposalsSince(sinceBlock);
-    for (const auto & proposal : ps) {
-        proposals.push_back(proposal);
-        const auto & v = gov::Governance::instance().getVotes(proposal.getHash());
-        votes.insert(votes.end(), v.begin(), v.end());
-    }
+    auto proposals = gov::Governance::instance().getProposalsSince(sinceBlock);
 
     const auto superblock = gov::NextSuperblock(consensus);
     std::map<gov::Proposal, gov::Tally> results;
@@ -169,7 +162,7 @@ static UniValue listproposals(const JSONRPCRequest& request)
             if (results.count(proposal))
                 status = "passed";
         }
-        const auto tally = gov::Governance::getTally(proposal.getHash(), votes, consensus);
+        const auto tally = gov::Governance::instance().getTally(proposal.getHash(), consensus);
         UniValue prop(UniValue::VOBJ);
         prop.pushKV("hash", proposal.getHash().ToString());
         prop.pushKV("name", proposal.getName());
@@ -38,6 +38,7 @@ extern int GetChainTipHeight();
 namespace sn {
 
 typedef std::function<bool(const COutPoint & out, CTransactionRef & tx)> TxFunc;
+typedef std::function<bool(const COutPoint & out, CTxOut & txout)> UtxoFunc;
 typedef std::function<bool(const uint32_t & blockNumber, const uint256 & blockHash, const bool & checkStale)> BlockValidFunc;
 
 /**
@@ -372,6 +373,27 @@ public:
      * @return
      */
     bool isValid(const TxFunc & getTxFunc, const BlockValidFunc & isBlockValid, const bool & checkStale=true) const
+    {
+        return isValid([&getTxFunc](const COutPoint & out, CTxOut & txout) -> bool {
+            CTransactionRef tx;
+            const bool success = getTxFunc(out, tx);
+            if (tx && out.n < tx->vout.size())
+                txout = tx->vout[out.n];
+            return success;
+        }, isBlockValid, checkStale);
+    }
+
+    /**
+     * Returns true if the Servicenode is valid. Collateral is resolved with the specified utxo lookup, which
+     * only requires the value and script of each collateral output (e.g. the coins view). The lookup returns
+     * false if the utxo is spent and should still assign the output if known, this is required to validate
+     * snodes that are in the spent collateral grace period.
+     * @param getUtxoFunc
+     * @param isBlockValid
+     * @param checkStale
+     * @return
+     */
+    bool isValid(const UtxoFunc & getUtxoFunc, const BlockValidFunc & isBlockValid, const bool & checkStale=true) const
     {
         // Block reported by snode must be ancestor of our chain tip
         if (!isBlockValid(pingBestBlock, pingBestBlockHash, checkStale))
@@ -421,20 +443,16 @@ public:
 
         // Determine if all collateral utxos validate the sig
         for (const auto & op : collateral) {
-            CTransactionRef tx;
-            auto success = getTxFunc(op, tx);
-            if (!tx)
-                return false;
+            CTxOut out;
+            auto success = getUtxoFunc(op, out);
+            if (out.IsNull())
+                return false; // not valid if no utxo found or bad vout index
             if (invalidBlock > 0) {
                 if (GetChainTipHeight() - invalidBlock >= VALID_GRACEPERIOD_BLOCKS)
                     return false; // if grace period has expired
             } else if (!success)
-                return false; // not valid if no transaction found or utxo is already spent
-
-            if (tx->vout.size() <= op.n)
-                return false; // not valid if bad vout index
+                return false; // not valid if utxo is already spent
 
-            const auto & out = tx->vout[op.n];
             total += out.nValue;
 
             if (processed.count(CScriptID(out.scriptPubKey)))
@@ -745,6 +763,24 @@ public:
      * @param isBlockValid
      */
     bool isValid(const TxFunc & getTxFunc, const BlockValidFunc & isBlockValid) const {
+        return isValidPing(isBlockValid) && snode.isValid(getTxFunc, isBlockValid, false); // stale check not required here, it happens on isBlockValid
+    }
+
+    /**
+     * Returns true if this servicenode ping is valid. Servicenode collateral is resolved with the specified utxo lookup.
+     * @param getUtxoFunc
+     * @param isBlockValid
+     */
+    bool isValid(const UtxoFunc & getUtxoFunc, const BlockValidFunc & isBlockValid) const {
+        return isValidPing(isBlockValid) && snode.isValid(getUtxoFunc, isBlockValid, false); // stale check not required here, it happens on isBlockValid
+    }
+
+protected:
+    /**
+     * Returns true if the ping's block, services and signature are valid. Does not check the servicenode collateral.
+     * @param isBlockValid
+     */
+    bool isValidPing(const BlockValidFunc & isBlockValid) const {
         if (!isBlockValid(bestBlock, bestBlockHash, true))
             return false; // fail if ping is stale
 
@@ -779,7 +815,7 @@ public:
         if (pubkey.GetID() != snodePubKey.GetID())
             return false; // fail if pubkeys don't match
 
-        return snode.isValid(getTxFunc, isBlockValid, false); // stale check not required here, it happens above on isBlockValid
+        return true;
     }
 
 protected:
@@ -6,6 +6,7 @@
 #define BLOCKNET_SERVICENODE_SERVICENODEMGR_H
 
 #include <amount.h>
+#include <bloom.h>
 #include <key_io.h>
 #include <net.h>
 #include <netmessagemaker.h>
@@ -13,6 +14,7 @@
 #include <script/standard.h>
 #include <streams.h>
 #include <sync.h>
+#include <txmempool.h>
 #include <util/strencodings.h>
 #include <util/system.h>
 #include <validation.h>
@@ -34,6 +36,11 @@
  */
 namespace sn {
 
+/** Default number of recently seen servicenode packets remembered for duplicate detection */
+static const unsigned int DEFAULT_SEEN_PACKETS = 350000;
+/** Default false positive rate of the seen packets filters */
+static const double DEFAULT_SEEN_PACKETS_FPRATE = 0.000001;
+
 extern CTxDestination ServiceNodePaymentAddress(const std::string & snode);
 
 /**
@@ -93,10 +100,34 @@ public:
     void reset() {
         LOCK(mu);
         snodes.clear();
+        collateralSnodes.clear();
         pings.clear();
-        seenPackets.clear();
+        seenPackets.reset();
         snodeEntries.clear();
         seenBlocks.clear();
+        validCollateral.clear();
+        spentCollateral.clear();
+        collateralBlock.SetNull();
+    }
+
+    /**
+     * Returns true if the hash has already been seen, the hash is not recorded.
+     * @param hash
+     * @return
+     */
+    bool hasSeenPacket(const uint256 & hash) {
+        LOCK(mu);
+        return seenPackets.contains(hash);
+    }
+
+    /**
+     * Resizes the seen packets filter. Previously seen packets are forgotten.
+     * @param elements Number of most recent packets remembered
+     * @param fpRate False positive rate, i.e. chance an unseen packet is reported as seen
+     */
+    void setSeenPacketsFilter(const unsigned int elements, const double fpRate) {
+        LOCK(mu);
+        seenPackets = CRollingBloomFilter(elements, fpRate);
     }
 
     /**
@@ -182,7 +213,7 @@ public:
         if (seenPacket(ping.getHash()))
             return false;
 
-        if (!ping.isValid(GetTxFunc, IsServiceNodeBlockValidFunc))
+        if (!ping.isValid(collateralFunc(), IsServiceNodeBlockValidFunc))
             return false; // bad ping
 
         if (!addPing(ping))
@@ -362,7 +393,7 @@ public:
 
         ServiceNodePing ping(activesn.key.GetPubKey(), bestBlock, bestBlockHash, static_cast<uint32_t>(GetTime()), config, *snode);
         ping.sign(activesn.key);
-        if (!ping.isValid(GetTxFunc, IsServiceNodeBlockValidFunc)) {
+        if (!ping.isValid(collateralFunc(), IsServiceNodeBlockValidFunc)) {
             LogPrint(BCLog::SNODE, "service node ping failed\n");
             return false;
         }
@@ -515,7 +546,7 @@ public:
     void removeSnEntries() {
         LOCK(mu);
         for (const auto & entry : snodeEntries)
-            snodes.erase(entry.key.GetPubKey());
+            eraseSn(entry.key.GetPubKey());
         snodeEntries.clear();
     }
 
@@ -858,14 +889,14 @@ protected:
      * @return
      */
     ServiceNodePtr addSn(const ServiceNode & snode, const bool checkValid = true, const bool staleCheck = true) {
-        if (checkValid && !snode.isValid(GetTxFunc, IsServiceNodeBlockValidFunc, staleCheck))
+        if (checkValid && !snode.isValid(collateralFunc(), IsServiceNodeBlockValidFunc, staleCheck))
             return nullptr;
-        removeSnWithCollateral(snode);
         auto ptr = std::make_shared<ServiceNode>(snode);
         {
             LOCK(mu);
-            snodes[ptr->getSnodePubKey()] = ptr;
+            insertSn(ptr);
         }
+        cacheCollateral(*ptr);
         return ptr;
     }
 
@@ -896,10 +927,10 @@ protected:
      * @return
      */
     bool removeSn(const CPubKey & snodePubKey) {
-        if (!hasSn(snodePubKey))
-            return false;
         LOCK(mu);
-        snodes.erase(snodePubKey);
+        if (!snodes.count(snodePubKey))
+            return false;
+        eraseSn(snodePubKey);
         return true;
     }
 
@@ -920,11 +951,9 @@ protected:
      */
     bool seenPacket(const uint256 & hash) {
         LOCK(mu);
-        if (seenPackets.count(hash))
+        if (seenPackets.contains(hash))
             return true; // already seen
-        if (seenPackets.size() > 350000)
-            seenPackets.clear(); // mem mgmt, ~12MB (32bytes * 350k)
-        seenPackets.insert(hash);
+        seenPackets.insert(hash); // oldest packets roll out of the filter
         return false;
     }
 
@@ -938,6 +967,76 @@ protected:
         return seenPacket(hash);
     }
 
+    /**
+     * Returns the collateral utxo. Collateral of known snodes is cached, only collateral
+     * spent in new blocks is evicted from the cache. Otherwise the utxo is looked up in
+     * the coins view. Returns false if the utxo is spent or spent by a transaction in the
+     * mempool, the output of spent collateral is still assigned.
+     * @param out
+     * @param txout
+     * @return
+     */
+    bool getCollateral(const COutPoint & out, CTxOut & txout) {
+        const bool mempoolSpent = mempool.isSpent(out);
+        {
+            LOCK(mu);
+            auto it = validCollateral.find(out);
+            if (it != validCollateral.end()) {
+                txout = it->second;
+                return !mempoolSpent;
+            }
+            auto sit = spentCollateral.find(out);
+            if (sit != spentCollateral.end()) {
+                txout = sit->second.first;
+                return false;
+            }
+        }
+
+        return GetUtxoFunc(out, txout);
+    }
+
+    /**
+     * Caches the unspent collateral of the specified snode. Only collateral of snodes in
+     * the snode list is cached, lookups for arbitrary utxos (e.g. from invalid packets)
+     * are never cached.
+     * @param snode
+     */
+    void cacheCollateral(const ServiceNode & snode) {
+        uint256 tipHash;
+        std::vector<std::pair<COutPoint, CTxOut>> outs;
+        {
+            LOCK(cs_main);
+            if (chainActive.Tip())
+                tipHash = chainActive.Tip()->GetBlockHash();
+            for (const auto & out : snode.getCollateral()) {
+                CTxOut txout;
+                if (GetUtxoFunc(out, txout))
+                    outs.emplace_back(out, txout);
+            }
+        }
+
+        LOCK(mu);
+        // Only cache utxos looked up on the block last processed by the validation
+        // interface, otherwise a spend in a pending block could be missed.
+        if (!collateralBlock.IsNull() && collateralBlock != tipHash)
+            return;
+        auto it = snodes.find(snode.getSnodePubKey());
+        if (it == snodes.end() || it->second->getCollateral() != snode.getCollateral())
+            return; // snode was removed or re-registered in the meantime
+        for (const auto & item : outs)
+            validCollateral[item.first] = item.second;
+    }
+
+    /**
+     * Returns the collateral lookup used to validate servicenodes.
+     * @return
+     */
+    UtxoFunc collateralFunc() {
+        return [this](const COutPoint & out, CTxOut & txout) -> bool {
+            return getCollateral(out, txout);
+        };
+    }
+
     /**
      * Removes existing snodes that match the collateral utxos of
      * the specified snode. i.e. This method will mutate the snode
@@ -948,18 +1047,7 @@ protected:
      */
     void removeSnWithCollateral(const ServiceNode & snode) {
         LOCK(mu);
-        std::map<COutPoint, ServiceNodePtr> utxos;
-        for (const auto & item : snodes) {
-            const auto & s = item.second;
-            if (s->getSnodePubKey() != snode.getSnodePubKey()) { // exclude specified snode
-                for (const auto & utxo : s->getCollateral())
-                    utxos[utxo] = s;
-            }
-        }
-        for (const auto & utxo : snode.getCollateral()) {
-            if (utxos.count(utxo) && snodes.count(utxos[utxo]->getSnodePubKey()))
-                snodes.erase(utxos[utxo]->getSnodePubKey());
-        }
+        removeSnWithCollateralLocked(snode);
     }
 
 #ifdef ENABLE_WALLET
@@ -1118,6 +1206,55 @@ protected:
 #endif // ENABLE_WALLET
 
 protected:
+    /**
+     * Adds the servicenode to the snode list and the collateral index. Existing snodes
+     * with the same collateral are removed. Requires mu.
+     * @param snode
+     */
+    void insertSn(const ServiceNodePtr & snode) {
+        const auto & pubkey = snode->getSnodePubKey();
+        if (snodes.count(pubkey)) // re-registration may change the collateral
+            eraseSn(pubkey);
+        removeSnWithCollateralLocked(*snode);
+        for (const auto & utxo : snode->getCollateral())
+            collateralSnodes[utxo] = pubkey;
+        snodes[pubkey] = snode;
+    }
+
+    /**
+     * Removes the servicenode from the snode list, the collateral index and the collateral
+     * cache. Requires mu.
+     * @param snodePubKey
+     */
+    void eraseSn(const CPubKey & snodePubKey) {
+        auto it = snodes.find(snodePubKey);
+        if (it == snodes.end())
+            return;
+        for (const auto & utxo : it->second->getCollateral()) {
+            auto cit = collateralSnodes.find(utxo);
+            if (cit != collateralSnodes.end() && cit->second == snodePubKey) {
+                collateralSnodes.erase(cit);
+                validCollateral.erase(utxo);
+            }
+        }
+        snodes.erase(it);
+    }
+
+    /**
+     * Removes existing snodes, other than the specified snode, that match its
+     * collateral utxos. Requires mu.
+     * @param snode
+     */
+    void removeSnWithCollateralLocked(const ServiceNode & snode) {
+        for (const auto & utxo : snode.getCollateral()) {
+            auto it = collateralSnodes.find(utxo);
+            if (it == collateralSnodes.end() || it->second == snode.getSnodePubKey())
+                continue; // exclude specified snode
+            const CPubKey pubkey = it->second; // copy, eraseSn invalidates the iterator
+            eraseSn(pubkey);
+        }
+    }
+
     /**
      * Records when the last known block was received.
      */
@@ -1182,7 +1319,7 @@ protected:
             if (snode.isNull())
                 continue; // skip snodes we don't know about
 
-            if (!snode.getInvalid() && snode.isValid(GetTxFunc, IsServiceNodeBlockValidFunc))
+            if (!snode.getInvalid() && snode.isValid(collateralFunc(), IsServiceNodeBlockValidFunc))
                 continue; // skip valid snodes
 
             // At this point we want to try and re-register any snodes that are marked
@@ -1224,32 +1361,74 @@ protected:
         }
 
         // Check that existing snodes are valid
+        std::vector<ServiceNodePtr> revalidate;
         {
             LOCK(mu);
-            for (auto & item : snodes) {
-                auto snode = item.second;
-                for (const auto & collateral : snode->getCollateral()) {
-                    if (spent.count(collateral)) {
-                        snode->markInvalid(true, blockNumber);
-                        break;
-                    }
+            if (connected) {
+                // Only collateral spent in this block is evicted from the cache. Spent
+                // collateral is kept for the grace period.
+                for (const auto & out : spent) {
+                    auto it = validCollateral.find(out);
+                    if (it == validCollateral.end())
+                        continue;
+                    spentCollateral[out] = std::make_pair(it->second, blockNumber);
+                    validCollateral.erase(it);
                 }
-                // Re-validate snodes on potential reorg (on block disconnected)
-                if (!connected) {
-                    snode->markInvalid(false); // reset state before is valid check
-                    snode->markInvalid(!snode->isValid(GetTxFunc, IsServiceNodeBlockValidFunc));
+                for (auto it = spentCollateral.begin(); it != spentCollateral.end(); ) {
+                    if (blockNumber - it->second.second >= ServiceNode::VALID_GRACEPERIOD_BLOCKS)
+                        it = spentCollateral.erase(it);
+                    else
+                        ++it;
                 }
+                collateralBlock = block->GetHash();
+            } else {
+                // Disconnected blocks restore spent utxos, clear the cache
+                validCollateral.clear();
+                spentCollateral.clear();
+                collateralBlock = block->hashPrevBlock;
+            }
+
+            // Only the block's spent utxos are checked against the collateral index
+            for (const auto & out : spent) {
+                auto it = collateralSnodes.find(out);
+                if (it == collateralSnodes.end())
+                    continue;
+                auto snode = snodes.find(it->second);
+                if (snode != snodes.end())
+                    snode->second->markInvalid(true, blockNumber);
+            }
+
+            if (!connected) {
+                for (auto & item : snodes)
+                    revalidate.push_back(item.second);
+            }
+        }
+
+        // Re-validate snodes on potential reorg (on block disconnected)
+        for (auto & snode : revalidate) {
+            ServiceNode s = *snode;
+            s.markInvalid(false); // reset state before is valid check
+            const bool valid = s.isValid(collateralFunc(), IsServiceNodeBlockValidFunc);
+            {
+                LOCK(mu);
+                snode->markInvalid(!valid);
             }
+            if (valid)
+                cacheCollateral(s);
         }
     }
 
 protected:
     Mutex mu;
     std::map<CPubKey, ServiceNodePtr> snodes;
+    std::unordered_map<COutPoint, CPubKey, SaltedOutpointHasher> collateralSnodes; // collateral utxo -> snode
     std::unordered_map<CPubKey, ServiceNodePing, Hasher> pings;
-    std::set<uint256> seenPackets;
+    CRollingBloomFilter seenPackets{DEFAULT_SEEN_PACKETS, DEFAULT_SEEN_PACKETS_FPRATE};
     std::set<ServiceNodeConfigEntry> snodeEntries;
     std::vector<int> seenBlocks;
+    std::unordered_map<COutPoint, CTxOut, SaltedOutpointHasher> validCollateral;
+    std::unordered_map<COutPoint, std::pair<CTxOut, int>, SaltedOutpointHasher> spentCollateral;
+    uint256 collateralBlock;
 };
 
 }
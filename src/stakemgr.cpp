@@ -12,6 +12,8 @@
 #include <timedata.h>
 #include <validation.h>
 
+#include <array>
+
 std::unique_ptr<StakeMgr> g_staker;
 
 void ThreadStakeMinter() {
@@ -88,19 +90,60 @@ bool StakeMgr::Update(std::vector<std::shared_ptr<CWallet>> & wallets, const CBl
     // Always search for stake from last block time if the tip changed
     lastUpdateTime = tipChanged ? tip->GetBlockTime() + 1 : lastUpdateTime + 1;
 
-    // Cache all possible stakes between last update and few seconds into the future
-    for (const auto & item : selected) {
-        boost::this_thread::interruption_point();
-        const auto out = item.out;
-        auto wallet = item.wallet;
-        std::map<int64_t, std::vector<StakeCoin>> stakes;
-        const int64_t adjustedTime = GetAdjustedTime();
-        const auto blockTime = std::max(tip->GetBlockTime()+1, adjustedTime);
-        if (!GetStakesMeetingTarget(out, wallet, tip, adjustedTime, blockTime, lastUpdateTime, endTime, stakes, params))
-            continue;
-        if (!stakes.empty()) {
-            LOCK(mu);
-            stakeTimes.insert(stakes.begin(), stakes.end());
+    // Look up the stake block of all coins at once instead of locking cs_main for each coin
+    std::vector<const CBlockIndex*> stakeIndexes(selected.size(), nullptr);
+    {
+        LOCK(cs_main);
+        for (size_t i = 0; i < selected.size(); ++i)
+            stakeIndexes[i] = LookupBlockIndex(selected[i].out->tx->hashBlock);
+    }
+
+    // Cache all possible stakes between last update and few seconds into the future.
+    // Coins are partitioned across the staking threads, each thread collects stakes
+    // into its own buffer which are merged once all threads complete.
+    const auto argThreads = static_cast<int>(gArgs.GetArg("-stakingthreads", DEFAULT_STAKINGTHREADS));
+    const auto nthreads = static_cast<size_t>(std::max(1, std::min(argThreads <= 0 ? GetNumCores() : argThreads,
+                                                                   static_cast<int>(selected.size()))));
+    std::vector<std::map<int64_t, std::vector<StakeCoin>>> threadStakes(nthreads);
+    const auto updateTime = lastUpdateTime.load();
+    auto searchCoins = [&](const size_t & thread) {
+        auto & stakes = threadStakes[thread];
+        for (size_t i = thread; i < selected.size(); i += nthreads) {
+            boost::this_thread::interruption_point();
+            if (!stakeIndexes[i])
+                continue; // skip txs with block that can't be found
+            auto wallet = selected[i].wallet;
+            const int64_t adjustedTime = GetAdjustedTime();
+            const auto blockTime = std::max(tip->GetBlockTime()+1, adjustedTime);
+            GetStakesMeetingTarget(selected[i].out, wallet, tip, stakeIndexes[i], adjustedTime, blockTime, updateTime,
+                                   endTime, stakes, params);
+        }
+    };
+
+    if (nthreads == 1) {
+        searchCoins(0);
+    } else {
+        boost::thread_group workers;
+        for (size_t t = 0; t < nthreads; ++t)
+            workers.create_thread([&searchCoins, t]() { searchCoins(t); });
+        try {
+            workers.join_all();
+        } catch (boost::thread_interrupted &) {
+            // Workers reference local state, stop them before unwinding
+            boost::this_thread::disable_interruption di;
+            workers.interrupt_all();
+            workers.join_all();
+            throw;
+        }
+    }
+
+    {
+        LOCK(mu);
+        for (auto & stakes : threadStakes) {
+            for (auto & item : stakes) {
+                auto & v = stakeTimes[item.first];
+                v.insert(v.end(), item.second.begin(), item.second.end());
+            }
         }
     }
 
@@ -238,9 +281,6 @@ bool StakeMgr::GetStakesMeetingTarget(const std::shared_ptr<COutput> & coin, std
         const CBlockIndex *tip, const int64_t & adjustedTime, const int64_t & blockTime, const int64_t & fromTime,
         const int64_t & toTime, std::map<int64_t, std::vector<StakeCoin>> & stakes, const Consensus::Params & params)
 {
-    if (fromTime - coin->tx->GetTxTime() < params.stakeMinAge) // skip coins that don't meet stake age
-        return false;
-
     CBlockIndex *pindexStake = nullptr;
     {
         LOCK(cs_main);
@@ -249,6 +289,17 @@ bool StakeMgr::GetStakesMeetingTarget(const std::shared_ptr<COutput> & coin, std
             return false; // skip txs with block that can't be found
     }
 
+    return GetStakesMeetingTarget(coin, wallet, tip, pindexStake, adjustedTime, blockTime, fromTime, toTime, stakes, params);
+}
+
+bool StakeMgr::GetStakesMeetingTarget(const std::shared_ptr<COutput> & coin, std::shared_ptr<CWallet> & wallet,
+        const CBlockIndex *tip, const CBlockIndex *pindexStake, const int64_t & adjustedTime, const int64_t & blockTime,
+        const int64_t & fromTime, const int64_t & toTime, std::map<int64_t, std::vector<StakeCoin>> & stakes,
+        const Consensus::Params & params)
+{
+    if (fromTime - coin->tx->GetTxTime() < params.stakeMinAge) // skip coins that don't meet stake age
+        return false;
+
     const auto stakeHeight = tip->nHeight + 1;
     const int hashBlockTime = pindexStake->GetBlockTime();
     const auto & txInBlockHash = pindexStake->GetBlockHash();
@@ -261,31 +312,34 @@ bool StakeMgr::GetStakesMeetingTarget(const std::shared_ptr<COutput> & coin, std
         if (blockTime - params.stakeMinAge <= hashBlockTime) // valid modifier time check
             return false;
 
-        int64_t i = fromTime;
-        for (; i < toTime; ++i) {
-            if (i - txTime < params.stakeMinAge)
-                continue; // skip coins that don't meet stake age
-            uint64_t stakeModifier{0};
-            int stakeModifierHeight{0};
-            int64_t stakeModifierTime{0};
-            if (!GetKernelStakeModifier(tip, pindexStake, blockTime, stakeModifier, stakeModifierHeight, stakeModifierTime))
-                continue;
-
-            CDataStream ss(SER_GETHASH, 0);
-            ss << stakeModifier;
+        // The stake modifier only depends on the block time, it's the same for all timestamps
+        uint64_t stakeModifier{0};
+        int stakeModifierHeight{0};
+        int64_t stakeModifierTime{0};
+        if (!GetKernelStakeModifier(tip, pindexStake, blockTime, stakeModifier, stakeModifierHeight, stakeModifierTime))
+            return true;
 
-            uint256 hashProofOfStake;
-            if (IsProtocolV06(blockTime, params)) {
-                hashProofOfStake = stakeHashV06(ss, txInBlockHash, hashBlockTime, stakeHeight, coin->i, i);
-                if (!stakeTargetHitV06(hashProofOfStake, coin->GetInputCoin().txout.nValue, bnTargetPerCoinDay))
-                    continue;
-            } else {
-                hashProofOfStake = stakeHashV05(ss, hashBlockTime, stakeHeight, coin->i, i);
-                if (!stakeTargetHit(hashProofOfStake, coin->GetInputCoin().txout.nValue, bnTargetPerCoinDay))
-                    continue;
+        const bool v06 = IsProtocolV06(blockTime, params);
+        const auto hasher = v06 ? StakeKernelHasher(stakeModifier, txInBlockHash, hashBlockTime, stakeHeight, coin->i)
+                                : StakeKernelHasher(stakeModifier, hashBlockTime, stakeHeight, coin->i);
+        const auto & nValue = coin->GetInputCoin().txout.nValue;
+        const auto bnTarget = v06 ? stakeTargetV06(nValue, bnTargetPerCoinDay) : stakeTarget(nValue, bnTargetPerCoinDay);
+
+        // Hash the timestamps in batches, skip timestamps that don't meet stake age
+        std::array<uint256, StakeKernelHasher::BATCH_SIZE> hashes;
+        for (int64_t i = std::max(fromTime, txTime + params.stakeMinAge); i < toTime; i += hashes.size()) {
+            const auto count = static_cast<size_t>(std::min<int64_t>(hashes.size(), toTime - i));
+            hasher.HashBatch(static_cast<unsigned int>(i), count, hashes.data());
+            size_t n = 0;
+            for (; n < count; ++n) {
+                if (UintToArith256(hashes[n]) < bnTarget)
+                    break;
             }
-            stakes[i].emplace_back(std::make_shared<CInputCoin>(coin->GetInputCoin()), wallet, i,
-                    blockTime, txInBlockHash, hashBlockTime, hashProofOfStake);
+            if (n == count)
+                continue;
+            const int64_t stakeTime = i + n;
+            stakes[stakeTime].emplace_back(std::make_shared<CInputCoin>(coin->GetInputCoin()), wallet, stakeTime,
+                    blockTime, txInBlockHash, hashBlockTime, hashes[n]);
             break;
         }
     } else {
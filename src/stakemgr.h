@@ -15,6 +15,9 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/thread.hpp>
 
+/** Default number of threads used to search for stakes (0 = number of cores) */
+static const int DEFAULT_STAKINGTHREADS = 1;
+
 class StakeMgr {
 public:
     struct StakeCoin {
@@ -89,6 +92,10 @@ public:
     bool GetStakesMeetingTarget(const std::shared_ptr<COutput> & coin, std::shared_ptr<CWallet> & wallet,
         const CBlockIndex *tip, const int64_t & adjustedTime, const int64_t & blockTime, const int64_t & fromTime,
         const int64_t & toTime, std::map<int64_t, std::vector<StakeCoin>> & stakes, const Consensus::Params & params);
+    bool GetStakesMeetingTarget(const std::shared_ptr<COutput> & coin, std::shared_ptr<CWallet> & wallet,
+        const CBlockIndex *tip, const CBlockIndex *pindexStake, const int64_t & adjustedTime, const int64_t & blockTime,
+        const int64_t & fromTime, const int64_t & toTime, std::map<int64_t, std::vector<StakeCoin>> & stakes,
+        const Consensus::Params & params);
 
 private:
     bool HasStakeModifier(const uint256 & blockHash) {
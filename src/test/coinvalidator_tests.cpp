@@ -0,0 +1,43 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coinvalidator.h>
+#include <test/test_bitcoin.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(coinvalidator_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(coinvalidator_isvalid)
+{
+    const uint256 bad = uint256S("00c0a0a887c2663e563494bd87f0ce279698d3e4f60fa3c5c39893f7fce8c336");
+    auto& validator = CoinValidator::instance();
+    validator.Clear();
+    BOOST_CHECK(validator.IsCoinValid(bad));
+
+    BOOST_CHECK(validator.LoadStatic());
+    BOOST_CHECK(validator.IsLoaded());
+    BOOST_CHECK(!validator.IsCoinValid(bad));
+    BOOST_CHECK(!validator.IsCoinValid(bad.ToString()));
+    BOOST_CHECK_EQUAL(validator.GetInfractions(bad).size(), 1);
+
+    // Txids that are not infractions, including txids passing the prefilter
+    for (int i = 0; i < 10000; ++i)
+        BOOST_CHECK(validator.IsCoinValid(InsecureRand256()));
+    uint256 filtered = bad;
+    *filtered.begin() ^= 1;
+    BOOST_CHECK(validator.IsCoinValid(filtered));
+    *filtered.begin() ^= 1;
+    *(filtered.end() - 1) ^= 1;
+    BOOST_CHECK(validator.IsCoinValid(filtered));
+
+    // Looking up infractions doesn't add the txid
+    BOOST_CHECK(validator.GetInfractions(filtered).empty());
+    BOOST_CHECK(validator.IsCoinValid(filtered.ToString()));
+
+    validator.Clear();
+    BOOST_CHECK(validator.IsCoinValid(bad));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,2076 @@
+namespace json_tests{
+static unsigned const char blockfilters[] = {
+0x5b, 0x0a, 0x5b, 0x22, 0x42, 0x6c, 0x6f, 0x63, 
+0x6b, 0x20, 0x48, 0x65, 0x69, 0x67, 0x68, 0x74, 
+0x2c, 0x42, 0x6c, 0x6f, 0x63, 0x6b, 0x20, 0x48, 
+0x61, 0x73, 0x68, 0x2c, 0x42, 0x6c, 0x6f, 0x63, 
+0x6b, 0x2c, 0x5b, 0x50, 0x72, 0x65, 0x76, 0x20, 
+0x4f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x20, 0x53, 
+0x63, 0x72, 0x69, 0x70, 0x74, 0x73, 0x20, 0x66, 
+0x6f, 0x72, 0x20, 0x42, 0x6c, 0x6f, 0x63, 0x6b, 
+0x5d, 0x2c, 0x50, 0x72, 0x65, 0x76, 0x69, 0x6f, 
+0x75, 0x73, 0x20, 0x42, 0x61, 0x73, 0x69, 0x63, 
+0x20, 0x48, 0x65, 0x61, 0x64, 0x65, 0x72, 0x2c, 
+0x42, 0x61, 0x73, 0x69, 0x63, 0x20, 0x46, 0x69, 
+0x6c, 0x74, 0x65, 0x72, 0x2c, 0x42, 0x61, 0x73, 
+0x69, 0x63, 0x20, 0x48, 0x65, 0x61, 0x64, 0x65, 
+0x72, 0x2c, 0x4e, 0x6f, 0x74, 0x65, 0x73, 0x22, 
+0x5d, 0x2c, 0x0a, 0x5b, 0x30, 0x2c, 0x22, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x39, 0x33, 0x33, 0x65, 0x61, 0x30, 0x31, 0x61, 
+0x64, 0x30, 0x65, 0x65, 0x39, 0x38, 0x34, 0x32, 
+0x30, 0x39, 0x37, 0x37, 0x39, 0x62, 0x61, 0x61, 
+0x65, 0x63, 0x33, 0x63, 0x65, 0x64, 0x39, 0x30, 
+0x66, 0x61, 0x33, 0x66, 0x34, 0x30, 0x38, 0x37, 
+0x31, 0x39, 0x35, 0x32, 0x36, 0x66, 0x38, 0x64, 
+0x37, 0x37, 0x66, 0x34, 0x39, 0x34, 0x33, 0x22, 
+0x2c, 0x22, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x33, 0x62, 0x61, 0x33, 0x65, 0x64, 
+0x66, 0x64, 0x37, 0x61, 0x37, 0x62, 0x31, 0x32, 
+0x62, 0x32, 0x37, 0x61, 0x63, 0x37, 0x32, 0x63, 
+0x33, 0x65, 0x36, 0x37, 0x37, 0x36, 0x38, 0x66, 
+0x36, 0x31, 0x37, 0x66, 0x63, 0x38, 0x31, 0x62, 
+0x63, 0x33, 0x38, 0x38, 0x38, 0x61, 0x35, 0x31, 
+0x33, 0x32, 0x33, 0x61, 0x39, 0x66, 0x62, 0x38, 
+0x61, 0x61, 0x34, 0x62, 0x31, 0x65, 0x35, 0x65, 
+0x34, 0x61, 0x64, 0x61, 0x65, 0x35, 0x34, 0x39, 
+0x34, 0x64, 0x66, 0x66, 0x66, 0x66, 0x30, 0x30, 
+0x31, 0x64, 0x31, 0x61, 0x61, 0x34, 0x61, 0x65, 
+0x31, 0x38, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x34, 0x64, 
+0x30, 0x34, 0x66, 0x66, 0x66, 0x66, 0x30, 0x30, 
+0x31, 0x64, 0x30, 0x31, 0x30, 0x34, 0x34, 0x35, 
+0x35, 0x34, 0x36, 0x38, 0x36, 0x35, 0x32, 0x30, 
+0x35, 0x34, 0x36, 0x39, 0x36, 0x64, 0x36, 0x35, 
+0x37, 0x33, 0x32, 0x30, 0x33, 0x30, 0x33, 0x33, 
+0x32, 0x66, 0x34, 0x61, 0x36, 0x31, 0x36, 0x65, 
+0x32, 0x66, 0x33, 0x32, 0x33, 0x30, 0x33, 0x30, 
+0x33, 0x39, 0x32, 0x30, 0x34, 0x33, 0x36, 0x38, 
+0x36, 0x31, 0x36, 0x65, 0x36, 0x33, 0x36, 0x35, 
+0x36, 0x63, 0x36, 0x63, 0x36, 0x66, 0x37, 0x32, 
+0x32, 0x30, 0x36, 0x66, 0x36, 0x65, 0x32, 0x30, 
+0x36, 0x32, 0x37, 0x32, 0x36, 0x39, 0x36, 0x65, 
+0x36, 0x62, 0x32, 0x30, 0x36, 0x66, 0x36, 0x36, 
+0x32, 0x30, 0x37, 0x33, 0x36, 0x35, 0x36, 0x33, 
+0x36, 0x66, 0x36, 0x65, 0x36, 0x34, 0x32, 0x30, 
+0x36, 0x32, 0x36, 0x31, 0x36, 0x39, 0x36, 0x63, 
+0x36, 0x66, 0x37, 0x35, 0x37, 0x34, 0x32, 0x30, 
+0x36, 0x36, 0x36, 0x66, 0x37, 0x32, 0x32, 0x30, 
+0x36, 0x32, 0x36, 0x31, 0x36, 0x65, 0x36, 0x62, 
+0x37, 0x33, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x30, 0x31, 0x30, 0x30, 0x66, 0x32, 
+0x30, 0x35, 0x32, 0x61, 0x30, 0x31, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x34, 0x33, 0x34, 0x31, 
+0x30, 0x34, 0x36, 0x37, 0x38, 0x61, 0x66, 0x64, 
+0x62, 0x30, 0x66, 0x65, 0x35, 0x35, 0x34, 0x38, 
+0x32, 0x37, 0x31, 0x39, 0x36, 0x37, 0x66, 0x31, 
+0x61, 0x36, 0x37, 0x31, 0x33, 0x30, 0x62, 0x37, 
+0x31, 0x30, 0x35, 0x63, 0x64, 0x36, 0x61, 0x38, 
+0x32, 0x38, 0x65, 0x30, 0x33, 0x39, 0x30, 0x39, 
+0x61, 0x36, 0x37, 0x39, 0x36, 0x32, 0x65, 0x30, 
+0x65, 0x61, 0x31, 0x66, 0x36, 0x31, 0x64, 0x65, 
+0x62, 0x36, 0x34, 0x39, 0x66, 0x36, 0x62, 0x63, 
+0x33, 0x66, 0x34, 0x63, 0x65, 0x66, 0x33, 0x38, 
+0x63, 0x34, 0x66, 0x33, 0x35, 0x35, 0x30, 0x34, 
+0x65, 0x35, 0x31, 0x65, 0x63, 0x31, 0x31, 0x32, 
+0x64, 0x65, 0x35, 0x63, 0x33, 0x38, 0x34, 0x64, 
+0x66, 0x37, 0x62, 0x61, 0x30, 0x62, 0x38, 0x64, 
+0x35, 0x37, 0x38, 0x61, 0x34, 0x63, 0x37, 0x30, 
+0x32, 0x62, 0x36, 0x62, 0x66, 0x31, 0x31, 0x64, 
+0x35, 0x66, 0x61, 0x63, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x22, 0x2c, 0x5b, 0x5d, 
+0x2c, 0x22, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x22, 0x2c, 0x22, 0x30, 0x31, 0x39, 
+0x64, 0x66, 0x63, 0x61, 0x38, 0x22, 0x2c, 0x22, 
+0x32, 0x31, 0x35, 0x38, 0x34, 0x35, 0x37, 0x39, 
+0x62, 0x37, 0x65, 0x62, 0x30, 0x38, 0x39, 0x39, 
+0x37, 0x37, 0x37, 0x33, 0x65, 0x35, 0x61, 0x65, 
+0x66, 0x66, 0x33, 0x61, 0x37, 0x66, 0x39, 0x33, 
+0x32, 0x37, 0x30, 0x30, 0x30, 0x34, 0x32, 0x64, 
+0x30, 0x65, 0x64, 0x32, 0x61, 0x36, 0x31, 0x32, 
+0x39, 0x30, 0x31, 0x32, 0x62, 0x37, 0x64, 0x37, 
+0x61, 0x65, 0x38, 0x31, 0x62, 0x37, 0x35, 0x30, 
+0x22, 0x2c, 0x22, 0x47, 0x65, 0x6e, 0x65, 0x73, 
+0x69, 0x73, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 
+0x22, 0x5d, 0x2c, 0x0a, 0x5b, 0x32, 0x2c, 0x22, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x36, 0x63, 0x30, 0x32, 0x63, 0x38, 0x65, 0x61, 
+0x36, 0x65, 0x34, 0x66, 0x66, 0x36, 0x39, 0x36, 
+0x35, 0x31, 0x66, 0x37, 0x66, 0x63, 0x64, 0x65, 
+0x33, 0x34, 0x38, 0x66, 0x62, 0x39, 0x64, 0x35, 
+0x35, 0x37, 0x61, 0x30, 0x36, 0x65, 0x36, 0x39, 
+0x35, 0x37, 0x62, 0x36, 0x35, 0x35, 0x35, 0x32, 
+0x30, 0x30, 0x32, 0x61, 0x37, 0x38, 0x32, 0x30, 
+0x22, 0x2c, 0x22, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x36, 0x31, 0x32, 0x38, 
+0x65, 0x38, 0x37, 0x62, 0x65, 0x38, 0x62, 0x31, 
+0x62, 0x34, 0x64, 0x65, 0x61, 0x34, 0x37, 0x61, 
+0x37, 0x32, 0x34, 0x37, 0x64, 0x35, 0x35, 0x32, 
+0x38, 0x64, 0x32, 0x37, 0x30, 0x32, 0x63, 0x39, 
+0x36, 0x38, 0x32, 0x36, 0x63, 0x37, 0x61, 0x36, 
+0x34, 0x38, 0x34, 0x39, 0x37, 0x65, 0x37, 0x37, 
+0x33, 0x62, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x65, 0x32, 0x34, 0x31, 0x33, 
+0x35, 0x32, 0x65, 0x33, 0x62, 0x65, 0x63, 0x30, 
+0x61, 0x39, 0x35, 0x61, 0x36, 0x32, 0x31, 0x37, 
+0x65, 0x31, 0x30, 0x63, 0x33, 0x61, 0x62, 0x62, 
+0x35, 0x34, 0x61, 0x64, 0x66, 0x61, 0x30, 0x35, 
+0x61, 0x62, 0x62, 0x31, 0x32, 0x63, 0x31, 0x32, 
+0x36, 0x36, 0x39, 0x35, 0x35, 0x39, 0x35, 0x35, 
+0x38, 0x30, 0x66, 0x62, 0x39, 0x32, 0x65, 0x32, 
+0x32, 0x32, 0x30, 0x33, 0x32, 0x65, 0x37, 0x34, 
+0x39, 0x34, 0x64, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x30, 0x31, 0x64, 0x30, 0x30, 0x64, 0x32, 0x33, 
+0x35, 0x33, 0x34, 0x30, 0x31, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x65, 0x30, 0x34, 0x33, 0x32, 0x65, 0x37, 0x34, 
+0x39, 0x34, 0x64, 0x30, 0x31, 0x30, 0x65, 0x30, 
+0x36, 0x32, 0x66, 0x35, 0x30, 0x33, 0x32, 0x35, 
+0x33, 0x34, 0x38, 0x32, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 0x31, 0x30, 
+0x30, 0x66, 0x32, 0x30, 0x35, 0x32, 0x61, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 
+0x33, 0x32, 0x31, 0x30, 0x33, 0x38, 0x61, 0x37, 
+0x66, 0x36, 0x65, 0x66, 0x31, 0x63, 0x38, 0x63, 
+0x61, 0x30, 0x63, 0x35, 0x38, 0x38, 0x61, 0x61, 
+0x35, 0x33, 0x66, 0x61, 0x38, 0x36, 0x30, 0x31, 
+0x32, 0x38, 0x30, 0x37, 0x37, 0x63, 0x39, 0x65, 
+0x36, 0x63, 0x31, 0x31, 0x65, 0x36, 0x38, 0x33, 
+0x30, 0x66, 0x34, 0x64, 0x37, 0x65, 0x65, 0x34, 
+0x65, 0x37, 0x36, 0x33, 0x61, 0x35, 0x36, 0x62, 
+0x37, 0x37, 0x31, 0x38, 0x66, 0x61, 0x63, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x22, 
+0x2c, 0x5b, 0x5d, 0x2c, 0x22, 0x64, 0x37, 0x62, 
+0x64, 0x61, 0x63, 0x31, 0x33, 0x61, 0x35, 0x39, 
+0x64, 0x37, 0x34, 0x35, 0x62, 0x31, 0x61, 0x64, 
+0x64, 0x30, 0x64, 0x32, 0x63, 0x65, 0x38, 0x35, 
+0x32, 0x66, 0x31, 0x61, 0x30, 0x34, 0x34, 0x32, 
+0x65, 0x38, 0x39, 0x34, 0x35, 0x66, 0x63, 0x31, 
+0x62, 0x66, 0x33, 0x38, 0x34, 0x38, 0x64, 0x33, 
+0x63, 0x62, 0x66, 0x66, 0x64, 0x38, 0x38, 0x63, 
+0x32, 0x34, 0x66, 0x65, 0x31, 0x22, 0x2c, 0x22, 
+0x30, 0x31, 0x37, 0x34, 0x61, 0x31, 0x37, 0x30, 
+0x22, 0x2c, 0x22, 0x31, 0x38, 0x36, 0x61, 0x66, 
+0x64, 0x31, 0x31, 0x65, 0x66, 0x32, 0x62, 0x35, 
+0x65, 0x37, 0x65, 0x33, 0x35, 0x30, 0x34, 0x66, 
+0x32, 0x65, 0x38, 0x63, 0x62, 0x66, 0x38, 0x64, 
+0x66, 0x32, 0x38, 0x61, 0x31, 0x66, 0x64, 0x32, 
+0x35, 0x31, 0x66, 0x65, 0x35, 0x33, 0x64, 0x36, 
+0x30, 0x64, 0x66, 0x66, 0x38, 0x62, 0x31, 0x34, 
+0x36, 0x37, 0x64, 0x31, 0x62, 0x33, 0x38, 0x36, 
+0x63, 0x66, 0x30, 0x22, 0x2c, 0x22, 0x22, 0x5d, 
+0x2c, 0x0a, 0x5b, 0x33, 0x2c, 0x22, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x38, 0x62, 
+0x38, 0x39, 0x36, 0x65, 0x32, 0x37, 0x32, 0x37, 
+0x35, 0x38, 0x64, 0x61, 0x35, 0x32, 0x39, 0x37, 
+0x62, 0x63, 0x64, 0x39, 0x38, 0x66, 0x64, 0x63, 
+0x36, 0x64, 0x39, 0x37, 0x63, 0x39, 0x62, 0x37, 
+0x36, 0x35, 0x65, 0x63, 0x65, 0x63, 0x34, 0x30, 
+0x31, 0x65, 0x32, 0x38, 0x36, 0x64, 0x63, 0x31, 
+0x66, 0x64, 0x62, 0x65, 0x31, 0x30, 0x22, 0x2c, 
+0x22, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x32, 0x30, 0x37, 0x38, 0x32, 0x61, 0x30, 
+0x30, 0x35, 0x32, 0x35, 0x35, 0x62, 0x36, 0x35, 
+0x37, 0x36, 0x39, 0x36, 0x65, 0x61, 0x30, 0x35, 
+0x37, 0x64, 0x35, 0x62, 0x39, 0x38, 0x66, 0x33, 
+0x34, 0x64, 0x65, 0x66, 0x63, 0x66, 0x37, 0x35, 
+0x31, 0x39, 0x36, 0x66, 0x36, 0x34, 0x66, 0x36, 
+0x65, 0x65, 0x61, 0x63, 0x38, 0x30, 0x32, 0x36, 
+0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x34, 0x31, 0x62, 0x61, 0x35, 0x61, 0x66, 
+0x63, 0x35, 0x33, 0x32, 0x61, 0x61, 0x65, 0x30, 
+0x33, 0x31, 0x35, 0x31, 0x62, 0x38, 0x61, 0x61, 
+0x38, 0x37, 0x62, 0x36, 0x35, 0x65, 0x31, 0x35, 
+0x39, 0x34, 0x66, 0x39, 0x37, 0x35, 0x30, 0x34, 
+0x61, 0x37, 0x36, 0x38, 0x65, 0x30, 0x31, 0x30, 
+0x63, 0x39, 0x38, 0x63, 0x30, 0x61, 0x64, 0x64, 
+0x37, 0x39, 0x32, 0x31, 0x36, 0x32, 0x34, 0x37, 
+0x31, 0x38, 0x36, 0x65, 0x37, 0x34, 0x39, 0x34, 
+0x64, 0x66, 0x66, 0x66, 0x66, 0x30, 0x30, 0x31, 
+0x64, 0x30, 0x35, 0x38, 0x64, 0x63, 0x32, 0x62, 
+0x36, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 0x65, 0x30, 
+0x34, 0x38, 0x36, 0x65, 0x37, 0x34, 0x39, 0x34, 
+0x64, 0x30, 0x31, 0x35, 0x31, 0x30, 0x36, 0x32, 
+0x66, 0x35, 0x30, 0x33, 0x32, 0x35, 0x33, 0x34, 
+0x38, 0x32, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x30, 0x31, 0x30, 0x30, 0x66, 
+0x32, 0x30, 0x35, 0x32, 0x61, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 0x33, 0x32, 
+0x31, 0x30, 0x33, 0x66, 0x36, 0x64, 0x39, 0x66, 
+0x66, 0x34, 0x63, 0x31, 0x32, 0x39, 0x35, 0x39, 
+0x34, 0x34, 0x35, 0x63, 0x61, 0x35, 0x35, 0x34, 
+0x39, 0x63, 0x38, 0x31, 0x31, 0x36, 0x38, 0x33, 
+0x62, 0x66, 0x39, 0x63, 0x38, 0x38, 0x65, 0x36, 
+0x33, 0x37, 0x62, 0x32, 0x32, 0x32, 0x64, 0x64, 
+0x32, 0x65, 0x30, 0x33, 0x31, 0x31, 0x31, 0x35, 
+0x34, 0x63, 0x34, 0x63, 0x38, 0x35, 0x63, 0x66, 
+0x34, 0x32, 0x33, 0x61, 0x63, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x22, 0x2c, 0x5b, 
+0x5d, 0x2c, 0x22, 0x31, 0x38, 0x36, 0x61, 0x66, 
+0x64, 0x31, 0x31, 0x65, 0x66, 0x32, 0x62, 0x35, 
+0x65, 0x37, 0x65, 0x33, 0x35, 0x30, 0x34, 0x66, 
+0x32, 0x65, 0x38, 0x63, 0x62, 0x66, 0x38, 0x64, 
+0x66, 0x32, 0x38, 0x61, 0x31, 0x66, 0x64, 0x32, 
+0x35, 0x31, 0x66, 0x65, 0x35, 0x33, 0x64, 0x36, 
+0x30, 0x64, 0x66, 0x66, 0x38, 0x62, 0x31, 0x34, 
+0x36, 0x37, 0x64, 0x31, 0x62, 0x33, 0x38, 0x36, 
+0x63, 0x66, 0x30, 0x22, 0x2c, 0x22, 0x30, 0x31, 
+0x36, 0x63, 0x66, 0x37, 0x61, 0x30, 0x22, 0x2c, 
+0x22, 0x38, 0x64, 0x36, 0x33, 0x61, 0x61, 0x64, 
+0x66, 0x35, 0x61, 0x62, 0x37, 0x32, 0x35, 0x37, 
+0x63, 0x62, 0x36, 0x64, 0x32, 0x33, 0x31, 0x36, 
+0x61, 0x35, 0x37, 0x62, 0x31, 0x36, 0x66, 0x35, 
+0x31, 0x37, 0x62, 0x66, 0x66, 0x31, 0x63, 0x36, 
+0x33, 0x38, 0x38, 0x66, 0x31, 0x32, 0x34, 0x65, 
+0x63, 0x34, 0x63, 0x30, 0x34, 0x61, 0x66, 0x31, 
+0x32, 0x31, 0x32, 0x37, 0x32, 0x39, 0x64, 0x32, 
+0x61, 0x22, 0x2c, 0x22, 0x22, 0x5d, 0x2c, 0x0a, 
+0x5b, 0x34, 0x39, 0x32, 0x39, 0x31, 0x2c, 0x22, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x38, 0x62, 0x30, 0x37, 0x64, 0x63, 0x61, 
+0x31, 0x62, 0x32, 0x38, 0x62, 0x34, 0x62, 0x35, 
+0x61, 0x31, 0x31, 0x39, 0x66, 0x36, 0x64, 0x36, 
+0x65, 0x37, 0x31, 0x36, 0x39, 0x38, 0x63, 0x65, 
+0x31, 0x65, 0x64, 0x39, 0x36, 0x66, 0x31, 0x34, 
+0x33, 0x66, 0x35, 0x34, 0x31, 0x37, 0x39, 0x63, 
+0x65, 0x31, 0x37, 0x37, 0x61, 0x31, 0x39, 0x63, 
+0x22, 0x2c, 0x22, 0x30, 0x32, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x61, 0x62, 0x66, 0x61, 0x66, 
+0x34, 0x37, 0x32, 0x37, 0x34, 0x32, 0x32, 0x33, 
+0x63, 0x61, 0x32, 0x66, 0x65, 0x61, 0x32, 0x32, 
+0x37, 0x39, 0x37, 0x65, 0x34, 0x34, 0x34, 0x39, 
+0x38, 0x32, 0x34, 0x30, 0x65, 0x34, 0x38, 0x32, 
+0x63, 0x62, 0x34, 0x63, 0x32, 0x66, 0x32, 0x62, 
+0x61, 0x65, 0x61, 0x30, 0x38, 0x38, 0x39, 0x36, 
+0x32, 0x66, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x36, 0x30, 0x34, 0x62, 0x35, 
+0x62, 0x35, 0x32, 0x63, 0x33, 0x32, 0x33, 0x30, 
+0x35, 0x62, 0x31, 0x35, 0x64, 0x37, 0x35, 0x34, 
+0x32, 0x30, 0x37, 0x31, 0x64, 0x38, 0x62, 0x30, 
+0x34, 0x65, 0x37, 0x35, 0x30, 0x61, 0x35, 0x34, 
+0x37, 0x35, 0x30, 0x30, 0x30, 0x30, 0x35, 0x64, 
+0x34, 0x30, 0x31, 0x30, 0x37, 0x32, 0x37, 0x36, 
+0x39, 0x34, 0x62, 0x36, 0x65, 0x37, 0x32, 0x61, 
+0x37, 0x37, 0x36, 0x65, 0x35, 0x35, 0x64, 0x30, 
+0x64, 0x35, 0x31, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x30, 0x31, 0x64, 0x32, 0x31, 0x31, 0x38, 0x30, 
+0x36, 0x34, 0x38, 0x30, 0x32, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x64, 0x30, 0x33, 0x38, 0x62, 0x63, 0x30, 0x30, 
+0x30, 0x30, 0x31, 0x30, 0x32, 0x30, 0x36, 0x32, 
+0x66, 0x35, 0x30, 0x33, 0x32, 0x35, 0x33, 0x34, 
+0x38, 0x32, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x30, 0x31, 0x61, 0x30, 0x37, 
+0x38, 0x30, 0x37, 0x32, 0x61, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 0x33, 0x32, 
+0x31, 0x30, 0x32, 0x39, 0x37, 0x31, 0x64, 0x64, 
+0x36, 0x30, 0x33, 0x34, 0x65, 0x64, 0x30, 0x63, 
+0x66, 0x35, 0x32, 0x34, 0x35, 0x30, 0x62, 0x36, 
+0x30, 0x38, 0x64, 0x31, 0x39, 0x36, 0x63, 0x30, 
+0x37, 0x64, 0x36, 0x33, 0x34, 0x35, 0x31, 0x38, 
+0x34, 0x66, 0x63, 0x62, 0x31, 0x34, 0x64, 0x65, 
+0x62, 0x32, 0x37, 0x37, 0x61, 0x36, 0x62, 0x38, 
+0x32, 0x64, 0x35, 0x32, 0x36, 0x61, 0x36, 0x31, 
+0x36, 0x33, 0x64, 0x61, 0x63, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x38, 0x31, 
+0x63, 0x65, 0x66, 0x64, 0x39, 0x36, 0x30, 0x36, 
+0x30, 0x65, 0x63, 0x62, 0x31, 0x63, 0x34, 0x66, 
+0x62, 0x65, 0x36, 0x37, 0x35, 0x61, 0x64, 0x38, 
+0x61, 0x34, 0x66, 0x38, 0x62, 0x64, 0x63, 0x36, 
+0x31, 0x64, 0x36, 0x33, 0x34, 0x63, 0x35, 0x32, 
+0x62, 0x33, 0x61, 0x31, 0x63, 0x34, 0x31, 0x31, 
+0x36, 0x64, 0x65, 0x65, 0x32, 0x33, 0x37, 0x34, 
+0x39, 0x66, 0x65, 0x38, 0x30, 0x66, 0x66, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x39, 
+0x33, 0x30, 0x30, 0x34, 0x39, 0x33, 0x30, 0x34, 
+0x36, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x38, 
+0x36, 0x36, 0x38, 0x35, 0x39, 0x63, 0x32, 0x31, 
+0x66, 0x33, 0x30, 0x36, 0x35, 0x33, 0x38, 0x31, 
+0x35, 0x32, 0x65, 0x38, 0x33, 0x66, 0x31, 0x31, 
+0x35, 0x62, 0x63, 0x66, 0x62, 0x66, 0x35, 0x39, 
+0x61, 0x62, 0x34, 0x62, 0x62, 0x33, 0x34, 0x38, 
+0x38, 0x37, 0x61, 0x38, 0x38, 0x63, 0x30, 0x33, 
+0x34, 0x38, 0x33, 0x61, 0x35, 0x64, 0x66, 0x66, 
+0x39, 0x38, 0x39, 0x35, 0x66, 0x39, 0x36, 0x30, 
+0x32, 0x32, 0x31, 0x30, 0x30, 0x61, 0x36, 0x64, 
+0x66, 0x64, 0x38, 0x33, 0x63, 0x61, 0x61, 0x36, 
+0x30, 0x39, 0x62, 0x66, 0x30, 0x35, 0x31, 0x36, 
+0x64, 0x65, 0x62, 0x63, 0x32, 0x62, 0x66, 0x36, 
+0x35, 0x63, 0x33, 0x64, 0x66, 0x39, 0x31, 0x38, 
+0x31, 0x33, 0x61, 0x34, 0x38, 0x34, 0x32, 0x36, 
+0x35, 0x30, 0x61, 0x31, 0x38, 0x35, 0x38, 0x62, 
+0x33, 0x66, 0x36, 0x31, 0x63, 0x66, 0x61, 0x38, 
+0x61, 0x66, 0x32, 0x34, 0x39, 0x30, 0x31, 0x34, 
+0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 
+0x30, 0x32, 0x39, 0x36, 0x64, 0x34, 0x62, 0x38, 
+0x31, 0x38, 0x62, 0x62, 0x30, 0x33, 0x37, 0x64, 
+0x30, 0x66, 0x38, 0x33, 0x66, 0x39, 0x66, 0x37, 
+0x31, 0x31, 0x31, 0x36, 0x36, 0x35, 0x66, 0x34, 
+0x39, 0x35, 0x33, 0x32, 0x64, 0x66, 0x64, 0x63, 
+0x62, 0x65, 0x63, 0x31, 0x65, 0x36, 0x62, 0x37, 
+0x38, 0x34, 0x35, 0x32, 0x36, 0x65, 0x39, 0x61, 
+0x63, 0x34, 0x30, 0x34, 0x36, 0x65, 0x61, 0x61, 
+0x36, 0x30, 0x32, 0x32, 0x30, 0x34, 0x61, 0x63, 
+0x66, 0x33, 0x61, 0x35, 0x63, 0x62, 0x32, 0x36, 
+0x39, 0x35, 0x65, 0x38, 0x34, 0x30, 0x34, 0x64, 
+0x38, 0x30, 0x62, 0x66, 0x34, 0x39, 0x61, 0x62, 
+0x30, 0x34, 0x38, 0x32, 0x38, 0x62, 0x63, 0x62, 
+0x65, 0x36, 0x66, 0x63, 0x33, 0x31, 0x64, 0x32, 
+0x35, 0x61, 0x32, 0x38, 0x34, 0x34, 0x63, 0x65, 
+0x64, 0x37, 0x61, 0x38, 0x64, 0x32, 0x34, 0x61, 
+0x66, 0x62, 0x64, 0x66, 0x66, 0x30, 0x31, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x31, 
+0x63, 0x65, 0x66, 0x64, 0x39, 0x36, 0x30, 0x36, 
+0x30, 0x65, 0x63, 0x62, 0x31, 0x63, 0x34, 0x66, 
+0x62, 0x65, 0x36, 0x37, 0x35, 0x61, 0x64, 0x38, 
+0x61, 0x34, 0x66, 0x38, 0x62, 0x64, 0x63, 0x36, 
+0x31, 0x64, 0x36, 0x33, 0x34, 0x63, 0x35, 0x32, 
+0x62, 0x33, 0x61, 0x31, 0x63, 0x34, 0x31, 0x31, 
+0x36, 0x64, 0x65, 0x65, 0x32, 0x33, 0x37, 0x34, 
+0x39, 0x66, 0x65, 0x38, 0x30, 0x66, 0x66, 0x30, 
+0x32, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x39, 
+0x34, 0x30, 0x30, 0x34, 0x38, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x65, 
+0x38, 0x37, 0x38, 0x39, 0x39, 0x31, 0x37, 0x35, 
+0x39, 0x39, 0x31, 0x61, 0x61, 0x30, 0x30, 0x38, 
+0x31, 0x37, 0x36, 0x63, 0x62, 0x35, 0x35, 0x33, 
+0x63, 0x36, 0x66, 0x32, 0x62, 0x61, 0x64, 0x62, 
+0x62, 0x35, 0x62, 0x37, 0x34, 0x31, 0x66, 0x33, 
+0x32, 0x38, 0x63, 0x39, 0x38, 0x34, 0x35, 0x66, 
+0x63, 0x61, 0x62, 0x38, 0x39, 0x66, 0x38, 0x62, 
+0x31, 0x38, 0x63, 0x61, 0x65, 0x32, 0x33, 0x30, 
+0x32, 0x32, 0x30, 0x30, 0x61, 0x63, 0x63, 0x65, 
+0x36, 0x38, 0x39, 0x38, 0x39, 0x36, 0x64, 0x63, 
+0x38, 0x32, 0x39, 0x33, 0x33, 0x30, 0x31, 0x35, 
+0x65, 0x37, 0x32, 0x33, 0x30, 0x65, 0x35, 0x32, 
+0x33, 0x30, 0x64, 0x35, 0x63, 0x66, 0x66, 0x38, 
+0x61, 0x31, 0x66, 0x66, 0x65, 0x38, 0x32, 0x64, 
+0x33, 0x33, 0x34, 0x64, 0x36, 0x30, 0x31, 0x36, 
+0x32, 0x61, 0x63, 0x32, 0x63, 0x35, 0x62, 0x30, 
+0x63, 0x39, 0x36, 0x30, 0x31, 0x34, 0x39, 0x33, 
+0x30, 0x34, 0x36, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x39, 0x39, 0x34, 0x61, 0x64, 0x32, 0x39, 
+0x64, 0x31, 0x65, 0x37, 0x62, 0x30, 0x33, 0x65, 
+0x34, 0x31, 0x37, 0x33, 0x31, 0x61, 0x34, 0x33, 
+0x31, 0x36, 0x65, 0x35, 0x66, 0x34, 0x39, 0x39, 
+0x32, 0x66, 0x30, 0x64, 0x39, 0x62, 0x36, 0x65, 
+0x32, 0x65, 0x66, 0x63, 0x34, 0x30, 0x61, 0x31, 
+0x63, 0x63, 0x64, 0x32, 0x63, 0x39, 0x34, 0x39, 
+0x62, 0x34, 0x36, 0x31, 0x31, 0x37, 0x35, 0x63, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x39, 
+0x39, 0x62, 0x36, 0x39, 0x66, 0x64, 0x63, 0x32, 
+0x64, 0x62, 0x30, 0x30, 0x66, 0x62, 0x62, 0x61, 
+0x32, 0x31, 0x34, 0x66, 0x31, 0x36, 0x65, 0x32, 
+0x38, 0x36, 0x66, 0x36, 0x61, 0x34, 0x39, 0x65, 
+0x32, 0x64, 0x38, 0x61, 0x30, 0x64, 0x35, 0x66, 
+0x66, 0x63, 0x36, 0x34, 0x30, 0x39, 0x64, 0x38, 
+0x37, 0x37, 0x39, 0x36, 0x61, 0x64, 0x64, 0x34, 
+0x37, 0x35, 0x34, 0x37, 0x38, 0x64, 0x36, 0x30, 
+0x31, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x31, 0x65, 0x34, 0x61, 0x36, 0x64, 0x32, 
+0x64, 0x32, 0x38, 0x30, 0x65, 0x61, 0x30, 0x36, 
+0x36, 0x38, 0x30, 0x64, 0x36, 0x63, 0x66, 0x38, 
+0x37, 0x38, 0x38, 0x61, 0x63, 0x39, 0x30, 0x33, 
+0x34, 0x34, 0x61, 0x39, 0x63, 0x36, 0x37, 0x63, 
+0x63, 0x61, 0x39, 0x62, 0x30, 0x36, 0x30, 0x30, 
+0x35, 0x62, 0x62, 0x64, 0x36, 0x64, 0x33, 0x66, 
+0x36, 0x39, 0x34, 0x35, 0x63, 0x38, 0x32, 0x37, 
+0x32, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x39, 0x35, 0x30, 0x30, 0x34, 0x39, 0x33, 
+0x30, 0x34, 0x36, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x61, 0x32, 0x37, 0x34, 0x30, 0x30, 0x62, 
+0x61, 0x35, 0x32, 0x66, 0x64, 0x38, 0x34, 0x32, 
+0x63, 0x65, 0x30, 0x37, 0x33, 0x39, 0x38, 0x61, 
+0x31, 0x64, 0x65, 0x31, 0x30, 0x32, 0x66, 0x37, 
+0x31, 0x30, 0x61, 0x31, 0x30, 0x63, 0x35, 0x35, 
+0x39, 0x39, 0x35, 0x34, 0x35, 0x65, 0x36, 0x63, 
+0x39, 0x35, 0x37, 0x39, 0x38, 0x39, 0x33, 0x34, 
+0x33, 0x35, 0x32, 0x63, 0x32, 0x65, 0x34, 0x64, 
+0x66, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x66, 
+0x36, 0x33, 0x38, 0x33, 0x62, 0x30, 0x62, 0x31, 
+0x34, 0x63, 0x39, 0x66, 0x36, 0x34, 0x62, 0x36, 
+0x37, 0x31, 0x38, 0x31, 0x33, 0x39, 0x66, 0x35, 
+0x35, 0x62, 0x36, 0x62, 0x39, 0x34, 0x39, 0x34, 
+0x33, 0x37, 0x34, 0x37, 0x35, 0x35, 0x62, 0x38, 
+0x36, 0x62, 0x61, 0x65, 0x37, 0x64, 0x36, 0x33, 
+0x66, 0x35, 0x64, 0x33, 0x65, 0x35, 0x38, 0x33, 
+0x62, 0x35, 0x37, 0x32, 0x35, 0x35, 0x61, 0x30, 
+0x31, 0x34, 0x39, 0x33, 0x30, 0x34, 0x36, 0x30, 
+0x32, 0x32, 0x31, 0x30, 0x30, 0x66, 0x64, 0x66, 
+0x35, 0x34, 0x33, 0x32, 0x39, 0x32, 0x66, 0x33, 
+0x34, 0x65, 0x31, 0x65, 0x65, 0x62, 0x31, 0x37, 
+0x30, 0x33, 0x62, 0x32, 0x36, 0x34, 0x39, 0x36, 
+0x35, 0x33, 0x33, 0x39, 0x65, 0x63, 0x34, 0x61, 
+0x34, 0x35, 0x30, 0x65, 0x63, 0x34, 0x37, 0x35, 
+0x38, 0x35, 0x30, 0x30, 0x39, 0x63, 0x36, 0x30, 
+0x36, 0x62, 0x33, 0x65, 0x64, 0x62, 0x63, 0x35, 
+0x62, 0x36, 0x31, 0x37, 0x62, 0x30, 0x32, 0x32, 
+0x31, 0x30, 0x30, 0x61, 0x35, 0x66, 0x62, 0x62, 
+0x31, 0x63, 0x38, 0x64, 0x65, 0x38, 0x61, 0x61, 
+0x61, 0x61, 0x35, 0x38, 0x32, 0x39, 0x38, 0x38, 
+0x63, 0x64, 0x62, 0x32, 0x33, 0x36, 0x32, 0x32, 
+0x38, 0x33, 0x38, 0x65, 0x33, 0x38, 0x64, 0x65, 
+0x39, 0x30, 0x62, 0x65, 0x62, 0x63, 0x61, 0x61, 
+0x62, 0x33, 0x39, 0x32, 0x38, 0x64, 0x39, 0x34, 
+0x39, 0x61, 0x61, 0x35, 0x30, 0x32, 0x61, 0x36, 
+0x35, 0x64, 0x34, 0x30, 0x31, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x31, 0x65, 0x34, 
+0x61, 0x36, 0x64, 0x32, 0x64, 0x32, 0x38, 0x30, 
+0x65, 0x61, 0x30, 0x36, 0x36, 0x38, 0x30, 0x64, 
+0x36, 0x63, 0x66, 0x38, 0x37, 0x38, 0x38, 0x61, 
+0x63, 0x39, 0x30, 0x33, 0x34, 0x34, 0x61, 0x39, 
+0x63, 0x36, 0x37, 0x63, 0x63, 0x61, 0x39, 0x62, 
+0x30, 0x36, 0x30, 0x30, 0x35, 0x62, 0x62, 0x64, 
+0x36, 0x64, 0x33, 0x66, 0x36, 0x39, 0x34, 0x35, 
+0x63, 0x38, 0x32, 0x37, 0x32, 0x30, 0x32, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x39, 0x34, 0x30, 
+0x30, 0x34, 0x39, 0x33, 0x30, 0x34, 0x36, 0x30, 
+0x32, 0x32, 0x31, 0x30, 0x30, 0x61, 0x63, 0x36, 
+0x32, 0x36, 0x61, 0x63, 0x33, 0x30, 0x35, 0x31, 
+0x66, 0x38, 0x37, 0x35, 0x31, 0x34, 0x35, 0x62, 
+0x34, 0x66, 0x65, 0x34, 0x63, 0x66, 0x65, 0x30, 
+0x38, 0x39, 0x65, 0x61, 0x38, 0x39, 0x35, 0x61, 
+0x61, 0x63, 0x37, 0x33, 0x66, 0x36, 0x35, 0x61, 
+0x62, 0x38, 0x33, 0x37, 0x62, 0x31, 0x61, 0x63, 
+0x33, 0x30, 0x66, 0x35, 0x64, 0x38, 0x37, 0x35, 
+0x38, 0x37, 0x34, 0x66, 0x61, 0x30, 0x32, 0x32, 
+0x31, 0x30, 0x30, 0x62, 0x63, 0x30, 0x33, 0x65, 
+0x37, 0x39, 0x66, 0x61, 0x34, 0x62, 0x37, 0x65, 
+0x62, 0x37, 0x30, 0x37, 0x66, 0x62, 0x37, 0x33, 
+0x35, 0x62, 0x39, 0x35, 0x66, 0x66, 0x36, 0x36, 
+0x31, 0x33, 0x63, 0x61, 0x33, 0x33, 0x61, 0x64, 
+0x65, 0x61, 0x66, 0x33, 0x61, 0x30, 0x36, 0x30, 
+0x37, 0x63, 0x64, 0x63, 0x65, 0x61, 0x64, 0x34, 
+0x63, 0x66, 0x64, 0x33, 0x62, 0x35, 0x31, 0x37, 
+0x32, 0x39, 0x38, 0x30, 0x31, 0x34, 0x38, 0x33, 
+0x30, 0x34, 0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x62, 0x37, 0x32, 0x30, 0x62, 0x30, 0x34, 
+0x61, 0x35, 0x63, 0x35, 0x65, 0x32, 0x66, 0x36, 
+0x31, 0x62, 0x37, 0x64, 0x66, 0x30, 0x66, 0x63, 
+0x66, 0x33, 0x33, 0x34, 0x61, 0x62, 0x36, 0x66, 
+0x65, 0x61, 0x31, 0x36, 0x37, 0x62, 0x37, 0x61, 
+0x61, 0x65, 0x64, 0x65, 0x35, 0x36, 0x39, 0x35, 
+0x64, 0x33, 0x66, 0x37, 0x63, 0x36, 0x39, 0x37, 
+0x33, 0x34, 0x39, 0x36, 0x61, 0x64, 0x62, 0x66, 
+0x31, 0x30, 0x32, 0x32, 0x30, 0x34, 0x33, 0x33, 
+0x32, 0x38, 0x63, 0x34, 0x63, 0x63, 0x31, 0x63, 
+0x64, 0x63, 0x33, 0x65, 0x35, 0x64, 0x62, 0x37, 
+0x62, 0x62, 0x38, 0x39, 0x35, 0x63, 0x63, 0x63, 
+0x33, 0x37, 0x31, 0x33, 0x33, 0x65, 0x39, 0x36, 
+0x30, 0x62, 0x32, 0x66, 0x64, 0x33, 0x65, 0x63, 
+0x65, 0x39, 0x38, 0x33, 0x35, 0x30, 0x66, 0x37, 
+0x37, 0x34, 0x35, 0x39, 0x36, 0x62, 0x61, 0x64, 
+0x62, 0x33, 0x38, 0x37, 0x32, 0x30, 0x31, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x32, 
+0x33, 0x61, 0x38, 0x37, 0x33, 0x33, 0x65, 0x33, 
+0x34, 0x39, 0x63, 0x39, 0x37, 0x64, 0x36, 0x63, 
+0x64, 0x39, 0x30, 0x66, 0x35, 0x32, 0x30, 0x66, 
+0x64, 0x64, 0x30, 0x38, 0x34, 0x62, 0x61, 0x31, 
+0x35, 0x63, 0x65, 0x30, 0x61, 0x33, 0x39, 0x35, 
+0x61, 0x61, 0x64, 0x30, 0x33, 0x63, 0x64, 0x35, 
+0x31, 0x33, 0x37, 0x30, 0x36, 0x30, 0x32, 0x62, 
+0x62, 0x39, 0x65, 0x35, 0x64, 0x62, 0x33, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x34, 
+0x61, 0x30, 0x30, 0x34, 0x38, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x65, 
+0x38, 0x35, 0x35, 0x36, 0x62, 0x37, 0x32, 0x63, 
+0x35, 0x65, 0x39, 0x63, 0x30, 0x64, 0x61, 0x37, 
+0x33, 0x37, 0x31, 0x39, 0x31, 0x33, 0x61, 0x34, 
+0x35, 0x38, 0x36, 0x31, 0x61, 0x36, 0x31, 0x63, 
+0x35, 0x64, 0x66, 0x34, 0x33, 0x34, 0x64, 0x66, 
+0x64, 0x39, 0x36, 0x32, 0x64, 0x65, 0x37, 0x62, 
+0x32, 0x33, 0x38, 0x34, 0x38, 0x65, 0x31, 0x61, 
+0x32, 0x38, 0x63, 0x38, 0x36, 0x63, 0x61, 0x30, 
+0x32, 0x32, 0x30, 0x35, 0x64, 0x34, 0x31, 0x63, 
+0x65, 0x64, 0x61, 0x30, 0x30, 0x31, 0x33, 0x36, 
+0x32, 0x36, 0x37, 0x32, 0x38, 0x31, 0x62, 0x65, 
+0x30, 0x39, 0x37, 0x34, 0x62, 0x65, 0x31, 0x33, 
+0x32, 0x61, 0x63, 0x34, 0x63, 0x64, 0x61, 0x31, 
+0x34, 0x35, 0x39, 0x66, 0x65, 0x32, 0x30, 0x39, 
+0x30, 0x63, 0x65, 0x34, 0x35, 0x35, 0x36, 0x31, 
+0x39, 0x64, 0x38, 0x62, 0x39, 0x31, 0x30, 0x34, 
+0x35, 0x65, 0x39, 0x30, 0x31, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x36, 0x38, 0x35, 
+0x36, 0x64, 0x36, 0x30, 0x39, 0x62, 0x38, 0x38, 
+0x31, 0x65, 0x38, 0x37, 0x35, 0x61, 0x35, 0x65, 
+0x65, 0x31, 0x34, 0x31, 0x63, 0x32, 0x33, 0x35, 
+0x65, 0x32, 0x61, 0x38, 0x32, 0x66, 0x36, 0x62, 
+0x30, 0x33, 0x39, 0x66, 0x32, 0x62, 0x39, 0x62, 
+0x61, 0x62, 0x65, 0x38, 0x32, 0x33, 0x33, 0x33, 
+0x36, 0x37, 0x37, 0x61, 0x35, 0x35, 0x37, 0x30, 
+0x32, 0x38, 0x35, 0x61, 0x36, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 0x61, 0x34, 
+0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 
+0x30, 0x34, 0x30, 0x61, 0x31, 0x63, 0x36, 0x33, 
+0x31, 0x35, 0x35, 0x34, 0x62, 0x38, 0x62, 0x32, 
+0x31, 0x30, 0x66, 0x62, 0x64, 0x66, 0x32, 0x61, 
+0x37, 0x33, 0x66, 0x31, 0x39, 0x31, 0x62, 0x32, 
+0x38, 0x35, 0x31, 0x61, 0x66, 0x62, 0x35, 0x31, 
+0x64, 0x35, 0x31, 0x37, 0x31, 0x66, 0x62, 0x35, 
+0x33, 0x35, 0x30, 0x32, 0x61, 0x33, 0x61, 0x30, 
+0x34, 0x30, 0x61, 0x33, 0x38, 0x64, 0x32, 0x63, 
+0x30, 0x30, 0x32, 0x32, 0x30, 0x34, 0x30, 0x64, 
+0x31, 0x31, 0x63, 0x66, 0x36, 0x65, 0x37, 0x62, 
+0x34, 0x31, 0x66, 0x65, 0x31, 0x62, 0x36, 0x36, 
+0x63, 0x33, 0x64, 0x30, 0x38, 0x66, 0x36, 0x61, 
+0x64, 0x61, 0x31, 0x61, 0x65, 0x65, 0x30, 0x37, 
+0x61, 0x30, 0x34, 0x37, 0x63, 0x62, 0x37, 0x37, 
+0x66, 0x32, 0x34, 0x32, 0x62, 0x38, 0x65, 0x63, 
+0x63, 0x36, 0x33, 0x38, 0x31, 0x32, 0x63, 0x38, 
+0x33, 0x32, 0x63, 0x39, 0x61, 0x30, 0x31, 0x32, 
+0x31, 0x30, 0x32, 0x62, 0x63, 0x66, 0x61, 0x64, 
+0x39, 0x33, 0x31, 0x62, 0x35, 0x30, 0x32, 0x37, 
+0x36, 0x31, 0x65, 0x34, 0x35, 0x32, 0x39, 0x36, 
+0x32, 0x61, 0x35, 0x39, 0x37, 0x36, 0x63, 0x37, 
+0x39, 0x31, 0x35, 0x38, 0x61, 0x30, 0x66, 0x36, 
+0x64, 0x33, 0x30, 0x37, 0x61, 0x64, 0x33, 0x31, 
+0x62, 0x37, 0x33, 0x39, 0x36, 0x31, 0x31, 0x64, 
+0x61, 0x63, 0x36, 0x61, 0x32, 0x39, 0x37, 0x63, 
+0x32, 0x35, 0x36, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x36, 0x38, 0x35, 0x36, 0x64, 
+0x36, 0x30, 0x39, 0x62, 0x38, 0x38, 0x31, 0x65, 
+0x38, 0x37, 0x35, 0x61, 0x35, 0x65, 0x65, 0x31, 
+0x34, 0x31, 0x63, 0x32, 0x33, 0x35, 0x65, 0x32, 
+0x61, 0x38, 0x32, 0x66, 0x36, 0x62, 0x30, 0x33, 
+0x39, 0x66, 0x32, 0x62, 0x39, 0x62, 0x61, 0x62, 
+0x65, 0x38, 0x32, 0x33, 0x33, 0x33, 0x36, 0x37, 
+0x37, 0x61, 0x35, 0x35, 0x37, 0x30, 0x32, 0x38, 
+0x35, 0x61, 0x36, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x39, 0x33, 0x30, 0x30, 0x34, 
+0x38, 0x33, 0x30, 0x34, 0x35, 0x30, 0x32, 0x32, 
+0x30, 0x35, 0x62, 0x31, 0x30, 0x39, 0x64, 0x66, 
+0x30, 0x39, 0x38, 0x66, 0x37, 0x65, 0x39, 0x33, 
+0x32, 0x66, 0x62, 0x66, 0x37, 0x31, 0x61, 0x34, 
+0x35, 0x38, 0x36, 0x39, 0x63, 0x33, 0x66, 0x38, 
+0x30, 0x33, 0x32, 0x33, 0x39, 0x37, 0x34, 0x61, 
+0x38, 0x32, 0x36, 0x65, 0x65, 0x32, 0x37, 0x37, 
+0x30, 0x37, 0x38, 0x39, 0x65, 0x61, 0x65, 0x31, 
+0x37, 0x38, 0x61, 0x32, 0x31, 0x62, 0x66, 0x63, 
+0x38, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x63, 
+0x30, 0x65, 0x37, 0x35, 0x36, 0x31, 0x35, 0x65, 
+0x35, 0x33, 0x65, 0x65, 0x34, 0x62, 0x36, 0x65, 
+0x33, 0x32, 0x62, 0x39, 0x62, 0x62, 0x35, 0x66, 
+0x61, 0x61, 0x33, 0x36, 0x61, 0x63, 0x35, 0x33, 
+0x39, 0x65, 0x39, 0x63, 0x30, 0x35, 0x66, 0x61, 
+0x32, 0x61, 0x65, 0x36, 0x62, 0x36, 0x64, 0x65, 
+0x35, 0x64, 0x30, 0x39, 0x63, 0x30, 0x38, 0x34, 
+0x35, 0x35, 0x63, 0x38, 0x62, 0x39, 0x36, 0x30, 
+0x31, 0x34, 0x38, 0x33, 0x30, 0x34, 0x35, 0x30, 
+0x32, 0x32, 0x30, 0x30, 0x39, 0x66, 0x62, 0x37, 
+0x64, 0x32, 0x37, 0x33, 0x37, 0x35, 0x63, 0x34, 
+0x37, 0x62, 0x65, 0x61, 0x32, 0x33, 0x62, 0x32, 
+0x34, 0x38, 0x31, 0x38, 0x36, 0x33, 0x34, 0x64, 
+0x66, 0x36, 0x61, 0x35, 0x34, 0x65, 0x63, 0x66, 
+0x37, 0x32, 0x64, 0x35, 0x32, 0x65, 0x30, 0x63, 
+0x31, 0x32, 0x36, 0x38, 0x66, 0x62, 0x32, 0x61, 
+0x32, 0x63, 0x38, 0x34, 0x66, 0x31, 0x38, 0x38, 
+0x35, 0x64, 0x65, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x65, 0x30, 0x65, 0x64, 0x34, 0x66, 0x31, 
+0x35, 0x64, 0x36, 0x32, 0x65, 0x37, 0x66, 0x35, 
+0x33, 0x37, 0x64, 0x61, 0x30, 0x64, 0x30, 0x66, 
+0x31, 0x38, 0x36, 0x33, 0x34, 0x39, 0x38, 0x66, 
+0x39, 0x63, 0x37, 0x63, 0x30, 0x63, 0x30, 0x61, 
+0x34, 0x65, 0x30, 0x30, 0x65, 0x34, 0x36, 0x37, 
+0x39, 0x35, 0x38, 0x38, 0x63, 0x38, 0x64, 0x31, 
+0x61, 0x39, 0x65, 0x62, 0x32, 0x30, 0x62, 0x62, 
+0x38, 0x30, 0x31, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x61, 0x35, 0x36, 0x33, 0x63, 
+0x33, 0x37, 0x32, 0x32, 0x62, 0x37, 0x62, 0x33, 
+0x39, 0x34, 0x38, 0x31, 0x38, 0x33, 0x36, 0x64, 
+0x35, 0x65, 0x64, 0x66, 0x63, 0x31, 0x34, 0x36, 
+0x31, 0x66, 0x39, 0x37, 0x33, 0x33, 0x35, 0x64, 
+0x35, 0x64, 0x31, 0x65, 0x39, 0x61, 0x32, 0x33, 
+0x61, 0x64, 0x65, 0x31, 0x33, 0x36, 0x38, 0x30, 
+0x64, 0x30, 0x65, 0x32, 0x63, 0x31, 0x63, 0x33, 
+0x37, 0x31, 0x66, 0x30, 0x33, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x36, 0x63, 0x34, 0x39, 0x33, 
+0x30, 0x34, 0x36, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x65, 0x63, 0x63, 0x33, 0x38, 0x61, 0x65, 
+0x32, 0x62, 0x31, 0x35, 0x36, 0x35, 0x36, 0x34, 
+0x33, 0x64, 0x63, 0x33, 0x63, 0x30, 0x64, 0x61, 
+0x64, 0x35, 0x65, 0x39, 0x36, 0x31, 0x61, 0x35, 
+0x66, 0x30, 0x65, 0x61, 0x30, 0x39, 0x63, 0x61, 
+0x62, 0x32, 0x38, 0x64, 0x30, 0x32, 0x34, 0x66, 
+0x39, 0x32, 0x66, 0x61, 0x30, 0x35, 0x63, 0x39, 
+0x32, 0x32, 0x39, 0x32, 0x34, 0x31, 0x35, 0x37, 
+0x65, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x65, 
+0x62, 0x63, 0x31, 0x36, 0x36, 0x65, 0x64, 0x66, 
+0x36, 0x66, 0x62, 0x65, 0x34, 0x30, 0x30, 0x34, 
+0x63, 0x37, 0x32, 0x62, 0x66, 0x65, 0x38, 0x63, 
+0x66, 0x34, 0x30, 0x31, 0x33, 0x30, 0x32, 0x36, 
+0x33, 0x66, 0x39, 0x38, 0x64, 0x64, 0x66, 0x66, 
+0x37, 0x32, 0x38, 0x63, 0x38, 0x65, 0x36, 0x37, 
+0x62, 0x31, 0x31, 0x33, 0x64, 0x62, 0x64, 0x36, 
+0x32, 0x31, 0x39, 0x30, 0x36, 0x61, 0x36, 0x30, 
+0x31, 0x32, 0x31, 0x30, 0x32, 0x31, 0x31, 0x61, 
+0x34, 0x65, 0x64, 0x32, 0x34, 0x31, 0x31, 0x37, 
+0x34, 0x37, 0x30, 0x38, 0x63, 0x30, 0x37, 0x32, 
+0x30, 0x36, 0x36, 0x30, 0x31, 0x62, 0x34, 0x34, 
+0x61, 0x34, 0x63, 0x31, 0x63, 0x32, 0x39, 0x65, 
+0x35, 0x61, 0x64, 0x38, 0x62, 0x31, 0x66, 0x37, 
+0x33, 0x31, 0x63, 0x35, 0x30, 0x63, 0x61, 0x37, 
+0x65, 0x31, 0x64, 0x34, 0x62, 0x32, 0x61, 0x30, 
+0x36, 0x64, 0x63, 0x31, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 0x32, 0x64, 
+0x30, 0x32, 0x32, 0x33, 0x61, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x34, 
+0x35, 0x64, 0x62, 0x30, 0x62, 0x37, 0x37, 0x39, 
+0x63, 0x30, 0x62, 0x39, 0x66, 0x61, 0x32, 0x30, 
+0x37, 0x66, 0x31, 0x32, 0x61, 0x38, 0x32, 0x31, 
+0x38, 0x63, 0x39, 0x34, 0x66, 0x63, 0x37, 0x37, 
+0x61, 0x66, 0x66, 0x35, 0x30, 0x34, 0x35, 0x38, 
+0x38, 0x61, 0x63, 0x38, 0x30, 0x66, 0x30, 0x66, 
+0x61, 0x30, 0x32, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x22, 0x2c, 0x5b, 
+0x22, 0x35, 0x32, 0x32, 0x31, 0x30, 0x33, 0x33, 
+0x34, 0x32, 0x33, 0x30, 0x30, 0x37, 0x64, 0x38, 
+0x66, 0x32, 0x36, 0x33, 0x38, 0x31, 0x39, 0x61, 
+0x32, 0x65, 0x34, 0x32, 0x62, 0x65, 0x63, 0x61, 
+0x61, 0x66, 0x35, 0x62, 0x30, 0x36, 0x66, 0x33, 
+0x34, 0x63, 0x62, 0x30, 0x39, 0x39, 0x31, 0x39, 
+0x65, 0x30, 0x36, 0x33, 0x30, 0x34, 0x33, 0x34, 
+0x39, 0x64, 0x39, 0x35, 0x30, 0x36, 0x36, 0x38, 
+0x32, 0x30, 0x39, 0x65, 0x61, 0x65, 0x64, 0x32, 
+0x31, 0x30, 0x32, 0x31, 0x64, 0x36, 0x39, 0x65, 
+0x32, 0x62, 0x36, 0x38, 0x63, 0x33, 0x39, 0x36, 
+0x30, 0x39, 0x30, 0x33, 0x62, 0x37, 0x30, 0x32, 
+0x61, 0x66, 0x37, 0x38, 0x32, 0x39, 0x66, 0x61, 
+0x64, 0x63, 0x64, 0x38, 0x30, 0x62, 0x64, 0x38, 
+0x39, 0x62, 0x31, 0x35, 0x38, 0x31, 0x35, 0x30, 
+0x63, 0x38, 0x35, 0x63, 0x34, 0x61, 0x37, 0x35, 
+0x62, 0x32, 0x63, 0x38, 0x63, 0x62, 0x39, 0x63, 
+0x33, 0x39, 0x34, 0x35, 0x32, 0x61, 0x65, 0x22, 
+0x2c, 0x22, 0x35, 0x32, 0x32, 0x31, 0x30, 0x32, 
+0x37, 0x39, 0x62, 0x65, 0x36, 0x36, 0x37, 0x65, 
+0x66, 0x39, 0x64, 0x63, 0x62, 0x62, 0x61, 0x63, 
+0x35, 0x35, 0x61, 0x30, 0x36, 0x32, 0x39, 0x35, 
+0x63, 0x65, 0x38, 0x37, 0x30, 0x62, 0x30, 0x37, 
+0x30, 0x32, 0x39, 0x62, 0x66, 0x63, 0x64, 0x62, 
+0x32, 0x64, 0x63, 0x65, 0x32, 0x38, 0x64, 0x39, 
+0x35, 0x39, 0x66, 0x32, 0x38, 0x31, 0x35, 0x62, 
+0x31, 0x36, 0x66, 0x38, 0x31, 0x37, 0x39, 0x38, 
+0x32, 0x31, 0x30, 0x32, 0x31, 0x64, 0x36, 0x39, 
+0x65, 0x32, 0x62, 0x36, 0x38, 0x63, 0x33, 0x39, 
+0x36, 0x30, 0x39, 0x30, 0x33, 0x62, 0x37, 0x30, 
+0x32, 0x61, 0x66, 0x37, 0x38, 0x32, 0x39, 0x66, 
+0x61, 0x64, 0x63, 0x64, 0x38, 0x30, 0x62, 0x64, 
+0x38, 0x39, 0x62, 0x31, 0x35, 0x38, 0x31, 0x35, 
+0x30, 0x63, 0x38, 0x35, 0x63, 0x34, 0x61, 0x37, 
+0x35, 0x62, 0x32, 0x63, 0x38, 0x63, 0x62, 0x39, 
+0x63, 0x33, 0x39, 0x34, 0x35, 0x32, 0x61, 0x65, 
+0x22, 0x2c, 0x22, 0x35, 0x32, 0x32, 0x31, 0x30, 
+0x32, 0x61, 0x37, 0x61, 0x65, 0x31, 0x65, 0x30, 
+0x39, 0x37, 0x31, 0x66, 0x63, 0x31, 0x36, 0x38, 
+0x39, 0x62, 0x64, 0x36, 0x36, 0x64, 0x32, 0x61, 
+0x37, 0x32, 0x39, 0x36, 0x64, 0x61, 0x33, 0x61, 
+0x31, 0x36, 0x36, 0x32, 0x66, 0x64, 0x32, 0x31, 
+0x61, 0x35, 0x33, 0x63, 0x39, 0x65, 0x33, 0x38, 
+0x39, 0x37, 0x39, 0x65, 0x30, 0x66, 0x30, 0x39, 
+0x30, 0x61, 0x33, 0x37, 0x35, 0x63, 0x31, 0x32, 
+0x64, 0x32, 0x31, 0x30, 0x32, 0x32, 0x61, 0x64, 
+0x62, 0x36, 0x32, 0x33, 0x33, 0x35, 0x66, 0x34, 
+0x31, 0x65, 0x62, 0x34, 0x65, 0x32, 0x37, 0x30, 
+0x35, 0x36, 0x61, 0x63, 0x33, 0x37, 0x64, 0x34, 
+0x36, 0x32, 0x63, 0x64, 0x61, 0x35, 0x61, 0x64, 
+0x37, 0x38, 0x33, 0x66, 0x61, 0x38, 0x65, 0x30, 
+0x65, 0x35, 0x32, 0x36, 0x65, 0x64, 0x37, 0x39, 
+0x63, 0x37, 0x35, 0x32, 0x34, 0x37, 0x35, 0x64, 
+0x62, 0x32, 0x38, 0x35, 0x64, 0x35, 0x32, 0x61, 
+0x65, 0x22, 0x2c, 0x22, 0x35, 0x32, 0x32, 0x31, 
+0x30, 0x32, 0x37, 0x39, 0x62, 0x65, 0x36, 0x36, 
+0x37, 0x65, 0x66, 0x39, 0x64, 0x63, 0x62, 0x62, 
+0x61, 0x63, 0x35, 0x35, 0x61, 0x30, 0x36, 0x32, 
+0x39, 0x35, 0x63, 0x65, 0x38, 0x37, 0x30, 0x62, 
+0x30, 0x37, 0x30, 0x32, 0x39, 0x62, 0x66, 0x63, 
+0x64, 0x62, 0x32, 0x64, 0x63, 0x65, 0x32, 0x38, 
+0x64, 0x39, 0x35, 0x39, 0x66, 0x32, 0x38, 0x31, 
+0x35, 0x62, 0x31, 0x36, 0x66, 0x38, 0x31, 0x37, 
+0x39, 0x38, 0x32, 0x31, 0x30, 0x32, 0x32, 0x61, 
+0x64, 0x62, 0x36, 0x32, 0x33, 0x33, 0x35, 0x66, 
+0x34, 0x31, 0x65, 0x62, 0x34, 0x65, 0x32, 0x37, 
+0x30, 0x35, 0x36, 0x61, 0x63, 0x33, 0x37, 0x64, 
+0x34, 0x36, 0x32, 0x63, 0x64, 0x61, 0x35, 0x61, 
+0x64, 0x37, 0x38, 0x33, 0x66, 0x61, 0x38, 0x65, 
+0x30, 0x65, 0x35, 0x32, 0x36, 0x65, 0x64, 0x37, 
+0x39, 0x63, 0x37, 0x35, 0x32, 0x34, 0x37, 0x35, 
+0x64, 0x62, 0x32, 0x38, 0x35, 0x64, 0x35, 0x32, 
+0x61, 0x65, 0x22, 0x2c, 0x22, 0x35, 0x31, 0x32, 
+0x31, 0x30, 0x33, 0x62, 0x39, 0x64, 0x31, 0x64, 
+0x30, 0x65, 0x32, 0x62, 0x34, 0x33, 0x35, 0x35, 
+0x65, 0x63, 0x33, 0x63, 0x64, 0x65, 0x66, 0x37, 
+0x63, 0x31, 0x31, 0x61, 0x35, 0x63, 0x30, 0x62, 
+0x65, 0x66, 0x66, 0x39, 0x65, 0x38, 0x62, 0x38, 
+0x64, 0x38, 0x33, 0x37, 0x32, 0x61, 0x62, 0x34, 
+0x62, 0x34, 0x65, 0x30, 0x61, 0x61, 0x66, 0x33, 
+0x30, 0x65, 0x38, 0x30, 0x31, 0x37, 0x33, 0x30, 
+0x30, 0x31, 0x39, 0x35, 0x31, 0x61, 0x65, 0x22, 
+0x2c, 0x22, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 
+0x39, 0x31, 0x34, 0x34, 0x37, 0x36, 0x31, 0x65, 
+0x62, 0x61, 0x63, 0x63, 0x64, 0x35, 0x62, 0x34, 
+0x62, 0x62, 0x64, 0x63, 0x32, 0x61, 0x33, 0x35, 
+0x34, 0x35, 0x33, 0x35, 0x38, 0x35, 0x62, 0x35, 
+0x36, 0x33, 0x37, 0x62, 0x32, 0x66, 0x38, 0x35, 
+0x38, 0x38, 0x61, 0x63, 0x22, 0x2c, 0x22, 0x35, 
+0x32, 0x32, 0x31, 0x30, 0x33, 0x66, 0x31, 0x38, 
+0x34, 0x38, 0x62, 0x34, 0x30, 0x36, 0x32, 0x31, 
+0x63, 0x35, 0x64, 0x34, 0x38, 0x34, 0x37, 0x31, 
+0x64, 0x39, 0x37, 0x38, 0x34, 0x63, 0x38, 0x31, 
+0x37, 0x34, 0x63, 0x61, 0x30, 0x36, 0x30, 0x35, 
+0x35, 0x35, 0x38, 0x39, 0x31, 0x61, 0x63, 0x65, 
+0x36, 0x64, 0x32, 0x62, 0x30, 0x33, 0x63, 0x35, 
+0x38, 0x65, 0x65, 0x63, 0x65, 0x39, 0x34, 0x36, 
+0x62, 0x31, 0x61, 0x39, 0x31, 0x32, 0x31, 0x30, 
+0x32, 0x30, 0x65, 0x65, 0x35, 0x64, 0x33, 0x32, 
+0x62, 0x35, 0x34, 0x64, 0x34, 0x32, 0x39, 0x63, 
+0x31, 0x35, 0x32, 0x66, 0x64, 0x63, 0x37, 0x62, 
+0x31, 0x64, 0x62, 0x38, 0x34, 0x66, 0x32, 0x30, 
+0x37, 0x34, 0x62, 0x30, 0x35, 0x36, 0x34, 0x64, 
+0x33, 0x35, 0x34, 0x30, 0x30, 0x64, 0x38, 0x39, 
+0x64, 0x31, 0x31, 0x38, 0x37, 0x30, 0x66, 0x39, 
+0x32, 0x37, 0x33, 0x65, 0x63, 0x31, 0x34, 0x30, 
+0x63, 0x35, 0x32, 0x61, 0x65, 0x22, 0x2c, 0x22, 
+0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x66, 0x34, 
+0x66, 0x61, 0x31, 0x63, 0x63, 0x37, 0x64, 0x65, 
+0x37, 0x34, 0x32, 0x64, 0x31, 0x33, 0x35, 0x65, 
+0x61, 0x38, 0x32, 0x63, 0x31, 0x37, 0x61, 0x64, 
+0x66, 0x30, 0x62, 0x62, 0x39, 0x63, 0x66, 0x35, 
+0x66, 0x34, 0x66, 0x62, 0x38, 0x33, 0x38, 0x38, 
+0x61, 0x63, 0x22, 0x5d, 0x2c, 0x22, 0x65, 0x64, 
+0x34, 0x37, 0x37, 0x30, 0x35, 0x33, 0x33, 0x34, 
+0x66, 0x34, 0x36, 0x34, 0x33, 0x38, 0x39, 0x32, 
+0x63, 0x61, 0x34, 0x36, 0x33, 0x39, 0x36, 0x65, 
+0x62, 0x33, 0x66, 0x34, 0x31, 0x39, 0x36, 0x61, 
+0x35, 0x65, 0x33, 0x30, 0x38, 0x38, 0x30, 0x35, 
+0x38, 0x39, 0x65, 0x34, 0x30, 0x30, 0x39, 0x65, 
+0x66, 0x33, 0x38, 0x65, 0x61, 0x65, 0x38, 0x39, 
+0x35, 0x64, 0x34, 0x61, 0x31, 0x33, 0x22, 0x2c, 
+0x22, 0x30, 0x61, 0x66, 0x62, 0x63, 0x32, 0x39, 
+0x32, 0x30, 0x61, 0x66, 0x31, 0x62, 0x30, 0x32, 
+0x37, 0x66, 0x33, 0x31, 0x66, 0x38, 0x37, 0x62, 
+0x35, 0x39, 0x32, 0x32, 0x37, 0x36, 0x65, 0x62, 
+0x34, 0x63, 0x33, 0x32, 0x30, 0x39, 0x34, 0x62, 
+0x62, 0x34, 0x64, 0x33, 0x36, 0x39, 0x37, 0x30, 
+0x32, 0x31, 0x62, 0x34, 0x63, 0x36, 0x33, 0x38, 
+0x30, 0x22, 0x2c, 0x22, 0x62, 0x36, 0x64, 0x39, 
+0x38, 0x36, 0x39, 0x32, 0x63, 0x65, 0x63, 0x35, 
+0x31, 0x34, 0x35, 0x66, 0x36, 0x37, 0x35, 0x38, 
+0x35, 0x66, 0x33, 0x34, 0x33, 0x34, 0x65, 0x63, 
+0x33, 0x63, 0x32, 0x62, 0x33, 0x30, 0x33, 0x30, 
+0x31, 0x38, 0x32, 0x65, 0x31, 0x63, 0x62, 0x33, 
+0x65, 0x63, 0x35, 0x38, 0x62, 0x38, 0x35, 0x35, 
+0x63, 0x35, 0x63, 0x31, 0x36, 0x34, 0x64, 0x66, 
+0x61, 0x61, 0x61, 0x33, 0x22, 0x2c, 0x22, 0x54, 
+0x78, 0x20, 0x70, 0x61, 0x79, 0x73, 0x20, 0x74, 
+0x6f, 0x20, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x20, 
+0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x20, 0x73, 
+0x63, 0x72, 0x69, 0x70, 0x74, 0x22, 0x5d, 0x2c, 
+0x0a, 0x5b, 0x31, 0x38, 0x30, 0x34, 0x38, 0x30, 
+0x2c, 0x22, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x66, 0x64, 0x33, 0x63, 0x65, 0x62, 
+0x32, 0x34, 0x30, 0x34, 0x66, 0x66, 0x30, 0x37, 
+0x61, 0x37, 0x38, 0x35, 0x63, 0x37, 0x66, 0x64, 
+0x63, 0x63, 0x37, 0x36, 0x36, 0x31, 0x39, 0x65, 
+0x64, 0x63, 0x38, 0x65, 0x64, 0x36, 0x31, 0x62, 
+0x64, 0x32, 0x35, 0x31, 0x33, 0x34, 0x65, 0x61, 
+0x61, 0x32, 0x32, 0x30, 0x38, 0x34, 0x33, 0x36, 
+0x36, 0x61, 0x22, 0x2c, 0x22, 0x30, 0x32, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 0x30, 0x35, 
+0x38, 0x61, 0x61, 0x30, 0x38, 0x30, 0x61, 0x36, 
+0x35, 0x35, 0x61, 0x61, 0x39, 0x39, 0x31, 0x61, 
+0x34, 0x34, 0x34, 0x62, 0x64, 0x37, 0x64, 0x31, 
+0x66, 0x32, 0x64, 0x65, 0x66, 0x64, 0x39, 0x61, 
+0x33, 0x62, 0x62, 0x65, 0x36, 0x38, 0x61, 0x61, 
+0x62, 0x62, 0x36, 0x39, 0x30, 0x33, 0x30, 0x63, 
+0x66, 0x33, 0x62, 0x34, 0x65, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x64, 0x32, 0x65, 
+0x38, 0x32, 0x36, 0x62, 0x66, 0x64, 0x37, 0x65, 
+0x66, 0x30, 0x62, 0x65, 0x61, 0x61, 0x38, 0x39, 
+0x31, 0x61, 0x37, 0x65, 0x65, 0x64, 0x62, 0x63, 
+0x39, 0x32, 0x63, 0x64, 0x36, 0x61, 0x35, 0x34, 
+0x34, 0x61, 0x36, 0x63, 0x62, 0x36, 0x31, 0x63, 
+0x37, 0x62, 0x64, 0x61, 0x61, 0x34, 0x33, 0x36, 
+0x37, 0x36, 0x32, 0x65, 0x62, 0x32, 0x31, 0x32, 
+0x33, 0x65, 0x66, 0x39, 0x37, 0x39, 0x30, 0x66, 
+0x35, 0x66, 0x35, 0x35, 0x32, 0x66, 0x66, 0x66, 
+0x66, 0x30, 0x30, 0x31, 0x64, 0x30, 0x30, 0x30, 
+0x32, 0x63, 0x39, 0x30, 0x66, 0x30, 0x35, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x30, 0x65, 0x30, 0x33, 0x30, 0x30, 0x63, 
+0x31, 0x30, 0x32, 0x30, 0x32, 0x34, 0x36, 0x30, 
+0x38, 0x30, 0x36, 0x32, 0x66, 0x35, 0x30, 0x33, 
+0x32, 0x35, 0x33, 0x34, 0x38, 0x32, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x31, 0x63, 0x30, 0x63, 0x36, 0x30, 0x37, 0x32, 
+0x61, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x32, 0x33, 0x32, 0x31, 0x30, 0x32, 0x65, 
+0x37, 0x36, 0x39, 0x65, 0x36, 0x30, 0x31, 0x33, 
+0x37, 0x61, 0x34, 0x64, 0x66, 0x36, 0x62, 0x30, 
+0x64, 0x66, 0x38, 0x65, 0x62, 0x64, 0x33, 0x38, 
+0x37, 0x63, 0x63, 0x61, 0x34, 0x34, 0x63, 0x34, 
+0x63, 0x35, 0x37, 0x61, 0x65, 0x37, 0x34, 0x63, 
+0x63, 0x30, 0x31, 0x31, 0x34, 0x61, 0x38, 0x65, 
+0x38, 0x33, 0x31, 0x37, 0x63, 0x38, 0x66, 0x33, 
+0x62, 0x66, 0x64, 0x38, 0x35, 0x65, 0x39, 0x61, 
+0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x33, 0x38, 0x31, 0x61, 0x30, 0x38, 
+0x30, 0x32, 0x39, 0x31, 0x31, 0x61, 0x30, 0x31, 
+0x66, 0x66, 0x62, 0x30, 0x32, 0x35, 0x63, 0x34, 
+0x64, 0x65, 0x61, 0x30, 0x62, 0x63, 0x37, 0x37, 
+0x39, 0x36, 0x33, 0x65, 0x38, 0x63, 0x31, 0x62, 
+0x62, 0x34, 0x36, 0x33, 0x31, 0x33, 0x62, 0x37, 
+0x31, 0x31, 0x36, 0x34, 0x63, 0x35, 0x33, 0x66, 
+0x37, 0x32, 0x66, 0x33, 0x37, 0x66, 0x65, 0x35, 
+0x32, 0x34, 0x38, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x35, 0x31, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x63, 
+0x39, 0x30, 0x34, 0x62, 0x32, 0x36, 0x37, 0x38, 
+0x33, 0x33, 0x64, 0x32, 0x31, 0x35, 0x65, 0x32, 
+0x31, 0x32, 0x38, 0x62, 0x64, 0x39, 0x35, 0x37, 
+0x35, 0x32, 0x34, 0x32, 0x32, 0x33, 0x32, 0x61, 
+0x63, 0x32, 0x62, 0x63, 0x33, 0x31, 0x31, 0x35, 
+0x35, 0x30, 0x63, 0x37, 0x66, 0x63, 0x31, 0x66, 
+0x30, 0x65, 0x66, 0x36, 0x66, 0x32, 0x36, 0x34, 
+0x62, 0x34, 0x30, 0x64, 0x31, 0x34, 0x63, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x35, 0x31, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x64, 0x66, 0x30, 0x39, 0x31, 
+0x35, 0x36, 0x36, 0x36, 0x36, 0x34, 0x39, 0x64, 
+0x62, 0x61, 0x38, 0x31, 0x38, 0x38, 0x36, 0x35, 
+0x31, 0x39, 0x63, 0x35, 0x33, 0x31, 0x36, 0x34, 
+0x39, 0x62, 0x37, 0x62, 0x30, 0x32, 0x31, 0x38, 
+0x30, 0x62, 0x34, 0x61, 0x66, 0x36, 0x37, 0x64, 
+0x36, 0x38, 0x38, 0x35, 0x65, 0x38, 0x37, 0x31, 
+0x32, 0x39, 0x39, 0x65, 0x39, 0x64, 0x35, 0x66, 
+0x37, 0x37, 0x35, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x35, 0x31, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x31, 0x38, 0x30, 0x38, 0x31, 0x37, 0x64, 0x63, 
+0x62, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x32, 0x33, 0x32, 0x31, 0x30, 0x33, 0x62, 
+0x62, 0x35, 0x32, 0x31, 0x33, 0x38, 0x39, 0x37, 
+0x32, 0x63, 0x34, 0x38, 0x61, 0x31, 0x33, 0x32, 
+0x66, 0x63, 0x31, 0x66, 0x36, 0x33, 0x37, 0x38, 
+0x35, 0x38, 0x63, 0x35, 0x31, 0x38, 0x39, 0x36, 
+0x30, 0x37, 0x64, 0x64, 0x30, 0x66, 0x37, 0x66, 
+0x65, 0x34, 0x30, 0x63, 0x34, 0x66, 0x32, 0x30, 
+0x66, 0x36, 0x61, 0x64, 0x36, 0x35, 0x66, 0x32, 
+0x64, 0x33, 0x38, 0x39, 0x62, 0x61, 0x34, 0x61, 
+0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x31, 0x38, 0x64, 0x61, 0x33, 0x38, 
+0x62, 0x34, 0x33, 0x34, 0x66, 0x62, 0x61, 0x38, 
+0x32, 0x64, 0x36, 0x36, 0x30, 0x35, 0x32, 0x61, 
+0x66, 0x37, 0x34, 0x66, 0x63, 0x35, 0x65, 0x34, 
+0x65, 0x39, 0x34, 0x33, 0x30, 0x31, 0x62, 0x31, 
+0x31, 0x34, 0x64, 0x39, 0x62, 0x63, 0x30, 0x33, 
+0x66, 0x38, 0x31, 0x39, 0x64, 0x63, 0x38, 0x37, 
+0x36, 0x33, 0x39, 0x38, 0x34, 0x30, 0x34, 0x63, 
+0x38, 0x62, 0x34, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x36, 0x63, 0x34, 0x39, 0x33, 
+0x30, 0x34, 0x36, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x66, 0x65, 0x37, 0x33, 0x38, 0x62, 0x37, 
+0x35, 0x38, 0x30, 0x64, 0x63, 0x35, 0x66, 0x62, 
+0x35, 0x31, 0x36, 0x38, 0x65, 0x35, 0x31, 0x66, 
+0x63, 0x36, 0x31, 0x62, 0x35, 0x61, 0x65, 0x64, 
+0x32, 0x31, 0x31, 0x31, 0x32, 0x35, 0x65, 0x62, 
+0x37, 0x31, 0x30, 0x36, 0x38, 0x30, 0x33, 0x31, 
+0x30, 0x30, 0x39, 0x61, 0x32, 0x32, 0x64, 0x39, 
+0x62, 0x62, 0x61, 0x64, 0x37, 0x35, 0x32, 0x63, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x62, 
+0x65, 0x35, 0x30, 0x38, 0x36, 0x62, 0x61, 0x61, 
+0x33, 0x38, 0x34, 0x64, 0x34, 0x30, 0x62, 0x63, 
+0x61, 0x62, 0x30, 0x66, 0x61, 0x35, 0x38, 0x36, 
+0x65, 0x34, 0x66, 0x37, 0x32, 0x38, 0x33, 0x39, 
+0x37, 0x33, 0x38, 0x38, 0x64, 0x38, 0x36, 0x65, 
+0x31, 0x38, 0x62, 0x36, 0x36, 0x63, 0x63, 0x34, 
+0x31, 0x37, 0x64, 0x63, 0x34, 0x66, 0x37, 0x66, 
+0x61, 0x34, 0x66, 0x39, 0x38, 0x37, 0x38, 0x30, 
+0x31, 0x32, 0x31, 0x30, 0x33, 0x66, 0x32, 0x33, 
+0x33, 0x32, 0x39, 0x39, 0x34, 0x35, 0x35, 0x31, 
+0x33, 0x34, 0x63, 0x61, 0x61, 0x32, 0x36, 0x38, 
+0x37, 0x62, 0x64, 0x66, 0x31, 0x35, 0x63, 0x62, 
+0x30, 0x62, 0x65, 0x63, 0x64, 0x66, 0x62, 0x30, 
+0x33, 0x62, 0x64, 0x30, 0x66, 0x66, 0x32, 0x66, 
+0x66, 0x33, 0x38, 0x65, 0x36, 0x35, 0x65, 0x63, 
+0x36, 0x62, 0x37, 0x38, 0x33, 0x34, 0x32, 0x39, 
+0x35, 0x63, 0x33, 0x34, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 0x32, 0x32, 
+0x65, 0x62, 0x63, 0x31, 0x34, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x37, 
+0x37, 0x37, 0x39, 0x62, 0x37, 0x66, 0x62, 0x61, 
+0x31, 0x63, 0x31, 0x65, 0x30, 0x36, 0x62, 0x37, 
+0x31, 0x37, 0x30, 0x36, 0x39, 0x62, 0x38, 0x30, 
+0x63, 0x61, 0x31, 0x37, 0x30, 0x65, 0x38, 0x62, 
+0x30, 0x34, 0x34, 0x35, 0x38, 0x61, 0x34, 0x38, 
+0x38, 0x61, 0x63, 0x39, 0x38, 0x37, 0x39, 0x63, 
+0x34, 0x30, 0x66, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 0x36, 0x61, 
+0x39, 0x31, 0x34, 0x32, 0x61, 0x30, 0x33, 0x30, 
+0x37, 0x63, 0x64, 0x39, 0x32, 0x35, 0x64, 0x62, 
+0x62, 0x36, 0x36, 0x62, 0x35, 0x33, 0x34, 0x63, 
+0x34, 0x64, 0x62, 0x33, 0x33, 0x30, 0x30, 0x33, 
+0x64, 0x64, 0x31, 0x38, 0x63, 0x35, 0x37, 0x30, 
+0x31, 0x35, 0x37, 0x38, 0x38, 0x61, 0x63, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x32, 0x36, 0x31, 0x33, 0x39, 0x61, 0x36, 0x32, 
+0x65, 0x33, 0x34, 0x32, 0x32, 0x61, 0x36, 0x30, 
+0x32, 0x64, 0x65, 0x33, 0x36, 0x63, 0x38, 0x37, 
+0x33, 0x61, 0x32, 0x32, 0x35, 0x63, 0x31, 0x64, 
+0x33, 0x63, 0x61, 0x35, 0x61, 0x65, 0x65, 0x65, 
+0x35, 0x39, 0x38, 0x35, 0x33, 0x39, 0x63, 0x65, 
+0x65, 0x63, 0x62, 0x39, 0x66, 0x30, 0x64, 0x63, 
+0x38, 0x64, 0x31, 0x61, 0x64, 0x30, 0x66, 0x38, 
+0x33, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x36, 0x62, 0x34, 0x38, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x61, 
+0x64, 0x39, 0x66, 0x33, 0x32, 0x62, 0x34, 0x61, 
+0x30, 0x61, 0x32, 0x64, 0x64, 0x63, 0x31, 0x39, 
+0x62, 0x35, 0x61, 0x37, 0x34, 0x65, 0x62, 0x61, 
+0x37, 0x38, 0x31, 0x32, 0x33, 0x65, 0x35, 0x37, 
+0x36, 0x31, 0x36, 0x66, 0x31, 0x62, 0x33, 0x63, 
+0x66, 0x64, 0x37, 0x32, 0x63, 0x65, 0x36, 0x38, 
+0x63, 0x30, 0x33, 0x65, 0x61, 0x33, 0x35, 0x61, 
+0x33, 0x64, 0x64, 0x61, 0x31, 0x66, 0x30, 0x30, 
+0x32, 0x32, 0x30, 0x30, 0x64, 0x62, 0x64, 0x32, 
+0x32, 0x61, 0x61, 0x36, 0x64, 0x61, 0x31, 0x37, 
+0x32, 0x31, 0x33, 0x64, 0x66, 0x35, 0x65, 0x37, 
+0x30, 0x64, 0x66, 0x63, 0x33, 0x62, 0x32, 0x36, 
+0x31, 0x31, 0x64, 0x34, 0x30, 0x66, 0x37, 0x30, 
+0x63, 0x39, 0x38, 0x65, 0x64, 0x39, 0x36, 0x32, 
+0x36, 0x61, 0x61, 0x35, 0x65, 0x32, 0x63, 0x64, 
+0x65, 0x39, 0x64, 0x39, 0x37, 0x34, 0x36, 0x31, 
+0x66, 0x30, 0x61, 0x30, 0x31, 0x32, 0x31, 0x30, 
+0x33, 0x64, 0x64, 0x62, 0x32, 0x39, 0x35, 0x64, 
+0x32, 0x66, 0x31, 0x65, 0x38, 0x33, 0x31, 0x39, 
+0x31, 0x38, 0x37, 0x37, 0x33, 0x38, 0x66, 0x62, 
+0x34, 0x62, 0x32, 0x33, 0x30, 0x66, 0x64, 0x64, 
+0x39, 0x61, 0x61, 0x32, 0x39, 0x64, 0x30, 0x65, 
+0x30, 0x31, 0x36, 0x34, 0x37, 0x66, 0x36, 0x39, 
+0x66, 0x36, 0x64, 0x37, 0x37, 0x30, 0x62, 0x39, 
+0x61, 0x62, 0x32, 0x34, 0x65, 0x65, 0x61, 0x39, 
+0x30, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x39, 0x38, 0x33, 0x63, 0x38, 0x32, 0x63, 
+0x38, 0x37, 0x63, 0x66, 0x30, 0x32, 0x30, 0x30, 
+0x34, 0x30, 0x64, 0x36, 0x37, 0x31, 0x39, 0x35, 
+0x36, 0x35, 0x32, 0x35, 0x30, 0x31, 0x34, 0x64, 
+0x35, 0x63, 0x32, 0x62, 0x32, 0x38, 0x63, 0x36, 
+0x64, 0x39, 0x34, 0x38, 0x63, 0x38, 0x35, 0x65, 
+0x31, 0x61, 0x35, 0x32, 0x32, 0x33, 0x36, 0x32, 
+0x63, 0x30, 0x30, 0x35, 0x39, 0x65, 0x65, 0x61, 
+0x65, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x36, 0x62, 0x34, 0x38, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x39, 
+0x63, 0x61, 0x35, 0x34, 0x34, 0x32, 0x37, 0x34, 
+0x63, 0x37, 0x38, 0x36, 0x64, 0x33, 0x30, 0x61, 
+0x35, 0x64, 0x35, 0x64, 0x32, 0x35, 0x65, 0x31, 
+0x37, 0x37, 0x35, 0x39, 0x32, 0x30, 0x31, 0x65, 
+0x61, 0x31, 0x36, 0x64, 0x33, 0x61, 0x65, 0x64, 
+0x64, 0x64, 0x66, 0x30, 0x62, 0x39, 0x65, 0x39, 
+0x37, 0x32, 0x31, 0x32, 0x34, 0x36, 0x66, 0x37, 
+0x65, 0x66, 0x36, 0x62, 0x33, 0x32, 0x65, 0x30, 
+0x32, 0x32, 0x30, 0x32, 0x63, 0x66, 0x61, 0x35, 
+0x35, 0x36, 0x34, 0x62, 0x36, 0x65, 0x38, 0x37, 
+0x64, 0x66, 0x64, 0x39, 0x66, 0x64, 0x39, 0x38, 
+0x39, 0x35, 0x37, 0x38, 0x32, 0x30, 0x65, 0x34, 
+0x64, 0x34, 0x65, 0x36, 0x32, 0x33, 0x38, 0x62, 
+0x61, 0x65, 0x62, 0x30, 0x66, 0x36, 0x35, 0x66, 
+0x65, 0x33, 0x30, 0x35, 0x64, 0x39, 0x31, 0x35, 
+0x30, 0x36, 0x62, 0x62, 0x31, 0x33, 0x66, 0x35, 
+0x66, 0x34, 0x66, 0x30, 0x31, 0x32, 0x31, 0x30, 
+0x33, 0x63, 0x39, 0x39, 0x31, 0x31, 0x33, 0x64, 
+0x65, 0x61, 0x63, 0x30, 0x64, 0x35, 0x64, 0x30, 
+0x34, 0x34, 0x65, 0x33, 0x61, 0x63, 0x30, 0x33, 
+0x34, 0x36, 0x61, 0x62, 0x63, 0x30, 0x32, 0x35, 
+0x30, 0x31, 0x35, 0x34, 0x32, 0x61, 0x66, 0x38, 
+0x63, 0x38, 0x64, 0x33, 0x37, 0x35, 0x39, 0x66, 
+0x31, 0x33, 0x38, 0x32, 0x63, 0x37, 0x32, 0x66, 
+0x66, 0x38, 0x34, 0x65, 0x37, 0x30, 0x34, 0x66, 
+0x37, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x30, 0x32, 0x63, 0x30, 0x63, 0x36, 0x32, 
+0x64, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 0x36, 0x61, 
+0x39, 0x31, 0x34, 0x61, 0x65, 0x31, 0x39, 0x64, 
+0x32, 0x37, 0x65, 0x66, 0x65, 0x31, 0x32, 0x66, 
+0x35, 0x61, 0x38, 0x38, 0x36, 0x64, 0x63, 0x37, 
+0x39, 0x61, 0x66, 0x33, 0x37, 0x61, 0x64, 0x36, 
+0x38, 0x30, 0x35, 0x64, 0x62, 0x36, 0x66, 0x39, 
+0x32, 0x32, 0x64, 0x38, 0x38, 0x61, 0x63, 0x37, 
+0x30, 0x63, 0x65, 0x32, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x33, 
+0x62, 0x38, 0x64, 0x30, 0x35, 0x31, 0x64, 0x33, 
+0x37, 0x61, 0x30, 0x37, 0x65, 0x61, 0x31, 0x30, 
+0x34, 0x32, 0x30, 0x36, 0x37, 0x65, 0x39, 0x33, 
+0x65, 0x66, 0x65, 0x36, 0x33, 0x64, 0x62, 0x66, 
+0x37, 0x33, 0x39, 0x32, 0x30, 0x62, 0x39, 0x38, 
+0x38, 0x61, 0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x32, 0x62, 0x65, 0x35, 
+0x36, 0x36, 0x65, 0x38, 0x63, 0x64, 0x39, 0x39, 
+0x33, 0x33, 0x66, 0x30, 0x63, 0x37, 0x35, 0x63, 
+0x34, 0x61, 0x38, 0x32, 0x63, 0x30, 0x32, 0x37, 
+0x66, 0x37, 0x64, 0x30, 0x63, 0x35, 0x34, 0x34, 
+0x64, 0x35, 0x63, 0x31, 0x30, 0x31, 0x64, 0x30, 
+0x36, 0x30, 0x37, 0x65, 0x66, 0x36, 0x61, 0x65, 
+0x35, 0x64, 0x30, 0x37, 0x62, 0x39, 0x38, 0x65, 
+0x37, 0x66, 0x31, 0x64, 0x63, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 0x62, 0x34, 
+0x38, 0x33, 0x30, 0x34, 0x35, 0x30, 0x32, 0x32, 
+0x30, 0x33, 0x36, 0x61, 0x38, 0x63, 0x64, 0x66, 
+0x64, 0x35, 0x65, 0x61, 0x37, 0x65, 0x62, 0x63, 
+0x30, 0x36, 0x63, 0x32, 0x62, 0x66, 0x62, 0x36, 
+0x65, 0x34, 0x66, 0x39, 0x34, 0x32, 0x62, 0x62, 
+0x66, 0x39, 0x61, 0x31, 0x63, 0x61, 0x65, 0x64, 
+0x65, 0x64, 0x34, 0x31, 0x36, 0x38, 0x30, 0x64, 
+0x31, 0x31, 0x61, 0x33, 0x61, 0x39, 0x66, 0x35, 
+0x64, 0x38, 0x32, 0x38, 0x34, 0x61, 0x62, 0x61, 
+0x64, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x63, 
+0x61, 0x63, 0x62, 0x39, 0x32, 0x61, 0x35, 0x62, 
+0x65, 0x33, 0x66, 0x33, 0x39, 0x65, 0x38, 0x62, 
+0x63, 0x31, 0x34, 0x64, 0x62, 0x31, 0x37, 0x31, 
+0x30, 0x39, 0x31, 0x30, 0x65, 0x66, 0x37, 0x62, 
+0x33, 0x39, 0x35, 0x66, 0x61, 0x31, 0x65, 0x31, 
+0x38, 0x66, 0x34, 0x35, 0x64, 0x34, 0x31, 0x63, 
+0x32, 0x38, 0x64, 0x39, 0x31, 0x34, 0x66, 0x63, 
+0x64, 0x64, 0x65, 0x33, 0x33, 0x62, 0x65, 0x30, 
+0x31, 0x32, 0x31, 0x30, 0x32, 0x62, 0x66, 0x35, 
+0x39, 0x61, 0x62, 0x66, 0x31, 0x31, 0x30, 0x62, 
+0x35, 0x31, 0x33, 0x31, 0x66, 0x61, 0x65, 0x30, 
+0x61, 0x33, 0x63, 0x65, 0x31, 0x65, 0x63, 0x33, 
+0x37, 0x39, 0x33, 0x32, 0x39, 0x62, 0x34, 0x63, 
+0x38, 0x39, 0x36, 0x61, 0x36, 0x61, 0x65, 0x35, 
+0x64, 0x34, 0x34, 0x33, 0x65, 0x64, 0x62, 0x36, 
+0x38, 0x35, 0x32, 0x39, 0x63, 0x63, 0x32, 0x62, 
+0x63, 0x37, 0x38, 0x31, 0x36, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x39, 0x36, 0x63, 
+0x66, 0x36, 0x37, 0x36, 0x34, 0x35, 0x62, 0x37, 
+0x36, 0x63, 0x65, 0x62, 0x32, 0x33, 0x66, 0x65, 
+0x39, 0x32, 0x32, 0x38, 0x37, 0x34, 0x38, 0x34, 
+0x37, 0x34, 0x35, 0x36, 0x61, 0x31, 0x35, 0x66, 
+0x65, 0x65, 0x65, 0x31, 0x36, 0x35, 0x35, 0x30, 
+0x38, 0x32, 0x66, 0x66, 0x33, 0x32, 0x64, 0x32, 
+0x35, 0x61, 0x36, 0x62, 0x66, 0x32, 0x63, 0x30, 
+0x64, 0x66, 0x63, 0x39, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 0x61, 0x34, 
+0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 
+0x30, 0x33, 0x34, 0x37, 0x31, 0x63, 0x61, 0x32, 
+0x30, 0x30, 0x31, 0x37, 0x38, 0x34, 0x61, 0x35, 
+0x61, 0x63, 0x30, 0x61, 0x62, 0x61, 0x62, 0x35, 
+0x38, 0x33, 0x35, 0x38, 0x31, 0x66, 0x32, 0x36, 
+0x31, 0x33, 0x35, 0x32, 0x33, 0x64, 0x61, 0x34, 
+0x37, 0x65, 0x63, 0x35, 0x66, 0x35, 0x33, 0x64, 
+0x66, 0x38, 0x33, 0x33, 0x63, 0x31, 0x31, 0x37, 
+0x62, 0x35, 0x61, 0x62, 0x64, 0x38, 0x31, 0x35, 
+0x30, 0x30, 0x32, 0x32, 0x30, 0x36, 0x31, 0x38, 
+0x61, 0x32, 0x38, 0x34, 0x37, 0x37, 0x32, 0x33, 
+0x64, 0x35, 0x37, 0x33, 0x32, 0x34, 0x66, 0x32, 
+0x39, 0x38, 0x34, 0x36, 0x37, 0x38, 0x64, 0x62, 
+0x35, 0x35, 0x36, 0x64, 0x62, 0x63, 0x61, 0x31, 
+0x61, 0x37, 0x32, 0x32, 0x33, 0x30, 0x66, 0x63, 
+0x37, 0x65, 0x33, 0x39, 0x64, 0x66, 0x30, 0x34, 
+0x63, 0x32, 0x32, 0x33, 0x39, 0x39, 0x34, 0x32, 
+0x62, 0x61, 0x39, 0x34, 0x32, 0x30, 0x31, 0x32, 
+0x31, 0x30, 0x32, 0x39, 0x32, 0x35, 0x63, 0x39, 
+0x37, 0x39, 0x34, 0x66, 0x64, 0x37, 0x62, 0x62, 
+0x39, 0x66, 0x38, 0x62, 0x32, 0x39, 0x65, 0x32, 
+0x30, 0x37, 0x64, 0x35, 0x66, 0x63, 0x34, 0x39, 
+0x31, 0x62, 0x31, 0x31, 0x35, 0x30, 0x31, 0x33, 
+0x35, 0x61, 0x32, 0x31, 0x66, 0x35, 0x30, 0x35, 
+0x30, 0x34, 0x31, 0x38, 0x35, 0x38, 0x38, 0x38, 
+0x39, 0x66, 0x61, 0x34, 0x65, 0x64, 0x66, 0x34, 
+0x33, 0x36, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x30, 0x32, 0x36, 0x63, 0x38, 
+0x34, 0x30, 0x66, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 
+0x36, 0x61, 0x39, 0x31, 0x34, 0x37, 0x39, 0x37, 
+0x66, 0x62, 0x38, 0x37, 0x37, 0x37, 0x64, 0x37, 
+0x39, 0x39, 0x31, 0x64, 0x38, 0x32, 0x38, 0x34, 
+0x64, 0x38, 0x38, 0x62, 0x66, 0x64, 0x34, 0x32, 
+0x31, 0x63, 0x65, 0x35, 0x32, 0x30, 0x66, 0x30, 
+0x66, 0x38, 0x34, 0x33, 0x31, 0x38, 0x38, 0x61, 
+0x63, 0x30, 0x30, 0x63, 0x61, 0x39, 0x61, 0x33, 
+0x62, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x31, 0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 
+0x34, 0x36, 0x64, 0x31, 0x30, 0x66, 0x33, 0x66, 
+0x35, 0x39, 0x32, 0x36, 0x39, 0x39, 0x32, 0x36, 
+0x35, 0x64, 0x31, 0x30, 0x62, 0x31, 0x30, 0x36, 
+0x65, 0x64, 0x61, 0x33, 0x37, 0x63, 0x33, 0x63, 
+0x65, 0x37, 0x39, 0x33, 0x66, 0x37, 0x61, 0x38, 
+0x35, 0x38, 0x38, 0x61, 0x63, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x22, 0x2c, 0x5b, 
+0x22, 0x22, 0x2c, 0x22, 0x22, 0x2c, 0x22, 0x22, 
+0x2c, 0x22, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 
+0x32, 0x39, 0x30, 0x33, 0x62, 0x31, 0x33, 0x38, 
+0x63, 0x32, 0x34, 0x62, 0x65, 0x39, 0x65, 0x30, 
+0x37, 0x30, 0x62, 0x33, 0x65, 0x37, 0x33, 0x65, 
+0x63, 0x34, 0x39, 0x35, 0x64, 0x37, 0x37, 0x61, 
+0x32, 0x30, 0x34, 0x36, 0x31, 0x35, 0x65, 0x37, 
+0x38, 0x38, 0x61, 0x63, 0x22, 0x2c, 0x22, 0x37, 
+0x36, 0x61, 0x39, 0x31, 0x34, 0x33, 0x33, 0x61, 
+0x31, 0x39, 0x34, 0x31, 0x66, 0x64, 0x39, 0x61, 
+0x33, 0x37, 0x62, 0x39, 0x38, 0x32, 0x31, 0x64, 
+0x33, 0x37, 0x36, 0x66, 0x35, 0x61, 0x35, 0x31, 
+0x62, 0x64, 0x34, 0x62, 0x35, 0x32, 0x66, 0x61, 
+0x35, 0x30, 0x65, 0x32, 0x38, 0x38, 0x38, 0x61, 
+0x63, 0x22, 0x2c, 0x22, 0x37, 0x36, 0x61, 0x39, 
+0x31, 0x34, 0x65, 0x34, 0x33, 0x37, 0x34, 0x65, 
+0x38, 0x31, 0x35, 0x35, 0x64, 0x30, 0x38, 0x36, 
+0x35, 0x37, 0x34, 0x32, 0x63, 0x61, 0x31, 0x32, 
+0x62, 0x38, 0x64, 0x34, 0x64, 0x31, 0x34, 0x64, 
+0x34, 0x31, 0x62, 0x35, 0x37, 0x64, 0x36, 0x38, 
+0x32, 0x66, 0x38, 0x38, 0x61, 0x63, 0x22, 0x2c, 
+0x22, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x30, 
+0x30, 0x31, 0x66, 0x61, 0x37, 0x34, 0x35, 0x39, 
+0x61, 0x36, 0x63, 0x66, 0x63, 0x36, 0x34, 0x62, 
+0x64, 0x63, 0x31, 0x37, 0x38, 0x62, 0x61, 0x37, 
+0x65, 0x37, 0x61, 0x32, 0x31, 0x36, 0x30, 0x33, 
+0x62, 0x62, 0x32, 0x35, 0x36, 0x38, 0x66, 0x38, 
+0x38, 0x61, 0x63, 0x22, 0x2c, 0x22, 0x37, 0x36, 
+0x61, 0x39, 0x31, 0x34, 0x66, 0x36, 0x30, 0x33, 
+0x39, 0x39, 0x35, 0x32, 0x62, 0x63, 0x32, 0x62, 
+0x33, 0x30, 0x37, 0x61, 0x65, 0x65, 0x63, 0x35, 
+0x33, 0x37, 0x31, 0x62, 0x66, 0x62, 0x39, 0x36, 
+0x62, 0x36, 0x36, 0x30, 0x37, 0x38, 0x65, 0x63, 
+0x31, 0x37, 0x66, 0x36, 0x38, 0x38, 0x61, 0x63, 
+0x22, 0x5d, 0x2c, 0x22, 0x62, 0x31, 0x30, 0x39, 
+0x31, 0x33, 0x39, 0x36, 0x37, 0x31, 0x64, 0x62, 
+0x65, 0x64, 0x63, 0x32, 0x62, 0x36, 0x66, 0x63, 
+0x64, 0x34, 0x39, 0x39, 0x61, 0x35, 0x34, 0x38, 
+0x30, 0x61, 0x37, 0x34, 0x36, 0x31, 0x61, 0x65, 
+0x34, 0x35, 0x38, 0x61, 0x66, 0x38, 0x66, 0x66, 
+0x39, 0x34, 0x31, 0x31, 0x64, 0x38, 0x31, 0x39, 
+0x61, 0x61, 0x36, 0x34, 0x62, 0x61, 0x36, 0x39, 
+0x39, 0x35, 0x64, 0x31, 0x22, 0x2c, 0x22, 0x30, 
+0x64, 0x62, 0x34, 0x31, 0x34, 0x63, 0x38, 0x35, 
+0x39, 0x61, 0x30, 0x37, 0x65, 0x38, 0x32, 0x30, 
+0x35, 0x38, 0x37, 0x36, 0x33, 0x35, 0x34, 0x61, 
+0x32, 0x31, 0x30, 0x61, 0x37, 0x35, 0x30, 0x34, 
+0x32, 0x64, 0x30, 0x34, 0x36, 0x33, 0x34, 0x30, 
+0x34, 0x39, 0x31, 0x33, 0x64, 0x36, 0x31, 0x61, 
+0x38, 0x65, 0x30, 0x36, 0x38, 0x65, 0x35, 0x38, 
+0x61, 0x33, 0x61, 0x65, 0x32, 0x61, 0x61, 0x30, 
+0x38, 0x30, 0x30, 0x32, 0x36, 0x22, 0x2c, 0x22, 
+0x61, 0x30, 0x61, 0x66, 0x37, 0x37, 0x65, 0x30, 
+0x61, 0x37, 0x65, 0x64, 0x32, 0x30, 0x65, 0x61, 
+0x37, 0x38, 0x64, 0x32, 0x64, 0x65, 0x66, 0x33, 
+0x32, 0x30, 0x30, 0x63, 0x63, 0x32, 0x34, 0x66, 
+0x30, 0x38, 0x32, 0x31, 0x37, 0x64, 0x63, 0x64, 
+0x35, 0x31, 0x37, 0x35, 0x35, 0x63, 0x37, 0x63, 
+0x37, 0x66, 0x65, 0x62, 0x30, 0x65, 0x32, 0x62, 
+0x61, 0x38, 0x33, 0x31, 0x36, 0x63, 0x32, 0x64, 
+0x22, 0x2c, 0x22, 0x54, 0x78, 0x20, 0x73, 0x70, 
+0x65, 0x6e, 0x64, 0x73, 0x20, 0x66, 0x72, 0x6f, 
+0x6d, 0x20, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x20, 
+0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x20, 0x73, 
+0x63, 0x72, 0x69, 0x70, 0x74, 0x22, 0x5d, 0x2c, 
+0x0a, 0x5b, 0x39, 0x32, 0x36, 0x34, 0x38, 0x35, 
+0x2c, 0x22, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x35, 0x64, 0x36, 0x30, 0x37, 0x37, 0x61, 0x34, 
+0x31, 0x31, 0x61, 0x38, 0x66, 0x35, 0x63, 0x63, 
+0x39, 0x35, 0x63, 0x61, 0x66, 0x37, 0x37, 0x35, 
+0x63, 0x63, 0x66, 0x31, 0x31, 0x63, 0x35, 0x34, 
+0x65, 0x32, 0x37, 0x64, 0x66, 0x37, 0x35, 0x63, 
+0x65, 0x35, 0x38, 0x64, 0x31, 0x38, 0x37, 0x33, 
+0x31, 0x33, 0x22, 0x2c, 0x22, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x32, 0x30, 0x36, 0x30, 0x62, 
+0x62, 0x61, 0x62, 0x30, 0x65, 0x64, 0x62, 0x66, 
+0x33, 0x65, 0x66, 0x38, 0x61, 0x34, 0x39, 0x36, 
+0x30, 0x38, 0x65, 0x65, 0x33, 0x32, 0x36, 0x66, 
+0x38, 0x66, 0x64, 0x37, 0x35, 0x63, 0x34, 0x37, 
+0x33, 0x62, 0x37, 0x65, 0x33, 0x39, 0x38, 0x32, 
+0x30, 0x39, 0x35, 0x65, 0x32, 0x64, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x63, 0x33, 0x30, 
+0x31, 0x33, 0x34, 0x66, 0x38, 0x63, 0x39, 0x62, 
+0x36, 0x64, 0x32, 0x34, 0x37, 0x30, 0x34, 0x38, 
+0x38, 0x64, 0x37, 0x61, 0x36, 0x37, 0x61, 0x38, 
+0x38, 0x38, 0x66, 0x36, 0x66, 0x61, 0x31, 0x32, 
+0x66, 0x38, 0x36, 0x39, 0x32, 0x65, 0x30, 0x63, 
+0x33, 0x34, 0x31, 0x31, 0x66, 0x62, 0x66, 0x62, 
+0x39, 0x32, 0x66, 0x30, 0x66, 0x36, 0x38, 0x66, 
+0x36, 0x37, 0x65, 0x65, 0x64, 0x61, 0x65, 0x30, 
+0x33, 0x63, 0x61, 0x35, 0x37, 0x65, 0x66, 0x31, 
+0x33, 0x30, 0x32, 0x31, 0x61, 0x63, 0x63, 0x32, 
+0x32, 0x64, 0x63, 0x34, 0x31, 0x30, 0x35, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x32, 0x66, 0x30, 
+0x33, 0x31, 0x35, 0x32, 0x33, 0x30, 0x65, 0x30, 
+0x30, 0x30, 0x34, 0x61, 0x65, 0x30, 0x33, 0x63, 
+0x61, 0x35, 0x37, 0x30, 0x34, 0x33, 0x65, 0x33, 
+0x64, 0x31, 0x65, 0x31, 0x64, 0x30, 0x63, 0x38, 
+0x37, 0x39, 0x36, 0x62, 0x66, 0x35, 0x37, 0x39, 
+0x61, 0x65, 0x66, 0x30, 0x63, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x32, 0x32, 0x66, 0x34, 0x65, 0x36, 0x39, 0x36, 
+0x65, 0x36, 0x61, 0x36, 0x31, 0x35, 0x30, 0x36, 
+0x66, 0x36, 0x66, 0x36, 0x63, 0x32, 0x66, 0x35, 
+0x33, 0x34, 0x35, 0x34, 0x37, 0x35, 0x37, 0x34, 
+0x39, 0x35, 0x34, 0x32, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 0x33, 0x38, 
+0x34, 0x32, 0x37, 0x61, 0x31, 0x31, 0x32, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x38, 
+0x37, 0x36, 0x66, 0x62, 0x62, 0x38, 0x32, 0x65, 
+0x63, 0x30, 0x35, 0x63, 0x61, 0x61, 0x36, 0x61, 
+0x66, 0x37, 0x61, 0x33, 0x62, 0x35, 0x65, 0x35, 
+0x61, 0x39, 0x38, 0x33, 0x61, 0x61, 0x65, 0x36, 
+0x63, 0x36, 0x63, 0x63, 0x36, 0x64, 0x36, 0x38, 
+0x38, 0x61, 0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x32, 0x36, 0x36, 0x61, 0x32, 
+0x34, 0x61, 0x61, 0x32, 0x31, 0x61, 0x39, 0x65, 
+0x64, 0x35, 0x63, 0x37, 0x34, 0x38, 0x65, 0x31, 
+0x32, 0x31, 0x63, 0x30, 0x66, 0x65, 0x31, 0x34, 
+0x36, 0x64, 0x39, 0x37, 0x33, 0x61, 0x34, 0x61, 
+0x63, 0x32, 0x36, 0x66, 0x61, 0x34, 0x61, 0x36, 
+0x38, 0x62, 0x30, 0x35, 0x34, 0x39, 0x64, 0x34, 
+0x36, 0x65, 0x65, 0x32, 0x32, 0x64, 0x32, 0x35, 
+0x66, 0x35, 0x30, 0x61, 0x35, 0x65, 0x34, 0x36, 
+0x66, 0x65, 0x31, 0x62, 0x33, 0x37, 0x37, 0x65, 
+0x65, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x32, 0x39, 0x35, 0x32, 0x35, 0x33, 0x34, 
+0x62, 0x34, 0x32, 0x34, 0x63, 0x34, 0x66, 0x34, 
+0x33, 0x34, 0x62, 0x33, 0x61, 0x63, 0x64, 0x31, 
+0x36, 0x37, 0x37, 0x32, 0x61, 0x64, 0x36, 0x31, 
+0x61, 0x33, 0x63, 0x35, 0x66, 0x30, 0x30, 0x32, 
+0x38, 0x37, 0x34, 0x38, 0x30, 0x62, 0x37, 0x32, 
+0x30, 0x66, 0x36, 0x30, 0x33, 0x35, 0x64, 0x35, 
+0x65, 0x35, 0x34, 0x63, 0x39, 0x65, 0x66, 0x63, 
+0x37, 0x31, 0x62, 0x65, 0x39, 0x34, 0x62, 0x62, 
+0x35, 0x65, 0x33, 0x37, 0x32, 0x37, 0x66, 0x31, 
+0x30, 0x39, 0x30, 0x39, 0x30, 0x30, 0x31, 0x32, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 0x31, 0x34, 
+0x35, 0x33, 0x31, 0x30, 0x65, 0x38, 0x37, 0x38, 
+0x39, 0x34, 0x31, 0x61, 0x31, 0x62, 0x32, 0x62, 
+0x63, 0x32, 0x64, 0x33, 0x33, 0x37, 0x39, 0x37, 
+0x65, 0x65, 0x34, 0x64, 0x38, 0x39, 0x64, 0x39, 
+0x35, 0x65, 0x61, 0x61, 0x66, 0x32, 0x65, 0x31, 
+0x33, 0x34, 0x38, 0x38, 0x30, 0x36, 0x33, 0x61, 
+0x32, 0x61, 0x61, 0x39, 0x61, 0x37, 0x34, 0x34, 
+0x39, 0x30, 0x66, 0x35, 0x31, 0x30, 0x61, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 
+0x33, 0x32, 0x32, 0x30, 0x30, 0x32, 0x30, 0x62, 
+0x36, 0x37, 0x34, 0x34, 0x64, 0x65, 0x34, 0x66, 
+0x36, 0x65, 0x63, 0x36, 0x33, 0x63, 0x63, 0x39, 
+0x32, 0x66, 0x37, 0x63, 0x32, 0x32, 0x30, 0x63, 
+0x64, 0x65, 0x66, 0x65, 0x65, 0x62, 0x31, 0x62, 
+0x31, 0x62, 0x65, 0x64, 0x32, 0x62, 0x36, 0x36, 
+0x63, 0x38, 0x65, 0x35, 0x37, 0x30, 0x36, 0x64, 
+0x38, 0x30, 0x65, 0x63, 0x32, 0x34, 0x37, 0x64, 
+0x33, 0x37, 0x65, 0x36, 0x35, 0x61, 0x31, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x30, 
+0x31, 0x30, 0x30, 0x32, 0x64, 0x33, 0x31, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x31, 0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 
+0x34, 0x33, 0x65, 0x62, 0x63, 0x34, 0x30, 0x65, 
+0x34, 0x31, 0x31, 0x65, 0x64, 0x33, 0x63, 0x37, 
+0x36, 0x66, 0x38, 0x36, 0x37, 0x31, 0x31, 0x35, 
+0x30, 0x37, 0x61, 0x62, 0x39, 0x35, 0x32, 0x33, 
+0x30, 0x30, 0x38, 0x39, 0x30, 0x33, 0x39, 0x37, 
+0x32, 0x38, 0x38, 0x61, 0x63, 0x30, 0x34, 0x30, 
+0x30, 0x34, 0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 
+0x32, 0x32, 0x30, 0x30, 0x31, 0x64, 0x64, 0x34, 
+0x38, 0x39, 0x61, 0x35, 0x64, 0x34, 0x65, 0x32, 
+0x66, 0x62, 0x64, 0x38, 0x61, 0x33, 0x61, 0x64, 
+0x65, 0x32, 0x37, 0x31, 0x37, 0x37, 0x66, 0x36, 
+0x62, 0x34, 0x39, 0x32, 0x39, 0x36, 0x62, 0x61, 
+0x37, 0x36, 0x39, 0x35, 0x63, 0x34, 0x30, 0x64, 
+0x62, 0x62, 0x65, 0x36, 0x35, 0x30, 0x65, 0x61, 
+0x38, 0x33, 0x66, 0x31, 0x30, 0x36, 0x34, 0x31, 
+0x35, 0x66, 0x64, 0x30, 0x32, 0x32, 0x30, 0x30, 
+0x62, 0x32, 0x33, 0x61, 0x30, 0x36, 0x30, 0x32, 
+0x64, 0x38, 0x66, 0x66, 0x31, 0x62, 0x64, 0x66, 
+0x37, 0x39, 0x64, 0x65, 0x65, 0x31, 0x31, 0x38, 
+0x32, 0x30, 0x35, 0x66, 0x63, 0x37, 0x65, 0x39, 
+0x62, 0x34, 0x30, 0x36, 0x37, 0x32, 0x62, 0x66, 
+0x33, 0x31, 0x35, 0x36, 0x33, 0x65, 0x35, 0x37, 
+0x34, 0x31, 0x66, 0x65, 0x62, 0x35, 0x33, 0x66, 
+0x62, 0x38, 0x36, 0x33, 0x38, 0x38, 0x35, 0x30, 
+0x31, 0x34, 0x38, 0x33, 0x30, 0x34, 0x35, 0x30, 
+0x32, 0x32, 0x31, 0x30, 0x30, 0x66, 0x38, 0x38, 
+0x66, 0x30, 0x34, 0x30, 0x65, 0x39, 0x30, 0x63, 
+0x63, 0x35, 0x64, 0x63, 0x36, 0x63, 0x36, 0x31, 
+0x38, 0x39, 0x64, 0x30, 0x34, 0x37, 0x31, 0x38, 
+0x33, 0x37, 0x36, 0x61, 0x63, 0x31, 0x39, 0x65, 
+0x64, 0x39, 0x39, 0x36, 0x62, 0x66, 0x39, 0x65, 
+0x34, 0x61, 0x33, 0x63, 0x32, 0x39, 0x63, 0x33, 
+0x37, 0x31, 0x38, 0x64, 0x39, 0x30, 0x66, 0x66, 
+0x64, 0x32, 0x37, 0x31, 0x38, 0x30, 0x32, 0x32, 
+0x30, 0x37, 0x36, 0x31, 0x37, 0x31, 0x31, 0x66, 
+0x31, 0x36, 0x63, 0x39, 0x65, 0x33, 0x61, 0x34, 
+0x34, 0x66, 0x37, 0x31, 0x61, 0x61, 0x62, 0x35, 
+0x35, 0x63, 0x62, 0x63, 0x30, 0x36, 0x33, 0x34, 
+0x39, 0x30, 0x37, 0x61, 0x31, 0x66, 0x61, 0x38, 
+0x62, 0x62, 0x36, 0x33, 0x35, 0x64, 0x39, 0x37, 
+0x31, 0x61, 0x39, 0x61, 0x30, 0x31, 0x64, 0x33, 
+0x36, 0x38, 0x37, 0x32, 0x37, 0x62, 0x65, 0x61, 
+0x31, 0x30, 0x31, 0x36, 0x39, 0x35, 0x32, 0x32, 
+0x31, 0x30, 0x33, 0x62, 0x33, 0x36, 0x32, 0x33, 
+0x31, 0x31, 0x37, 0x65, 0x39, 0x38, 0x38, 0x62, 
+0x37, 0x36, 0x61, 0x61, 0x61, 0x62, 0x65, 0x33, 
+0x64, 0x36, 0x33, 0x66, 0x35, 0x36, 0x61, 0x34, 
+0x66, 0x63, 0x38, 0x38, 0x62, 0x32, 0x32, 0x38, 
+0x61, 0x37, 0x31, 0x65, 0x36, 0x34, 0x63, 0x34, 
+0x63, 0x63, 0x35, 0x35, 0x31, 0x64, 0x31, 0x32, 
+0x30, 0x34, 0x38, 0x32, 0x32, 0x66, 0x65, 0x38, 
+0x35, 0x63, 0x62, 0x32, 0x31, 0x30, 0x33, 0x64, 
+0x64, 0x38, 0x32, 0x33, 0x30, 0x36, 0x36, 0x65, 
+0x30, 0x39, 0x36, 0x66, 0x37, 0x32, 0x65, 0x64, 
+0x36, 0x31, 0x37, 0x61, 0x34, 0x31, 0x64, 0x33, 
+0x63, 0x61, 0x35, 0x36, 0x37, 0x31, 0x37, 0x64, 
+0x62, 0x33, 0x33, 0x35, 0x62, 0x31, 0x65, 0x61, 
+0x34, 0x37, 0x61, 0x31, 0x62, 0x34, 0x63, 0x35, 
+0x63, 0x39, 0x64, 0x62, 0x64, 0x64, 0x30, 0x39, 
+0x36, 0x33, 0x61, 0x63, 0x62, 0x61, 0x36, 0x32, 
+0x31, 0x30, 0x33, 0x33, 0x64, 0x37, 0x63, 0x38, 
+0x39, 0x62, 0x64, 0x39, 0x64, 0x61, 0x32, 0x39, 
+0x66, 0x61, 0x38, 0x64, 0x34, 0x34, 0x64, 0x62, 
+0x37, 0x39, 0x30, 0x36, 0x61, 0x39, 0x37, 0x37, 
+0x38, 0x62, 0x35, 0x33, 0x31, 0x32, 0x31, 0x66, 
+0x37, 0x32, 0x31, 0x39, 0x31, 0x31, 0x38, 0x34, 
+0x61, 0x39, 0x66, 0x65, 0x65, 0x37, 0x38, 0x35, 
+0x63, 0x33, 0x39, 0x31, 0x38, 0x30, 0x65, 0x34, 
+0x62, 0x65, 0x31, 0x35, 0x33, 0x61, 0x65, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x32, 0x30, 0x39, 0x32, 0x35, 0x35, 0x33, 
+0x34, 0x32, 0x36, 0x31, 0x64, 0x65, 0x34, 0x64, 
+0x63, 0x65, 0x62, 0x62, 0x31, 0x65, 0x64, 0x35, 
+0x61, 0x62, 0x31, 0x62, 0x36, 0x32, 0x62, 0x66, 
+0x65, 0x37, 0x61, 0x33, 0x65, 0x66, 0x39, 0x36, 
+0x38, 0x66, 0x62, 0x31, 0x31, 0x31, 0x64, 0x63, 
+0x32, 0x63, 0x39, 0x31, 0x30, 0x61, 0x64, 0x66, 
+0x65, 0x62, 0x63, 0x36, 0x65, 0x33, 0x62, 0x64, 
+0x66, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x36, 0x62, 0x34, 0x38, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x66, 
+0x35, 0x30, 0x31, 0x39, 0x38, 0x66, 0x35, 0x61, 
+0x65, 0x36, 0x36, 0x32, 0x31, 0x31, 0x61, 0x34, 
+0x66, 0x34, 0x38, 0x35, 0x31, 0x39, 0x30, 0x61, 
+0x62, 0x65, 0x34, 0x64, 0x63, 0x37, 0x61, 0x63, 
+0x63, 0x64, 0x61, 0x62, 0x65, 0x33, 0x62, 0x63, 
+0x32, 0x31, 0x34, 0x65, 0x62, 0x63, 0x39, 0x65, 
+0x61, 0x37, 0x30, 0x36, 0x39, 0x62, 0x39, 0x37, 
+0x30, 0x39, 0x37, 0x64, 0x34, 0x36, 0x65, 0x30, 
+0x32, 0x32, 0x30, 0x33, 0x31, 0x36, 0x61, 0x37, 
+0x30, 0x61, 0x30, 0x33, 0x30, 0x31, 0x34, 0x38, 
+0x38, 0x37, 0x30, 0x38, 0x36, 0x65, 0x33, 0x33, 
+0x35, 0x66, 0x63, 0x31, 0x62, 0x34, 0x38, 0x33, 
+0x35, 0x38, 0x64, 0x34, 0x36, 0x63, 0x64, 0x36, 
+0x62, 0x64, 0x63, 0x39, 0x61, 0x66, 0x33, 0x62, 
+0x35, 0x37, 0x63, 0x31, 0x30, 0x39, 0x63, 0x39, 
+0x34, 0x61, 0x66, 0x37, 0x36, 0x66, 0x63, 0x39, 
+0x31, 0x35, 0x31, 0x30, 0x31, 0x32, 0x31, 0x30, 
+0x33, 0x31, 0x36, 0x63, 0x66, 0x66, 0x35, 0x38, 
+0x37, 0x61, 0x30, 0x31, 0x61, 0x32, 0x37, 0x33, 
+0x36, 0x64, 0x35, 0x65, 0x31, 0x32, 0x65, 0x35, 
+0x33, 0x35, 0x35, 0x31, 0x62, 0x31, 0x38, 0x64, 
+0x37, 0x33, 0x37, 0x38, 0x30, 0x62, 0x38, 0x33, 
+0x63, 0x33, 0x62, 0x66, 0x62, 0x34, 0x66, 0x63, 
+0x66, 0x32, 0x30, 0x39, 0x63, 0x38, 0x36, 0x39, 
+0x62, 0x31, 0x31, 0x62, 0x36, 0x34, 0x31, 0x35, 
+0x65, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x30, 0x32, 0x32, 0x30, 0x61, 0x31, 0x30, 
+0x37, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 0x36, 0x61, 
+0x39, 0x31, 0x34, 0x35, 0x30, 0x33, 0x33, 0x33, 
+0x30, 0x34, 0x36, 0x31, 0x31, 0x35, 0x65, 0x61, 
+0x61, 0x30, 0x61, 0x63, 0x39, 0x65, 0x30, 0x32, 
+0x31, 0x36, 0x35, 0x36, 0x35, 0x66, 0x39, 0x34, 
+0x35, 0x30, 0x37, 0x30, 0x65, 0x34, 0x34, 0x35, 
+0x37, 0x33, 0x39, 0x38, 0x38, 0x61, 0x63, 0x32, 
+0x65, 0x37, 0x63, 0x64, 0x30, 0x31, 0x61, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 
+0x39, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x63, 
+0x30, 0x31, 0x61, 0x37, 0x63, 0x61, 0x31, 0x36, 
+0x62, 0x34, 0x37, 0x62, 0x65, 0x35, 0x30, 0x63, 
+0x62, 0x64, 0x62, 0x63, 0x36, 0x30, 0x37, 0x32, 
+0x34, 0x66, 0x37, 0x30, 0x31, 0x64, 0x35, 0x32, 
+0x64, 0x37, 0x35, 0x31, 0x35, 0x36, 0x36, 0x38, 
+0x38, 0x61, 0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x32, 0x30, 0x33, 0x61, 
+0x32, 0x35, 0x66, 0x35, 0x38, 0x36, 0x33, 0x30, 
+0x64, 0x37, 0x61, 0x31, 0x65, 0x61, 0x35, 0x32, 
+0x35, 0x35, 0x30, 0x33, 0x36, 0x35, 0x66, 0x64, 
+0x32, 0x31, 0x35, 0x36, 0x36, 0x38, 0x33, 0x66, 
+0x35, 0x36, 0x64, 0x61, 0x66, 0x36, 0x63, 0x61, 
+0x37, 0x33, 0x61, 0x34, 0x62, 0x34, 0x62, 0x62, 
+0x64, 0x30, 0x39, 0x37, 0x65, 0x36, 0x36, 0x35, 
+0x31, 0x36, 0x33, 0x32, 0x32, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 0x61, 0x34, 
+0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 
+0x30, 0x34, 0x65, 0x66, 0x63, 0x33, 0x64, 0x37, 
+0x30, 0x65, 0x34, 0x63, 0x61, 0x33, 0x30, 0x34, 
+0x39, 0x63, 0x32, 0x61, 0x34, 0x32, 0x35, 0x30, 
+0x32, 0x35, 0x65, 0x64, 0x66, 0x32, 0x32, 0x64, 
+0x35, 0x63, 0x61, 0x33, 0x35, 0x35, 0x66, 0x39, 
+0x65, 0x63, 0x38, 0x39, 0x39, 0x64, 0x62, 0x66, 
+0x62, 0x62, 0x65, 0x65, 0x62, 0x32, 0x32, 0x36, 
+0x38, 0x35, 0x33, 0x33, 0x61, 0x30, 0x66, 0x32, 
+0x62, 0x30, 0x32, 0x32, 0x30, 0x34, 0x37, 0x38, 
+0x30, 0x64, 0x33, 0x37, 0x33, 0x39, 0x36, 0x35, 
+0x33, 0x30, 0x33, 0x35, 0x61, 0x66, 0x34, 0x38, 
+0x31, 0x34, 0x65, 0x61, 0x35, 0x32, 0x65, 0x31, 
+0x33, 0x39, 0x36, 0x64, 0x30, 0x32, 0x31, 0x39, 
+0x35, 0x33, 0x66, 0x39, 0x34, 0x38, 0x63, 0x32, 
+0x39, 0x37, 0x35, 0x34, 0x65, 0x64, 0x64, 0x30, 
+0x65, 0x65, 0x35, 0x33, 0x37, 0x33, 0x36, 0x34, 
+0x36, 0x30, 0x33, 0x64, 0x63, 0x30, 0x31, 0x32, 
+0x31, 0x30, 0x33, 0x66, 0x37, 0x61, 0x38, 0x39, 
+0x37, 0x65, 0x34, 0x64, 0x62, 0x65, 0x63, 0x61, 
+0x62, 0x32, 0x32, 0x36, 0x34, 0x62, 0x32, 0x31, 
+0x39, 0x31, 0x37, 0x66, 0x39, 0x30, 0x36, 0x36, 
+0x34, 0x65, 0x61, 0x38, 0x32, 0x35, 0x36, 0x31, 
+0x38, 0x39, 0x65, 0x61, 0x37, 0x32, 0x35, 0x64, 
+0x32, 0x38, 0x37, 0x34, 0x30, 0x63, 0x66, 0x37, 
+0x62, 0x61, 0x35, 0x64, 0x38, 0x35, 0x62, 0x35, 
+0x37, 0x36, 0x33, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x30, 0x33, 0x61, 0x32, 0x35, 
+0x66, 0x35, 0x38, 0x36, 0x33, 0x30, 0x64, 0x37, 
+0x61, 0x31, 0x65, 0x61, 0x35, 0x32, 0x35, 0x35, 
+0x30, 0x33, 0x36, 0x35, 0x66, 0x64, 0x32, 0x31, 
+0x35, 0x36, 0x36, 0x38, 0x33, 0x66, 0x35, 0x36, 
+0x64, 0x61, 0x66, 0x36, 0x63, 0x61, 0x37, 0x33, 
+0x61, 0x34, 0x62, 0x34, 0x62, 0x62, 0x64, 0x30, 
+0x39, 0x37, 0x65, 0x36, 0x36, 0x35, 0x31, 0x36, 
+0x33, 0x32, 0x32, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x36, 0x61, 0x34, 0x37, 0x33, 
+0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 0x30, 0x32, 
+0x64, 0x39, 0x36, 0x64, 0x65, 0x66, 0x64, 0x63, 
+0x35, 0x62, 0x34, 0x61, 0x66, 0x37, 0x31, 0x64, 
+0x36, 0x62, 0x61, 0x32, 0x38, 0x63, 0x39, 0x61, 
+0x36, 0x30, 0x34, 0x32, 0x63, 0x32, 0x64, 0x35, 
+0x65, 0x65, 0x37, 0x62, 0x63, 0x36, 0x64, 0x65, 
+0x35, 0x36, 0x35, 0x64, 0x34, 0x64, 0x62, 0x38, 
+0x34, 0x65, 0x66, 0x35, 0x31, 0x37, 0x34, 0x34, 
+0x35, 0x36, 0x32, 0x36, 0x65, 0x30, 0x33, 0x30, 
+0x32, 0x32, 0x30, 0x32, 0x32, 0x64, 0x61, 0x38, 
+0x30, 0x33, 0x32, 0x30, 0x65, 0x39, 0x65, 0x34, 
+0x38, 0x39, 0x63, 0x38, 0x66, 0x34, 0x31, 0x62, 
+0x37, 0x34, 0x38, 0x33, 0x33, 0x64, 0x66, 0x62, 
+0x36, 0x61, 0x35, 0x34, 0x61, 0x34, 0x65, 0x62, 
+0x35, 0x30, 0x38, 0x37, 0x63, 0x64, 0x62, 0x34, 
+0x36, 0x65, 0x62, 0x36, 0x36, 0x33, 0x65, 0x65, 
+0x66, 0x30, 0x62, 0x32, 0x35, 0x63, 0x61, 0x61, 
+0x35, 0x32, 0x36, 0x30, 0x31, 0x32, 0x31, 0x30, 
+0x33, 0x66, 0x37, 0x61, 0x38, 0x39, 0x37, 0x65, 
+0x34, 0x64, 0x62, 0x65, 0x63, 0x61, 0x62, 0x32, 
+0x32, 0x36, 0x34, 0x62, 0x32, 0x31, 0x39, 0x31, 
+0x37, 0x66, 0x39, 0x30, 0x36, 0x36, 0x34, 0x65, 
+0x61, 0x38, 0x32, 0x35, 0x36, 0x31, 0x38, 0x39, 
+0x65, 0x61, 0x37, 0x32, 0x35, 0x64, 0x32, 0x38, 
+0x37, 0x34, 0x30, 0x63, 0x66, 0x37, 0x62, 0x61, 
+0x35, 0x64, 0x38, 0x35, 0x62, 0x35, 0x37, 0x36, 
+0x33, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x30, 0x32, 0x30, 0x30, 0x65, 0x31, 0x66, 
+0x35, 0x30, 0x35, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x31, 0x37, 0x61, 0x39, 0x31, 
+0x34, 0x62, 0x37, 0x65, 0x36, 0x66, 0x37, 0x66, 
+0x66, 0x38, 0x36, 0x35, 0x38, 0x62, 0x32, 0x64, 
+0x31, 0x66, 0x62, 0x31, 0x30, 0x37, 0x65, 0x33, 
+0x64, 0x37, 0x62, 0x65, 0x37, 0x61, 0x66, 0x34, 
+0x37, 0x34, 0x32, 0x65, 0x36, 0x62, 0x31, 0x62, 
+0x33, 0x38, 0x37, 0x36, 0x66, 0x38, 0x38, 0x66, 
+0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 0x36, 0x61, 
+0x39, 0x31, 0x34, 0x39, 0x31, 0x33, 0x62, 0x63, 
+0x63, 0x32, 0x62, 0x65, 0x34, 0x39, 0x63, 0x62, 
+0x35, 0x33, 0x34, 0x63, 0x32, 0x30, 0x34, 0x37, 
+0x34, 0x63, 0x34, 0x64, 0x65, 0x65, 0x31, 0x65, 
+0x39, 0x63, 0x34, 0x63, 0x33, 0x31, 0x37, 0x65, 
+0x37, 0x65, 0x62, 0x38, 0x38, 0x61, 0x63, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x34, 0x33, 0x66, 0x66, 0x64, 0x36, 0x30, 0x64, 
+0x33, 0x38, 0x31, 0x38, 0x34, 0x33, 0x31, 0x63, 
+0x34, 0x39, 0x35, 0x62, 0x38, 0x39, 0x62, 0x65, 
+0x38, 0x34, 0x61, 0x66, 0x61, 0x63, 0x32, 0x30, 
+0x35, 0x64, 0x35, 0x64, 0x31, 0x65, 0x64, 0x36, 
+0x36, 0x33, 0x30, 0x30, 0x39, 0x32, 0x39, 0x31, 
+0x63, 0x35, 0x36, 0x30, 0x37, 0x35, 0x38, 0x62, 
+0x62, 0x64, 0x30, 0x61, 0x36, 0x36, 0x64, 0x66, 
+0x35, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x36, 0x62, 0x34, 0x38, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x66, 
+0x33, 0x34, 0x34, 0x36, 0x30, 0x37, 0x64, 0x65, 
+0x39, 0x64, 0x66, 0x34, 0x32, 0x30, 0x34, 0x39, 
+0x36, 0x38, 0x38, 0x64, 0x63, 0x61, 0x65, 0x38, 
+0x66, 0x66, 0x31, 0x64, 0x62, 0x33, 0x34, 0x63, 
+0x30, 0x63, 0x37, 0x63, 0x64, 0x32, 0x35, 0x65, 
+0x63, 0x30, 0x35, 0x35, 0x31, 0x36, 0x65, 0x33, 
+0x30, 0x64, 0x32, 0x62, 0x63, 0x38, 0x66, 0x31, 
+0x32, 0x61, 0x63, 0x39, 0x62, 0x32, 0x66, 0x30, 
+0x32, 0x32, 0x30, 0x36, 0x30, 0x62, 0x36, 0x34, 
+0x38, 0x66, 0x36, 0x61, 0x32, 0x31, 0x37, 0x34, 
+0x35, 0x65, 0x61, 0x36, 0x64, 0x39, 0x37, 0x38, 
+0x32, 0x65, 0x31, 0x37, 0x62, 0x63, 0x63, 0x34, 
+0x32, 0x37, 0x37, 0x62, 0x35, 0x38, 0x30, 0x38, 
+0x33, 0x32, 0x36, 0x34, 0x38, 0x38, 0x61, 0x31, 
+0x66, 0x34, 0x30, 0x64, 0x34, 0x31, 0x65, 0x31, 
+0x32, 0x35, 0x38, 0x37, 0x39, 0x37, 0x32, 0x33, 
+0x64, 0x33, 0x61, 0x30, 0x31, 0x32, 0x31, 0x30, 
+0x33, 0x66, 0x37, 0x61, 0x38, 0x39, 0x37, 0x65, 
+0x34, 0x64, 0x62, 0x65, 0x63, 0x61, 0x62, 0x32, 
+0x32, 0x36, 0x34, 0x62, 0x32, 0x31, 0x39, 0x31, 
+0x37, 0x66, 0x39, 0x30, 0x36, 0x36, 0x34, 0x65, 
+0x61, 0x38, 0x32, 0x35, 0x36, 0x31, 0x38, 0x39, 
+0x65, 0x61, 0x37, 0x32, 0x35, 0x64, 0x32, 0x38, 
+0x37, 0x34, 0x30, 0x63, 0x66, 0x37, 0x62, 0x61, 
+0x35, 0x64, 0x38, 0x35, 0x62, 0x35, 0x37, 0x36, 
+0x33, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x61, 0x35, 0x33, 0x37, 0x39, 0x34, 0x30, 
+0x31, 0x63, 0x63, 0x65, 0x33, 0x30, 0x66, 0x38, 
+0x34, 0x37, 0x33, 0x31, 0x65, 0x66, 0x31, 0x62, 
+0x61, 0x36, 0x35, 0x63, 0x65, 0x32, 0x37, 0x65, 
+0x64, 0x66, 0x32, 0x63, 0x63, 0x37, 0x63, 0x65, 
+0x35, 0x37, 0x37, 0x30, 0x34, 0x35, 0x30, 0x37, 
+0x65, 0x62, 0x65, 0x38, 0x37, 0x31, 0x34, 0x61, 
+0x61, 0x31, 0x36, 0x61, 0x39, 0x36, 0x62, 0x39, 
+0x32, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x36, 0x61, 0x34, 0x37, 0x33, 0x30, 0x34, 
+0x34, 0x30, 0x32, 0x32, 0x30, 0x32, 0x30, 0x63, 
+0x33, 0x37, 0x61, 0x36, 0x33, 0x62, 0x66, 0x34, 
+0x64, 0x37, 0x66, 0x35, 0x36, 0x34, 0x63, 0x32, 
+0x31, 0x39, 0x32, 0x35, 0x32, 0x38, 0x37, 0x30, 
+0x39, 0x62, 0x36, 0x61, 0x33, 0x38, 0x61, 0x62, 
+0x38, 0x32, 0x37, 0x31, 0x62, 0x64, 0x39, 0x36, 
+0x38, 0x39, 0x38, 0x63, 0x36, 0x63, 0x32, 0x65, 
+0x33, 0x33, 0x35, 0x65, 0x35, 0x32, 0x30, 0x38, 
+0x36, 0x36, 0x31, 0x35, 0x38, 0x30, 0x32, 0x32, 
+0x30, 0x34, 0x33, 0x35, 0x63, 0x36, 0x66, 0x31, 
+0x61, 0x64, 0x34, 0x64, 0x39, 0x33, 0x30, 0x35, 
+0x64, 0x32, 0x63, 0x30, 0x61, 0x38, 0x31, 0x38, 
+0x62, 0x32, 0x66, 0x65, 0x62, 0x35, 0x65, 0x34, 
+0x35, 0x64, 0x34, 0x34, 0x33, 0x66, 0x32, 0x66, 
+0x31, 0x36, 0x32, 0x63, 0x30, 0x66, 0x36, 0x31, 
+0x39, 0x35, 0x33, 0x61, 0x31, 0x34, 0x64, 0x30, 
+0x39, 0x37, 0x66, 0x64, 0x30, 0x37, 0x30, 0x36, 
+0x34, 0x30, 0x31, 0x32, 0x31, 0x30, 0x33, 0x66, 
+0x37, 0x61, 0x38, 0x39, 0x37, 0x65, 0x34, 0x64, 
+0x62, 0x65, 0x63, 0x61, 0x62, 0x32, 0x32, 0x36, 
+0x34, 0x62, 0x32, 0x31, 0x39, 0x31, 0x37, 0x66, 
+0x39, 0x30, 0x36, 0x36, 0x34, 0x65, 0x61, 0x38, 
+0x32, 0x35, 0x36, 0x31, 0x38, 0x39, 0x65, 0x61, 
+0x37, 0x32, 0x35, 0x64, 0x32, 0x38, 0x37, 0x34, 
+0x30, 0x63, 0x66, 0x37, 0x62, 0x61, 0x35, 0x64, 
+0x38, 0x35, 0x62, 0x35, 0x37, 0x36, 0x33, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x37, 
+0x30, 0x65, 0x37, 0x33, 0x31, 0x65, 0x31, 0x39, 
+0x33, 0x32, 0x33, 0x35, 0x66, 0x66, 0x31, 0x32, 
+0x63, 0x33, 0x31, 0x38, 0x34, 0x35, 0x31, 0x30, 
+0x38, 0x39, 0x35, 0x37, 0x33, 0x31, 0x61, 0x30, 
+0x39, 0x39, 0x31, 0x31, 0x32, 0x66, 0x66, 0x63, 
+0x61, 0x34, 0x62, 0x30, 0x30, 0x32, 0x34, 0x36, 
+0x63, 0x36, 0x30, 0x30, 0x30, 0x33, 0x63, 0x34, 
+0x30, 0x66, 0x38, 0x34, 0x33, 0x63, 0x65, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 
+0x61, 0x34, 0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 
+0x32, 0x32, 0x30, 0x35, 0x33, 0x37, 0x36, 0x30, 
+0x66, 0x37, 0x34, 0x63, 0x32, 0x39, 0x61, 0x38, 
+0x37, 0x39, 0x65, 0x33, 0x30, 0x61, 0x31, 0x37, 
+0x62, 0x35, 0x66, 0x30, 0x33, 0x61, 0x35, 0x62, 
+0x62, 0x30, 0x35, 0x37, 0x61, 0x35, 0x37, 0x35, 
+0x31, 0x61, 0x33, 0x39, 0x66, 0x38, 0x36, 0x66, 
+0x61, 0x36, 0x65, 0x63, 0x64, 0x65, 0x64, 0x63, 
+0x33, 0x36, 0x61, 0x31, 0x62, 0x37, 0x64, 0x62, 
+0x30, 0x34, 0x63, 0x30, 0x32, 0x32, 0x30, 0x34, 
+0x31, 0x64, 0x34, 0x31, 0x63, 0x39, 0x62, 0x39, 
+0x35, 0x66, 0x30, 0x30, 0x64, 0x32, 0x64, 0x31, 
+0x30, 0x61, 0x30, 0x33, 0x37, 0x33, 0x33, 0x32, 
+0x32, 0x61, 0x39, 0x30, 0x32, 0x35, 0x64, 0x62, 
+0x61, 0x36, 0x36, 0x63, 0x39, 0x34, 0x32, 0x31, 
+0x39, 0x36, 0x62, 0x63, 0x39, 0x64, 0x38, 0x61, 
+0x64, 0x65, 0x62, 0x30, 0x65, 0x31, 0x32, 0x64, 
+0x33, 0x30, 0x32, 0x34, 0x37, 0x32, 0x38, 0x30, 
+0x31, 0x32, 0x31, 0x30, 0x33, 0x66, 0x37, 0x61, 
+0x38, 0x39, 0x37, 0x65, 0x34, 0x64, 0x62, 0x65, 
+0x63, 0x61, 0x62, 0x32, 0x32, 0x36, 0x34, 0x62, 
+0x32, 0x31, 0x39, 0x31, 0x37, 0x66, 0x39, 0x30, 
+0x36, 0x36, 0x34, 0x65, 0x61, 0x38, 0x32, 0x35, 
+0x36, 0x31, 0x38, 0x39, 0x65, 0x61, 0x37, 0x32, 
+0x35, 0x64, 0x32, 0x38, 0x37, 0x34, 0x30, 0x63, 
+0x66, 0x37, 0x62, 0x61, 0x35, 0x64, 0x38, 0x35, 
+0x62, 0x35, 0x37, 0x36, 0x33, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x66, 0x36, 0x36, 0x62, 
+0x37, 0x61, 0x37, 0x31, 0x62, 0x33, 0x65, 0x35, 
+0x30, 0x33, 0x37, 0x39, 0x63, 0x38, 0x65, 0x38, 
+0x35, 0x66, 0x63, 0x31, 0x38, 0x66, 0x65, 0x33, 
+0x66, 0x31, 0x61, 0x34, 0x30, 0x38, 0x66, 0x63, 
+0x39, 0x38, 0x35, 0x66, 0x32, 0x35, 0x37, 0x30, 
+0x33, 0x36, 0x63, 0x33, 0x34, 0x37, 0x30, 0x32, 
+0x62, 0x61, 0x32, 0x30, 0x35, 0x63, 0x65, 0x66, 
+0x30, 0x39, 0x66, 0x36, 0x66, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x36, 0x61, 0x34, 
+0x37, 0x33, 0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 
+0x30, 0x34, 0x39, 0x39, 0x62, 0x66, 0x39, 0x65, 
+0x32, 0x64, 0x62, 0x33, 0x64, 0x62, 0x36, 0x65, 
+0x39, 0x33, 0x30, 0x32, 0x32, 0x38, 0x64, 0x30, 
+0x36, 0x36, 0x31, 0x33, 0x39, 0x35, 0x66, 0x36, 
+0x35, 0x34, 0x33, 0x31, 0x61, 0x63, 0x61, 0x65, 
+0x34, 0x36, 0x36, 0x36, 0x33, 0x34, 0x64, 0x30, 
+0x39, 0x38, 0x36, 0x31, 0x32, 0x66, 0x64, 0x38, 
+0x30, 0x62, 0x30, 0x38, 0x34, 0x35, 0x39, 0x65, 
+0x65, 0x30, 0x32, 0x32, 0x30, 0x34, 0x30, 0x65, 
+0x30, 0x36, 0x39, 0x66, 0x63, 0x39, 0x65, 0x33, 
+0x63, 0x36, 0x30, 0x30, 0x30, 0x39, 0x66, 0x35, 
+0x32, 0x31, 0x63, 0x65, 0x66, 0x35, 0x34, 0x63, 
+0x33, 0x38, 0x61, 0x61, 0x64, 0x62, 0x64, 0x31, 
+0x32, 0x35, 0x31, 0x61, 0x65, 0x65, 0x33, 0x37, 
+0x39, 0x34, 0x30, 0x65, 0x36, 0x30, 0x31, 0x38, 
+0x61, 0x61, 0x64, 0x62, 0x31, 0x30, 0x66, 0x31, 
+0x39, 0x34, 0x64, 0x36, 0x61, 0x30, 0x31, 0x32, 
+0x31, 0x30, 0x33, 0x66, 0x37, 0x61, 0x38, 0x39, 
+0x37, 0x65, 0x34, 0x64, 0x62, 0x65, 0x63, 0x61, 
+0x62, 0x32, 0x32, 0x36, 0x34, 0x62, 0x32, 0x31, 
+0x39, 0x31, 0x37, 0x66, 0x39, 0x30, 0x36, 0x36, 
+0x34, 0x65, 0x61, 0x38, 0x32, 0x35, 0x36, 0x31, 
+0x38, 0x39, 0x65, 0x61, 0x37, 0x32, 0x35, 0x64, 
+0x32, 0x38, 0x37, 0x34, 0x30, 0x63, 0x66, 0x37, 
+0x62, 0x61, 0x35, 0x64, 0x38, 0x35, 0x62, 0x35, 
+0x37, 0x36, 0x33, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x30, 0x32, 0x30, 0x30, 0x65, 
+0x31, 0x66, 0x35, 0x30, 0x35, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x37, 0x61, 
+0x39, 0x31, 0x34, 0x38, 0x66, 0x63, 0x33, 0x37, 
+0x61, 0x64, 0x34, 0x36, 0x30, 0x66, 0x64, 0x66, 
+0x62, 0x64, 0x32, 0x62, 0x34, 0x34, 0x66, 0x65, 
+0x34, 0x34, 0x36, 0x66, 0x36, 0x65, 0x33, 0x30, 
+0x37, 0x31, 0x61, 0x34, 0x66, 0x36, 0x34, 0x66, 
+0x61, 0x61, 0x36, 0x38, 0x37, 0x38, 0x66, 0x34, 
+0x34, 0x37, 0x66, 0x30, 0x62, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 
+0x36, 0x61, 0x39, 0x31, 0x34, 0x39, 0x31, 0x33, 
+0x62, 0x63, 0x63, 0x32, 0x62, 0x65, 0x34, 0x39, 
+0x63, 0x62, 0x35, 0x33, 0x34, 0x63, 0x32, 0x30, 
+0x34, 0x37, 0x34, 0x63, 0x34, 0x64, 0x65, 0x65, 
+0x31, 0x65, 0x39, 0x63, 0x34, 0x63, 0x33, 0x31, 
+0x37, 0x65, 0x37, 0x65, 0x62, 0x38, 0x38, 0x61, 
+0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x22, 0x2c, 0x5b, 0x22, 0x61, 0x39, 0x31, 
+0x34, 0x66, 0x65, 0x62, 0x38, 0x61, 0x32, 0x39, 
+0x36, 0x33, 0x35, 0x63, 0x35, 0x36, 0x64, 0x39, 
+0x63, 0x64, 0x39, 0x31, 0x33, 0x31, 0x32, 0x32, 
+0x66, 0x39, 0x30, 0x36, 0x37, 0x38, 0x37, 0x35, 
+0x36, 0x62, 0x66, 0x32, 0x33, 0x38, 0x38, 0x37, 
+0x36, 0x38, 0x37, 0x22, 0x2c, 0x22, 0x37, 0x36, 
+0x61, 0x39, 0x31, 0x34, 0x63, 0x30, 0x31, 0x61, 
+0x37, 0x63, 0x61, 0x31, 0x36, 0x62, 0x34, 0x37, 
+0x62, 0x65, 0x35, 0x30, 0x63, 0x62, 0x64, 0x62, 
+0x63, 0x36, 0x30, 0x37, 0x32, 0x34, 0x66, 0x37, 
+0x30, 0x31, 0x64, 0x35, 0x32, 0x64, 0x37, 0x35, 
+0x31, 0x35, 0x36, 0x36, 0x38, 0x38, 0x61, 0x63, 
+0x22, 0x2c, 0x22, 0x37, 0x36, 0x61, 0x39, 0x31, 
+0x34, 0x39, 0x31, 0x33, 0x62, 0x63, 0x63, 0x32, 
+0x62, 0x65, 0x34, 0x39, 0x63, 0x62, 0x35, 0x33, 
+0x34, 0x63, 0x32, 0x30, 0x34, 0x37, 0x34, 0x63, 
+0x34, 0x64, 0x65, 0x65, 0x31, 0x65, 0x39, 0x63, 
+0x34, 0x63, 0x33, 0x31, 0x37, 0x65, 0x37, 0x65, 
+0x62, 0x38, 0x38, 0x61, 0x63, 0x22, 0x2c, 0x22, 
+0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 0x39, 0x31, 
+0x33, 0x62, 0x63, 0x63, 0x32, 0x62, 0x65, 0x34, 
+0x39, 0x63, 0x62, 0x35, 0x33, 0x34, 0x63, 0x32, 
+0x30, 0x34, 0x37, 0x34, 0x63, 0x34, 0x64, 0x65, 
+0x65, 0x31, 0x65, 0x39, 0x63, 0x34, 0x63, 0x33, 
+0x31, 0x37, 0x65, 0x37, 0x65, 0x62, 0x38, 0x38, 
+0x61, 0x63, 0x22, 0x2c, 0x22, 0x37, 0x36, 0x61, 
+0x39, 0x31, 0x34, 0x39, 0x31, 0x33, 0x62, 0x63, 
+0x63, 0x32, 0x62, 0x65, 0x34, 0x39, 0x63, 0x62, 
+0x35, 0x33, 0x34, 0x63, 0x32, 0x30, 0x34, 0x37, 
+0x34, 0x63, 0x34, 0x64, 0x65, 0x65, 0x31, 0x65, 
+0x39, 0x63, 0x34, 0x63, 0x33, 0x31, 0x37, 0x65, 
+0x37, 0x65, 0x62, 0x38, 0x38, 0x61, 0x63, 0x22, 
+0x2c, 0x22, 0x37, 0x36, 0x61, 0x39, 0x31, 0x34, 
+0x39, 0x31, 0x33, 0x62, 0x63, 0x63, 0x32, 0x62, 
+0x65, 0x34, 0x39, 0x63, 0x62, 0x35, 0x33, 0x34, 
+0x63, 0x32, 0x30, 0x34, 0x37, 0x34, 0x63, 0x34, 
+0x64, 0x65, 0x65, 0x31, 0x65, 0x39, 0x63, 0x34, 
+0x63, 0x33, 0x31, 0x37, 0x65, 0x37, 0x65, 0x62, 
+0x38, 0x38, 0x61, 0x63, 0x22, 0x2c, 0x22, 0x37, 
+0x36, 0x61, 0x39, 0x31, 0x34, 0x39, 0x31, 0x33, 
+0x62, 0x63, 0x63, 0x32, 0x62, 0x65, 0x34, 0x39, 
+0x63, 0x62, 0x35, 0x33, 0x34, 0x63, 0x32, 0x30, 
+0x34, 0x37, 0x34, 0x63, 0x34, 0x64, 0x65, 0x65, 
+0x31, 0x65, 0x39, 0x63, 0x34, 0x63, 0x33, 0x31, 
+0x37, 0x65, 0x37, 0x65, 0x62, 0x38, 0x38, 0x61, 
+0x63, 0x22, 0x2c, 0x22, 0x37, 0x36, 0x61, 0x39, 
+0x31, 0x34, 0x39, 0x31, 0x33, 0x62, 0x63, 0x63, 
+0x32, 0x62, 0x65, 0x34, 0x39, 0x63, 0x62, 0x35, 
+0x33, 0x34, 0x63, 0x32, 0x30, 0x34, 0x37, 0x34, 
+0x63, 0x34, 0x64, 0x65, 0x65, 0x31, 0x65, 0x39, 
+0x63, 0x34, 0x63, 0x33, 0x31, 0x37, 0x65, 0x37, 
+0x65, 0x62, 0x38, 0x38, 0x61, 0x63, 0x22, 0x5d, 
+0x2c, 0x22, 0x64, 0x61, 0x34, 0x39, 0x39, 0x37, 
+0x37, 0x62, 0x61, 0x31, 0x65, 0x65, 0x30, 0x64, 
+0x36, 0x32, 0x30, 0x61, 0x32, 0x63, 0x34, 0x66, 
+0x38, 0x66, 0x36, 0x34, 0x36, 0x62, 0x30, 0x33, 
+0x63, 0x64, 0x30, 0x64, 0x32, 0x33, 0x30, 0x66, 
+0x35, 0x63, 0x36, 0x63, 0x39, 0x39, 0x34, 0x37, 
+0x32, 0x32, 0x65, 0x33, 0x62, 0x61, 0x38, 0x38, 
+0x34, 0x38, 0x38, 0x39, 0x66, 0x30, 0x62, 0x65, 
+0x31, 0x61, 0x22, 0x2c, 0x22, 0x30, 0x39, 0x30, 
+0x32, 0x37, 0x61, 0x63, 0x65, 0x61, 0x36, 0x31, 
+0x62, 0x36, 0x63, 0x63, 0x33, 0x66, 0x62, 0x33, 
+0x33, 0x66, 0x35, 0x64, 0x35, 0x32, 0x66, 0x37, 
+0x64, 0x30, 0x38, 0x38, 0x61, 0x36, 0x62, 0x32, 
+0x66, 0x37, 0x35, 0x64, 0x32, 0x33, 0x34, 0x65, 
+0x38, 0x39, 0x63, 0x61, 0x38, 0x30, 0x30, 0x22, 
+0x2c, 0x22, 0x34, 0x63, 0x64, 0x39, 0x64, 0x64, 
+0x30, 0x30, 0x37, 0x61, 0x33, 0x32, 0x35, 0x31, 
+0x39, 0x39, 0x31, 0x30, 0x32, 0x66, 0x31, 0x66, 
+0x63, 0x30, 0x62, 0x37, 0x64, 0x37, 0x37, 0x63, 
+0x61, 0x32, 0x35, 0x65, 0x65, 0x33, 0x63, 0x38, 
+0x34, 0x64, 0x34, 0x36, 0x30, 0x31, 0x38, 0x63, 
+0x34, 0x33, 0x35, 0x33, 0x65, 0x63, 0x66, 0x63, 
+0x62, 0x35, 0x36, 0x63, 0x30, 0x64, 0x33, 0x65, 
+0x37, 0x61, 0x22, 0x2c, 0x22, 0x44, 0x75, 0x70, 
+0x6c, 0x69, 0x63, 0x61, 0x74, 0x65, 0x20, 0x70, 
+0x75, 0x73, 0x68, 0x64, 0x61, 0x74, 0x61, 0x20, 
+0x39, 0x31, 0x33, 0x62, 0x63, 0x63, 0x32, 0x62, 
+0x65, 0x34, 0x39, 0x63, 0x62, 0x35, 0x33, 0x34, 
+0x63, 0x32, 0x30, 0x34, 0x37, 0x34, 0x63, 0x34, 
+0x64, 0x65, 0x65, 0x31, 0x65, 0x39, 0x63, 0x34, 
+0x63, 0x33, 0x31, 0x37, 0x65, 0x37, 0x65, 0x62, 
+0x22, 0x5d, 0x2c, 0x0a, 0x5b, 0x39, 0x38, 0x37, 
+0x38, 0x37, 0x36, 0x2c, 0x22, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x63, 0x30, 0x30, 0x39, 0x30, 0x31, 
+0x66, 0x32, 0x30, 0x34, 0x39, 0x30, 0x35, 0x35, 
+0x65, 0x32, 0x61, 0x34, 0x33, 0x37, 0x63, 0x38, 
+0x31, 0x39, 0x64, 0x37, 0x39, 0x61, 0x33, 0x64, 
+0x35, 0x34, 0x66, 0x64, 0x36, 0x33, 0x65, 0x36, 
+0x61, 0x66, 0x37, 0x39, 0x36, 0x63, 0x64, 0x37, 
+0x62, 0x38, 0x61, 0x37, 0x39, 0x22, 0x2c, 0x22, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 0x30, 
+0x32, 0x36, 0x39, 0x34, 0x66, 0x37, 0x34, 0x39, 
+0x36, 0x39, 0x66, 0x64, 0x62, 0x35, 0x34, 0x32, 
+0x30, 0x39, 0x30, 0x65, 0x39, 0x35, 0x61, 0x35, 
+0x36, 0x62, 0x63, 0x38, 0x61, 0x61, 0x32, 0x64, 
+0x36, 0x34, 0x36, 0x65, 0x32, 0x37, 0x30, 0x33, 
+0x33, 0x38, 0x35, 0x30, 0x65, 0x33, 0x32, 0x66, 
+0x31, 0x63, 0x35, 0x66, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x66, 0x37, 0x65, 0x35, 0x33, 0x36, 0x37, 0x36, 
+0x62, 0x33, 0x66, 0x31, 0x32, 0x64, 0x35, 0x62, 
+0x65, 0x62, 0x35, 0x32, 0x34, 0x65, 0x64, 0x36, 
+0x31, 0x37, 0x66, 0x32, 0x64, 0x32, 0x35, 0x66, 
+0x35, 0x61, 0x39, 0x33, 0x62, 0x35, 0x66, 0x34, 
+0x66, 0x35, 0x32, 0x63, 0x31, 0x62, 0x61, 0x32, 
+0x36, 0x37, 0x38, 0x32, 0x36, 0x30, 0x64, 0x37, 
+0x32, 0x37, 0x31, 0x32, 0x66, 0x38, 0x64, 0x64, 
+0x30, 0x61, 0x36, 0x64, 0x66, 0x65, 0x35, 0x37, 
+0x34, 0x30, 0x32, 0x35, 0x37, 0x65, 0x31, 0x61, 
+0x34, 0x62, 0x31, 0x37, 0x36, 0x38, 0x39, 0x36, 
+0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x66, 0x31, 0x36, 0x30, 0x33, 
+0x65, 0x34, 0x31, 0x32, 0x30, 0x66, 0x66, 0x39, 
+0x63, 0x33, 0x30, 0x61, 0x31, 0x63, 0x32, 0x31, 
+0x36, 0x39, 0x30, 0x30, 0x30, 0x30, 0x32, 0x66, 
+0x34, 0x32, 0x34, 0x64, 0x34, 0x39, 0x32, 0x30, 
+0x35, 0x34, 0x36, 0x35, 0x37, 0x33, 0x37, 0x34, 
+0x32, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x30, 0x30, 0x30, 0x31, 0x32, 0x30, 0x35, 0x66, 
+0x61, 0x30, 0x31, 0x32, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x65, 0x37, 0x36, 
+0x61, 0x39, 0x31, 0x34, 0x63, 0x34, 0x38, 0x36, 
+0x64, 0x65, 0x35, 0x38, 0x34, 0x61, 0x37, 0x33, 
+0x35, 0x65, 0x63, 0x32, 0x66, 0x32, 0x32, 0x64, 
+0x61, 0x37, 0x63, 0x64, 0x39, 0x36, 0x38, 0x31, 
+0x36, 0x31, 0x34, 0x36, 0x38, 0x31, 0x66, 0x39, 
+0x32, 0x31, 0x37, 0x33, 0x64, 0x38, 0x33, 0x64, 
+0x30, 0x61, 0x61, 0x36, 0x38, 0x36, 0x38, 0x38, 
+0x61, 0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x22, 0x2c, 0x5b, 0x5d, 0x2c, 0x22, 
+0x65, 0x39, 0x64, 0x37, 0x32, 0x39, 0x62, 0x37, 
+0x32, 0x64, 0x35, 0x33, 0x33, 0x63, 0x32, 0x39, 
+0x61, 0x62, 0x65, 0x35, 0x32, 0x37, 0x36, 0x64, 
+0x35, 0x63, 0x66, 0x36, 0x63, 0x31, 0x35, 0x32, 
+0x66, 0x33, 0x37, 0x32, 0x33, 0x66, 0x31, 0x30, 
+0x65, 0x66, 0x65, 0x30, 0x30, 0x30, 0x62, 0x31, 
+0x65, 0x30, 0x63, 0x39, 0x63, 0x61, 0x35, 0x32, 
+0x36, 0x35, 0x61, 0x38, 0x62, 0x65, 0x62, 0x36, 
+0x22, 0x2c, 0x22, 0x30, 0x31, 0x30, 0x63, 0x30, 
+0x62, 0x34, 0x30, 0x22, 0x2c, 0x22, 0x65, 0x36, 
+0x31, 0x33, 0x37, 0x61, 0x65, 0x35, 0x61, 0x38, 
+0x34, 0x32, 0x34, 0x63, 0x34, 0x30, 0x64, 0x61, 
+0x31, 0x65, 0x35, 0x30, 0x32, 0x33, 0x63, 0x31, 
+0x36, 0x39, 0x37, 0x35, 0x63, 0x63, 0x39, 0x37, 
+0x62, 0x30, 0x39, 0x33, 0x30, 0x30, 0x62, 0x34, 
+0x63, 0x30, 0x35, 0x30, 0x65, 0x36, 0x62, 0x31, 
+0x63, 0x37, 0x31, 0x33, 0x61, 0x64, 0x64, 0x33, 
+0x38, 0x33, 0x36, 0x63, 0x34, 0x30, 0x22, 0x2c, 
+0x22, 0x43, 0x6f, 0x69, 0x6e, 0x62, 0x61, 0x73, 
+0x65, 0x20, 0x74, 0x78, 0x20, 0x68, 0x61, 0x73, 
+0x20, 0x75, 0x6e, 0x70, 0x61, 0x72, 0x73, 0x65, 
+0x61, 0x62, 0x6c, 0x65, 0x20, 0x6f, 0x75, 0x74, 
+0x70, 0x75, 0x74, 0x20, 0x73, 0x63, 0x72, 0x69, 
+0x70, 0x74, 0x22, 0x5d, 0x2c, 0x0a, 0x5b, 0x31, 
+0x32, 0x36, 0x33, 0x34, 0x34, 0x32, 0x2c, 0x22, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x36, 0x66, 0x32, 0x37, 0x64, 0x64, 0x66, 0x65, 
+0x31, 0x64, 0x64, 0x36, 0x38, 0x30, 0x30, 0x34, 
+0x34, 0x61, 0x33, 0x34, 0x35, 0x34, 0x38, 0x66, 
+0x34, 0x31, 0x62, 0x65, 0x64, 0x34, 0x37, 0x65, 
+0x62, 0x61, 0x39, 0x65, 0x36, 0x66, 0x30, 0x62, 
+0x33, 0x31, 0x30, 0x64, 0x61, 0x32, 0x31, 0x34, 
+0x32, 0x33, 0x62, 0x63, 0x35, 0x66, 0x33, 0x33, 
+0x22, 0x2c, 0x22, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x32, 0x30, 0x31, 0x63, 0x38, 0x64, 0x31, 
+0x61, 0x35, 0x32, 0x39, 0x63, 0x33, 0x39, 0x61, 
+0x33, 0x39, 0x36, 0x64, 0x62, 0x32, 0x64, 0x62, 
+0x32, 0x33, 0x34, 0x64, 0x35, 0x65, 0x63, 0x31, 
+0x35, 0x32, 0x66, 0x61, 0x36, 0x35, 0x31, 0x61, 
+0x32, 0x38, 0x37, 0x32, 0x39, 0x36, 0x36, 0x64, 
+0x61, 0x63, 0x63, 0x62, 0x64, 0x65, 0x30, 0x32, 
+0x38, 0x62, 0x34, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x38, 0x33, 0x66, 0x31, 
+0x34, 0x34, 0x39, 0x32, 0x36, 0x37, 0x39, 0x31, 
+0x35, 0x31, 0x64, 0x62, 0x66, 0x61, 0x61, 0x31, 
+0x61, 0x38, 0x32, 0x35, 0x65, 0x66, 0x34, 0x63, 
+0x31, 0x38, 0x35, 0x31, 0x38, 0x65, 0x37, 0x38, 
+0x30, 0x63, 0x31, 0x66, 0x39, 0x31, 0x30, 0x34, 
+0x34, 0x31, 0x38, 0x30, 0x32, 0x38, 0x30, 0x61, 
+0x37, 0x64, 0x33, 0x33, 0x66, 0x34, 0x61, 0x39, 
+0x38, 0x66, 0x66, 0x35, 0x66, 0x34, 0x35, 0x37, 
+0x36, 0x35, 0x61, 0x61, 0x64, 0x64, 0x63, 0x30, 
+0x30, 0x31, 0x64, 0x33, 0x38, 0x33, 0x33, 0x33, 
+0x62, 0x39, 0x61, 0x30, 0x32, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x32, 0x33, 0x30, 0x33, 0x35, 
+0x32, 0x34, 0x37, 0x31, 0x33, 0x30, 0x30, 0x66, 
+0x65, 0x35, 0x66, 0x34, 0x35, 0x37, 0x36, 0x35, 
+0x61, 0x66, 0x65, 0x39, 0x34, 0x36, 0x39, 0x30, 
+0x61, 0x30, 0x30, 0x30, 0x39, 0x36, 0x33, 0x36, 
+0x37, 0x36, 0x64, 0x36, 0x39, 0x36, 0x65, 0x36, 
+0x35, 0x37, 0x32, 0x33, 0x34, 0x33, 0x32, 0x30, 
+0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x66, 0x66, 0x66, 0x66, 0x66, 
+0x66, 0x66, 0x66, 0x30, 0x32, 0x34, 0x34, 0x32, 
+0x33, 0x61, 0x38, 0x30, 0x34, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x39, 0x37, 
+0x36, 0x61, 0x39, 0x31, 0x34, 0x66, 0x32, 0x63, 
+0x32, 0x35, 0x61, 0x63, 0x33, 0x64, 0x35, 0x39, 
+0x66, 0x33, 0x64, 0x36, 0x37, 0x34, 0x62, 0x31, 
+0x64, 0x31, 0x64, 0x30, 0x61, 0x32, 0x35, 0x63, 
+0x32, 0x37, 0x33, 0x33, 0x39, 0x61, 0x61, 0x61, 
+0x63, 0x30, 0x62, 0x61, 0x36, 0x38, 0x38, 0x61, 
+0x63, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x32, 0x36, 0x36, 0x61, 0x32, 0x34, 0x61, 
+0x61, 0x32, 0x31, 0x61, 0x39, 0x65, 0x64, 0x63, 
+0x62, 0x32, 0x36, 0x63, 0x62, 0x33, 0x30, 0x35, 
+0x32, 0x34, 0x32, 0x36, 0x62, 0x39, 0x65, 0x62, 
+0x62, 0x34, 0x64, 0x31, 0x39, 0x63, 0x38, 0x31, 
+0x39, 0x65, 0x66, 0x38, 0x37, 0x63, 0x31, 0x39, 
+0x36, 0x37, 0x37, 0x62, 0x62, 0x66, 0x33, 0x61, 
+0x37, 0x63, 0x34, 0x36, 0x65, 0x66, 0x30, 0x38, 
+0x35, 0x35, 0x62, 0x64, 0x31, 0x62, 0x32, 0x61, 
+0x62, 0x65, 0x38, 0x33, 0x34, 0x39, 0x31, 0x30, 
+0x31, 0x32, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x32, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x30, 
+0x31, 0x64, 0x32, 0x30, 0x39, 0x37, 0x38, 0x34, 
+0x36, 0x33, 0x39, 0x30, 0x36, 0x62, 0x61, 0x34, 
+0x66, 0x66, 0x35, 0x65, 0x37, 0x31, 0x39, 0x32, 
+0x34, 0x39, 0x34, 0x62, 0x38, 0x38, 0x64, 0x64, 
+0x35, 0x65, 0x62, 0x30, 0x64, 0x65, 0x38, 0x35, 
+0x64, 0x39, 0x30, 0x30, 0x61, 0x62, 0x32, 0x35, 
+0x33, 0x61, 0x66, 0x39, 0x30, 0x39, 0x31, 0x30, 
+0x36, 0x66, 0x61, 0x61, 0x32, 0x32, 0x63, 0x63, 
+0x35, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x34, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x31, 0x34, 0x37, 0x37, 
+0x37, 0x66, 0x66, 0x30, 0x30, 0x30, 0x30, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x36, 0x30, 
+0x30, 0x31, 0x34, 0x34, 0x36, 0x63, 0x32, 0x39, 
+0x65, 0x61, 0x62, 0x65, 0x38, 0x32, 0x30, 0x38, 
+0x61, 0x33, 0x33, 0x61, 0x61, 0x31, 0x30, 0x32, 
+0x33, 0x63, 0x37, 0x34, 0x31, 0x66, 0x61, 0x37, 
+0x39, 0x61, 0x61, 0x39, 0x32, 0x65, 0x38, 0x38, 
+0x31, 0x66, 0x66, 0x30, 0x33, 0x34, 0x37, 0x33, 
+0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 0x30, 0x37, 
+0x64, 0x37, 0x63, 0x61, 0x39, 0x36, 0x31, 0x33, 
+0x34, 0x66, 0x32, 0x62, 0x63, 0x66, 0x64, 0x64, 
+0x36, 0x62, 0x35, 0x33, 0x36, 0x35, 0x33, 0x36, 
+0x66, 0x64, 0x64, 0x33, 0x39, 0x61, 0x64, 0x31, 
+0x37, 0x37, 0x39, 0x33, 0x36, 0x33, 0x32, 0x30, 
+0x31, 0x36, 0x39, 0x33, 0x36, 0x66, 0x37, 0x37, 
+0x37, 0x65, 0x62, 0x62, 0x33, 0x32, 0x63, 0x32, 
+0x32, 0x39, 0x34, 0x33, 0x66, 0x64, 0x61, 0x30, 
+0x32, 0x32, 0x30, 0x36, 0x30, 0x31, 0x34, 0x64, 
+0x32, 0x66, 0x62, 0x38, 0x61, 0x36, 0x61, 0x61, 
+0x35, 0x38, 0x32, 0x37, 0x39, 0x37, 0x39, 0x37, 
+0x66, 0x38, 0x36, 0x31, 0x30, 0x34, 0x32, 0x62, 
+0x61, 0x36, 0x30, 0x34, 0x65, 0x62, 0x64, 0x32, 
+0x66, 0x38, 0x66, 0x36, 0x31, 0x65, 0x35, 0x62, 
+0x64, 0x64, 0x62, 0x64, 0x39, 0x64, 0x33, 0x62, 
+0x65, 0x35, 0x61, 0x32, 0x34, 0x35, 0x30, 0x34, 
+0x37, 0x62, 0x32, 0x30, 0x31, 0x30, 0x30, 0x34, 
+0x62, 0x36, 0x33, 0x32, 0x31, 0x30, 0x33, 0x65, 
+0x65, 0x61, 0x65, 0x62, 0x61, 0x37, 0x63, 0x65, 
+0x35, 0x64, 0x63, 0x32, 0x34, 0x37, 0x30, 0x32, 
+0x32, 0x31, 0x65, 0x39, 0x35, 0x31, 0x37, 0x66, 
+0x62, 0x34, 0x39, 0x38, 0x65, 0x38, 0x64, 0x36, 
+0x62, 0x64, 0x34, 0x65, 0x37, 0x33, 0x62, 0x38, 
+0x35, 0x62, 0x38, 0x62, 0x65, 0x36, 0x35, 0x35, 
+0x31, 0x39, 0x36, 0x39, 0x37, 0x32, 0x65, 0x62, 
+0x39, 0x63, 0x63, 0x64, 0x35, 0x35, 0x36, 0x36, 
+0x37, 0x35, 0x34, 0x62, 0x32, 0x37, 0x35, 0x32, 
+0x31, 0x30, 0x33, 0x61, 0x34, 0x30, 0x62, 0x37, 
+0x34, 0x64, 0x34, 0x33, 0x64, 0x66, 0x32, 0x34, 
+0x34, 0x37, 0x39, 0x39, 0x64, 0x30, 0x34, 0x31, 
+0x66, 0x33, 0x32, 0x63, 0x65, 0x31, 0x61, 0x64, 
+0x35, 0x31, 0x35, 0x61, 0x36, 0x63, 0x64, 0x39, 
+0x39, 0x35, 0x30, 0x31, 0x37, 0x30, 0x31, 0x35, 
+0x34, 0x30, 0x65, 0x33, 0x38, 0x37, 0x35, 0x30, 
+0x64, 0x38, 0x38, 0x33, 0x61, 0x65, 0x32, 0x31, 
+0x64, 0x33, 0x61, 0x36, 0x38, 0x61, 0x63, 0x30, 
+0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x22, 
+0x2c, 0x5b, 0x22, 0x30, 0x30, 0x32, 0x30, 0x32, 
+0x37, 0x61, 0x35, 0x30, 0x30, 0x30, 0x63, 0x37, 
+0x39, 0x31, 0x37, 0x66, 0x37, 0x38, 0x35, 0x64, 
+0x38, 0x66, 0x63, 0x36, 0x65, 0x35, 0x61, 0x35, 
+0x35, 0x61, 0x64, 0x66, 0x63, 0x61, 0x38, 0x37, 
+0x31, 0x37, 0x65, 0x63, 0x62, 0x39, 0x37, 0x33, 
+0x65, 0x62, 0x62, 0x37, 0x37, 0x34, 0x33, 0x38, 
+0x34, 0x39, 0x66, 0x66, 0x39, 0x35, 0x36, 0x64, 
+0x38, 0x39, 0x36, 0x61, 0x37, 0x65, 0x64, 0x22, 
+0x5d, 0x2c, 0x22, 0x61, 0x34, 0x61, 0x34, 0x64, 
+0x36, 0x63, 0x36, 0x30, 0x33, 0x34, 0x64, 0x61, 
+0x38, 0x61, 0x61, 0x30, 0x36, 0x66, 0x30, 0x31, 
+0x66, 0x65, 0x37, 0x31, 0x66, 0x31, 0x66, 0x66, 
+0x66, 0x62, 0x64, 0x37, 0x39, 0x65, 0x30, 0x33, 
+0x32, 0x30, 0x30, 0x36, 0x62, 0x30, 0x37, 0x66, 
+0x36, 0x63, 0x37, 0x61, 0x32, 0x63, 0x36, 0x30, 
+0x61, 0x36, 0x36, 0x61, 0x61, 0x33, 0x31, 0x30, 
+0x63, 0x30, 0x31, 0x22, 0x2c, 0x22, 0x30, 0x33, 
+0x38, 0x35, 0x61, 0x63, 0x62, 0x34, 0x66, 0x30, 
+0x66, 0x65, 0x38, 0x38, 0x39, 0x65, 0x66, 0x30, 
+0x22, 0x2c, 0x22, 0x33, 0x35, 0x38, 0x38, 0x66, 
+0x33, 0x34, 0x66, 0x62, 0x62, 0x63, 0x31, 0x31, 
+0x36, 0x34, 0x30, 0x66, 0x39, 0x65, 0x64, 0x34, 
+0x30, 0x62, 0x32, 0x61, 0x36, 0x36, 0x61, 0x34, 
+0x65, 0x30, 0x39, 0x36, 0x32, 0x31, 0x35, 0x64, 
+0x35, 0x30, 0x33, 0x38, 0x39, 0x36, 0x39, 0x31, 
+0x33, 0x30, 0x39, 0x63, 0x31, 0x64, 0x61, 0x63, 
+0x37, 0x34, 0x64, 0x34, 0x32, 0x36, 0x38, 0x61, 
+0x61, 0x38, 0x31, 0x22, 0x2c, 0x22, 0x49, 0x6e, 
+0x63, 0x6c, 0x75, 0x64, 0x65, 0x73, 0x20, 0x77, 
+0x69, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x64, 
+0x61, 0x74, 0x61, 0x22, 0x5d, 0x0a, 0x5d, 0x0a, 
+};};
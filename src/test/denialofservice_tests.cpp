@@ -51,6 +51,13 @@ struct COrphanTx {
 extern CCriticalSection g_cs_orphans;
 extern std::map<uint256, COrphanTx> mapOrphanTransactions GUARDED_BY(g_cs_orphans);
 
+// Tests these internal-to-net_processing.cpp xbridge relay methods:
+extern void AddXBridgeRelayPacket(const uint256& hash, const std::vector<unsigned char>& packet);
+extern std::vector<std::vector<unsigned char>> FindXBridgeRelayPackets(const std::vector<uint256>& vHashes);
+extern std::vector<uint256> ProcessXBridgeInventory(CNode* pfrom, const std::vector<uint256>& vHashes);
+extern std::vector<uint256> GetXBridgeRequests(CNode* pnode);
+extern void XBridgePacketReceived(CNode* pfrom, const uint256& hash);
+
 static CService ip(uint32_t i)
 {
     struct in_addr s;
@@ -444,4 +451,136 @@ BOOST_AUTO_TEST_CASE(DoS_mapOrphans)
     BOOST_CHECK(mapOrphanTransactions.empty());
 }
 
+static size_t SentXBridgeBytes(CNode* node)
+{
+    CNodeStats stats;
+    node->copyStats(stats);
+    return stats.mapSendBytesPerMsgCmd[NetMsgType::XBRIDGE];
+}
+
+static size_t PendingXBridgeInventory(CNode* node)
+{
+    LOCK(node->cs_inventory);
+    return node->vInventoryXBridgeToSend.size();
+}
+
+BOOST_AUTO_TEST_CASE(xbridge_relay)
+{
+    auto connman = MakeUnique<CConnmanTest>(0x1337, 0x1337);
+    CAddress addr(ip(0xa0b0c001), NODE_NONE);
+    auto addNode = [&](const bool connected, const bool sendInv) -> CNode* {
+        CNode* node = new CNode(id++, NODE_NETWORK, 0, INVALID_SOCKET, addr, 0, 0, CAddress(), "", /*fInboundIn=*/ true);
+        node->fSuccessfullyConnected = connected;
+        node->fSendXBridgeInv = sendInv;
+        connman->AddNode(*node);
+        return node;
+    };
+    CNode* invPeer = addNode(true, true);
+    CNode* fullPeer = addNode(true, false);
+    CNode* handshakePeer = addNode(false, false);
+    CNode* disconnectPeer = addNode(true, false);
+    disconnectPeer->fDisconnect = true;
+    CNode* fromPeer = addNode(true, true);
+
+    const int64_t nStartTime = GetTime();
+    SetMockTime(nStartTime);
+
+    const std::vector<unsigned char> packet = g_insecure_rand_ctx.randbytes(100);
+    const uint256 hash = Hash(packet.begin(), packet.end());
+    RelayXBridgePacket(packet, connman.get(), fromPeer->GetId());
+
+    // Announce to inv peers, send the packet to other fully connected peers
+    BOOST_CHECK_EQUAL(PendingXBridgeInventory(invPeer), 1U);
+    BOOST_CHECK_EQUAL(SentXBridgeBytes(invPeer), 0U);
+    BOOST_CHECK(SentXBridgeBytes(fullPeer) > 0);
+    BOOST_CHECK_EQUAL(SentXBridgeBytes(handshakePeer), 0U);
+    BOOST_CHECK_EQUAL(SentXBridgeBytes(disconnectPeer), 0U);
+    BOOST_CHECK_EQUAL(PendingXBridgeInventory(fromPeer), 0U);
+
+    // Announced packets are served from the relay map
+    const uint256 unknown = InsecureRand256();
+    auto packets = FindXBridgeRelayPackets({hash, unknown});
+    BOOST_CHECK_EQUAL(packets.size(), 1U);
+    BOOST_CHECK(packets.size() == 1 && packets.front() == packet);
+
+    // Only unknown packets are requested, and only from one peer at a time
+    auto getdata = ProcessXBridgeInventory(invPeer, {hash, unknown});
+    BOOST_CHECK(getdata.size() == 1 && getdata.front() == unknown);
+    BOOST_CHECK(ProcessXBridgeInventory(fullPeer, {unknown}).empty());
+    SetMockTime(nStartTime + 31); // request timed out, ask another peer
+    getdata = ProcessXBridgeInventory(fullPeer, {unknown});
+    BOOST_CHECK(getdata.size() == 1 && getdata.front() == unknown);
+
+    // Packets that are not served in time are requested from the next announcer
+    const uint256 unserved = InsecureRand256();
+    BOOST_CHECK_EQUAL(ProcessXBridgeInventory(invPeer, {unserved}).size(), 1U);
+    BOOST_CHECK(ProcessXBridgeInventory(fullPeer, {unserved}).empty());
+    BOOST_CHECK(GetXBridgeRequests(fullPeer).empty());
+    SetMockTime(nStartTime + 61);
+    getdata = GetXBridgeRequests(fullPeer);
+    BOOST_CHECK(getdata.size() == 1 && getdata.front() == unserved);
+
+    // Received packets are not requested again
+    const std::vector<unsigned char> served = g_insecure_rand_ctx.randbytes(100);
+    const uint256 servedHash = Hash(served.begin(), served.end());
+    BOOST_CHECK_EQUAL(ProcessXBridgeInventory(invPeer, {servedHash}).size(), 1U);
+    BOOST_CHECK(ProcessXBridgeInventory(fullPeer, {servedHash}).empty());
+    XBridgePacketReceived(invPeer, servedHash);
+    AddXBridgeRelayPacket(servedHash, served);
+    SetMockTime(nStartTime + 91);
+    BOOST_CHECK(GetXBridgeRequests(fullPeer).empty());
+
+    // Outstanding requests are bounded per peer and in total
+    auto announce = [](CNode* node, const size_t count) {
+        std::vector<uint256> vHashes;
+        for (size_t i = 0; i < count; ++i)
+            vHashes.push_back(InsecureRand256());
+        return ProcessXBridgeInventory(node, vHashes).size();
+    };
+    std::vector<CNode*> askPeers;
+    for (int i = 0; i < 11; ++i)
+        askPeers.push_back(addNode(true, true));
+    BOOST_CHECK_EQUAL(announce(askPeers[0], 1500), 1000U);
+    BOOST_CHECK_EQUAL(announce(askPeers[0], 1), 0U);
+    size_t requested{1000};
+    for (int i = 1; i < 11; ++i)
+        requested += announce(askPeers[i], 1000);
+    BOOST_CHECK(requested < 11000U);
+    BOOST_CHECK_EQUAL(announce(askPeers[10], 1), 0U);
+
+    // Timed out requests are evicted
+    SetMockTime(nStartTime + 122);
+    BOOST_CHECK_EQUAL(announce(askPeers[0], 1), 1U);
+    BOOST_CHECK_EQUAL(announce(askPeers[10], 1), 1U);
+
+    // Relayed packets expire
+    SetMockTime(nStartTime + 5 * 60 + 1);
+    BOOST_CHECK(FindXBridgeRelayPackets({hash}).empty());
+
+    // The relay map is bounded by count
+    std::vector<uint256> hashes;
+    for (int i = 0; i <= 10000; ++i) {
+        const std::vector<unsigned char> p = g_insecure_rand_ctx.randbytes(32);
+        hashes.push_back(Hash(p.begin(), p.end()));
+        AddXBridgeRelayPacket(hashes.back(), p);
+    }
+    BOOST_CHECK(FindXBridgeRelayPackets({hashes.front()}).empty());
+    BOOST_CHECK_EQUAL(FindXBridgeRelayPackets({hashes[1], hashes.back()}).size(), 2U);
+
+    // The relay map is bounded by size
+    const std::vector<unsigned char> large1(20 * 1000 * 1000, 1);
+    const std::vector<unsigned char> large2(20 * 1000 * 1000, 2);
+    const uint256 large1Hash = Hash(large1.begin(), large1.end());
+    const uint256 large2Hash = Hash(large2.begin(), large2.end());
+    AddXBridgeRelayPacket(large1Hash, large1);
+    AddXBridgeRelayPacket(large2Hash, large2);
+    BOOST_CHECK(FindXBridgeRelayPackets({large1Hash}).empty());
+    BOOST_CHECK_EQUAL(FindXBridgeRelayPackets({large2Hash}).size(), 1U);
+
+    SetMockTime(nStartTime + 5 * 60 * 2 + 2); // expire test packets
+    FindXBridgeRelayPackets({});
+    SetMockTime(0);
+    connman->ClearNodes();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -7,6 +7,7 @@
 #include <consensus/tx_verify.h>
 #include <consensus/merkle.h>
 #include <governance/governancewallet.h>
+#include <index/governanceindex.h>
 #include <net.h>
 #include <node/transaction.h>
 #include <wallet/coincontrol.h>
@@ -307,6 +308,20 @@ bool isTxInBlock(const CBlockIndex *blockhash, const uint256 & txhash, const Con
     return txInBlock;
 }
 
+bool loadGovernanceIndex(GovernanceIndex & govindex, const Consensus::Params & consensus, std::string & failReason) {
+    gov::Governance::instance().reset();
+    failReason.clear();
+    govindex.Start();
+    const int64_t timeout = GetTime() + 10;
+    while (!govindex.IsSynced() && GetTime() < timeout)
+        MilliSleep(100);
+    if (!govindex.IsSynced()) {
+        failReason = "Governance index failed to sync";
+        return false;
+    }
+    return govindex.LoadGovernanceData(gov::Governance::instance(), consensus, failReason);
+}
+
 bool cleanup(int blockCount, CWallet *wallet=nullptr) {
     const auto & params = Params();
     {
@@ -846,6 +861,14 @@ BOOST_FIXTURE_TEST_CASE(governance_tests_votes_undo, TestChainPoS)
             StakeBlocks(1), SyncWithValidationInterfaceQueue();
             auto vs = gov::Governance::instance().getVotes(proposal.getHash());
             BOOST_CHECK_MESSAGE(vs.size() == 1, strprintf("Expecting 1 vote, found %u", vs.size()));
+            // Utxo and voter lookups should find the same vote
+            BOOST_REQUIRE(vs.size() == 1);
+            auto uvs = gov::Governance::instance().getVotes(vs[0].getUtxo());
+            BOOST_CHECK_MESSAGE(uvs.size() == 1 && uvs[0].getHash() == vs[0].getHash(), "Expecting 1 vote for utxo");
+            auto kvs = gov::Governance::instance().getVotes(vs[0].getKeyID());
+            BOOST_CHECK_MESSAGE(kvs.size() == 1 && kvs[0].getHash() == vs[0].getHash(), "Expecting 1 vote for voter");
+            BOOST_CHECK(gov::Governance::instance().hasVote(proposal.getHash(), gov::YES, vs[0].getUtxo()));
+            BOOST_CHECK(!gov::Governance::instance().hasVote(proposal.getHash(), gov::NO, vs[0].getUtxo()));
         }
         // 2) Spend vote
         {
@@ -857,6 +880,10 @@ BOOST_FIXTURE_TEST_CASE(governance_tests_votes_undo, TestChainPoS)
             BOOST_CHECK_MESSAGE(vs.empty(), strprintf("Expecting 0 votes, found %u", vs.size()));
             auto pvs = gov::Governance::instance().getVotes(proposal.getHash(), true);
             BOOST_CHECK_MESSAGE(pvs.size() == 1 && pvs[0].spent(), "Expecting 1 spent vote");
+            if (pvs.size() == 1) {
+                BOOST_CHECK(gov::Governance::instance().getVotes(pvs[0].getUtxo()).empty());
+                BOOST_CHECK(gov::Governance::instance().getVotes(pvs[0].getUtxo(), true).size() == 1);
+            }
         }
         // 3) Simulate block invalidation/disconnect and make sure votes are properly unspent
         {
@@ -2011,6 +2038,12 @@ BOOST_AUTO_TEST_CASE(governance_tests_superblockresults)
                 const auto & tally = gov::Governance::getTally(cv.proposal.getHash(), allVotesB, consensus);
                 BOOST_CHECK_MESSAGE(tally.no == maxVotes, strprintf("Expected %d no votes on the changed votes test, instead found %d", maxVotes, tally.no));
             }
+            // Running tallies should match a full recount of the votes
+            for (const auto & proposal : allProposalsB) {
+                auto tally = gov::Governance::getTally(proposal.getHash(), allVotesB, consensus);
+                BOOST_CHECK_MESSAGE(tally == gov::Governance::instance().getTally(proposal.getHash(), consensus),
+                        strprintf("Running tally should match getTally for proposal %s", proposal.getName()));
+            }
         }
 
         // Vote invalidation tests
@@ -2051,6 +2084,12 @@ BOOST_AUTO_TEST_CASE(governance_tests_superblockresults)
             const auto spentVotes = static_cast<int>(allProposalsB.size());
             BOOST_CHECK_MESSAGE(proposalsB.size() == allProposalsB.size(), strprintf("Expected to have %d proposals, instead have %d", proposalsB.size(), allProposalsB.size()));
             BOOST_CHECK_MESSAGE(votesB.size()-spentVotes == allVotesB.size(), strprintf("Expected to have %d votes, instead have %d", votesB.size()-spentVotes, allVotesB.size()));
+            // Running tallies should match a full recount of the votes
+            for (const auto & proposal : allProposalsB) {
+                auto tally = gov::Governance::getTally(proposal.getHash(), allVotesB, consensus);
+                BOOST_CHECK_MESSAGE(tally == gov::Governance::instance().getTally(proposal.getHash(), consensus),
+                        strprintf("Running tally should match getTally for proposal %s", proposal.getName()));
+            }
 
             // Update state for next tests
             votesA = std::set<gov::Vote>(allVotesA.begin(), allVotesA.end());
@@ -3064,6 +3103,21 @@ BOOST_AUTO_TEST_CASE(governance_tests_loadgovernancedata_votes)
                                                                       "expected %u, spent or invalid %u", gvotes.size(), cvs.size(), spent));
         }
 
+        // Load governance data from the governance index
+        {
+            GovernanceIndex govindex(1 << 20, true);
+            auto govsuccess = loadGovernanceIndex(govindex, consensus, failReason);
+            BOOST_CHECK_MESSAGE(govsuccess, strprintf("Failed to load governance data from the governance index: %s", failReason));
+            BOOST_CHECK_MESSAGE(failReason.empty(), "LoadGovernanceData fail reason should be empty");
+            auto gvotes = gov::Governance::instance().getVotes();
+            BOOST_CHECK_MESSAGE(gvotes.size() == cvs.size(), strprintf("Failed to load governance index votes, found %u "
+                                                                       "expected %u", gvotes.size(), cvs.size()));
+            for (const auto & vote : cvs)
+                BOOST_CHECK_MESSAGE(gov::Governance::instance().hasVote(vote.getHash()), "Governance index is missing a vote");
+            BOOST_CHECK_MESSAGE(gov::Governance::instance().getProposals().size() == cps.size(), "Governance index proposals do not match");
+            govindex.Stop();
+        }
+
         // Load governance data with default multiple threads
         if (GetNumCores() >= 4) {
             gov::Governance::instance().reset();
@@ -3080,6 +3134,175 @@ BOOST_AUTO_TEST_CASE(governance_tests_loadgovernancedata_votes)
             BOOST_CHECK_MESSAGE(gvotes.size() == cvs.size(), strprintf("Failed to load governance data votes, found %u "
                                                                        "expected %u, spent or invalid %u", gvotes.size(), cvs.size(), spent));
         }
+
+        // Parallel load must match the single threaded load exactly
+        {
+            gov::Governance::instance().reset();
+            failReason.clear();
+            BOOST_CHECK(gov::Governance::instance().loadGovernanceData(chainActive, cs_main, consensus, failReason, 1));
+            const auto serialProposals = gov::Governance::instance().copyProposals();
+            const auto serialVotes = gov::Governance::instance().copyVotes();
+            for (const int nthreads : {2, 3, 4, 8}) {
+                gov::Governance::instance().reset();
+                failReason.clear();
+                auto govsuccess = gov::Governance::instance().loadGovernanceData(chainActive, cs_main, consensus, failReason, nthreads);
+                BOOST_CHECK_MESSAGE(govsuccess, strprintf("Failed to load governance data with %d threads: %s", nthreads, failReason));
+                const auto proposals = gov::Governance::instance().copyProposals();
+                const auto votes = gov::Governance::instance().copyVotes();
+                BOOST_CHECK_MESSAGE(proposals.size() == serialProposals.size(), strprintf("Expected %u proposals with %d threads, found %u", serialProposals.size(), nthreads, proposals.size()));
+                BOOST_CHECK_MESSAGE(votes.size() == serialVotes.size(), strprintf("Expected %u votes with %d threads, found %u", serialVotes.size(), nthreads, votes.size()));
+                for (const auto & item : serialProposals) {
+                    BOOST_CHECK(proposals.count(item.first) > 0);
+                    if (proposals.count(item.first))
+                        BOOST_CHECK_EQUAL(proposals.at(item.first).getBlockNumber(), item.second.getBlockNumber());
+                }
+                for (const auto & item : serialVotes) {
+                    BOOST_CHECK(votes.count(item.first) > 0);
+                    if (!votes.count(item.first))
+                        continue;
+                    const auto & vote = votes.at(item.first);
+                    BOOST_CHECK(vote.getVote() == item.second.getVote());
+                    BOOST_CHECK(vote.getOutpoint() == item.second.getOutpoint());
+                    BOOST_CHECK_EQUAL(vote.getBlockNumber(), item.second.getBlockNumber());
+                    BOOST_CHECK_EQUAL(vote.getAmount(), item.second.getAmount());
+                    BOOST_CHECK_EQUAL(vote.spent(), item.second.spent());
+                }
+            }
+        }
+
+        // Votes on utxos that were spent before the vote are spent in both loaders, the
+        // governance index estimates the spend since it was not recorded
+        {
+            gov::Proposal proposal("Test proposal 3", nextSuperblock(chainActive.Height(), consensus.superblock), 250 * COIN,
+                                   EncodeDestination(dest), "https://forum.blocknet.co", "Short description");
+            CTransactionRef ptx;
+            BOOST_REQUIRE_MESSAGE(gov::SubmitProposal(proposal, {pos.wallet}, consensus, ptx, g_connman.get(), &failReason),
+                                  strprintf("Proposal submission failed: %s", failReason));
+            CTransactionRef utxotx;
+            CTransactionRef feetx;
+            BOOST_REQUIRE_MESSAGE(sendToAddress(pos.wallet.get(), voteDest, 150 * COIN, utxotx)
+                               && sendToAddress(pos.wallet.get(), voteDest, 2 * COIN, feetx), "Failed to send coin to vote address");
+            pos.StakeBlocks(1), SyncWithValidationInterfaceQueue();
+
+            auto findOutput = [&voteDest](const CTransactionRef & tx, COutPoint & outpoint, CTxOut & txout) {
+                for (int i = 0; i < static_cast<int>(tx->vout.size()); ++i) {
+                    CTxDestination destination;
+                    if (ExtractDestination(tx->vout[i].scriptPubKey, destination) && destination == voteDest) {
+                        outpoint = {tx->GetHash(), static_cast<uint32_t>(i)};
+                        txout = tx->vout[i];
+                        return true;
+                    }
+                }
+                return false;
+            };
+            COutPoint utxo; CTxOut utxoOut;
+            COutPoint feeVin; CTxOut feeOut;
+            BOOST_REQUIRE(findOutput(utxotx, utxo, utxoOut));
+            BOOST_REQUIRE(findOutput(feetx, feeVin, feeOut));
+            CBasicKeyStore keystore;
+            keystore.AddKey(voteDestKey);
+
+            // Spend the vote utxo
+            CMutableTransaction mtx1;
+            mtx1.vin.resize(1);
+            mtx1.vin[0] = CTxIn(utxo);
+            mtx1.vout.resize(1);
+            mtx1.vout[0] = CTxOut(utxoOut.nValue - COIN, GetScriptForDestination(dest));
+            {
+                SignatureData sigdata = DataFromTransaction(mtx1, 0, utxoOut);
+                ProduceSignature(keystore, MutableTransactionSignatureCreator(&mtx1, 0, utxoOut.nValue, SIGHASH_ALL),
+                                 utxoOut.scriptPubKey, sigdata);
+                UpdateInput(mtx1.vin[0], sigdata);
+                uint256 txid;
+                std::string errstr;
+                const TransactionError err = BroadcastTransaction(MakeTransactionRef(mtx1), txid, errstr, 100 * COIN);
+                BOOST_REQUIRE_MESSAGE(err == TransactionError::OK, strprintf("Failed to spend vote utxo: %s", errstr));
+                pos.StakeBlocks(1), SyncWithValidationInterfaceQueue();
+            }
+
+            // Vote with the spent utxo in a later block
+            const gov::VinHash voteVinHash = gov::makeVinHash(feeVin);
+            gov::Vote vote(proposal.getHash(), gov::YES, utxo, voteVinHash);
+            BOOST_REQUIRE_MESSAGE(vote.sign(voteDestKey), "Vote signing should succeed");
+            CMutableTransaction mtx2;
+            mtx2.vin.resize(1);
+            mtx2.vin[0] = CTxIn(feeVin);
+            CDataStream ss(SER_NETWORK, GOV_PROTOCOL_VERSION);
+            ss << vote;
+            mtx2.vout.resize(2);
+            mtx2.vout[0] = CTxOut(0, CScript() << OP_RETURN << ToByteVector(ss));
+            mtx2.vout[1] = CTxOut(feeOut.nValue - 10000, feeOut.scriptPubKey);
+            {
+                SignatureData sigdata = DataFromTransaction(mtx2, 0, feeOut);
+                ProduceSignature(keystore, MutableTransactionSignatureCreator(&mtx2, 0, feeOut.nValue, SIGHASH_ALL),
+                                 feeOut.scriptPubKey, sigdata);
+                UpdateInput(mtx2.vin[0], sigdata);
+                uint256 txid;
+                std::string errstr;
+                const TransactionError err = BroadcastTransaction(MakeTransactionRef(mtx2), txid, errstr, 100 * COIN);
+                BOOST_REQUIRE_MESSAGE(err == TransactionError::OK, strprintf("Failed to send vote transaction: %s", errstr));
+                pos.StakeBlocks(1), SyncWithValidationInterfaceQueue();
+            }
+
+            gov::Governance::instance().reset();
+            failReason.clear();
+            BOOST_CHECK(gov::Governance::instance().loadGovernanceData(chainActive, cs_main, consensus, failReason, 1));
+            const auto chainVotes = gov::Governance::instance().copyVotes();
+            BOOST_REQUIRE_MESSAGE(chainVotes.count(vote.getHash()) > 0, "Expected the vote on the spent utxo to be loaded from the chain");
+            BOOST_CHECK(chainVotes.at(vote.getHash()).spent());
+
+            GovernanceIndex govindex(1 << 20, true);
+            BOOST_REQUIRE_MESSAGE(loadGovernanceIndex(govindex, consensus, failReason),
+                                strprintf("Failed to load governance data from the governance index: %s", failReason));
+            std::pair<uint256, int> spend;
+            BOOST_CHECK_MESSAGE(!govindex.FindSpend(utxo, spend), "Spends before the first vote are not indexed");
+            const auto indexVotes = gov::Governance::instance().copyVotes();
+            BOOST_CHECK_EQUAL(indexVotes.size(), chainVotes.size());
+            for (const auto & item : chainVotes) {
+                BOOST_CHECK(indexVotes.count(item.first) > 0);
+                if (indexVotes.count(item.first))
+                    BOOST_CHECK_EQUAL(indexVotes.at(item.first).spent(), item.second.spent());
+            }
+            govindex.Stop();
+        }
+
+        // Spent votes are restored from the governance index, which only records spends of vote utxos
+        {
+            CTransactionRef spendtx;
+            BOOST_REQUIRE_MESSAGE(sendToAddress(otherwallet.get(), dest, otherwallet->GetBalance() - COIN, spendtx),
+                                  "Failed to spend the vote utxos");
+            pos.StakeBlocks(1), SyncWithValidationInterfaceQueue();
+
+            gov::Governance::instance().reset();
+            failReason.clear();
+            BOOST_CHECK(gov::Governance::instance().loadGovernanceData(chainActive, cs_main, consensus, failReason, 1));
+            const auto chainVotes = gov::Governance::instance().copyVotes();
+            int spentVotes{0};
+            for (const auto & item : chainVotes)
+                spentVotes += item.second.spent() ? 1 : 0;
+            BOOST_CHECK_MESSAGE(spentVotes > 0, "Expected spent votes");
+
+            GovernanceIndex govindex(1 << 20, true);
+            BOOST_REQUIRE_MESSAGE(loadGovernanceIndex(govindex, consensus, failReason),
+                                strprintf("Failed to load governance data from the governance index: %s", failReason));
+            const auto indexVotes = gov::Governance::instance().copyVotes();
+            BOOST_CHECK_EQUAL(indexVotes.size(), chainVotes.size());
+            for (const auto & item : chainVotes) {
+                BOOST_CHECK(indexVotes.count(item.first) > 0);
+                if (indexVotes.count(item.first))
+                    BOOST_CHECK_EQUAL(indexVotes.at(item.first).spent(), item.second.spent());
+            }
+
+            // Spends of utxos that were never voted with are not indexed
+            std::pair<uint256, int> spend;
+            BOOST_CHECK(!govindex.FindSpend(sendtx->vin[0].prevout, spend));
+            bool foundVoteSpend{false};
+            for (const auto & vin : spendtx->vin)
+                foundVoteSpend = foundVoteSpend || govindex.FindSpend(vin.prevout, spend);
+            BOOST_CHECK(foundVoteSpend);
+            BOOST_CHECK(spend.first == spendtx->GetHash());
+            govindex.Stop();
+        }
     }
 
     // clean up
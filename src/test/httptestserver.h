@@ -0,0 +1,151 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BLOCKNET_TEST_HTTPTESTSERVER_H
+#define BLOCKNET_TEST_HTTPTESTSERVER_H
+
+#include <compat.h>
+#include <rpc/protocol.h>
+#include <support/events.h>
+#include <sync.h>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <event2/buffer.h>
+#include <event2/http.h>
+#include <event2/keyvalq_struct.h>
+#include <event2/thread.h>
+
+/**
+ * Http server on the loopback interface for tests of the http clients. Requests are
+ * answered by the handler on the server thread.
+ */
+class HTTPTestServer
+{
+public:
+    struct Request {
+        std::string uri;
+        std::map<std::string, std::string> headers;
+        std::string body;
+    };
+    struct Response {
+        int status{HTTP_OK};
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::string body;
+        bool drop{false}; // close the connection without replying
+    };
+    typedef std::function<Response(const Request & request)> Handler;
+
+    /** Starts the server on a free port. */
+    explicit HTTPTestServer(Handler handler) : handler(std::move(handler)) {
+#ifdef WIN32
+        evthread_use_windows_threads();
+#else
+        evthread_use_pthreads();
+#endif
+        base = obtain_event_base();
+        http = obtain_evhttp(base.get());
+        if (!http)
+            throw std::runtime_error("create http server failed");
+        evhttp_set_gencb(http.get(), onRequest, this);
+        auto socket = evhttp_bind_socket_with_handle(http.get(), "127.0.0.1", 0);
+        if (!socket)
+            throw std::runtime_error("bind http server failed");
+        struct sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        if (getsockname(evhttp_bound_socket_get_fd(socket), (struct sockaddr*)&addr, &len) != 0)
+            throw std::runtime_error("http server has no port");
+        serverPort = ntohs(addr.sin_port);
+        thread = std::thread([this]() { event_base_dispatch(base.get()); });
+    }
+
+    ~HTTPTestServer() {
+        stop();
+    }
+
+    /** Stops the server, further connections are refused. */
+    void stop() {
+        if (!thread.joinable())
+            return;
+        event_base_loopbreak(base.get());
+        thread.join();
+        http.reset();
+        base.reset();
+    }
+
+    int port() const {
+        return serverPort;
+    }
+
+    /** Number of requests answered */
+    int requests() {
+        LOCK(mu);
+        return requestCount;
+    }
+
+    /** Number of client connections the requests were received on */
+    int connections() {
+        LOCK(mu);
+        return static_cast<int>(peers.size());
+    }
+
+private:
+    static void onRequest(struct evhttp_request *req, void *ctx) {
+        auto server = static_cast<HTTPTestServer*>(ctx);
+        Request request;
+        request.uri = evhttp_request_get_uri(req);
+        auto input = evhttp_request_get_input_headers(req);
+        for (auto header = input->tqh_first; header; header = header->next.tqe_next)
+            request.headers[header->key] = header->value;
+        auto buf = evhttp_request_get_input_buffer(req);
+        const auto size = evbuffer_get_length(buf);
+        request.body = std::string((const char*)evbuffer_pullup(buf, size), size);
+
+        char *address{nullptr};
+        ev_uint16_t port{0};
+        evhttp_connection_get_peer(evhttp_request_get_connection(req), &address, &port);
+        {
+            LOCK(server->mu);
+            ++server->requestCount;
+            server->peers.insert(port);
+        }
+
+        const auto response = server->handler(request);
+        if (response.drop) { // the connection can't be freed in its request callback
+            struct timeval now{0, 0};
+            event_base_once(server->base.get(), -1, EV_TIMEOUT, onDrop, evhttp_request_get_connection(req), &now);
+            return;
+        }
+        auto output = evhttp_request_get_output_headers(req);
+        for (const auto & header : response.headers)
+            evhttp_add_header(output, header.first.c_str(), header.second.c_str());
+        auto reply = evbuffer_new();
+        evbuffer_add(reply, response.body.data(), response.body.size());
+        evhttp_send_reply(req, response.status, "", reply);
+        evbuffer_free(reply);
+    }
+
+    static void onDrop(evutil_socket_t, short, void *ctx) {
+        evhttp_connection_free(static_cast<struct evhttp_connection*>(ctx));
+    }
+
+private:
+    Handler handler;
+    raii_event_base base;
+    raii_evhttp http;
+    std::thread thread;
+    int serverPort{0};
+    Mutex mu;
+    int requestCount{0};
+    std::set<ev_uint16_t> peers; // client ports
+};
+
+#endif // BLOCKNET_TEST_HTTPTESTSERVER_H
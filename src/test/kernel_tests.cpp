@@ -0,0 +1,58 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kernel.h>
+#include <random.h>
+#include <test/test_bitcoin.h>
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(kernel_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(kernel_tests_stakekernelhasher)
+{
+    for (int n = 0; n < 16; ++n) {
+        const uint64_t stakeModifier = InsecureRandBits(64);
+        const uint256 hashBlockFrom = InsecureRand256();
+        const unsigned int nTimeBlockFrom = InsecureRand32();
+        const int blockHeight = static_cast<int>(InsecureRandRange(10000000));
+        const unsigned int prevoutIndex = InsecureRandRange(100);
+        const unsigned int nTimeTx = InsecureRand32();
+
+        CDataStream ss(SER_GETHASH, 0);
+        ss << stakeModifier;
+
+        const StakeKernelHasher hasherV06(stakeModifier, hashBlockFrom, nTimeBlockFrom, blockHeight, prevoutIndex);
+        const StakeKernelHasher hasherV05(stakeModifier, nTimeBlockFrom, blockHeight, prevoutIndex);
+        std::vector<uint256> hashesV06(StakeKernelHasher::BATCH_SIZE);
+        std::vector<uint256> hashesV05(StakeKernelHasher::BATCH_SIZE);
+        hasherV06.HashBatch(nTimeTx, hashesV06.size(), hashesV06.data());
+        hasherV05.HashBatch(nTimeTx, hashesV05.size(), hashesV05.data());
+
+        for (unsigned int i = 0; i < hashesV06.size(); ++i) {
+            const unsigned int t = nTimeTx + i; // timestamps wrap like the scalar kernel
+            BOOST_CHECK_EQUAL(hashesV06[i], stakeHashV06(ss, hashBlockFrom, nTimeBlockFrom, blockHeight, prevoutIndex, t));
+            BOOST_CHECK_EQUAL(hashesV05[i], stakeHashV05(ss, nTimeBlockFrom, blockHeight, prevoutIndex, t));
+        }
+        BOOST_CHECK_EQUAL(hasherV06.Hash(nTimeTx), hashesV06[0]);
+        BOOST_CHECK_EQUAL(hasherV05.Hash(nTimeTx), hashesV05[0]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(kernel_tests_staketarget)
+{
+    arith_uint256 bnTargetPerCoinDay;
+    bnTargetPerCoinDay.SetCompact(0x1e0fffff);
+    const CAmount amount = 5000 * COIN;
+    const auto target = stakeTargetV06(amount, bnTargetPerCoinDay);
+    BOOST_CHECK(stakeTargetHitV06(ArithToUint256(target - 1), amount, bnTargetPerCoinDay));
+    BOOST_CHECK(!stakeTargetHitV06(ArithToUint256(target), amount, bnTargetPerCoinDay));
+    const auto targetV05 = stakeTarget(amount, bnTargetPerCoinDay);
+    BOOST_CHECK(stakeTargetHit(ArithToUint256(targetV05 - 1), amount, bnTargetPerCoinDay));
+    BOOST_CHECK(!stakeTargetHit(ArithToUint256(targetV05), amount, bnTargetPerCoinDay));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -189,6 +189,25 @@ BOOST_AUTO_TEST_CASE(cnode_simple_test)
     BOOST_CHECK(pnode2->fFeeler == false);
 }
 
+BOOST_AUTO_TEST_CASE(cnode_xbridge_inventory)
+{
+    in_addr ipv4Addr;
+    ipv4Addr.s_addr = 0xa0b0c001;
+    CAddress addr = CAddress(CService(ipv4Addr, 7777), NODE_NETWORK);
+    std::unique_ptr<CNode> pnode = MakeUnique<CNode>(0, NODE_NETWORK, 0, INVALID_SOCKET, addr, 0, 0, CAddress(), std::string(), false);
+    BOOST_CHECK(!pnode->fSendXBridgeInv);
+
+    const uint256 known = InsecureRand256();
+    const uint256 unknown = InsecureRand256();
+    pnode->AddXBridgeKnown(known);
+    pnode->PushXBridgeInventory(known);
+    pnode->PushXBridgeInventory(unknown);
+
+    LOCK(pnode->cs_inventory);
+    BOOST_CHECK_EQUAL(pnode->vInventoryXBridgeToSend.size(), 1U);
+    BOOST_CHECK(pnode->vInventoryXBridgeToSend.front() == unknown);
+}
+
 // prior to PR #14728, this test triggers an undefined behavior
 BOOST_AUTO_TEST_CASE(ipv4_peer_with_ipv6_addrMe_test)
 {
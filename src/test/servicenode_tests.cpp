@@ -320,6 +320,9 @@ BOOST_AUTO_TEST_CASE(servicenode_tests_spent_collateral)
         sn::ServiceNode snode;
         BOOST_CHECK_NO_THROW(snode = snodeNetwork(snodePubKey, tier, snodePubKey.GetID(), collateral, chainActive.Height(), chainActive.Tip()->GetBlockHash(), sig));
         BOOST_CHECK_MESSAGE(snode.isValid(GetTxFunc, IsServiceNodeBlockValidFunc), "Should not fail on spent collateral in mempool");
+        CTxOut txout;
+        BOOST_CHECK_MESSAGE(!GetUtxoFunc(c.GetInputCoin().outpoint, txout), "Collateral spent in the mempool should be reported spent");
+        BOOST_CHECK_MESSAGE(!snode.isValid(sn::ServiceNodeMgr::instance().collateralFunc(), IsServiceNodeBlockValidFunc), "Should fail on collateral spent in the mempool");
 
         cleanupSn();
     }
@@ -357,6 +360,13 @@ BOOST_AUTO_TEST_CASE(servicenode_tests_spent_collateral)
         const auto snode = sn::ServiceNodeMgr::instance().getSn(snodePubKey);
         BOOST_CHECK_MESSAGE(!snode.isNull(), "snode registration should succeed");
         if (!snode.isNull()) {
+            // Only collateral of registered snodes should be cached
+            for (const auto & utxo : snode.getCollateral())
+                BOOST_CHECK_MESSAGE(sn::ServiceNodeMgr::instance().validCollateral.count(utxo) > 0, "registered snode collateral should be cached");
+            const auto cacheSize = sn::ServiceNodeMgr::instance().validCollateral.size();
+            CTxOut otherOut;
+            sn::ServiceNodeMgr::instance().getCollateral(coins[0].GetInputCoin().outpoint, otherOut);
+            BOOST_CHECK_MESSAGE(sn::ServiceNodeMgr::instance().validCollateral.size() == cacheSize, "utxo lookups should not grow the collateral cache");
             RegisterValidationInterface(&sn::ServiceNodeMgr::instance());
             const auto firstUtxo = snode.getCollateral().front();
             CTransactionRef tx; uint256 hashBlock;
@@ -376,8 +386,19 @@ BOOST_AUTO_TEST_CASE(servicenode_tests_spent_collateral)
             BOOST_CHECK_MESSAGE(checkSnode.isValid(GetTxFunc, IsServiceNodeBlockValidFunc), "snode should be valid because collateral was spent but we're still in grace period");
             BOOST_CHECK_MESSAGE(checkSnode.getInvalid(), "snode should be marked invalid in the validation interface event (connect block)");
             BOOST_CHECK_MESSAGE(checkSnode.getInvalidBlockNumber() == chainActive.Height(), "snode invalid block number should match chain tip");
+            // Spent collateral should be resolved from the collateral cache during the grace period
+            CTxOut txout;
+            BOOST_CHECK_MESSAGE(!GetUtxoFunc(firstUtxo, txout), "spent collateral should not be in the coins view");
+            BOOST_CHECK_MESSAGE(txout == tx->vout[firstUtxo.n], "spent collateral output should be resolved from its transaction");
+            txout.SetNull();
+            BOOST_CHECK_MESSAGE(!sn::ServiceNodeMgr::instance().getCollateral(firstUtxo, txout), "collateral cache should report spent collateral");
+            BOOST_CHECK_MESSAGE(txout == tx->vout[firstUtxo.n], "collateral cache should return spent collateral during grace period");
+            BOOST_CHECK_MESSAGE(checkSnode.isValid(sn::ServiceNodeMgr::instance().collateralFunc(), IsServiceNodeBlockValidFunc), "snode should be valid from collateral cache during grace period");
+            BOOST_CHECK_MESSAGE(checkSnode.isValid(GetUtxoFunc, IsServiceNodeBlockValidFunc), "snode should be valid from the collateral transaction during grace period when the collateral is not cached");
             pos.StakeBlocks(sn::ServiceNode::VALID_GRACEPERIOD_BLOCKS), SyncWithValidationInterfaceQueue(); // make sure snode grace period expires
             BOOST_CHECK_MESSAGE(!checkSnode.isValid(GetTxFunc, IsServiceNodeBlockValidFunc), "snode should be invalid because collateral was spent and grace period expired");
+            BOOST_CHECK_MESSAGE(!checkSnode.isValid(sn::ServiceNodeMgr::instance().collateralFunc(), IsServiceNodeBlockValidFunc), "snode should be invalid from collateral cache after grace period expired");
+            BOOST_CHECK_MESSAGE(!checkSnode.isValid(GetUtxoFunc, IsServiceNodeBlockValidFunc), "snode should be invalid from the collateral transaction after grace period expired");
             UnregisterValidationInterface(&sn::ServiceNodeMgr::instance());
         }
 
@@ -1256,6 +1277,74 @@ BOOST_AUTO_TEST_CASE(servicenode_tests_misc_checks)
     pos_ptr.reset();
 }
 
+/// Check that the collateral index tracks snode registrations
+BOOST_AUTO_TEST_CASE(servicenode_tests_collateral_index)
+{
+    auto & smgr = sn::ServiceNodeMgr::instance();
+    const auto tier = sn::ServiceNode::Tier::SPV;
+    CKey key1; key1.MakeNewKey(true);
+    CKey key2; key2.MakeNewKey(true);
+    const COutPoint utxo1{InsecureRand256(), 0};
+    const COutPoint utxo2{InsecureRand256(), 1};
+    const COutPoint utxo3{InsecureRand256(), 2};
+
+    auto snode1 = snodeNetwork(key1.GetPubKey(), tier, key1.GetPubKey().GetID(), {utxo1, utxo2}, 0, uint256(), {});
+    auto snode2 = snodeNetwork(key2.GetPubKey(), tier, key2.GetPubKey().GetID(), {utxo2, utxo3}, 0, uint256(), {});
+    BOOST_CHECK(smgr.addSn(snode1, false));
+    BOOST_CHECK_EQUAL(smgr.collateralSnodes.size(), 2U);
+    BOOST_CHECK(smgr.addSn(snode2, false));
+    BOOST_CHECK_MESSAGE(!smgr.hasSn(key1.GetPubKey()), "snode with the same collateral should be removed");
+    BOOST_CHECK_MESSAGE(smgr.hasSn(key2.GetPubKey()), "snode should be added");
+    BOOST_CHECK_EQUAL(smgr.collateralSnodes.size(), 2U);
+    BOOST_CHECK(!smgr.collateralSnodes.count(utxo1));
+
+    // Re-registration with different collateral should update the index
+    auto snode2b = snodeNetwork(key2.GetPubKey(), tier, key2.GetPubKey().GetID(), {utxo1}, 0, uint256(), {});
+    BOOST_CHECK(smgr.addSn(snode2b, false));
+    BOOST_CHECK_EQUAL(smgr.collateralSnodes.size(), 1U);
+    BOOST_CHECK(smgr.collateralSnodes.count(utxo1) && smgr.collateralSnodes[utxo1] == key2.GetPubKey());
+    BOOST_CHECK(smgr.addSn(snode1, false));
+    BOOST_CHECK_MESSAGE(!smgr.hasSn(key2.GetPubKey()), "snode with the same collateral should be removed");
+
+    // Spent collateral in a connected block should mark the snode invalid
+    CMutableTransaction mtx;
+    mtx.vin.resize(1);
+    mtx.vin[0] = CTxIn(utxo2);
+    auto block = std::make_shared<CBlock>();
+    block->vtx.push_back(MakeTransactionRef(mtx));
+    smgr.processValidationBlock(block, true, 100);
+    const auto snode = smgr.getSn(key1.GetPubKey());
+    BOOST_CHECK_MESSAGE(snode.getInvalid(), "snode with spent collateral should be marked invalid");
+    BOOST_CHECK_EQUAL(snode.getInvalidBlockNumber(), 100);
+
+    BOOST_CHECK(smgr.removeSn(key1.GetPubKey()));
+    BOOST_CHECK(smgr.collateralSnodes.empty());
+    cleanupSn();
+}
+
+/// Check that seen packets roll out of the filter instead of being cleared all at once
+BOOST_AUTO_TEST_CASE(servicenode_tests_seen_packets)
+{
+    auto & smgr = sn::ServiceNodeMgr::instance();
+    smgr.setSeenPacketsFilter(1000, sn::DEFAULT_SEEN_PACKETS_FPRATE);
+    std::vector<uint256> hashes;
+    for (int i = 0; i < 5000; ++i)
+        hashes.push_back(InsecureRand256());
+    for (const auto & hash : hashes) {
+        BOOST_CHECK(!smgr.seenPacket(hash));
+        BOOST_CHECK(smgr.hasSeenPacket(hash));
+        BOOST_CHECK(smgr.seenPacket(hash));
+    }
+    // The most recent packets must always be remembered
+    for (auto it = hashes.rbegin(); it != hashes.rbegin() + 1000; ++it)
+        BOOST_CHECK(smgr.hasSeenPacket(*it));
+    // The oldest packets are forgotten
+    BOOST_CHECK(!smgr.hasSeenPacket(hashes.front()));
+    cleanupSn();
+    BOOST_CHECK(!smgr.hasSeenPacket(hashes.back()));
+    smgr.setSeenPacketsFilter(sn::DEFAULT_SEEN_PACKETS, sn::DEFAULT_SEEN_PACKETS_FPRATE);
+}
+
 /// Check rpc cases
 BOOST_AUTO_TEST_CASE(servicenode_tests_rpc)
 {
@@ -0,0 +1,95 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <consensus/validation.h>
+#include <index/xbridgetradeindex.h>
+#include <script/sign.h>
+#include <script/standard.h>
+#include <test/test_bitcoin.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(xbridgetradeindex_tests)
+
+/// Returns a transaction recording an xbridge trade in an OP_RETURN output.
+static CMutableTransaction TradeTx(const CTransactionRef& prevTx, const CKey& key, const std::string& xid)
+{
+    const CScript scriptPubKey = CScript() << ToByteVector(key.GetPubKey()) << OP_CHECKSIG;
+    const std::string json = "[\"" + xid + "\",\"BLOCK\",100000000,\"LTC\",250000000]";
+
+    CMutableTransaction tx;
+    tx.nVersion = 1;
+    tx.vin.resize(1);
+    tx.vin[0].prevout = COutPoint(prevTx->GetHash(), 0);
+    tx.vout.resize(2);
+    tx.vout[0].nValue = 0;
+    tx.vout[0].scriptPubKey = CScript() << OP_RETURN << std::vector<unsigned char>(json.begin(), json.end());
+    tx.vout[1].nValue = 11*CENT;
+    tx.vout[1].scriptPubKey = GetScriptForDestination(key.GetPubKey().GetID());
+
+    std::vector<unsigned char> vchSig;
+    const uint256 hash = SignatureHash(scriptPubKey, tx, 0, SIGHASH_ALL, 0, SigVersion::BASE);
+    BOOST_CHECK(key.Sign(hash, vchSig));
+    vchSig.push_back((unsigned char)SIGHASH_ALL);
+    tx.vin[0].scriptSig << vchSig;
+    return tx;
+}
+
+BOOST_FIXTURE_TEST_CASE(xbridgetradeindex_find_trades, TestChain100Setup)
+{
+    // Validation updates the global index
+    g_xbridgetradeindex = MakeUnique<XBridgeTradeIndex>(1 << 20, true);
+    auto& index = *g_xbridgetradeindex;
+    index.Start();
+    const int64_t timeout = GetTime() + 10;
+    while (!index.IsSynced() && GetTime() < timeout)
+        MilliSleep(100);
+    BOOST_REQUIRE_MESSAGE(index.IsSynced(), "XBridge trade index failed to sync");
+
+    std::vector<CurrencyPair> trades;
+    BOOST_CHECK(index.FindTrades(0, std::numeric_limits<int64_t>::max(), trades));
+    BOOST_CHECK(trades.empty());
+
+    // Trades in new blocks make it into the index
+    const CScript scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    const auto tx = TradeTx(m_coinbase_txns[0], coinbaseKey, "trade1");
+    const CBlock block = CreateAndProcessBlock({tx}, scriptPubKey);
+    BOOST_REQUIRE(chainActive.Tip()->GetBlockHash() == block.GetHash());
+
+    BOOST_CHECK(index.FindTrades(0, std::numeric_limits<int64_t>::max(), trades));
+    BOOST_REQUIRE_EQUAL(trades.size(), 1);
+    BOOST_CHECK_EQUAL(trades[0].xid(), "trade1");
+    BOOST_CHECK_EQUAL(trades[0].from.currency().to_string(), "BLOCK");
+    BOOST_CHECK_EQUAL(trades[0].from.accumulator(), 100000000);
+    BOOST_CHECK_EQUAL(trades[0].to.currency().to_string(), "LTC");
+    BOOST_CHECK_EQUAL(trades[0].to.accumulator(), 250000000);
+    BOOST_CHECK(trades[0].timeStamp == boost::posix_time::from_time_t(block.GetBlockTime()));
+
+    // Time range excludes the block
+    trades.clear();
+    BOOST_CHECK(index.FindTrades(0, block.GetBlockTime(), trades));
+    BOOST_CHECK(trades.empty());
+    BOOST_CHECK(index.FindTrades(block.GetBlockTime() + 1, std::numeric_limits<int64_t>::max(), trades));
+    BOOST_CHECK(trades.empty());
+
+    // Trades of disconnected blocks are removed
+    {
+        CValidationState state;
+        CBlockIndex* pindex;
+        {
+            LOCK(cs_main);
+            pindex = LookupBlockIndex(block.GetHash());
+        }
+        BOOST_REQUIRE(InvalidateBlock(state, Params(), pindex));
+    }
+    BOOST_CHECK(index.FindTrades(0, std::numeric_limits<int64_t>::max(), trades));
+    BOOST_CHECK(trades.empty());
+
+    index.Stop();
+    g_xbridgetradeindex.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
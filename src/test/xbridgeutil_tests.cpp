@@ -0,0 +1,399 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/httptestserver.h>
+#include <test/test_bitcoin.h>
+#include <xbridge/util/httpclientpool.h>
+#include <xbridge/util/logwriter.h>
+#include <xbridge/util/orderbook.h>
+#include <xbridge/util/xutil.h>
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/test/unit_test.hpp>
+
+static std::vector<std::string> ReadLines(const std::string & fileName)
+{
+    std::vector<std::string> lines;
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line))
+        if (!line.empty())
+            lines.push_back(line);
+    return lines;
+}
+
+static xbridge::TransactionDescrPtr MakeOrder(const std::string & fromCurrency, const uint64_t fromAmount,
+                                              const std::string & toCurrency, const uint64_t toAmount,
+                                              const xbridge::TransactionDescr::State state = xbridge::TransactionDescr::trPending)
+{
+    auto ptr = std::make_shared<xbridge::TransactionDescr>();
+    ptr->id = InsecureRand256();
+    ptr->fromCurrency = fromCurrency;
+    ptr->fromAmount = fromAmount;
+    ptr->toCurrency = toCurrency;
+    ptr->toAmount = toAmount;
+    ptr->state = state;
+    return ptr;
+}
+
+static std::vector<uint256> OrderIds(const std::vector<xbridge::TransactionDescrPtr> & orders)
+{
+    std::vector<uint256> ids;
+    for (const auto & ptr : orders)
+        ids.push_back(ptr->id);
+    return ids;
+}
+
+BOOST_FIXTURE_TEST_SUITE(xbridgeutil_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(xbridgeutil_findjsonmember)
+{
+    std::string member;
+
+    // Nested values are returned as is
+    const std::string reply = "{\"result\":{\"a\":[1,{\"b\":\"}\"}]},\"error\":null,\"id\":1}";
+    BOOST_CHECK(xbridge::findJsonMember(reply, "result", member));
+    BOOST_CHECK_EQUAL(member, "{\"a\":[1,{\"b\":\"}\"}]}");
+    BOOST_CHECK(xbridge::findJsonMember(reply, "error", member));
+    BOOST_CHECK_EQUAL(member, "null");
+    BOOST_CHECK(xbridge::findJsonMember(reply, "id", member));
+    BOOST_CHECK_EQUAL(member, "1");
+
+    // Only top-level members are found
+    BOOST_CHECK(!xbridge::findJsonMember("{\"x\":{\"id\":5}}", "id", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"x\":\"\\\"id\\\":5\"}", "id", member));
+
+    // Escaped quotes and backslashes in strings
+    BOOST_CHECK(xbridge::findJsonMember("{\"a\":\"x\\\"y\",\"b\":2}", "a", member));
+    BOOST_CHECK_EQUAL(member, "\"x\\\"y\"");
+    BOOST_CHECK(xbridge::findJsonMember("{\"a\":\"x\\\"y\",\"b\":2}", "b", member));
+    BOOST_CHECK_EQUAL(member, "2");
+    BOOST_CHECK(xbridge::findJsonMember("{\"a\":\"x\\\\\",\"b\":true}", "b", member));
+    BOOST_CHECK_EQUAL(member, "true");
+
+    // Whitespace around keys, values and separators
+    const std::string spaced = " \n{ \"id\" : 7 ,\t\"r\" : [ 1 , 2 ] }\r\n";
+    BOOST_CHECK(xbridge::findJsonMember(spaced, "id", member));
+    BOOST_CHECK_EQUAL(member, "7");
+    BOOST_CHECK(xbridge::findJsonMember(spaced, "r", member));
+    BOOST_CHECK_EQUAL(member, "[ 1 , 2 ]");
+
+    // Malformed input
+    BOOST_CHECK(!xbridge::findJsonMember("", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("[{\"a\":1}]", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"a\":", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"a\" 1}", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"a\":}", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"a\":\"unterminated}", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"a\":1", "b", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{\"a\":[1,2}", "a", member));
+    BOOST_CHECK(!xbridge::findJsonMember("{a:1}", "a", member));
+}
+
+BOOST_AUTO_TEST_CASE(xbridgeutil_splitjsonarray)
+{
+    std::vector<std::string> elements;
+
+    BOOST_CHECK(xbridge::splitJsonArray("[]", elements));
+    BOOST_CHECK(elements.empty());
+    BOOST_CHECK(xbridge::splitJsonArray(" [ \n ] ", elements));
+    BOOST_CHECK(elements.empty());
+
+    // Nested values, separators in strings and whitespace
+    const std::string batch = "[{\"id\":1,\"result\":\"a,b\"}, {\"id\":2,\"result\":[1,[2]]} ,\n3 , \"x]\\\"\" ,null]";
+    BOOST_CHECK(xbridge::splitJsonArray(batch, elements));
+    BOOST_CHECK_EQUAL(elements.size(), 5U);
+    if (elements.size() == 5) {
+        BOOST_CHECK_EQUAL(elements[0], "{\"id\":1,\"result\":\"a,b\"}");
+        BOOST_CHECK_EQUAL(elements[1], "{\"id\":2,\"result\":[1,[2]]}");
+        BOOST_CHECK_EQUAL(elements[2], "3");
+        BOOST_CHECK_EQUAL(elements[3], "\"x]\\\"\"");
+        BOOST_CHECK_EQUAL(elements[4], "null");
+    }
+
+    // Malformed input
+    elements.clear();
+    BOOST_CHECK(!xbridge::splitJsonArray("", elements));
+    BOOST_CHECK(!xbridge::splitJsonArray("{}", elements));
+    BOOST_CHECK(!xbridge::splitJsonArray("[1,2", elements));
+    BOOST_CHECK(!xbridge::splitJsonArray("[1,", elements));
+    BOOST_CHECK(!xbridge::splitJsonArray("[\"a]", elements));
+    BOOST_CHECK(!xbridge::splitJsonArray("[{\"a\":1}", elements));
+    BOOST_CHECK(!xbridge::splitJsonArray("[{\"a\":1}{\"b\":2}]", elements));
+}
+
+BOOST_AUTO_TEST_CASE(xbridgeutil_httpclientpool)
+{
+    // Echoes the request body, requests starting with "drop" are dropped once
+    std::set<std::string> dropped;
+    HTTPTestServer server([&dropped](const HTTPTestServer::Request & request) {
+        HTTPTestServer::Response response;
+        response.drop = request.body.find("drop") == 0 && dropped.insert(request.body).second;
+        response.body = request.body;
+        return response;
+    });
+    xbridge::HTTPClientPool pool;
+    pool.setLimits(2, 60);
+    const std::vector<std::pair<std::string, std::string>> headers{{"Content-Type", "application/json"}};
+
+    // Connections are reused
+    auto reply = pool.post("127.0.0.1", server.port(), headers, "1", 10);
+    BOOST_CHECK_EQUAL(reply.status, HTTP_OK);
+    BOOST_CHECK_EQUAL(reply.body, "1");
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", server.port()), 1U);
+    reply = pool.post("127.0.0.1", server.port(), headers, "2", 10);
+    BOOST_CHECK_EQUAL(reply.body, "2");
+    BOOST_CHECK_EQUAL(server.requests(), 2);
+    BOOST_CHECK_EQUAL(server.connections(), 1);
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", server.port()), 1U);
+
+    // Requests failing on a reused connection are sent again on a new connection
+    reply = pool.post("127.0.0.1", server.port(), headers, "drop3", 10);
+    BOOST_CHECK_EQUAL(reply.status, HTTP_OK);
+    BOOST_CHECK_EQUAL(reply.body, "drop3");
+    BOOST_CHECK_EQUAL(server.requests(), 4);
+    BOOST_CHECK_EQUAL(server.connections(), 2);
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", server.port()), 1U);
+
+    // Idle connections expire
+    SetMockTime(GetTime() + 60);
+    reply = pool.post("127.0.0.1", server.port(), headers, "4", 10);
+    BOOST_CHECK_EQUAL(reply.body, "4");
+    BOOST_CHECK_EQUAL(server.connections(), 3);
+    SetMockTime(0);
+
+    // Requests failing on a new connection are not sent again
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", server.port()), 0U);
+    reply = pool.post("127.0.0.1", server.port(), headers, "drop5", 10);
+    BOOST_CHECK_EQUAL(reply.status, 0);
+    BOOST_CHECK_EQUAL(server.requests(), 6);
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", server.port()), 0U);
+
+    // Connections are not kept when keep-alive is disabled
+    pool.setLimits(2, 0);
+    reply = pool.post("127.0.0.1", server.port(), headers, "6", 10);
+    BOOST_CHECK_EQUAL(reply.body, "6");
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", server.port()), 0U);
+
+    // Unreachable servers report no status
+    const int port = server.port();
+    server.stop();
+    reply = pool.post("127.0.0.1", port, headers, "7", 10);
+    BOOST_CHECK_EQUAL(reply.status, 0);
+    BOOST_CHECK_EQUAL(pool.idleConnections("127.0.0.1", port), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(xbridgeutil_orderbook)
+{
+    const auto COIN = xbridge::TransactionDescr::COIN;
+    xbridge::OrderBook book;
+
+    // Orders are sorted by price, lowest first, and only listed in their own market
+    const auto ask2 = MakeOrder("BLOCK", 10 * COIN, "LTC", 20 * COIN);
+    const auto ask1 = MakeOrder("BLOCK", 10 * COIN, "LTC", 10 * COIN);
+    const auto ask3 = MakeOrder("BLOCK", 5 * COIN, "LTC", 15 * COIN);
+    const auto bid = MakeOrder("LTC", 10 * COIN, "BLOCK", 10 * COIN);
+    for (const auto & ptr : {ask2, ask1, ask3, bid})
+        book.add(ptr);
+    BOOST_CHECK_EQUAL(book.size(), 4U);
+    BOOST_CHECK(OrderIds(book.best("BLOCK", "LTC", 10)) == OrderIds({ask1, ask2, ask3}));
+    BOOST_CHECK(OrderIds(book.best("BLOCK", "LTC", 2)) == OrderIds({ask1, ask2}));
+    BOOST_CHECK(OrderIds(book.best("LTC", "BLOCK", 10)) == OrderIds({bid}));
+    BOOST_CHECK(book.best("BLOCK", "BTC", 10).empty());
+
+    // Orders priced equal to the last returned order complete its price level
+    const auto ask2b = MakeOrder("BLOCK", 1 * COIN, "LTC", 2 * COIN);
+    book.add(ask2b);
+    const auto level = book.best("BLOCK", "LTC", 2);
+    BOOST_CHECK_EQUAL(level.size(), 3U);
+    BOOST_CHECK(level[0]->id == ask1->id);
+    BOOST_CHECK(std::count_if(level.begin() + 1, level.end(), [&](const xbridge::TransactionDescrPtr & ptr) {
+        return ptr->id == ask2->id || ptr->id == ask2b->id;
+    }) == 2);
+
+    // Re-adding an order moves it to its new price
+    ask3->toAmount = 1 * COIN;
+    book.add(ask3);
+    BOOST_CHECK_EQUAL(book.size(), 5U);
+    BOOST_CHECK(book.best("BLOCK", "LTC", 1).front()->id == ask3->id);
+
+    // Orders that are not pending stay indexed and are skipped
+    ask3->state = xbridge::TransactionDescr::trAccepting;
+    BOOST_CHECK(book.best("BLOCK", "LTC", 1).front()->id == ask1->id);
+    BOOST_CHECK_EQUAL(book.size(), 5U);
+
+    // Removed orders, orders without amounts and null orders are not listed
+    book.remove(ask1->id);
+    book.remove(ask1->id);
+    BOOST_CHECK_EQUAL(book.size(), 4U);
+    BOOST_CHECK_EQUAL(book.best("BLOCK", "LTC", 10).size(), 2U);
+    book.add(MakeOrder("BLOCK", 0, "LTC", 10 * COIN));
+    book.add(nullptr);
+    BOOST_CHECK_EQUAL(book.size(), 4U);
+    bid->toAmount = 0;
+    book.add(bid);
+    BOOST_CHECK_EQUAL(book.size(), 3U);
+    BOOST_CHECK(book.best("LTC", "BLOCK", 10).empty());
+    for (const auto & ptr : {ask2, ask2b, ask3})
+        book.remove(ptr->id);
+    BOOST_CHECK_EQUAL(book.size(), 0U);
+    BOOST_CHECK(book.best("BLOCK", "LTC", 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(xbridgeutil_orderbook_sort)
+{
+    // Random orders of both sides of a market with many equal prices, compared to the
+    // descending sorts dxGetOrderBook used before the index
+    const auto COIN = xbridge::TransactionDescr::COIN;
+    xbridge::OrderBook book;
+    std::vector<xbridge::TransactionDescrPtr> orders;
+    for (int i = 0; i < 500; ++i) {
+        const bool ask = InsecureRandBool();
+        const auto state = InsecureRandRange(4) == 0 ? xbridge::TransactionDescr::trCreated
+                                                     : xbridge::TransactionDescr::trPending;
+        orders.push_back(MakeOrder(ask ? "BLOCK" : "LTC", (1 + InsecureRandRange(8)) * COIN,
+                                   ask ? "LTC" : "BLOCK", (1 + InsecureRandRange(8)) * COIN, state));
+        book.add(orders.back());
+    }
+    // Removed orders are no longer listed
+    for (int i = 0; i < 100; ++i) {
+        const auto n = InsecureRandRange(orders.size());
+        book.remove(orders[n]->id);
+        orders.erase(orders.begin() + n);
+    }
+
+    std::vector<xbridge::TransactionDescrPtr> asks, bids;
+    for (const auto & ptr : orders) {
+        if (ptr->state != xbridge::TransactionDescr::trPending)
+            continue;
+        (ptr->fromCurrency == "BLOCK" ? asks : bids).push_back(ptr);
+    }
+    std::sort(asks.begin(), asks.end(), [](const xbridge::TransactionDescrPtr & a, const xbridge::TransactionDescrPtr & b) {
+        return xbridge::price(a) > xbridge::price(b);
+    });
+    std::sort(bids.begin(), bids.end(), [](const xbridge::TransactionDescrPtr & a, const xbridge::TransactionDescrPtr & b) {
+        return xbridge::priceBid(a) > xbridge::priceBid(b);
+    });
+
+    for (const size_t depth : {size_t(1), size_t(5), size_t(20), asks.size() + bids.size()}) {
+        // Best asks were the back of the descending sort, best bids its front
+        const auto bestAsks = book.best("BLOCK", "LTC", depth);
+        const auto bestBids = book.best("LTC", "BLOCK", depth);
+        const auto askCount = std::min(depth, asks.size());
+        const auto bidCount = std::min(depth, bids.size());
+        BOOST_CHECK(bestAsks.size() >= askCount);
+        BOOST_CHECK(bestBids.size() >= bidCount);
+        if (bestAsks.size() < askCount || bestBids.size() < bidCount)
+            continue;
+        for (size_t i = 0; i < askCount; ++i)
+            BOOST_CHECK_EQUAL(xbridge::price(bestAsks[i]), xbridge::price(asks[asks.size() - 1 - i]));
+        for (size_t i = 0; i < bidCount; ++i)
+            BOOST_CHECK_EQUAL(xbridge::priceBid(bestBids[i]), xbridge::priceBid(bids[i]));
+
+        // Extra orders complete the last price level
+        for (size_t i = askCount; i < bestAsks.size(); ++i)
+            BOOST_CHECK(xbridge::OrderBook::priceEqual(xbridge::price(bestAsks[i]), xbridge::price(bestAsks[askCount - 1])));
+        for (size_t i = bidCount; i < bestBids.size(); ++i)
+            BOOST_CHECK(xbridge::OrderBook::priceEqual(xbridge::priceBid(bestBids[i]), xbridge::priceBid(bestBids[bidCount - 1])));
+        const auto levelAsks = std::count_if(asks.begin(), asks.end(), [&](const xbridge::TransactionDescrPtr & ptr) {
+            return askCount > 0 && xbridge::OrderBook::priceEqual(xbridge::price(ptr), xbridge::price(bestAsks[askCount - 1]));
+        });
+        const auto returnedLevelAsks = std::count_if(bestAsks.begin(), bestAsks.end(), [&](const xbridge::TransactionDescrPtr & ptr) {
+            return xbridge::OrderBook::priceEqual(xbridge::price(ptr), xbridge::price(bestAsks[askCount - 1]));
+        });
+        BOOST_CHECK_EQUAL(levelAsks, returnedLevelAsks);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(xbridgeutil_asynclogwriter)
+{
+    SetDataDir("logwriter");
+    ClearDatadirCache();
+
+    // Concurrent writers, every message is written once and in order per thread
+    {
+        xbridge::AsyncLogWriter writer("logtest", "concurrent.log", false);
+        const int threadCount = 4;
+        const int messages = 2000; // total fits the queue, nothing is dropped
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+            threads.emplace_back([&writer, t]() {
+                for (int i = 0; i < messages; ++i)
+                    writer.write("\n" + std::to_string(t) + " " + std::to_string(i));
+            });
+        for (auto & thread : threads)
+            thread.join();
+        writer.flush();
+        BOOST_CHECK_EQUAL(writer.dropped(), 0U);
+        BOOST_CHECK_EQUAL(writer.fileName(), (GetDataDir(false) / "logtest" / "concurrent.log").string());
+
+        const auto lines = ReadLines(writer.fileName());
+        BOOST_CHECK_EQUAL(lines.size(), static_cast<size_t>(threadCount * messages));
+        std::vector<int> next(threadCount, 0);
+        for (const auto & line : lines) {
+            int t{-1}, i{-1};
+            BOOST_CHECK(sscanf(line.c_str(), "%d %d", &t, &i) == 2);
+            BOOST_CHECK(t >= 0 && t < threadCount);
+            if (t < 0 || t >= threadCount)
+                continue;
+            BOOST_CHECK_EQUAL(i, next[t]);
+            next[t] = i + 1;
+        }
+        for (int t = 0; t < threadCount; ++t)
+            BOOST_CHECK_EQUAL(next[t], messages);
+    }
+
+    // Messages are either written or counted as dropped, drops are reported in the log
+    {
+        xbridge::AsyncLogWriter writer("logtest", "overflow.log", false);
+        const size_t messages = xbridge::AsyncLogWriter::QUEUE_SIZE * 4;
+        size_t accepted{0};
+        for (size_t i = 0; i < messages; ++i)
+            accepted += writer.write("\nmessage " + std::to_string(i)) ? 1 : 0;
+        writer.flush();
+        BOOST_CHECK_EQUAL(accepted + writer.dropped(), messages);
+
+        size_t written{0}, notices{0};
+        for (const auto & line : ReadLines(writer.fileName())) {
+            if (line.find("message ") == 0)
+                ++written;
+            else if (line.find("log queue full") != std::string::npos)
+                ++notices;
+        }
+        BOOST_CHECK_EQUAL(written, accepted);
+        BOOST_CHECK_EQUAL(notices > 0, writer.dropped() > 0);
+    }
+
+    // Queued messages are written on stop, later messages are written directly
+    {
+        xbridge::AsyncLogWriter writer("logtest", "stop.log", false);
+        for (int i = 0; i < 100; ++i)
+            writer.write("\nqueued " + std::to_string(i));
+        writer.stop();
+        BOOST_CHECK_EQUAL(ReadLines(writer.fileName()).size(), 100U);
+        BOOST_CHECK(writer.write("\nafter stop"));
+        const auto lines = ReadLines(writer.fileName());
+        BOOST_CHECK_EQUAL(lines.size(), 101U);
+        BOOST_CHECK_EQUAL(lines.back(), "after stop");
+        writer.stop();
+    }
+
+    // Daily logs are named by the local date
+    {
+        xbridge::AsyncLogWriter writer("logtest", "daily_");
+        writer.write("\ndaily");
+        writer.flush();
+        const std::string day = boost::gregorian::to_iso_string(boost::gregorian::day_clock::local_day());
+        const auto dir = GetDataDir(false) / "logtest";
+        BOOST_CHECK_EQUAL(writer.fileName(), (dir / ("daily_" + day + ".log")).string());
+        BOOST_CHECK_EQUAL(ReadLines(writer.fileName()).size(), 1U);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,474 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <core_io.h>
+#include <netbase.h>
+#include <test/httptestserver.h>
+#include <test/test_bitcoin.h>
+
+#define private public
+#include <xrouter/xrouterapp.h>
+#undef private
+#include <xrouter/xrouterconnectorbtc.h>
+
+#include <future>
+
+#include <boost/test/unit_test.hpp>
+
+using QueryMgr = xrouter::App::QueryMgr;
+using xrouter::NodeAddr;
+
+/** Returns the canonical reply hash. */
+static uint256 ReplyHash(const std::string & reply, bool & error) {
+    return QueryMgr::replyHash(reply, error);
+}
+
+static uint256 ReplyHash(const std::string & reply) {
+    bool error{false};
+    return ReplyHash(reply, error);
+}
+
+/** Returns true if the future is ready within the timeout. */
+static bool IsReady(const boost::shared_future<void> & future, const int timeoutMillis = 0) {
+    return future.wait_for(boost::chrono::milliseconds(timeoutMillis)) == boost::future_status::ready;
+}
+
+/** Sends the request through the shared url client and waits for the handler. */
+static std::pair<xrouter::XRouterReply, std::string> CallUrl(const std::string & host, const int port,
+                                                             const std::string & data, const CKey & key)
+{
+    auto done = std::make_shared<std::promise<std::pair<xrouter::XRouterReply, std::string>>>();
+    auto future = done->get_future();
+    xrouter::CallXRouterUrlAsync(host, port, "/xr/BLOCK/xrGetBlockCount", data, 10, key, CPubKey(), "feetx",
+                                 [done](const xrouter::XRouterReply & reply, const std::string & error) {
+        done->set_value(std::make_pair(reply, error));
+    });
+    if (future.wait_for(std::chrono::seconds(20)) != std::future_status::ready)
+        return std::make_pair(xrouter::XRouterReply{}, std::string("timed out"));
+    return future.get();
+}
+
+/** Fake rpc backend reply to a json-rpc call, the result is "<method>:<first param>". */
+static json_spirit::Object RPCReply(const json_spirit::Value & call)
+{
+    const auto & obj = call.get_obj();
+    const auto & params = json_spirit::find_value(obj, "params").get_array();
+    std::string result = json_spirit::find_value(obj, "method").get_str() + ":";
+    if (!params.empty())
+        result += params[0].type() == json_spirit::str_type ? params[0].get_str() : json_spirit::write_string(params[0], false);
+    json_spirit::Object reply;
+    reply.emplace_back("result", result);
+    reply.emplace_back("error", json_spirit::Value());
+    reply.emplace_back("id", json_spirit::find_value(obj, "id"));
+    return reply;
+}
+
+/** Returns the result of a json-rpc reply and its id. */
+static std::string RPCResult(const std::string & reply, int64_t & id)
+{
+    json_spirit::Value val;
+    if (!json_spirit::read_string(reply, val) || val.type() != json_spirit::obj_type)
+        return "";
+    const auto & idVal = json_spirit::find_value(val.get_obj(), "id");
+    id = idVal.type() == json_spirit::int_type ? idVal.get_int64() : -1;
+    const auto & result = json_spirit::find_value(val.get_obj(), "result");
+    return result.type() == json_spirit::str_type ? result.get_str() : "";
+}
+
+BOOST_FIXTURE_TEST_SUITE(xrouter_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(xrouter_replyhash)
+{
+    // Json replies of any type match regardless of formatting
+    BOOST_CHECK(ReplyHash("{\"a\":1.5,\"b\":[1,2]}") == ReplyHash("{ \"a\" : 1.50000000000000000, \"b\" : [ 1, 2 ] }\n"));
+    BOOST_CHECK(ReplyHash("[1.5,{\"x\":\"y\"}]") == ReplyHash("[ 1.50000000000000000 , { \"x\" : \"y\" } ]"));
+    BOOST_CHECK(ReplyHash("1.5") == ReplyHash("1.50000000000000000"));
+    BOOST_CHECK(ReplyHash("\"abc\"") == ReplyHash(" \"abc\"\n"));
+    BOOST_CHECK(ReplyHash("[1,2]") != ReplyHash("[2,1]"));
+    BOOST_CHECK(ReplyHash("1.5") != ReplyHash("\"1.5\""));
+
+    // Other replies are compared as is
+    BOOST_CHECK(ReplyHash("not json") == ReplyHash("not json"));
+    BOOST_CHECK(ReplyHash("not json") != ReplyHash("not  json"));
+    BOOST_CHECK(ReplyHash("[1] trailing") != ReplyHash("[1]"));
+
+    // Only json objects with an error field are errors
+    bool error{false};
+    ReplyHash("{\"error\":\"bad\",\"code\":1}", error);
+    BOOST_CHECK(error);
+    ReplyHash("{\"result\":1,\"error\":null}", error);
+    BOOST_CHECK(!error);
+    ReplyHash("[{\"error\":\"bad\"}]", error);
+    BOOST_CHECK(!error);
+}
+
+BOOST_AUTO_TEST_CASE(xrouter_querymgr_replies)
+{
+    QueryMgr qm;
+
+    // Unknown queries are ready
+    BOOST_CHECK(IsReady(qm.replies("unknown", 1)));
+
+    // Replies are only accepted once from nodes added to the query
+    qm.addQuery("q1", "n1");
+    qm.addQuery("q1", "n2");
+    qm.addQuery("q1", "n3");
+    auto future = qm.replies("q1", 3);
+    BOOST_CHECK(!IsReady(future));
+    BOOST_CHECK_EQUAL(qm.addReply("q1", "n4", "{\"a\":1}"), 0);
+    BOOST_CHECK_EQUAL(qm.addReply("q1", "n1", "{\"a\":1}"), 1);
+    BOOST_CHECK_EQUAL(qm.addReply("q1", "n1", "{\"a\":2}"), 0);
+    BOOST_CHECK(!IsReady(future));
+    BOOST_CHECK(!qm.hasConsensus("q1"));
+
+    // Completes early once the pending reply can no longer change the most common reply
+    BOOST_CHECK_EQUAL(qm.addReply("q1", "n2", "{ \"a\" : 1 }"), 2);
+    BOOST_CHECK(qm.hasConsensus("q1"));
+    BOOST_CHECK(IsReady(future));
+    std::string reply;
+    std::map<NodeAddr, std::string> replies;
+    std::set<NodeAddr> agree, diff;
+    BOOST_CHECK_EQUAL(qm.mostCommonReply("q1", reply, replies, agree, diff), 2);
+    BOOST_CHECK_EQUAL(reply, "{\"a\":1}");
+    BOOST_CHECK(agree == std::set<NodeAddr>({"n1", "n2"}));
+    BOOST_CHECK(diff.empty());
+
+    // Late replies are still recorded
+    BOOST_CHECK_EQUAL(qm.addReply("q1", "n3", "{\"a\":2}"), 3);
+    BOOST_CHECK_EQUAL(qm.mostCommonReply("q1", reply, replies, agree, diff), 2);
+    BOOST_CHECK(diff == std::set<NodeAddr>({"n3"}));
+    BOOST_CHECK_EQUAL(replies.size(), 3U);
+
+    // Completes when the requested number of replies arrived
+    qm.addQuery("q2", "n1");
+    qm.addQuery("q2", "n2");
+    qm.addQuery("q2", "n3");
+    future = qm.replies("q2", 2);
+    qm.addReply("q2", "n1", "1");
+    BOOST_CHECK(!IsReady(future));
+    qm.addReply("q2", "n2", "2");
+    BOOST_CHECK(IsReady(future));
+
+    // Split replies complete once no more replies are expected
+    qm.addQuery("q3", "n1");
+    qm.addQuery("q3", "n2");
+    qm.addQuery("q3", "n3");
+    future = qm.replies("q3", 3);
+    qm.addReply("q3", "n1", "1");
+    qm.addReply("q3", "n2", "2");
+    BOOST_CHECK(!IsReady(future));
+    qm.purge("q3", "n3");
+    BOOST_CHECK(IsReady(future));
+    BOOST_CHECK(!qm.hasQuery("q3"));
+
+    // Replies received before waiting complete the query once waited on
+    qm.addQuery("q4", "n1");
+    qm.addReply("q4", "n1", "1");
+    BOOST_CHECK(IsReady(qm.replies("q4", 1)));
+
+    // Purged queries complete and reject further replies
+    qm.addQuery("q5", "n1");
+    qm.addQuery("q5", "n2");
+    future = qm.replies("q5", 2);
+    qm.purge("q5");
+    BOOST_CHECK(IsReady(future));
+    BOOST_CHECK_EQUAL(qm.addReply("q5", "n1", "1"), 0);
+    BOOST_CHECK(!qm.hasReply("q5", "n1"));
+
+    // Cancelled queries complete
+    qm.addQuery("q6", "n1");
+    future = qm.replies("q6", 1);
+    qm.cancelAll();
+    BOOST_CHECK(IsReady(future));
+
+    // Waiting callers are woken up by replies from other threads
+    qm.addQuery("q7", "n1");
+    qm.addQuery("q7", "n2");
+    future = qm.replies("q7", 2);
+    std::thread t([&qm]() {
+        MilliSleep(50);
+        qm.addReply("q7", "n1", "1");
+        qm.addReply("q7", "n2", "1");
+    });
+    BOOST_CHECK(IsReady(future, 10000));
+    t.join();
+    BOOST_CHECK_EQUAL(qm.allReplies("q7").size(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE(xrouter_urlclient)
+{
+    CKey key; key.MakeNewKey(true);
+    const auto callerThread = std::this_thread::get_id();
+    std::thread::id handlerThread;
+
+    // Replies with the request data if the request is signed by the key
+    HTTPTestServer server([&key](const HTTPTestServer::Request & request) {
+        HTTPTestServer::Response response;
+        const auto & body = request.body;
+        const auto data = body.empty() ? body : body.substr(0, body.size() - 1);
+        CHashWriter hw(SER_GETHASH, 0);
+        hw << data;
+        CPubKey pubkey;
+        const auto signature = ParseHex(request.headers.count("XR-Signature") ? request.headers.at("XR-Signature") : "");
+        if (!pubkey.RecoverCompact(hw.GetHash(), signature) || pubkey != key.GetPubKey()
+            || request.headers.count("XR-Pubkey") == 0 || request.headers.at("XR-Pubkey") != HexStr(pubkey))
+        {
+            response.status = HTTP_BAD_REQUEST;
+            response.body = "bad signature";
+            return response;
+        }
+        response.body = strprintf("%s %s %s", request.uri, request.headers.at("XR-Payment"), data);
+        return response;
+    });
+
+    auto result = CallUrl("127.0.0.1", server.port(), "[1,2]", key);
+    BOOST_CHECK_EQUAL(result.second, "");
+    BOOST_CHECK_EQUAL(result.first.status, HTTP_OK);
+    BOOST_CHECK_EQUAL(result.first.result, "/xr/BLOCK/xrGetBlockCount feetx [1,2]");
+
+    // Concurrent requests on the shared client thread
+    {
+        std::vector<std::future<std::pair<xrouter::XRouterReply, std::string>>> calls;
+        for (int i = 0; i < 8; ++i)
+            calls.push_back(std::async(std::launch::async, [&server,&key,i]() {
+                return CallUrl("127.0.0.1", server.port(), std::to_string(i), key);
+            }));
+        for (int i = 0; i < 8; ++i) {
+            const auto r = calls[i].get();
+            BOOST_CHECK_EQUAL(r.second, "");
+            BOOST_CHECK_EQUAL(r.first.result, strprintf("/xr/BLOCK/xrGetBlockCount feetx %d", i));
+        }
+        BOOST_CHECK_EQUAL(server.requests(), 9);
+    }
+
+    // Handlers are called on the client thread
+    {
+        auto done = std::make_shared<std::promise<void>>();
+        xrouter::CallXRouterUrlAsync("127.0.0.1", server.port(), "/", "", 10, key, CPubKey(), "",
+                                     [done,&handlerThread](const xrouter::XRouterReply &, const std::string &) {
+            handlerThread = std::this_thread::get_id();
+            done->set_value();
+        });
+        BOOST_CHECK(done->get_future().wait_for(std::chrono::seconds(20)) == std::future_status::ready);
+        BOOST_CHECK(handlerThread != callerThread);
+    }
+
+    // Failed requests call the handler with the error
+    const int port = server.port();
+    server.stop();
+    result = CallUrl("127.0.0.1", port, "[1,2]", key);
+    BOOST_CHECK(!result.second.empty());
+    BOOST_CHECK(result.second != "timed out");
+
+    // The client restarts after it was stopped
+    xrouter::StopXRouterUrlClient();
+    HTTPTestServer server2([](const HTTPTestServer::Request & request) {
+        HTTPTestServer::Response response;
+        response.body = "ok";
+        return response;
+    });
+    result = CallUrl("127.0.0.1", server2.port(), "", key);
+    BOOST_CHECK_EQUAL(result.second, "");
+    BOOST_CHECK_EQUAL(result.first.result, "ok");
+    xrouter::StopXRouterUrlClient();
+}
+
+BOOST_AUTO_TEST_CASE(xrouter_rpcbatch)
+{
+    // Batches are answered in reverse order, optionally without the reply of one call
+    // or with the single error of backends that do not support batches
+    std::atomic<bool> batchSupport{true};
+    std::atomic<int64_t> omitId{-1};
+    Mutex mu;
+    std::vector<size_t> batchSizes;
+    HTTPTestServer server([&](const HTTPTestServer::Request & request) {
+        HTTPTestServer::Response response;
+        json_spirit::Value body;
+        json_spirit::read_string(request.body, body);
+        if (body.type() != json_spirit::array_type) {
+            response.body = json_spirit::write_string(json_spirit::Value(RPCReply(body)), false);
+            return response;
+        }
+        const auto & calls = body.get_array();
+        {
+            LOCK(mu);
+            batchSizes.push_back(calls.size());
+        }
+        if (!batchSupport) {
+            response.body = "{\"result\":null,\"error\":{\"code\":-32600,\"message\":\"Invalid Request object\"},\"id\":null}";
+            return response;
+        }
+        json_spirit::Array replies;
+        for (auto it = calls.rbegin(); it != calls.rend(); ++it)
+            if (json_spirit::find_value(it->get_obj(), "id").get_int64() != omitId)
+                replies.emplace_back(RPCReply(*it));
+        response.body = json_spirit::write_string(json_spirit::Value(replies), false);
+        return response;
+    });
+    const std::string host{"127.0.0.1"};
+    const std::string port{std::to_string(server.port())};
+    const std::vector<std::pair<std::string, json_spirit::Array>> calls{
+        {"getblockhash", json_spirit::Array{ 1 }},
+        {"getblock", json_spirit::Array{ "a" }},
+        {"getblockcount", json_spirit::Array{}},
+    };
+    const std::vector<std::string> expected{"getblockhash:1", "getblock:a", "getblockcount:"};
+    auto checkReplies = [&expected](const std::vector<std::string> & replies, const bool matchIds) {
+        BOOST_CHECK_EQUAL(replies.size(), expected.size());
+        for (size_t i = 0; i < std::min(replies.size(), expected.size()); ++i) {
+            int64_t id{-1};
+            BOOST_CHECK_EQUAL(RPCResult(replies[i], id), expected[i]);
+            if (matchIds)
+                BOOST_CHECK_EQUAL(id, static_cast<int64_t>(i));
+        }
+    };
+
+    // No request without calls
+    BOOST_CHECK(xrouter::CallRPCBatch("", "", host, port, {}).empty());
+    BOOST_CHECK_EQUAL(server.requests(), 0);
+
+    // Replies are matched to the calls by id
+    checkReplies(xrouter::CallRPCBatch("", "", host, port, calls), true);
+    BOOST_CHECK_EQUAL(server.requests(), 1);
+
+    // Calls without a reply in the batch are sent individually
+    omitId = 1;
+    checkReplies(xrouter::CallRPCBatch("", "", host, port, calls), false);
+    BOOST_CHECK_EQUAL(server.requests(), 3);
+    omitId = -1;
+
+    // Backends without batch support are sent every call individually
+    batchSupport = false;
+    checkReplies(xrouter::CallRPCBatch("", "", host, port, calls), false);
+    BOOST_CHECK_EQUAL(server.requests(), 7);
+    batchSupport = true;
+
+    // Connector calls are sent in batches of at most rpcBatchSize, replies follow the
+    // requested order and repeated hashes are fetched once
+    xrouter::BtcWalletConnectorXRouter conn;
+    conn.m_ip = host;
+    conn.m_port = port;
+    conn.rpcBatchSize = 2;
+    {
+        LOCK(mu);
+        batchSizes.clear();
+    }
+    const auto blocks = conn.getBlocks({"c", "a", "e", "a", "b", "d"});
+    const std::vector<std::string> expectedBlocks{"getblock:c", "getblock:a", "getblock:e", "getblock:a", "getblock:b", "getblock:d"};
+    BOOST_CHECK_EQUAL(blocks.size(), expectedBlocks.size());
+    for (size_t i = 0; i < std::min(blocks.size(), expectedBlocks.size()); ++i) {
+        int64_t id{-1};
+        BOOST_CHECK_EQUAL(RPCResult(blocks[i], id), expectedBlocks[i]);
+    }
+    {
+        LOCK(mu);
+        BOOST_CHECK(batchSizes == std::vector<size_t>({2, 2, 1}));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(xrouter_requestqueue)
+{
+    using namespace xrouter;
+    auto & app = App::instance();
+    CNode node(0, NODE_NETWORK, 0, INVALID_SOCKET, CAddress(LookupNumeric("127.0.0.2", 41412), NODE_NONE),
+               0, 0, CAddress(), "", /*fInboundIn=*/ true);
+    const std::string ownQuery{"00000000-0000-0000-0000-000000000001"};
+    const std::string otherQuery{"00000000-0000-0000-0000-000000000002"};
+    app.queryMgr.addQuery(ownQuery, node.GetAddrName());
+
+    // Commands cost 0.1 paid to the payee, xrGetBlockHash is free
+    CKey payee;
+    payee.MakeNewKey(true);
+    const CTxDestination payeeDest = payee.GetPubKey().GetID();
+    const auto xrsettings = app.xrsettings;
+    app.xrsettings = std::make_shared<XRouterSettings>(CPubKey{});
+    BOOST_CHECK(app.xrsettings->init("[Main]\nhost=127.0.0.1\nfee=0.1\npaymentaddress=" + EncodeDestination(payeeDest) +
+                                     "\n[xrGetBlockHash]\nfee=0\n"));
+
+    auto makeFeeTx = [](const CScript & script, const CAmount amount) {
+        CMutableTransaction mtx;
+        mtx.vin.emplace_back(COutPoint(InsecureRand256(), 0));
+        mtx.vout.emplace_back(amount, script);
+        return EncodeHexTx(CTransaction(mtx));
+    };
+    const std::string feetx = makeFeeTx(GetScriptForDestination(payeeDest), COIN / 10);
+    auto makeRequest = [](const XRouterCommand command, const std::string & uuid, const std::string & feetx) {
+        auto packet = std::make_shared<XRouterPacket>(command, uuid);
+        packet->append("BLOCK");
+        packet->append(feetx);
+        packet->append(static_cast<uint32_t>(0));
+        return packet;
+    };
+    auto makeReply = [](const XRouterCommand command, const std::string & uuid) {
+        auto packet = std::make_shared<XRouterPacket>(command, uuid);
+        packet->append("{\"result\":1}");
+        return packet;
+    };
+
+    // Only requests with a fee transaction paying the command fee to our payment address are paid
+    const auto free = makeRequest(xrGetBlockCount, otherQuery, "");
+    const auto paid = makeRequest(xrGetBlockCount, otherQuery, feetx);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, free), REQUEST_PRIORITY_FREE);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, paid), REQUEST_PRIORITY_PAID);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeRequest(xrGetBlockCount, otherQuery, "nofee")), REQUEST_PRIORITY_FREE);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeRequest(xrGetBlockCount, otherQuery, "00")), REQUEST_PRIORITY_FREE);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeRequest(xrGetConfig, otherQuery, feetx)), REQUEST_PRIORITY_FREE);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeRequest(xrGetBlockHash, otherQuery, feetx)), REQUEST_PRIORITY_FREE);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeRequest(xrGetBlockCount, otherQuery,
+            makeFeeTx(GetScriptForDestination(payeeDest), COIN / 10 - 1))), REQUEST_PRIORITY_FREE);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeRequest(xrGetBlockCount, otherQuery,
+            makeFeeTx(CScript() << OP_TRUE, COIN))), REQUEST_PRIORITY_FREE);
+
+    // Only replies to our own queries are served first
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeReply(xrReply, ownQuery)), REQUEST_PRIORITY_REPLY);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeReply(xrConfigReply, ownQuery)), REQUEST_PRIORITY_REPLY);
+    BOOST_CHECK_EQUAL(app.requestPriority(&node, makeReply(xrReply, otherQuery)), REQUEST_PRIORITY_FREE);
+
+    // A full queue rejects the lowest priority requests but never replies to our own queries
+    const auto queueMax = app.requestQueueMax;
+    const uint64_t rejected = app.requestsRejected;
+    app.requestQueueMax = 2;
+    auto queue = [&app,&node](XRouterPacketPtr packet) {
+        node.AddRef();
+        app.queueRequest(&node, packet);
+    };
+    auto queued = [&app](const int priority) {
+        return std::count_if(app.requestQueue.begin(), app.requestQueue.end(), [priority](const App::QueuedRequest & r) {
+            return r.priority == priority;
+        });
+    };
+    queue(free);
+    queue(free);
+    queue(paid);
+    BOOST_CHECK_EQUAL(app.requestQueue.size(), 2U);
+    BOOST_CHECK_EQUAL(queued(REQUEST_PRIORITY_PAID), 1);
+    BOOST_CHECK_EQUAL(app.requestsRejected, rejected + 1);
+    queue(makeReply(xrReply, otherQuery));
+    BOOST_CHECK_EQUAL(app.requestsRejected, rejected + 2);
+    for (int i = 0; i < 3; ++i)
+        queue(makeReply(xrReply, ownQuery));
+    BOOST_CHECK_EQUAL(app.requestQueue.size(), 3U);
+    BOOST_CHECK_EQUAL(queued(REQUEST_PRIORITY_REPLY), 3);
+    queue(paid);
+    BOOST_CHECK_EQUAL(queued(REQUEST_PRIORITY_REPLY), 3);
+    BOOST_CHECK_EQUAL(app.requestsRejected, rejected + 5);
+    BOOST_CHECK_EQUAL(node.GetRefCount(), 3);
+
+    // Requests received after stop() are released instead of queued
+    app.stopped = true;
+    queue(paid);
+    app.stopped = false;
+    BOOST_CHECK_EQUAL(app.requestQueue.size(), 3U);
+    BOOST_CHECK_EQUAL(node.GetRefCount(), 3);
+
+    // Clean up
+    for (const auto & request : app.requestQueue)
+        request.node->Release();
+    app.requestQueue.clear();
+    app.requestQueueMax = queueMax;
+    app.xrsettings = xrsettings;
+    app.queryMgr.purge(ownQuery);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,7 +20,9 @@
 #include <governance/governance.h>
 #include <hash.h>
 #include <kernel.h>
+#include <index/governanceindex.h>
 #include <index/txindex.h>
+#include <index/xbridgetradeindex.h>
 #include <net.h>
 #include <policy/fees.h>
 #include <policy/policy.h>
@@ -47,8 +49,10 @@
 #include <validationinterface.h>
 #include <warnings.h>
 
+#include <deque>
 #include <future>
 #include <sstream>
+#include <unordered_map>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/thread.hpp>
@@ -2186,6 +2190,10 @@ bool static FlushStateToDisk(const CChainParams& chainparams, CValidationState &
         auto locator = chainActive.GetLocator();
         if (g_txindex)
             g_txindex->ChainStateFlushedSync(locator);
+        if (g_governanceindex)
+            g_governanceindex->ChainStateFlushedSync(locator);
+        if (g_xbridgetradeindex)
+            g_xbridgetradeindex->ChainStateFlushedSync(locator);
         GetMainSignals().ChainStateFlushed(locator);
     }
     } catch (const std::runtime_error& e) {
@@ -2330,6 +2338,12 @@ bool CChainState::DisconnectTip(CValidationState& state, const CChainParams& cha
     chainActive.SetTip(pindexDelete->pprev);
 
     UpdateTip(pindexDelete->pprev, chainparams);
+    // Indexes that are still syncing skip disconnected blocks, the sync thread
+    // continues from the fork on the active chain.
+    if (g_governanceindex && g_governanceindex->IsSynced())
+        g_governanceindex->BlockDisconnectedSync(pblock, pindexDelete);
+    if (g_xbridgetradeindex && g_xbridgetradeindex->IsSynced())
+        g_xbridgetradeindex->BlockDisconnectedSync(pblock, pindexDelete);
     // Let wallets know transactions went from 1-confirmed to
     // 0-confirmed or conflicted:
     GetMainSignals().BlockDisconnected(pblock);
@@ -2721,6 +2735,10 @@ bool CChainState::ActivateBestChain(CValidationState &state, const CChainParams&
                     assert(trace.pblock && trace.pindex);
                     if (g_txindex)
                         g_txindex->BlockConnectedSync(trace.pblock, trace.pindex, *trace.conflictedTxs);
+                    if (g_governanceindex)
+                        g_governanceindex->BlockConnectedSync(trace.pblock, trace.pindex, *trace.conflictedTxs);
+                    if (g_xbridgetradeindex)
+                        g_xbridgetradeindex->BlockConnectedSync(trace.pblock, trace.pindex, *trace.conflictedTxs);
                     GetMainSignals().BlockConnected(trace.pblock, trace.pindex, trace.conflictedTxs);
                 }
             } while (!chainActive.Tip() || (starting_tip && CBlockIndexWorkComparator()(chainActive.Tip(), starting_tip)));
@@ -2923,6 +2941,40 @@ void ResetBlockFailureFlags(CBlockIndex *pindex) {
     return g_chainstate.ResetBlockFailureFlags(pindex);
 }
 
+/**
+ * Proof-of-stake hashes of checked headers, kept until the header is added to
+ * the block index where the hash is stored (CBlockIndex::hashProofOfStake).
+ * Headers are checked right before they are indexed, the oldest entries are
+ * evicted so blocks that are checked again after indexing don't accumulate.
+ */
+static const size_t MAX_PENDING_PROOF_OF_STAKE = 1000;
+static Mutex muPendingProofOfStake;
+static std::unordered_map<uint256, uint256, BlockHasher> mapPendingProofOfStake GUARDED_BY(muPendingProofOfStake);
+static std::deque<uint256> dequePendingProofOfStake GUARDED_BY(muPendingProofOfStake);
+
+static void AddPendingProofOfStake(const uint256& blockHash, const uint256& hashProofOfStake)
+{
+    LOCK(muPendingProofOfStake);
+    if (!mapPendingProofOfStake.emplace(blockHash, hashProofOfStake).second)
+        return;
+    dequePendingProofOfStake.push_back(blockHash);
+    while (dequePendingProofOfStake.size() > MAX_PENDING_PROOF_OF_STAKE) {
+        mapPendingProofOfStake.erase(dequePendingProofOfStake.front());
+        dequePendingProofOfStake.pop_front();
+    }
+}
+
+static bool TakePendingProofOfStake(const uint256& blockHash, uint256& hashProofOfStake)
+{
+    LOCK(muPendingProofOfStake);
+    auto it = mapPendingProofOfStake.find(blockHash);
+    if (it == mapPendingProofOfStake.end())
+        return false;
+    hashProofOfStake = it->second;
+    mapPendingProofOfStake.erase(it);
+    return true;
+}
+
 CBlockIndex* CChainState::AddToBlockIndex(const CBlockHeader& block)
 {
     AssertLockHeld(cs_main);
@@ -2953,15 +3005,11 @@ CBlockIndex* CChainState::AddToBlockIndex(const CBlockHeader& block)
         pindexNew->SetStakeEntropyBit(ebit);
         if (IsProofOfStake(pindexNew->nHeight)) {
             pindexNew->SetProofOfStake();
-            if (HasHashProofOfStake(hash))
-                pindexNew->hashProofOfStake = GetHashProofOfStake(hash);
-            else {
-                uint256 hashProofOfStake;
-                if (!CheckProofOfStake(block, pindexNew->pprev, hashProofOfStake, Params().GetConsensus()))
-                    LogPrint(BCLog::ALL, "AddToBlockIndex() : CheckProofOfStake failed\n");
-                pindexNew->hashProofOfStake = hashProofOfStake;
-                SetHashProofOfStake(block.GetHash(), hashProofOfStake);
-            }
+            uint256 hashProofOfStake;
+            if (!TakePendingProofOfStake(hash, hashProofOfStake)
+                    && !CheckProofOfStake(block, pindexNew->pprev, hashProofOfStake, Params().GetConsensus()))
+                LogPrint(BCLog::ALL, "AddToBlockIndex() : CheckProofOfStake failed\n");
+            pindexNew->hashProofOfStake = hashProofOfStake;
         }
 
         // ppcoin: compute stake modifier
@@ -3139,8 +3187,8 @@ static bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state,
     uint256 blockHash = block.GetHash();
     uint256 hashProofOfStake;
     bool valid = CheckPoS(block, state, hashProofOfStake, consensusParams);
-    if (valid && !HasHashProofOfStake(blockHash))
-        SetHashProofOfStake(blockHash, hashProofOfStake);
+    if (valid)
+        AddPendingProofOfStake(blockHash, hashProofOfStake);
     return valid;
 }
 
@@ -4045,6 +4093,16 @@ bool CChainState::LoadBlockIndex(const Consensus::Params& consensus_params, CBlo
             pindexBestInvalid = pindex;
         if (pindex->pprev)
             pindex->BuildSkip();
+        // Fill in proof-of-stake hashes missing from the block index db. Only v05
+        // stakes are recomputed, older stake modifiers depend on the active chain.
+        if (pindex->IsProofOfStake() && pindex->hashProofOfStake.IsNull() && pindex->pprev
+                && IsProtocolV05(pindex->GetBlockTime()) && !(pindex->nStatus & BLOCK_FAILED_MASK)) {
+            uint256 hashProofOfStake;
+            if (CheckProofOfStake(pindex->GetBlockHeader(), pindex->pprev, hashProofOfStake, consensus_params)) {
+                pindex->hashProofOfStake = hashProofOfStake;
+                setDirtyBlockIndex.insert(pindex);
+            }
+        }
         if (pindex->IsValid(BLOCK_VALID_TREE) && (pindexBestHeader == nullptr || CBlockIndexWorkComparator()(pindexBestHeader, pindex)))
             pindexBestHeader = pindex;
 
@@ -4524,6 +4582,7 @@ void UnloadBlockIndex()
         warningcache[b].clear();
     }
 
+    ResetLegacyStakeModifierIndex(); // references the block index
     for (const BlockMap::value_type& entry : mapBlockIndex) {
         delete entry.second;
     }
@@ -5161,6 +5220,24 @@ bool GetTxFunc(const COutPoint & out, CTransactionRef & tx) {
     return true;
 }
 
+bool GetUtxoFunc(const COutPoint & out, CTxOut & txout) {
+    {
+        LOCK(cs_main);
+        Coin coin;
+        if (pcoinsTip->GetCoin(out, coin)) {
+            txout = coin.out;
+            return !mempool.isSpent(out); // utxo spent by a pending transaction
+        }
+    }
+    // Spent utxos are resolved from the transaction, the output is required to
+    // validate servicenodes in the spent collateral grace period.
+    CTransactionRef tx;
+    uint256 hashBlock;
+    if (GetTransaction(out.hash, tx, Params().GetConsensus(), hashBlock) && out.n < tx->vout.size())
+        txout = tx->vout[out.n];
+    return false;
+}
+
 bool IsServiceNodeBlockValidFunc(const uint64_t & blockNumber, const uint256 & blockHash, const bool & checkStale) {
     LOCK(cs_main);
     if (checkStale && blockNumber < chainActive.Height() - SNODE_STALE_BLOCKS) // check if stale
@@ -5175,20 +5252,3 @@ int GetChainTipHeight() {
     LOCK(cs_main);
     return chainActive.Height();
 }
-
-Mutex muMapProofOfStake;
-std::map<uint256, uint256> mapProofOfStake;
-uint256 GetHashProofOfStake(const uint256 & blockHash) {
-    LOCK(muMapProofOfStake);
-    if (mapProofOfStake.count(blockHash))
-        return mapProofOfStake[blockHash];
-    return {};
-}
-bool HasHashProofOfStake(const uint256 & blockHash) {
-    LOCK(muMapProofOfStake);
-    return mapProofOfStake.count(blockHash) > 0;
-}
-void SetHashProofOfStake(const uint256 & blockHash, const uint256 & hashProofOfStake) {
-    LOCK(muMapProofOfStake);
-    mapProofOfStake[blockHash] = hashProofOfStake;
-}
\ No newline at end of file
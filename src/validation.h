@@ -537,6 +537,16 @@ bool VerifySig(const CBlock & block, const CScript & stakeScript);
  */
 bool GetTxFunc(const COutPoint & out, CTransactionRef & tx);
 
+/**
+ * Returns the unspent output from the coins view (chain tip). Returns false if the utxo
+ * is spent, spent by a transaction in the mempool or not found. The output of a spent
+ * utxo is still assigned from its transaction if it can be found.
+ * @param out
+ * @param txout
+ * @return bool
+ */
+bool GetUtxoFunc(const COutPoint & out, CTxOut & txout);
+
 /**
  * Returns true if the specified block is found in the chain tip.
  * @param blockNumber
@@ -553,9 +563,4 @@ bool IsServiceNodeBlockValidFunc(const uint64_t & blockNumber, const uint256 & b
  */
 extern int GetChainTipHeight();
 
-/** hashProofOfStake management */
-uint256 GetHashProofOfStake(const uint256 & blockHash);
-bool HasHashProofOfStake(const uint256 & blockHash);
-void SetHashProofOfStake(const uint256 & blockHash, const uint256 & hashProofOfStake);
-
 #endif // BITCOIN_VALIDATION_H
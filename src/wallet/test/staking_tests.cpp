@@ -104,6 +104,54 @@ BOOST_AUTO_TEST_CASE(staking_tests_v03modifier)
     pos_ptr.reset();
 }
 
+/// Check that the precomputed v03 stake modifiers match the v03 chain search
+BOOST_AUTO_TEST_CASE(staking_tests_v03modifierindex)
+{
+    auto pos_ptr = std::make_shared<TestChainPoS>(false);
+    auto & pos = *pos_ptr;
+    auto *params = (CChainParams*)&Params();
+    params->consensus.lastPOWBlock = 150;
+    params->consensus.governanceBlock = 10000; // disable governance
+    params->consensus.stakingV05UpgradeTime = std::numeric_limits<int>::max(); // set far into future
+    params->consensus.stakingV06UpgradeTime = std::numeric_limits<int>::max(); // disable v06
+    pos.Init("150");
+    const int blocks{100};
+    while (chainActive.Height() < 150 + blocks) {
+        pos.StakeBlocks(blocks/4);
+        SetMockTime(GetAdjustedTime() + GetStakeModifierSelectionInterval());
+    }
+
+    // The index can't be built while the chain is on the v03 protocol
+    BOOST_CHECK(!BuildLegacyStakeModifierIndex(chainActive.Tip()));
+
+    // Search the chain for the v03 modifiers
+    std::map<int, std::tuple<uint64_t, int, int64_t>> expected;
+    for (int i = 1; i <= chainActive.Height(); ++i) {
+        uint64_t nStakeModifier{0};
+        int nStakeModifierHeight{0};
+        int64_t nStakeModifierTime{0};
+        if (GetKernelStakeModifierV03(chainActive[i], nStakeModifier, nStakeModifierHeight, nStakeModifierTime))
+            expected[i] = std::make_tuple(nStakeModifier, nStakeModifierHeight, nStakeModifierTime);
+    }
+    BOOST_CHECK(!expected.empty());
+
+    // Upgrade to v05 at the chain tip, all prior blocks are v03 stakes
+    params->consensus.stakingV05UpgradeTime = chainActive.Tip()->GetBlockTime();
+    BOOST_CHECK(BuildLegacyStakeModifierIndex(chainActive.Tip()));
+    for (const auto & item : expected) {
+        uint64_t nStakeModifier{0};
+        int nStakeModifierHeight{0};
+        int64_t nStakeModifierTime{0};
+        BOOST_CHECK(GetKernelStakeModifierV03(chainActive[item.first], nStakeModifier, nStakeModifierHeight, nStakeModifierTime));
+        BOOST_CHECK_MESSAGE(std::make_tuple(nStakeModifier, nStakeModifierHeight, nStakeModifierTime) == item.second,
+                strprintf("Indexed v03 stake modifier should match chain search at height %d", item.first));
+    }
+
+    ResetLegacyStakeModifierIndex();
+    params->consensus.stakingV05UpgradeTime = std::numeric_limits<int>::max();
+    pos_ptr.reset();
+}
+
 /// Check that v05 staking modifier changes for each new selection interval
 BOOST_AUTO_TEST_CASE(staking_tests_v05modifier)
 {
@@ -602,6 +650,49 @@ BOOST_FIXTURE_TEST_CASE(staking_tests_stakes, TestChainPoS)
     // TODO Blocknet PoS unit test for p2pkh stakes
 }
 
+/// Check that the multi-threaded stake search finds the same stakes as the single-threaded search
+BOOST_FIXTURE_TEST_CASE(staking_tests_stakingthreads, TestChainPoS)
+{
+    const auto & params = Params();
+    std::vector<std::shared_ptr<CWallet>> wallets{wallet};
+    CBlockIndex *tip = nullptr;
+    {
+        LOCK(cs_main);
+        tip = chainActive.Tip();
+    }
+
+    auto findStakes = [&](const int & threads, std::set<std::pair<COutPoint, int64_t>> & stakesRet) -> bool {
+        gArgs.ForceSetArg("-stakingthreads", std::to_string(threads));
+        StakeMgr staker;
+        std::vector<StakeMgr::StakeCoin> nextStakes;
+        if (!staker.Update(wallets, tip, params.GetConsensus(), true) || !staker.NextStake(nextStakes, tip, params))
+            return false;
+        for (const auto & stake : nextStakes)
+            stakesRet.emplace(stake.coin->outpoint, stake.time);
+        return true;
+    };
+
+    // Search the same window with a different number of threads
+    const auto mockTime = GetAdjustedTime();
+    bool foundStakes{false};
+    for (int i = 0; i < 10; ++i) {
+        SetMockTime(mockTime + i * params.GetConsensus().nPowTargetSpacing);
+        std::set<std::pair<COutPoint, int64_t>> stakes1;
+        if (!findStakes(1, stakes1))
+            continue;
+        foundStakes = true;
+        for (const int threads : {2, 4, 0}) {
+            std::set<std::pair<COutPoint, int64_t>> stakesN;
+            BOOST_CHECK_MESSAGE(findStakes(threads, stakesN), strprintf("Expected stakes with %d staking threads", threads));
+            BOOST_CHECK_MESSAGE(stakes1 == stakesN, strprintf("Stakes found with %d staking threads should match", threads));
+        }
+        break;
+    }
+    BOOST_CHECK_MESSAGE(foundStakes, "Expected stakes in at least one search window");
+    gArgs.ForceSetArg("-stakingthreads", std::to_string(DEFAULT_STAKINGTHREADS));
+    SetMockTime(0);
+}
+
 /// Check CLTV
 BOOST_FIXTURE_TEST_CASE(staking_tests_cltv, TestChainPoS)
 {
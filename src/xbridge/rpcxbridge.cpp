@@ -6,6 +6,7 @@
 
 #include <xbridge/util/settings.h>
 #include <xbridge/util/logger.h>
+#include <xbridge/util/orderbook.h>
 #include <xbridge/util/xbridgeerror.h>
 #include <xbridge/util/xseries.h>
 #include <xbridge/util/xutil.h>
@@ -52,94 +53,6 @@ UniValue uret(const json_spirit::Value & o) {
     return uv;
 }
 
-/**
- * @brief TxOutToCurrencyPair inspects a CTxOut and returns currency pair transaction info
- * @param tx.vout - transaction outpoints with possible multisig/op_return
- * @param snode_pubkey - (output) the service node public key
- * @return - currency pair transaction details
- */
-CurrencyPair TxOutToCurrencyPair(const std::vector<CTxOut> & vout, std::string& snode_pubkey)
-{
-    snode_pubkey.clear();
-
-    if (vout.empty())
-        return {};
-
-    bool foundOpData{false};
-    std::string json;
-
-    for (const CTxOut & out : vout) {
-        if (out.scriptPubKey.empty())
-            continue;
-
-        std::vector<std::vector<unsigned char> > solutions;
-        txnouttype type = Solver(out.scriptPubKey, solutions);
-
-        if (type == TX_MULTISIG) {
-            if (solutions.size() < 4)
-                continue;
-
-            snode_pubkey = EncodeDestination(CTxDestination(CPubKey(solutions[1]).GetID()));
-            for (size_t i = 2; i < solutions.size()-1; ++i) {
-                const auto& sol = solutions[i];
-                if (sol.size() != 65)
-                    break;
-                std::copy(sol.begin()+1, sol.end(), std::back_inserter(json));
-            }
-        } else if (type == TX_NULL_DATA) {
-            if (out.nValue != 0 || !out.scriptPubKey.IsUnspendable())
-                continue;
-            std::vector<unsigned char> data;
-            CScript::const_iterator pc = out.scriptPubKey.begin();
-            while (pc < out.scriptPubKey.end()) { // look for order data
-                opcodetype opcode;
-                if (!out.scriptPubKey.GetOp(pc, opcode, data))
-                    break;
-                if (data.size() != 0) {
-                    std::copy(data.begin(), data.end(), std::back_inserter(json));
-                    foundOpData = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (json.empty())
-        return {}; // no data found
-
-    if (foundOpData && vout.size() >= 2) {
-        CTxDestination snodeAddr;
-        if (ExtractDestination(vout[1].scriptPubKey, snodeAddr))
-            snode_pubkey = EncodeDestination(snodeAddr);
-    }
-
-    json_spirit::Value val;
-    if (not json_spirit::read_string(json, val) || val.type() != json_spirit::array_type)
-        return {}; // not order data, ignore
-    json_spirit::Array xtx = val.get_array();
-    if (xtx.size() != 5)
-        return {"Unknown chain data, bad records count"};
-    // validate chain inputs
-    try { xtx[0].get_str(); } catch(...) {
-        return {"Bad ID" }; }
-    try { xtx[1].get_str(); } catch(...) {
-        return {"Bad from token" }; }
-    try { xtx[2].get_uint64(); } catch(...) {
-        return {"Bad from amount" }; }
-    try { xtx[3].get_str(); } catch(...) {
-        return {"Bad to token" }; }
-    try { xtx[4].get_uint64(); } catch(...) {
-        return {"Bad to amount" }; }
-
-    return CurrencyPair{
-            xtx[0].get_str(),    // xid
-            {ccy::Currency{xtx[1].get_str(),xbridge::TransactionDescr::COIN}, // fromCurrency
-             xtx[2].get_uint64()},                                     // fromAmount
-            {ccy::Currency{xtx[3].get_str(),xbridge::TransactionDescr::COIN}, // toCurrency
-             xtx[4].get_uint64()}                                      // toAmount
-    };
-}
-
 UniValue dxGetNewTokenAddress(const JSONRPCRequest& request)
 {
     if (request.fHelp)
@@ -1049,6 +962,51 @@ UniValue dxFlushCancelledOrders(const JSONRPCRequest& request)
     return uret(result);
 }
 
+UniValue dxGetPacketQueueStats(const JSONRPCRequest& request)
+{
+    if (request.fHelp)
+        throw std::runtime_error(
+            RPCHelpMan{"dxGetPacketQueueStats",
+                "\nReturns metrics of the XBridge network packet processing queue.\n",
+                {},
+                RPCResult{
+                "{\n"
+                "  \"workers\": n,              (numeric) Number of packet worker threads\n"
+                "  \"maxdepth\": n,             (numeric) Maximum queued packets per worker\n"
+                "  \"depth\": n,                (numeric) Number of packets currently queued\n"
+                "  \"processed\": n,            (numeric) Total number of processed packets\n"
+                "  \"throttled\": n,            (numeric) Number of times packet relay waited on a full queue\n"
+                "  \"avgwaitmicros\": n,        (numeric) Average time packets waited in the queue\n"
+                "  \"maxwaitmicros\": n,        (numeric) Maximum time a packet waited in the queue\n"
+                "  \"avgprocessmicros\": n      (numeric) Average packet processing time\n"
+                "}\n"
+                },
+                RPCExamples{
+                    HelpExampleCli("dxGetPacketQueueStats", "")
+                  + HelpExampleRpc("dxGetPacketQueueStats", "")
+                },
+            }.ToString());
+    Value js; json_spirit::read_string(request.params.write(), js); Array params = js.get_array();
+
+    if (params.size() > 0) {
+        return uret(xbridge::makeError(xbridge::INVALID_PARAMETERS, __FUNCTION__,
+                               "This function does not accept any parameters."));
+    }
+
+    const auto stats = xbridge::App::instance().packetQueueStats();
+    Object result{
+        Pair{"workers",          static_cast<int>(stats.workers)},
+        Pair{"maxdepth",         static_cast<int>(stats.maxDepth)},
+        Pair{"depth",            static_cast<int64_t>(stats.depth)},
+        Pair{"processed",        static_cast<int64_t>(stats.processed)},
+        Pair{"throttled",        static_cast<int64_t>(stats.throttled)},
+        Pair{"avgwaitmicros",    stats.avgWaitMicros},
+        Pair{"maxwaitmicros",    stats.maxWaitMicros},
+        Pair{"avgprocessmicros", stats.avgProcessMicros},
+    };
+    return uret(result);
+}
+
 UniValue dxGetOrderBook(const JSONRPCRequest& request)
 {
     if (request.fHelp)
@@ -1084,7 +1042,6 @@ UniValue dxGetOrderBook(const JSONRPCRequest& request)
     }
 
     Object res;
-    TransactionMap trList = xbridge::App::instance().transactions();
     {
         /**
          * @brief detaiLevel - Get a list of open orders for a product.
@@ -1120,82 +1077,25 @@ UniValue dxGetOrderBook(const JSONRPCRequest& request)
          */
         Array asks;
 
-        if(trList.empty())
-        {
-            LOG() << "empty transactions list";
-            res.emplace_back(Pair("asks", asks));
-            res.emplace_back(Pair("bids", bids));
-            return uret(res);
-        }
-
-        TransactionMap asksList;
-        TransactionMap bidsList;
-
-        //copy all transactions in currencies specified in the parameters
-
-        // ask orders are based in the first token in the trading pair
-        std::copy_if(trList.begin(), trList.end(), std::inserter(asksList, asksList.end()),
-                     [&toCurrency, &fromCurrency](const TransactionPair &transaction)
-        {
-            if(transaction.second == nullptr)
-                return false;
-            if (transaction.second->fromAmount <= 0 || transaction.second->toAmount <= 0)
-                return false;
-            if (transaction.second->state != xbridge::TransactionDescr::trPending)
-                return false;
-
-            return  ((transaction.second->toCurrency == toCurrency) &&
-                    (transaction.second->fromCurrency == fromCurrency));
-        });
-
-        // bid orders are based in the second token in the trading pair (inverse of asks)
-        std::copy_if(trList.begin(), trList.end(), std::inserter(bidsList, bidsList.end()),
-                     [&toCurrency, &fromCurrency](const TransactionPair &transaction)
-        {
-            if(transaction.second == nullptr)
-                return false;
-            if (transaction.second->fromAmount <= 0 || transaction.second->toAmount <= 0)
-                return false;
-            if (transaction.second->state != xbridge::TransactionDescr::trPending)
-                return false;
-
-            return  ((transaction.second->toCurrency == fromCurrency) &&
-                    (transaction.second->fromCurrency == toCurrency));
-        });
-
-        std::vector<xbridge::TransactionDescrPtr> asksVector;
-        std::vector<xbridge::TransactionDescrPtr> bidsVector;
-
-        for (const auto &trEntry : asksList)
-            asksVector.emplace_back(trEntry.second);
-
-        for (const auto &trEntry : bidsList)
-            bidsVector.emplace_back(trEntry.second);
+        // The order book index returns the best orders first and includes all orders
+        // at the price of the last returned order, detail 1 and 4 only need the best price.
+        const std::size_t depth = detailLevel == 1 || detailLevel == 4 ? 1 : maxOrders;
 
-        // sort asks descending
-        std::sort(asksVector.begin(), asksVector.end(),
-                  [](const xbridge::TransactionDescrPtr &a, const xbridge::TransactionDescrPtr &b)
-        {
-            const auto priceA = xbridge::price(a);
-            const auto priceB = xbridge::price(b);
-            return priceA > priceB;
-        });
+        // ask orders are based in the first token in the trading pair, best (lowest price) first
+        const auto asksVector = xbridge::App::instance().orderBook(fromCurrency, toCurrency, depth);
+        // bid orders are based in the second token in the trading pair (inverse of asks), best (highest price) first
+        const auto bidsVector = xbridge::App::instance().orderBook(toCurrency, fromCurrency, depth);
 
-        //sort bids descending
-        std::sort(bidsVector.begin(), bidsVector.end(),
-                  [](const xbridge::TransactionDescrPtr &a, const xbridge::TransactionDescrPtr &b)
-        {
-            const auto priceA = xbridge::priceBid(a);
-            const auto priceB = xbridge::priceBid(b);
-            return priceA > priceB;
-        });
+        const auto floatCompare = &xbridge::OrderBook::priceEqual;
 
-        // floating point comparisons
-        // see Knuth 4.2.2 Eq 36
-        auto floatCompare = [](const double a, const double b) -> bool
+        // number of orders priced equal to the order at index i
+        auto levelCount = [floatCompare](const std::vector<xbridge::TransactionDescrPtr> & orders, const std::size_t i,
+                                         double (*priceFn)(const xbridge::TransactionDescrPtr)) -> int64_t
         {
-            const auto epsilon = std::numeric_limits<double>::epsilon();
-            return (fabs(a - b) / fabs(a) <= epsilon) && (fabs(a - b) / fabs(b) <= epsilon);
+            const auto levelPrice = priceFn(orders[i]);
+            return std::count_if(orders.begin(), orders.end(), [&](const xbridge::TransactionDescrPtr & tr) {
+                return floatCompare(priceFn(tr), levelPrice);
+            });
         };
 
         switch (detailLevel)
@@ -1203,103 +1103,18 @@ UniValue dxGetOrderBook(const JSONRPCRequest& request)
         case 1:
         {
             //return only the best bid and ask
-            if (!bidsList.empty()) {
-                const auto bidsItem = std::max_element(bidsList.begin(), bidsList.end(),
-                                       [](const TransactionPair &a, const TransactionPair &b)
-                {
-                    //find transaction with best bids
-                    const auto &tr1 = a.second;
-                    const auto &tr2 = b.second;
-
-                    if(tr1 == nullptr)
-                        return true;
-
-                    if(tr2 == nullptr)
-                        return false;
-
-                    const auto priceA = xbridge::priceBid(tr1);
-                    const auto priceB = xbridge::priceBid(tr2);
-
-                    return priceA < priceB;
-                });
-
-                const auto bidsCount = std::count_if(bidsList.begin(), bidsList.end(),
-                                                     [bidsItem, floatCompare](const TransactionPair &a)
-                {
-                    const auto &tr = a.second;
-
-                    if(tr == nullptr)
-                        return false;
-
-                    const auto price = xbridge::priceBid(tr);
-
-                    const auto &bestTr = bidsItem->second;
-                    if (bestTr != nullptr)
-                    {
-                        const auto bestBidPrice = xbridge::priceBid(bestTr);
-                        return floatCompare(price, bestBidPrice);
-                    }
-
-                    return false;
-                });
-
-                const auto &tr = bidsItem->second;
-                if (tr != nullptr)
-                {
-                    const auto bidPrice = xbridge::priceBid(tr);
-                    bids.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(bidPrice),
-                                            xbridge::xBridgeStringValueFromAmount(tr->toAmount),
-                                            static_cast<int64_t>(bidsCount)});
-                }
+            if (!bidsVector.empty()) {
+                const auto &tr = bidsVector.front();
+                bids.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(xbridge::priceBid(tr)),
+                                        xbridge::xBridgeStringValueFromAmount(tr->toAmount),
+                                        levelCount(bidsVector, 0, xbridge::priceBid)});
             }
 
-            if (!asksList.empty()) {
-                const auto asksItem = std::min_element(asksList.begin(), asksList.end(),
-                                                   [](const TransactionPair &a, const TransactionPair &b)
-                {
-                    //find transactions with best asks
-                    const auto &tr1 = a.second;
-                    const auto &tr2 = b.second;
-
-                    if(tr1 == nullptr)
-                        return true;
-
-                    if(tr2 == nullptr)
-                        return false;
-
-                    const auto priceA = xbridge::price(tr1);
-                    const auto priceB = xbridge::price(tr2);
-                    return priceA < priceB;
-                });
-
-                const auto asksCount = std::count_if(asksList.begin(), asksList.end(),
-                                                     [asksItem, floatCompare](const TransactionPair &a)
-                {
-                    const auto &tr = a.second;
-
-                    if(tr == nullptr)
-                        return false;
-
-                    const auto price = xbridge::price(tr);
-
-                    const auto &bestTr = asksItem->second;
-                    if (bestTr != nullptr)
-                    {
-                        const auto bestAskPrice = xbridge::price(bestTr);
-                        return floatCompare(price, bestAskPrice);
-                    }
-
-                    return false;
-                });
-
-                const auto &tr = asksItem->second;
-                if (tr != nullptr)
-                {
-                    const auto askPrice = xbridge::price(tr);
-                    asks.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(askPrice),
-                                            xbridge::xBridgeStringValueFromAmount(tr->fromAmount),
-                                            static_cast<int64_t>(asksCount)});
-                }
+            if (!asksVector.empty()) {
+                const auto &tr = asksVector.front();
+                asks.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(xbridge::price(tr)),
+                                        xbridge::xBridgeStringValueFromAmount(tr->fromAmount),
+                                        levelCount(asksVector, 0, xbridge::price)});
             }
 
             res.emplace_back(Pair("asks", asks));
@@ -1313,73 +1128,39 @@ UniValue dxGetOrderBook(const JSONRPCRequest& request)
             /**
              * @brief bound - calculate upper bound
              */
-            auto bound = std::min<int32_t>(maxOrders, bidsVector.size());
-            for (size_t i = 0; i < bound; ++i) // Best bids are at the beginning of the stack (sorted descending, highest price better)
+            auto bound = std::min(maxOrders, bidsVector.size());
+            for (size_t i = 0; i < bound; ) // Best bids are at the beginning of the stack (highest price better)
             {
-                if(bidsVector[i] == nullptr)
-                    continue;
-
-                Array bid;
                 //calculate bids and push to array
-                const auto bidAmount    = bidsVector[i]->toAmount;
                 const auto bidPrice     = xbridge::priceBid(bidsVector[i]);
-                auto bidSize            = bidAmount;
-                const auto bidsCount    = std::count_if(bidsList.begin(), bidsList.end(),
-                                                     [bidPrice, floatCompare](const TransactionPair &a)
-                {
-                    const auto &tr = a.second;
-
-                    if(tr == nullptr)
-                        return false;
-
-                    const auto price = xbridge::priceBid(tr);
-
-                    return floatCompare(price, bidPrice);
-                });
-                //array sorted by bid price, we can to skip the transactions with equals bid price
-                while((++i < bound) && floatCompare(xbridge::priceBid(bidsVector[i]), bidPrice)) {
+                const auto bidsCount    = levelCount(bidsVector, i, xbridge::priceBid);
+                auto bidSize            = bidsVector[i]->toAmount;
+                //array sorted by bid price, aggregate the transactions with equal bid price
+                while ((++i < bound) && floatCompare(xbridge::priceBid(bidsVector[i]), bidPrice)) {
                     bidSize += bidsVector[i]->toAmount;
                 }
-                bid.emplace_back(xbridge::xBridgeStringValueFromPrice(bidPrice));
-                bid.emplace_back(xbridge::xBridgeStringValueFromAmount(bidSize));
-                bid.emplace_back(static_cast<int64_t>(bidsCount));
-                bids.emplace_back(bid);
+                bids.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(bidPrice),
+                                        xbridge::xBridgeStringValueFromAmount(bidSize),
+                                        bidsCount});
             }
 
-            bound = std::min<int32_t>(maxOrders, asksVector.size());
-            const auto asks_len = static_cast<int32_t>(asksVector.size());
-            for (int32_t i = asks_len - bound; i < asks_len; ++i) // Best asks are at the back of the stack (sorted descending, lowest price better)
+            bound = std::min(maxOrders, asksVector.size());
+            for (size_t i = 0; i < bound; ) // Best asks are at the beginning of the stack (lowest price better)
             {
-                if(asksVector[i] == nullptr)
-                    continue;
-
-                Array ask;
                 //calculate asks and push to array
-                const auto askAmount    = asksVector[i]->fromAmount;
                 const auto askPrice     = xbridge::price(asksVector[i]);
-                auto askSize            = askAmount;
-                const auto asksCount    = std::count_if(asksList.begin(), asksList.end(),
-                                                     [askPrice, floatCompare](const TransactionPair &a)
-                {
-                    const auto &tr = a.second;
-
-                    if(tr == nullptr)
-                        return false;
-
-                    const auto price = xbridge::price(tr);
-
-                    return floatCompare(price, askPrice);
-                });
-
-                //array sorted by price, we can to skip the transactions with equals price
-                while((++i < bound) && floatCompare(xbridge::price(asksVector[i]), askPrice)){
+                const auto asksCount    = levelCount(asksVector, i, xbridge::price);
+                auto askSize            = asksVector[i]->fromAmount;
+                //array sorted by price, aggregate the transactions with equal price
+                while ((++i < bound) && floatCompare(xbridge::price(asksVector[i]), askPrice)) {
                     askSize += asksVector[i]->fromAmount;
                 }
-                ask.emplace_back(xbridge::xBridgeStringValueFromPrice(askPrice));
-                ask.emplace_back(xbridge::xBridgeStringValueFromAmount(askSize));
-                ask.emplace_back(static_cast<int64_t>(asksCount));
-                asks.emplace_back(ask);
+                asks.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(askPrice),
+                                        xbridge::xBridgeStringValueFromAmount(askSize),
+                                        asksCount});
             }
+            // asks are listed highest price first
+            std::reverse(asks.begin(), asks.end());
 
             res.emplace_back(Pair("asks", asks));
             res.emplace_back(Pair("bids", bids));
@@ -1388,37 +1169,23 @@ UniValue dxGetOrderBook(const JSONRPCRequest& request)
         case 3:
         {
             //Full order book (non aggregated)
-            auto bound = std::min<int32_t>(maxOrders, bidsVector.size());
-            for (size_t i = 0; i < bound; ++i) // Best bids are at the beginning of the stack (sorted descending, highest price better)
+            auto bound = std::min(maxOrders, bidsVector.size());
+            for (size_t i = 0; i < bound; ++i) // Best bids are at the beginning of the stack (highest price better)
             {
-                if(bidsVector[i] == nullptr)
-                    continue;
-
-                Array bid;
-                const auto bidAmount   = bidsVector[i]->toAmount;
-                const auto bidPrice    = xbridge::priceBid(bidsVector[i]);
-                bid.emplace_back(xbridge::xBridgeStringValueFromPrice(bidPrice));
-                bid.emplace_back(xbridge::xBridgeStringValueFromAmount(bidAmount));
-                bid.emplace_back(bidsVector[i]->id.GetHex());
-
-                bids.emplace_back(bid);
+                const auto &tr = bidsVector[i];
+                bids.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(xbridge::priceBid(tr)),
+                                        xbridge::xBridgeStringValueFromAmount(tr->toAmount),
+                                        tr->id.GetHex()});
             }
 
-            bound = std::min<int32_t>(maxOrders, asksVector.size());
-            const auto asks_len = static_cast<int32_t>(asksVector.size());
-            for (int32_t i = asks_len - bound; i < asks_len; ++i) // Best asks are at the back of the stack (sorted descending, lowest price better)
+            // asks are listed highest price first, the best ask is the last entry
+            bound = std::min(maxOrders, asksVector.size());
+            for (size_t i = bound; i-- > 0; )
             {
-                if(asksVector[i] == nullptr)
-                    continue;
-
-                Array ask;
-                const auto bidAmount    = asksVector[i]->fromAmount;
-                const auto askPrice     = xbridge::price(asksVector[i]);
-                ask.emplace_back(xbridge::xBridgeStringValueFromPrice(askPrice));
-                ask.emplace_back(xbridge::xBridgeStringValueFromAmount(bidAmount));
-                ask.emplace_back(asksVector[i]->id.GetHex());
-
-                asks.emplace_back(ask);
+                const auto &tr = asksVector[i];
+                asks.emplace_back(Array{xbridge::xBridgeStringValueFromPrice(xbridge::price(tr)),
+                                        xbridge::xBridgeStringValueFromAmount(tr->fromAmount),
+                                        tr->id.GetHex()});
             }
 
             res.emplace_back(Pair("asks", asks));
@@ -1428,107 +1195,34 @@ UniValue dxGetOrderBook(const JSONRPCRequest& request)
         case 4:
         {
             //return Only the best bid and ask
-            if (!bidsList.empty()) {
-                const auto bidsItem = std::max_element(bidsList.begin(), bidsList.end(),
-                                           [](const TransactionPair &a, const TransactionPair &b)
-                {
-                    //find transaction with best bids
-                    const auto &tr1 = a.second;
-                    const auto &tr2 = b.second;
-
-                    if(tr1 == nullptr)
-                        return true;
-
-                    if(tr2 == nullptr)
-                        return false;
-
-                    const auto priceA = xbridge::priceBid(tr1);
-                    const auto priceB = xbridge::priceBid(tr2);
-
-                    return priceA < priceB;
-                });
-
-                const auto &tr = bidsItem->second;
-                if (tr != nullptr)
+            if (!bidsVector.empty()) {
+                const auto &tr = bidsVector.front();
+                const auto bidPrice = xbridge::priceBid(tr);
+                bids.emplace_back(xbridge::xBridgeStringValueFromPrice(bidPrice));
+                bids.emplace_back(xbridge::xBridgeStringValueFromAmount(tr->toAmount));
+
+                Array bidsIds;
+                for (const auto &otherTr : bidsVector)
                 {
-                    const auto bidPrice = xbridge::priceBid(tr);
-                    bids.emplace_back(xbridge::xBridgeStringValueFromPrice(bidPrice));
-                    bids.emplace_back(xbridge::xBridgeStringValueFromAmount(tr->toAmount));
-
-                    Array bidsIds;
-                    bidsIds.emplace_back(tr->id.GetHex());
-
-                    for(const TransactionPair &tp : bidsList)
-                    {
-                        const auto &otherTr = tp.second;
-
-                        if(otherTr == nullptr)
-                            continue;
-
-                        if(tr->id == otherTr->id)
-                            continue;
-
-                        const auto otherTrBidPrice = xbridge::priceBid(otherTr);
-
-                        if(!floatCompare(bidPrice, otherTrBidPrice))
-                            continue;
-
+                    if (floatCompare(bidPrice, xbridge::priceBid(otherTr)))
                         bidsIds.emplace_back(otherTr->id.GetHex());
-                    }
-
-                    bids.emplace_back(bidsIds);
                 }
+                bids.emplace_back(bidsIds);
             }
 
-            if (!asksList.empty()) {
-                const auto asksItem = std::min_element(asksList.begin(), asksList.end(),
-                                                   [](const TransactionPair &a, const TransactionPair &b)
-                {
-                    //find transactions with best asks
-                    const auto &tr1 = a.second;
-                    const auto &tr2 = b.second;
-
-                    if(tr1 == nullptr)
-                        return true;
-
-                    if(tr2 == nullptr)
-                        return false;
-
-                    const auto priceA = xbridge::price(tr1);
-                    const auto priceB = xbridge::price(tr2);
-                    return priceA < priceB;
-                });
+            if (!asksVector.empty()) {
+                const auto &tr = asksVector.front();
+                const auto askPrice = xbridge::price(tr);
+                asks.emplace_back(xbridge::xBridgeStringValueFromPrice(askPrice));
+                asks.emplace_back(xbridge::xBridgeStringValueFromAmount(tr->fromAmount));
 
-                const auto &tr = asksItem->second;
-                if (tr != nullptr)
+                Array asksIds;
+                for (const auto &otherTr : asksVector)
                 {
-                    const auto askPrice = xbridge::price(tr);
-                    asks.emplace_back(xbridge::xBridgeStringValueFromPrice(askPrice));
-                    asks.emplace_back(xbridge::xBridgeStringValueFromAmount(tr->fromAmount));
-
-                    Array asksIds;
-                    asksIds.emplace_back(tr->id.GetHex());
-
-                    for(const TransactionPair &tp : asksList)
-                    {
-                        const auto &otherTr = tp.second;
-
-                        if(otherTr == nullptr)
-                            continue;
-
-                        if(tr->id == otherTr->id)
-                            continue;
-
-                        const auto otherTrAskPrice = xbridge::price(otherTr);
-
-                        if(!floatCompare(askPrice, otherTrAskPrice))
-                            continue;
-
+                    if (floatCompare(askPrice, xbridge::price(otherTr)))
                         asksIds.emplace_back(otherTr->id.GetHex());
-                    }
-
-                    asks.emplace_back(asksIds);
                 }
+                asks.emplace_back(asksIds);
             }
 
             res.emplace_back(Pair("asks", asks));
@@ -1857,7 +1551,7 @@ UniValue gettradingdata(const JSONRPCRequest& request)
             const auto txid = tx->GetHash().GetHex();
             std::string snode_pubkey{};
 
-            const CurrencyPair p = TxOutToCurrencyPair(tx->vout, snode_pubkey);
+            const CurrencyPair p = xbridge::TxOutToCurrencyPair(tx->vout, snode_pubkey);
             switch(p.tag) {
             case CurrencyPair::Tag::Error:
                 // Show errors
@@ -1992,7 +1686,7 @@ UniValue dxGetTradingData(const JSONRPCRequest& request)
             const auto txid = tx->GetHash().GetHex();
             std::string snode_pubkey{};
 
-            const CurrencyPair p = TxOutToCurrencyPair(tx->vout, snode_pubkey);
+            const CurrencyPair p = xbridge::TxOutToCurrencyPair(tx->vout, snode_pubkey);
             switch(p.tag) {
             case CurrencyPair::Tag::Error:
                 // Show errors
@@ -2045,6 +1739,7 @@ static const CRPCCommand commands[] =
     { "xbridge",            "dxGetMyOrders",           &dxGetMyOrders,           {} },
     { "xbridge",            "dxGetLockedUtxos",        &dxGetLockedUtxos,        {} },
     { "xbridge",            "dxFlushCancelledOrders",  &dxFlushCancelledOrders,  {} },
+    { "xbridge",            "dxGetPacketQueueStats",   &dxGetPacketQueueStats,   {} },
     { "xbridge",            "gettradingdata",          &gettradingdata,          {} },
     { "xbridge",            "dxGetTradingData",        &dxGetTradingData,        {} },
 };
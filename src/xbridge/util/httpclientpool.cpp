@@ -0,0 +1,265 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <xbridge/util/httpclientpool.h>
+
+#include <support/events.h>
+#include <tinyformat.h>
+#include <util/time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+
+#include <event2/buffer.h>
+
+//*****************************************************************************
+//*****************************************************************************
+namespace xbridge
+{
+
+namespace
+{
+
+/** Request state for the libevent callbacks */
+struct PendingRequest
+{
+    HTTPClientReply * reply;
+    struct event_base * base;
+};
+
+void http_request_done(struct evhttp_request *req, void *ctx)
+{
+    PendingRequest *pending = static_cast<PendingRequest*>(ctx);
+    // Keep-alive connections stay registered on the event base, stop dispatching
+    // once the reply is complete instead of waiting for the connection to close.
+    event_base_loopbreak(pending->base);
+
+    if (req == nullptr) {
+        /* If req is nullptr, it means an error occurred while connecting: the
+         * error code will have been passed to http_error_cb.
+         */
+        pending->reply->status = 0;
+        return;
+    }
+
+    pending->reply->status = evhttp_request_get_response_code(req);
+
+    struct evbuffer *buf = evhttp_request_get_input_buffer(req);
+    if (buf)
+    {
+        size_t size = evbuffer_get_length(buf);
+        const char *data = (const char*)evbuffer_pullup(buf, size);
+        if (data)
+            pending->reply->body = std::string(data, size);
+        evbuffer_drain(buf, size);
+    }
+}
+
+#if LIBEVENT_VERSION_NUMBER >= 0x02010300
+void http_error_cb(enum evhttp_request_error err, void *ctx)
+{
+    PendingRequest *pending = static_cast<PendingRequest*>(ctx);
+    pending->reply->error = err;
+}
+#endif
+
+/**
+ * Returns true if the failed request may be sent again on a new connection. Timed
+ * out requests are not retried, the server may still be processing them.
+ */
+bool retryable(const HTTPClientReply & reply)
+{
+    if (reply.status != 0)
+        return false;
+#if LIBEVENT_VERSION_NUMBER >= 0x02010300
+    return reply.error != EVREQ_HTTP_TIMEOUT;
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+//*****************************************************************************
+//*****************************************************************************
+struct HTTPClientPool::Connection
+{
+    raii_event_base base;
+    raii_evhttp_connection evcon;
+    int64_t lastUsed{0};
+    bool reused{false};
+};
+
+//*****************************************************************************
+//*****************************************************************************
+HTTPClientPool & HTTPClientPool::instance()
+{
+    static HTTPClientPool pool;
+    return pool;
+}
+
+HTTPClientPool::HTTPClientPool() = default;
+
+HTTPClientPool::~HTTPClientPool()
+{
+    clear();
+}
+
+void HTTPClientPool::setLimits(unsigned int maxPerHost, int64_t idleTimeout)
+{
+    {
+        LOCK(mu);
+        this->maxPerHost = std::max(1u, maxPerHost);
+        this->idleTimeout = std::max<int64_t>(0, idleTimeout);
+    }
+    cv.notify_all();
+}
+
+HTTPClientReply HTTPClientPool::post(const std::string & host, int port,
+                                     const std::vector<std::pair<std::string, std::string>> & headers,
+                                     const std::string & body, int timeout)
+{
+    const auto key = strprintf("%s:%d", host, port);
+    bool keepAlive{true};
+    {
+        LOCK(mu);
+        keepAlive = idleTimeout > 0;
+    }
+    for (int attempt = 0; ; ++attempt) {
+        auto conn = acquire(key, host, port, timeout);
+        const bool reused = conn->reused;
+        HTTPClientReply reply;
+        try {
+            send(*conn, host, headers, body, timeout, keepAlive, reply);
+        } catch (...) {
+            release(key, std::move(conn), false);
+            throw;
+        }
+        // Connections that failed a request are not reused
+        release(key, std::move(conn), reply.status != 0);
+        if (!reused || attempt > 0 || !retryable(reply))
+            return reply;
+    }
+}
+
+void HTTPClientPool::clear()
+{
+    std::vector<std::unique_ptr<Connection>> closing;
+    {
+        LOCK(mu);
+        for (auto & item : endpoints) {
+            auto & idle = item.second.idle;
+            std::move(idle.begin(), idle.end(), std::back_inserter(closing));
+            idle.clear();
+        }
+    }
+}
+
+size_t HTTPClientPool::idleConnections(const std::string & host, int port)
+{
+    LOCK(mu);
+    auto it = endpoints.find(strprintf("%s:%d", host, port));
+    return it != endpoints.end() ? it->second.idle.size() : 0;
+}
+
+std::unique_ptr<HTTPClientPool::Connection> HTTPClientPool::acquire(const std::string & key,
+                                                                     const std::string & host,
+                                                                     int port, int timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(std::max(1, timeout));
+    {
+        WAIT_LOCK(mu, lock);
+        auto & endpoint = endpoints[key];
+        while (true) {
+            // Close idle connections the server has likely closed already
+            const auto now = GetTime();
+            auto & idle = endpoint.idle;
+            idle.erase(std::remove_if(idle.begin(), idle.end(), [&](const std::unique_ptr<Connection> & c) {
+                return now - c->lastUsed >= idleTimeout;
+            }), idle.end());
+
+            if (!idle.empty()) {
+                auto conn = std::move(idle.back()); // most recently used
+                idle.pop_back();
+                ++endpoint.active;
+                return conn;
+            }
+            if (endpoint.active < maxPerHost)
+                break;
+            if (cv.wait_until(lock, deadline) == std::cv_status::timeout
+                && endpoint.idle.empty() && endpoint.active >= maxPerHost)
+                throw std::runtime_error(strprintf("no connection to %s available, all %u connections are busy", key, maxPerHost));
+        }
+        ++endpoint.active;
+    }
+
+    // Host lookup and connection setup happen outside the pool lock
+    try {
+        std::unique_ptr<Connection> conn(new Connection);
+        conn->base = obtain_event_base();
+        conn->evcon = obtain_evhttp_connection_base(conn->base.get(), host, port);
+        return conn;
+    } catch (...) {
+        {
+            LOCK(mu);
+            --endpoints[key].active;
+        }
+        cv.notify_one();
+        throw;
+    }
+}
+
+void HTTPClientPool::release(const std::string & key, std::unique_ptr<Connection> conn, bool healthy)
+{
+    {
+        LOCK(mu);
+        auto & endpoint = endpoints[key];
+        --endpoint.active;
+        if (healthy && idleTimeout > 0 && endpoint.idle.size() < maxPerHost) {
+            conn->lastUsed = GetTime();
+            conn->reused = true;
+            endpoint.idle.push_back(std::move(conn));
+        }
+    }
+    cv.notify_one();
+    // Unhealthy connections are closed here, outside the pool lock
+}
+
+void HTTPClientPool::send(Connection & conn, const std::string & host,
+                          const std::vector<std::pair<std::string, std::string>> & headers,
+                          const std::string & body, int timeout, bool keepAlive, HTTPClientReply & reply)
+{
+    evhttp_connection_set_timeout(conn.evcon.get(), timeout);
+
+    PendingRequest pending{&reply, conn.base.get()};
+    raii_evhttp_request req = obtain_evhttp_request(http_request_done, (void*)&pending);
+    if (req == nullptr)
+        throw std::runtime_error("create http request failed");
+#if LIBEVENT_VERSION_NUMBER >= 0x02010300
+    evhttp_request_set_error_cb(req.get(), http_error_cb);
+#endif
+
+    struct evkeyvalq* output_headers = evhttp_request_get_output_headers(req.get());
+    assert(output_headers);
+    evhttp_add_header(output_headers, "Host", host.c_str());
+    evhttp_add_header(output_headers, "Connection", keepAlive ? "keep-alive" : "close");
+    for (const auto & header : headers)
+        evhttp_add_header(output_headers, header.first.c_str(), header.second.c_str());
+
+    // Attach request data
+    struct evbuffer* output_buffer = evhttp_request_get_output_buffer(req.get());
+    assert(output_buffer);
+    evbuffer_add(output_buffer, body.data(), body.size());
+
+    int r = evhttp_make_request(conn.evcon.get(), req.get(), EVHTTP_REQ_POST, "/");
+    req.release(); // ownership moved to evcon in above call
+    if (r != 0)
+        throw std::runtime_error("send http request failed");
+
+    event_base_dispatch(conn.base.get());
+}
+
+} // namespace xbridge
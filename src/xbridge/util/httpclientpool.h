@@ -0,0 +1,117 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BLOCKNET_XBRIDGE_UTIL_HTTPCLIENTPOOL_H
+#define BLOCKNET_XBRIDGE_UTIL_HTTPCLIENTPOOL_H
+
+#include <sync.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+//*****************************************************************************
+//*****************************************************************************
+namespace xbridge
+{
+
+/** Default maximum number of connections to a single wallet rpc endpoint */
+static const unsigned int DEFAULT_RPC_POOL_CONNECTIONS = 8;
+/** Default number of seconds unused wallet rpc connections are kept open */
+static const int64_t DEFAULT_RPC_POOL_IDLE_TIMEOUT = 15;
+
+/** Reply of a request posted through the connection pool */
+struct HTTPClientReply
+{
+    int status{0};
+    int error{-1};
+    std::string body;
+};
+
+/**
+ * Pool of persistent keep-alive http connections to the rpc endpoints of the
+ * wallet backends, shared by the xbridge and xrouter wallet connectors. Each
+ * connection owns its event base, requests on different connections can be
+ * dispatched concurrently. Connections are reused until they are idle for longer
+ * than the idle timeout or a request on them fails.
+ */
+class HTTPClientPool
+{
+public:
+    /**
+     * @brief instance - the pool shared by all wallet connectors
+     * @return
+     */
+    static HTTPClientPool & instance();
+
+    HTTPClientPool();
+    ~HTTPClientPool();
+
+    /**
+     * @brief setLimits - sets the connection limits, existing connections are not affected.
+     * @param maxPerHost Maximum number of connections to a single endpoint
+     * @param idleTimeout Number of seconds idle connections are kept open, 0 disables keep-alive
+     */
+    void setLimits(unsigned int maxPerHost, int64_t idleTimeout);
+
+    /**
+     * @brief post - posts the request body to the endpoint on a pooled connection and waits
+     *               for the reply. Requests failing on a reused connection are sent again on
+     *               a new connection, the server may have closed the connection while it was idle.
+     *               Throws if no connection to the endpoint becomes available before the timeout.
+     * @param host
+     * @param port
+     * @param headers Additional request headers
+     * @param body
+     * @param timeout Request timeout in seconds
+     * @return Reply, the status is 0 if the server could not be reached
+     */
+    HTTPClientReply post(const std::string & host, int port,
+                         const std::vector<std::pair<std::string, std::string>> & headers,
+                         const std::string & body, int timeout);
+
+    /**
+     * @brief clear - closes all idle connections.
+     */
+    void clear();
+
+    /**
+     * @brief idleConnections - number of idle connections to the endpoint
+     * @param host
+     * @param port
+     * @return
+     */
+    size_t idleConnections(const std::string & host, int port);
+
+private:
+    struct Connection;
+
+    struct Endpoint
+    {
+        std::vector<std::unique_ptr<Connection>> idle;
+        unsigned int active{0};
+    };
+
+private:
+    std::unique_ptr<Connection> acquire(const std::string & key, const std::string & host, int port, int timeout);
+    void release(const std::string & key, std::unique_ptr<Connection> conn, bool healthy);
+    static void send(Connection & conn, const std::string & host,
+                     const std::vector<std::pair<std::string, std::string>> & headers,
+                     const std::string & body, int timeout, bool keepAlive, HTTPClientReply & reply);
+
+private:
+    Mutex mu;
+    std::condition_variable cv;
+    std::map<std::string, Endpoint> endpoints;
+    unsigned int maxPerHost{DEFAULT_RPC_POOL_CONNECTIONS};
+    int64_t idleTimeout{DEFAULT_RPC_POOL_IDLE_TIMEOUT};
+};
+
+} // namespace xbridge
+
+#endif // BLOCKNET_XBRIDGE_UTIL_HTTPCLIENTPOOL_H
@@ -7,25 +7,21 @@
 
 #include <xbridge/util/logger.h>
 
-#include <xbridge/xuiconnector.h>
-
-#include <util/system.h>
+#include <xbridge/util/logwriter.h>
 
 #include <string>
-#include <sstream>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/thread/thread.hpp>
-#include <boost/thread/mutex.hpp>
-#include <boost/thread/locks.hpp>
-
-boost::mutex logLocker;
 
 //******************************************************************************
 //******************************************************************************
-// static
-std::string LOG::m_logFileName;
+static xbridge::AsyncLogWriter & logWriter()
+{
+    // never destroyed, messages may be logged during static destruction
+    static xbridge::AsyncLogWriter * writer = new xbridge::AsyncLogWriter("log", "xbridgep2p_");
+    return *writer;
+}
 
 //******************************************************************************
 //******************************************************************************
@@ -34,6 +30,13 @@ LOG::LOG(const char reason)
                     boost::pool_allocator<char> >()
     , m_r(reason)
 {
+    // skip formatting of disabled messages
+    if (!enabled(m_r))
+    {
+        setstate(std::ios_base::badbit);
+        return;
+    }
+
     *this << "\n" << "[" << (char)std::toupper(m_r) << "] "
           << boost::posix_time::second_clock::local_time()
           << " [0x" << boost::this_thread::get_id() << "] ";
@@ -44,45 +47,28 @@ LOG::LOG(const char reason)
 // static
 std::string LOG::logFileName()
 {
-    return m_logFileName;
+    return logWriter().fileName();
 }
 
 //******************************************************************************
 //******************************************************************************
-LOG::~LOG()
+// static
+bool LOG::enabled(const char reason)
 {
-    boost::lock_guard<boost::mutex> lock(logLocker);
-
-    try
-    {
-        static boost::gregorian::date day = boost::gregorian::day_clock::local_day();
-        if (m_logFileName.empty())
-            m_logFileName = makeFileName();
-
-        boost::gregorian::date tmpday = boost::gregorian::day_clock::local_day();
-        if (day != tmpday) {
-            m_logFileName = makeFileName();
-            day = tmpday;
-        }
-
-        std::ofstream file(m_logFileName.c_str(), std::ios_base::app);
-        file << str().c_str();
-    }
-    catch (...) { }
+    return xbridge::logLevelEnabled(reason);
 }
 
 //******************************************************************************
 //******************************************************************************
-std::string LOG::makeFileName()
+LOG::~LOG()
 {
-    static boost::filesystem::path directory = GetDataDir(false) / "log";
-    boost::filesystem::create_directory(directory);
+    if (bad())
+        return;
 
-    auto lt = boost::posix_time::second_clock::local_time();
-    auto df = new boost::gregorian::date_facet("%Y%m%d");
-    std::ostringstream ss;
-    ss.imbue(std::locale(ss.getloc(), df));
-    ss << lt.date();
-    return directory.string() + "/" +
-            "xbridgep2p_" + ss.str() + ".log";
+    try
+    {
+        const auto & s = rdbuf()->str();
+        logWriter().write(std::string(s.begin(), s.end()));
+    }
+    catch (...) { }
 }
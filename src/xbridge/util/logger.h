@@ -12,13 +12,14 @@
 
 #include <boost/pool/pool_alloc.hpp>
 
-#define WARN()  LOG('W')
-#define ERR()   LOG('E')
-#define TRACE() LOG('T')
-
-#define DEBUG_TRACE() (TRACE() << __FUNCTION__)
-#define DEBUG_TRACE_LOG(str) (TRACE() << str << " " << __FUNCTION__)
-#define DEBUG_TRACE_TODO() (TRACE() << "TODO " << __FUNCTION__)
+// messages below the log level are not formatted
+#define WARN()  if (!LOG::enabled('W')) {} else LOG('W')
+#define ERR()   if (!LOG::enabled('E')) {} else LOG('E')
+#define TRACE() if (!LOG::enabled('T')) {} else LOG('T')
+
+#define DEBUG_TRACE() TRACE() << __FUNCTION__
+#define DEBUG_TRACE_LOG(str) TRACE() << str << " " << __FUNCTION__
+#define DEBUG_TRACE_TODO() TRACE() << "TODO " << __FUNCTION__
 // #define DEBUG_TRACE()
 // #define DEBUG_TRACE_TODO()
 
@@ -35,13 +36,15 @@ public:
 
     static std::string logFileName();
 
-private:
-    static std::string makeFileName();
+    /**
+     * @brief enabled - checks the log level
+     * @param reason - message level
+     * @return true if messages of the level are written to the log
+     */
+    static bool enabled(const char reason);
 
 private:
     char m_r;
-
-    static std::string m_logFileName;
 };
 
 #endif // BLOCKNET_XBRIDGE_UTIL_LOGGER_H
@@ -0,0 +1,362 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <xbridge/util/logwriter.h>
+
+#include <util/system.h>
+
+#include <cctype>
+#include <set>
+#include <sstream>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem.hpp>
+
+//*****************************************************************************
+//*****************************************************************************
+namespace xbridge
+{
+
+namespace
+{
+
+/** Writer thread sleeps at most this long, bounds the delay of a missed wakeup */
+const boost::chrono::milliseconds WRITER_IDLE_TIMEOUT(100);
+
+boost::mutex writersLock;
+std::set<AsyncLogWriter *> writers;
+
+std::atomic<int> minLogLevel{0};
+std::atomic<bool> logDebug{false};
+
+int levelRank(const char reason)
+{
+    switch (std::toupper(reason))
+    {
+        case 'T':
+        case 'D': return 0;
+        case 'I': return 1;
+        case 'W': return 2;
+        case 'E': return 3;
+        default:  return 1;
+    }
+}
+
+} // namespace
+
+//*****************************************************************************
+//*****************************************************************************
+AsyncLogWriter::AsyncLogWriter(const std::string & directory, const std::string & prefix, bool daily)
+    : m_directory(directory)
+    , m_prefix(prefix)
+    , m_daily(daily)
+    , m_slots(new Slot[QUEUE_SIZE])
+{
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0, "QUEUE_SIZE must be a power of 2");
+    for (size_t i = 0; i < QUEUE_SIZE; ++i)
+        m_slots[i].seq.store(i, std::memory_order_relaxed);
+
+    m_thread = boost::thread(&AsyncLogWriter::run, this);
+
+    boost::lock_guard<boost::mutex> lock(writersLock);
+    writers.insert(this);
+}
+
+//*****************************************************************************
+//*****************************************************************************
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        boost::lock_guard<boost::mutex> lock(writersLock);
+        writers.erase(this);
+    }
+
+    stop();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::stop()
+{
+    boost::lock_guard<boost::mutex> stoppedLock(m_stoppedLock);
+    if (m_stopped)
+        return;
+
+    m_stop = true;
+    {
+        boost::lock_guard<boost::mutex> lock(m_lock);
+        m_cv.notify_one();
+    }
+    m_thread.join();
+
+    // messages published while the writer thread was exiting
+    m_stopped = true;
+    drain();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+bool AsyncLogWriter::write(std::string && message)
+{
+    if (m_stopped)
+    {
+        // no writer thread, messages queued by racing threads are written first
+        boost::lock_guard<boost::mutex> lock(m_stoppedLock);
+        drain();
+        try
+        {
+            append(message, true);
+            m_file.flush();
+        }
+        catch (...) { }
+        return true;
+    }
+
+    // bounded multi-producer queue, producers claim a slot by advancing
+    // the enqueue position and publish the message through the slot sequence
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot * slot;
+    for (;;)
+    {
+        slot = &m_slots[pos & (QUEUE_SIZE - 1)];
+        const size_t seq = slot->seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // writer is behind by a full queue
+            ++m_dropped;
+            return false;
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->message = std::move(message);
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    notify();
+    return true;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::notify()
+{
+    if (!m_sleeping.load())
+        return;
+    boost::lock_guard<boost::mutex> lock(m_lock);
+    m_cv.notify_one();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+bool AsyncLogWriter::pop(std::string & message)
+{
+    Slot & slot = m_slots[m_dequeuePos & (QUEUE_SIZE - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != m_dequeuePos + 1)
+        return false;
+
+    message.clear();
+    message.swap(slot.message);
+    slot.seq.store(m_dequeuePos + QUEUE_SIZE, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::flush()
+{
+    const uint64_t target = m_enqueuePos.load();
+
+    boost::unique_lock<boost::mutex> lock(m_lock);
+    m_cv.notify_one();
+    while (m_written.load() < target && !m_stop)
+        m_flushed.wait_for(lock, WRITER_IDLE_TIMEOUT);
+}
+
+//*****************************************************************************
+//*****************************************************************************
+// static
+void AsyncLogWriter::flushAll()
+{
+    boost::lock_guard<boost::mutex> lock(writersLock);
+    for (auto writer : writers)
+        writer->flush();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+// static
+void AsyncLogWriter::stopAll()
+{
+    boost::lock_guard<boost::mutex> lock(writersLock);
+    for (auto writer : writers)
+        writer->stop();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+std::string AsyncLogWriter::fileName()
+{
+    boost::lock_guard<boost::mutex> lock(m_lock);
+    return m_fileName;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::open(const boost::gregorian::date & day)
+{
+    if (m_file.is_open())
+        m_file.close();
+
+    boost::filesystem::path directory = GetDataDir(false) / m_directory;
+    boost::filesystem::create_directory(directory);
+
+    std::string name = m_prefix;
+    if (m_daily)
+    {
+        auto df = new boost::gregorian::date_facet("%Y%m%d");
+        std::ostringstream ss;
+        ss.imbue(std::locale(ss.getloc(), df));
+        ss << day;
+        name += ss.str() + ".log";
+    }
+
+    const std::string fileName = (directory / name).string();
+    m_file.open(fileName.c_str(), std::ios_base::app);
+    m_day = day;
+
+    boost::lock_guard<boost::mutex> lock(m_lock);
+    m_fileName = fileName;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::append(const std::string & message, bool rotate)
+{
+    if (rotate)
+    {
+        const auto day = boost::gregorian::day_clock::local_day();
+        if (!m_file.is_open() || (m_daily && day != m_day))
+            open(day);
+    }
+    m_file << message;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::drain()
+{
+    std::string message;
+    uint64_t count = 0;
+    while (pop(message))
+    {
+        try
+        {
+            append(message, count == 0);
+        }
+        catch (...) { }
+        ++count;
+    }
+    if (count > 0)
+    {
+        m_file.flush();
+        m_written += count;
+    }
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void AsyncLogWriter::run()
+{
+    std::string message;
+    for (;;)
+    {
+        uint64_t count = 0;
+        while (pop(message))
+        {
+            try
+            {
+                append(message, count == 0); // rotate once per batch
+            }
+            catch (...) { }
+            ++count;
+        }
+
+        if (count > 0)
+        {
+            const uint64_t dropped = m_dropped.load();
+            if (dropped != m_droppedReported)
+            {
+                m_file << "\n" << "[W] " << boost::posix_time::second_clock::local_time()
+                       << " log queue full, " << (dropped - m_droppedReported) << " messages dropped";
+                m_droppedReported = dropped;
+            }
+            m_file.flush();
+
+            boost::lock_guard<boost::mutex> lock(m_lock);
+            m_written += count;
+            m_flushed.notify_all();
+            continue;
+        }
+
+        if (m_stop)
+            break;
+
+        boost::unique_lock<boost::mutex> lock(m_lock);
+        m_sleeping = true;
+        // recheck after publishing m_sleeping, producers notify only a sleeping writer
+        const Slot & slot = m_slots[m_dequeuePos & (QUEUE_SIZE - 1)];
+        if (slot.seq.load() != m_dequeuePos + 1 && !m_stop)
+            m_cv.wait_for(lock, WRITER_IDLE_TIMEOUT);
+        m_sleeping = false;
+    }
+
+    boost::lock_guard<boost::mutex> lock(m_lock);
+    m_flushed.notify_all();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+bool setLogLevel(const std::string & level)
+{
+    if (level == "trace" || level == "debug")
+        minLogLevel = 0;
+    else if (level == "info")
+        minLogLevel = 1;
+    else if (level == "warning")
+        minLogLevel = 2;
+    else if (level == "error")
+        minLogLevel = 3;
+    else
+        return false;
+    return true;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void setLogDebug(bool debug)
+{
+    logDebug = debug;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+bool logLevelEnabled(const char reason)
+{
+    // 'D' is turned on when debug=1 in blocknet.conf
+    if (std::toupper(reason) == 'D' && !logDebug.load(std::memory_order_relaxed))
+        return false;
+    return levelRank(reason) >= minLogLevel.load(std::memory_order_relaxed);
+}
+
+} // namespace xbridge
@@ -0,0 +1,153 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BLOCKNET_XBRIDGE_UTIL_LOGWRITER_H
+#define BLOCKNET_XBRIDGE_UTIL_LOGWRITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+//*****************************************************************************
+//*****************************************************************************
+namespace xbridge
+{
+
+/** Default for -xbridgeloglevel */
+static const char * const DEFAULT_LOG_LEVEL = "trace";
+
+/**
+ * Asynchronous writer of the XBridge and XRouter log files. Logging threads queue
+ * messages without locking, a single writer thread appends them to the log file in
+ * batches. The file is kept open and a new file is started every day. The queue is
+ * bounded, messages are dropped if it is full and the number of dropped messages
+ * is written to the log once there is room again.
+ */
+class AsyncLogWriter
+{
+public:
+    /** Maximum number of queued messages, must be a power of 2 */
+    static const size_t QUEUE_SIZE = 8192;
+
+    /**
+     * @brief AsyncLogWriter
+     * @param directory - log directory, relative to the data directory
+     * @param prefix - file name prefix, the local date and ".log" are appended
+     * @param daily - start a new file every day, otherwise prefix is the file name
+     */
+    AsyncLogWriter(const std::string & directory, const std::string & prefix, bool daily = true);
+    ~AsyncLogWriter();
+
+    /**
+     * @brief write - queues the message, does not block
+     * @param message
+     * @return false if the queue is full and the message was dropped
+     */
+    bool write(std::string && message);
+
+    /**
+     * @brief flush - waits until the messages queued before the call are written
+     */
+    void flush();
+
+    /**
+     * @brief fileName - path of the current log file, empty until the first message is written
+     * @return
+     */
+    std::string fileName();
+
+    /**
+     * @brief stop - writes the queued messages and stops the writer thread, later messages
+     *               are written by the logging threads
+     */
+    void stop();
+
+    /**
+     * @brief flushAll - flushes all log writers
+     */
+    static void flushAll();
+
+    /**
+     * @brief stopAll - stops all log writers
+     */
+    static void stopAll();
+
+    /**
+     * @brief dropped - number of messages dropped because the queue was full
+     * @return
+     */
+    uint64_t dropped() const { return m_dropped; }
+
+private:
+    /** Queue slot, seq tells producers and the writer whose turn it is */
+    struct Slot
+    {
+        std::atomic<size_t> seq;
+        std::string message;
+    };
+
+private:
+    bool pop(std::string & message);
+    void run();
+    void open(const boost::gregorian::date & day);
+    void append(const std::string & message, bool rotate);
+    void drain();
+    void notify();
+
+private:
+    const std::string m_directory;
+    const std::string m_prefix;
+    const bool m_daily;
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<size_t> m_enqueuePos{0};
+    size_t m_dequeuePos{0}; // writer thread only
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+    uint64_t m_droppedReported{0}; // writer thread only
+
+    std::ofstream m_file;
+    boost::gregorian::date m_day;
+
+    boost::mutex m_lock;
+    boost::condition_variable m_cv;
+    boost::condition_variable m_flushed;
+    std::atomic<bool> m_sleeping{false};
+    std::atomic<bool> m_stop{false};
+    boost::mutex m_stoppedLock; // file access once the writer thread is stopped
+    std::atomic<bool> m_stopped{false};
+    std::string m_fileName;
+    boost::thread m_thread;
+};
+
+/**
+ * @brief setLogLevel - sets the minimum level of the messages written to the XBridge and XRouter logs
+ * @param level - trace, debug, info, warning or error
+ * @return false if the level is unknown
+ */
+bool setLogLevel(const std::string & level);
+
+/**
+ * @brief setLogDebug - enables the XRouter debug messages
+ * @param debug
+ */
+void setLogDebug(bool debug);
+
+/**
+ * @brief logLevelEnabled - checks if messages of the level are written to the log
+ * @param reason - message level: 'T' trace, 'D' debug, 'I' info, 'W' warning, 'E' error
+ * @return
+ */
+bool logLevelEnabled(char reason);
+
+} // namespace xbridge
+
+#endif // BLOCKNET_XBRIDGE_UTIL_LOGWRITER_H
@@ -0,0 +1,76 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <xbridge/util/orderbook.h>
+
+#include <xbridge/util/xutil.h>
+
+#include <cmath>
+#include <limits>
+
+//*****************************************************************************
+//*****************************************************************************
+namespace xbridge
+{
+
+void OrderBook::add(const TransactionDescrPtr & ptr)
+{
+    if (ptr == nullptr)
+        return;
+    remove(ptr->id);
+    if (ptr->fromAmount <= 0 || ptr->toAmount <= 0)
+        return;
+
+    const Market market{ptr->fromCurrency, ptr->toCurrency};
+    const Key key{xbridge::price(ptr), ptr->id};
+    books[market][key] = ptr;
+    orders[ptr->id] = std::make_pair(market, key);
+}
+
+void OrderBook::remove(const uint256 & id)
+{
+    auto it = orders.find(id);
+    if (it == orders.end())
+        return;
+
+    auto book = books.find(it->second.first);
+    if (book != books.end()) {
+        book->second.erase(it->second.second);
+        if (book->second.empty())
+            books.erase(book);
+    }
+    orders.erase(it);
+}
+
+std::vector<TransactionDescrPtr> OrderBook::best(const std::string & fromCurrency,
+                                                 const std::string & toCurrency,
+                                                 size_t maxOrders) const
+{
+    std::vector<TransactionDescrPtr> result;
+    auto book = books.find(Market{fromCurrency, toCurrency});
+    if (book == books.end())
+        return result;
+
+    // Orders that are not pending (new, in progress) stay indexed, skip them here
+    double lastPrice{0};
+    for (const auto & item : book->second) {
+        const auto & ptr = item.second;
+        if (ptr->state != TransactionDescr::trPending)
+            continue;
+        const auto price = item.first.first;
+        if (result.size() >= maxOrders && (result.empty() || !priceEqual(price, lastPrice)))
+            break;
+        result.push_back(ptr);
+        lastPrice = price;
+    }
+    return result;
+}
+
+bool OrderBook::priceEqual(const double a, const double b)
+{
+    const auto epsilon = std::numeric_limits<double>::epsilon();
+    return (fabs(a - b) / fabs(a) <= epsilon) && (fabs(a - b) / fabs(b) <= epsilon);
+}
+
+} // namespace xbridge
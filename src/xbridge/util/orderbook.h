@@ -0,0 +1,83 @@
+// Copyright (c) 2020 The Blocknet developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BLOCKNET_XBRIDGE_UTIL_ORDERBOOK_H
+#define BLOCKNET_XBRIDGE_UTIL_ORDERBOOK_H
+
+#include <xbridge/xbridgetransactiondescr.h>
+
+#include <uint256.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+//*****************************************************************************
+//*****************************************************************************
+namespace xbridge
+{
+
+/**
+ * Price index of the open orders, one book per market (maker currency, taker currency).
+ * Orders in a book are sorted by price (taker amount per maker amount), lowest first.
+ * The asks of a trading pair are the orders of the (maker, taker) book, the bids are
+ * the orders of the inverse (taker, maker) book. The index is not synchronized, the
+ * owner updates it under the same lock as its list of orders.
+ */
+class OrderBook
+{
+public:
+    /**
+     * @brief add - adds the order to the book of its market, replaces an order with the same id.
+     *              Orders without amounts are not indexed.
+     * @param ptr
+     */
+    void add(const TransactionDescrPtr & ptr);
+
+    /**
+     * @brief remove - removes the order from the index
+     * @param id
+     */
+    void remove(const uint256 & id);
+
+    /**
+     * @brief best - pending orders selling fromCurrency for toCurrency, lowest price first.
+     *               Returns the best maxOrders orders and all orders priced equal to the
+     *               last of them, so that the counts of the returned price levels are complete.
+     * @param fromCurrency
+     * @param toCurrency
+     * @param maxOrders
+     * @return
+     */
+    std::vector<TransactionDescrPtr> best(const std::string & fromCurrency,
+                                          const std::string & toCurrency,
+                                          size_t maxOrders) const;
+
+    /**
+     * @brief size - number of indexed orders
+     * @return
+     */
+    size_t size() const { return orders.size(); }
+
+    /**
+     * @brief priceEqual - compares order prices within floating point precision (Knuth 4.2.2 Eq 36)
+     * @param a
+     * @param b
+     * @return
+     */
+    static bool priceEqual(double a, double b);
+
+private:
+    typedef std::pair<std::string, std::string> Market;
+    typedef std::pair<double, uint256> Key; // price, order id
+    typedef std::map<Key, TransactionDescrPtr> Book;
+
+    std::map<Market, Book> books;
+    std::map<uint256, std::pair<Market, Key>> orders;
+};
+
+} // namespace xbridge
+
+#endif // BLOCKNET_XBRIDGE_UTIL_ORDERBOOK_H
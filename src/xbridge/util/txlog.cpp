@@ -5,26 +5,23 @@
 //******************************************************************************
 //******************************************************************************
 
-#include <xbridge/util/settings.h>
 #include <xbridge/util/txlog.h>
-#include <xbridge/xuiconnector.h>
 
-#include <util/system.h>
+#include <xbridge/util/logwriter.h>
 
 #include <string>
-#include <sstream>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/thread/thread.hpp>
-#include <boost/thread/mutex.hpp>
-
-boost::mutex txlogLocker;
 
 //******************************************************************************
 //******************************************************************************
-// static
-std::string TXLOG::m_logFileName;
+static xbridge::AsyncLogWriter & txlogWriter()
+{
+    // never destroyed, messages may be logged during static destruction
+    static xbridge::AsyncLogWriter * writer = new xbridge::AsyncLogWriter("log-tx", "xbridgep2p_");
+    return *writer;
+}
 
 //******************************************************************************
 //******************************************************************************
@@ -42,45 +39,17 @@ TXLOG::TXLOG()
 // static
 std::string TXLOG::logFileName()
 {
-    return m_logFileName;
+    return txlogWriter().fileName();
 }
 
 //******************************************************************************
 //******************************************************************************
 TXLOG::~TXLOG()
 {
-    boost::mutex::scoped_lock l(txlogLocker);
-
     try
     {
-        static boost::gregorian::date day = boost::gregorian::day_clock::local_day();
-        if (m_logFileName.empty())
-            m_logFileName = makeFileName();
-
-        boost::gregorian::date tmpday = boost::gregorian::day_clock::local_day();
-        if (day != tmpday) {
-            m_logFileName = makeFileName();
-            day = tmpday;
-        }
-
-        std::ofstream file(m_logFileName.c_str(), std::ios_base::app);
-        file << str().c_str();
+        const auto & s = rdbuf()->str();
+        txlogWriter().write(std::string(s.begin(), s.end()));
     }
     catch (...) { }
 }
-
-//******************************************************************************
-//******************************************************************************
-std::string TXLOG::makeFileName()
-{
-    static boost::filesystem::path directory = GetDataDir(false) / "log-tx";
-    boost::filesystem::create_directory(directory);
-
-    auto lt = boost::posix_time::second_clock::local_time();
-    auto df = new boost::gregorian::date_facet("%Y%m%d");
-    std::ostringstream ss;
-    ss.imbue(std::locale(ss.getloc(), df));
-    ss << lt.date();
-    return directory.string() + "/" +
-            "xbridgep2p_" + ss.str() + ".log";
-}
@@ -12,7 +12,7 @@
 
 #include <boost/pool/pool_alloc.hpp>
 
-#define TXERR()   LOG('E')
+#define TXERR()   if (!LOG::enabled('E')) {} else LOG('E')
 // #define TXWARN()  LOG('W')
 // #define TXTRACE() LOG('T')
 
@@ -26,12 +26,6 @@ public:
     virtual ~TXLOG();
 
     static std::string logFileName();
-
-private:
-    static std::string makeFileName();
-
-private:
-    static std::string m_logFileName;
 };
 
 #endif // BLOCKNET_XBRIDGE_UTIL_TXLOG_H
@@ -3,17 +3,15 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <xbridge/util/xseries.h>
+#include <xbridge/util/xutil.h>
 
 #include <chain.h>
+#include <index/xbridgetradeindex.h>
 #include <key_io.h>
 #include <validation.h>
 
 #include <json/json_spirit_reader_template.h>
 
-//******************************************************************************
-//******************************************************************************
-extern CurrencyPair TxOutToCurrencyPair(const std::vector<CTxOut> & vout, std::string& snode_pubkey); // declared in rpcxbridge.cpp
-
 namespace {
     // Helper functions to filter transactions in a query
     //
@@ -55,10 +53,19 @@ namespace {
     }
     std::vector<CurrencyPair> get_tradingdata(boost::posix_time::time_period query)
     {
-        LOCK(cs_main);
-
         std::vector<CurrencyPair> records;
 
+        // Range scan the trade index if enabled, without reading blocks or holding cs_main
+        if (g_xbridgetradeindex && g_xbridgetradeindex->IsSynced()) {
+            const auto epoch = boost::posix_time::from_time_t(0);
+            if (g_xbridgetradeindex->FindTrades((query.begin() - epoch).total_seconds(),
+                                                (query.end() - epoch).total_seconds(), records))
+                return records;
+            records.clear();
+        }
+
+        LOCK(cs_main);
+
         CBlockIndex * pindex = chainActive.Tip();
         auto ts = boost::posix_time::from_time_t(pindex->GetBlockTime());
         while (pindex->pprev != nullptr && query.end() < ts) {
@@ -75,7 +82,7 @@ namespace {
             for (const CTransactionRef & tx : block.vtx)
             {
                 std::string snode_pubkey{};
-                CurrencyPair p = TxOutToCurrencyPair(tx->vout, snode_pubkey);
+                CurrencyPair p = xbridge::TxOutToCurrencyPair(tx->vout, snode_pubkey);
                 if (p.tag == CurrencyPair::Tag::Valid) {
                     p.timeStamp = ts;
                     records.emplace_back(p);
@@ -9,6 +9,10 @@
 
 #include <xbridge/xbridgetransactiondescr.h>
 
+#include <key_io.h>
+#include <pubkey.h>
+#include <script/standard.h>
+
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -303,4 +307,227 @@ json_spirit::Object makeError(const xbridge::Error statusCode, const std::string
     return  error;
 }
 
-} // namespace xbridge
\ No newline at end of file
+//******************************************************************************
+//******************************************************************************
+void writeJsonrpcRequest(std::ostream & os, const std::string & method, const Array & params,
+                         const Value & id, const std::string & jsonver)
+{
+    os << '{';
+    if (!jsonver.empty()) {
+        os << "\"jsonrpc\":";
+        write_stream(Value(jsonver), os);
+        os << ',';
+    }
+    os << "\"method\":";
+    write_stream(Value(method), os);
+    os << ",\"params\":";
+    // amounts are written with 8 decimal places
+    write_stream(Value(params), os, none, 8);
+    os << ",\"id\":";
+    write_stream(id, os);
+    os << '}';
+}
+
+//******************************************************************************
+//******************************************************************************
+std::string jsonrpcRequest(const std::string & method, const Array & params,
+                           const Value & id, const std::string & jsonver)
+{
+    std::ostringstream os;
+    writeJsonrpcRequest(os, method, params, id, jsonver);
+    os << '\n';
+    return os.str();
+}
+
+//******************************************************************************
+//******************************************************************************
+static const char *jsonWhitespace = " \t\r\n";
+
+/**
+ * Returns the position following the json value starting at pos, npos if the value
+ * is incomplete.
+ */
+static size_t skipJsonValue(const std::string & json, size_t pos)
+{
+    if (pos >= json.size())
+        return std::string::npos;
+    const char first = json[pos];
+    if (first == '"') {
+        for (++pos; pos < json.size(); ++pos) {
+            if (json[pos] == '\\')
+                ++pos;
+            else if (json[pos] == '"')
+                return pos + 1;
+        }
+        return std::string::npos;
+    }
+    if (first == '{' || first == '[') {
+        std::string closers; // expected closing brackets of the open containers
+        while (pos < json.size()) {
+            const char c = json[pos];
+            if (c == '"') {
+                pos = skipJsonValue(json, pos);
+                if (pos == std::string::npos)
+                    return pos;
+                continue;
+            }
+            if (c == '{' || c == '[')
+                closers.push_back(c == '{' ? '}' : ']');
+            else if (c == '}' || c == ']') {
+                if (c != closers.back())
+                    return std::string::npos; // mismatched brackets
+                closers.pop_back();
+                if (closers.empty())
+                    return pos + 1;
+            }
+            ++pos;
+        }
+        return std::string::npos;
+    }
+    // number, true, false or null
+    const auto end = json.find_first_of(",}]", pos);
+    const auto last = json.find_last_not_of(jsonWhitespace, end == std::string::npos ? std::string::npos : end - 1);
+    return last == std::string::npos || last < pos ? std::string::npos : last + 1;
+}
+
+bool findJsonMember(const std::string & json, const std::string & key, std::string & member)
+{
+    auto pos = json.find_first_not_of(jsonWhitespace);
+    if (pos == std::string::npos || json[pos] != '{')
+        return false;
+    const auto quotedKey = "\"" + key + "\"";
+    while (true) {
+        pos = json.find_first_not_of(jsonWhitespace, pos + 1);
+        if (pos == std::string::npos || json[pos] != '"')
+            return false;
+        const auto keyEnd = skipJsonValue(json, pos);
+        if (keyEnd == std::string::npos)
+            return false;
+        const bool found = json.compare(pos, keyEnd - pos, quotedKey) == 0;
+        pos = json.find_first_not_of(jsonWhitespace, keyEnd);
+        if (pos == std::string::npos || json[pos] != ':')
+            return false;
+        pos = json.find_first_not_of(jsonWhitespace, pos + 1);
+        const auto valueEnd = skipJsonValue(json, pos);
+        if (valueEnd == std::string::npos)
+            return false;
+        if (found) {
+            member = json.substr(pos, valueEnd - pos);
+            return true;
+        }
+        pos = json.find_first_not_of(jsonWhitespace, valueEnd);
+        if (pos == std::string::npos || json[pos] != ',')
+            return false;
+    }
+}
+
+bool splitJsonArray(const std::string & json, std::vector<std::string> & elements)
+{
+    auto pos = json.find_first_not_of(jsonWhitespace);
+    if (pos == std::string::npos || json[pos] != '[')
+        return false;
+    pos = json.find_first_not_of(jsonWhitespace, pos + 1);
+    if (pos != std::string::npos && json[pos] == ']')
+        return true; // empty array
+    while (pos != std::string::npos) {
+        const auto end = skipJsonValue(json, pos);
+        if (end == std::string::npos)
+            return false;
+        elements.push_back(json.substr(pos, end - pos));
+        pos = json.find_first_not_of(jsonWhitespace, end);
+        if (pos == std::string::npos)
+            return false;
+        if (json[pos] == ']')
+            return true;
+        if (json[pos] != ',')
+            return false;
+        pos = json.find_first_not_of(jsonWhitespace, pos + 1);
+    }
+    return false;
+}
+
+//******************************************************************************
+//******************************************************************************
+CurrencyPair TxOutToCurrencyPair(const std::vector<CTxOut> & vout, std::string& snode_pubkey)
+{
+    snode_pubkey.clear();
+
+    if (vout.empty())
+        return {};
+
+    bool foundOpData{false};
+    std::string json;
+
+    for (const CTxOut & out : vout) {
+        if (out.scriptPubKey.empty())
+            continue;
+
+        std::vector<std::vector<unsigned char> > solutions;
+        txnouttype type = Solver(out.scriptPubKey, solutions);
+
+        if (type == TX_MULTISIG) {
+            if (solutions.size() < 4)
+                continue;
+
+            snode_pubkey = EncodeDestination(CTxDestination(CPubKey(solutions[1]).GetID()));
+            for (size_t i = 2; i < solutions.size()-1; ++i) {
+                const auto& sol = solutions[i];
+                if (sol.size() != 65)
+                    break;
+                std::copy(sol.begin()+1, sol.end(), std::back_inserter(json));
+            }
+        } else if (type == TX_NULL_DATA) {
+            if (out.nValue != 0 || !out.scriptPubKey.IsUnspendable())
+                continue;
+            std::vector<unsigned char> data;
+            CScript::const_iterator pc = out.scriptPubKey.begin();
+            while (pc < out.scriptPubKey.end()) { // look for order data
+                opcodetype opcode;
+                if (!out.scriptPubKey.GetOp(pc, opcode, data))
+                    break;
+                if (data.size() != 0) {
+                    std::copy(data.begin(), data.end(), std::back_inserter(json));
+                    foundOpData = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (json.empty())
+        return {}; // no data found
+
+    if (foundOpData && vout.size() >= 2) {
+        CTxDestination snodeAddr;
+        if (ExtractDestination(vout[1].scriptPubKey, snodeAddr))
+            snode_pubkey = EncodeDestination(snodeAddr);
+    }
+
+    json_spirit::Value val;
+    if (not json_spirit::read_string(json, val) || val.type() != json_spirit::array_type)
+        return {}; // not order data, ignore
+    json_spirit::Array xtx = val.get_array();
+    if (xtx.size() != 5)
+        return {"Unknown chain data, bad records count"};
+    // validate chain inputs
+    try { xtx[0].get_str(); } catch(...) {
+        return {"Bad ID" }; }
+    try { xtx[1].get_str(); } catch(...) {
+        return {"Bad from token" }; }
+    try { xtx[2].get_uint64(); } catch(...) {
+        return {"Bad from amount" }; }
+    try { xtx[3].get_str(); } catch(...) {
+        return {"Bad to token" }; }
+    try { xtx[4].get_uint64(); } catch(...) {
+        return {"Bad to amount" }; }
+
+    return CurrencyPair{
+            xtx[0].get_str(),    // xid
+            {ccy::Currency{xtx[1].get_str(),xbridge::TransactionDescr::COIN}, // fromCurrency
+             xtx[2].get_uint64()},                                     // fromAmount
+            {ccy::Currency{xtx[3].get_str(),xbridge::TransactionDescr::COIN}, // toCurrency
+             xtx[4].get_uint64()}                                      // toAmount
+    };
+}
+
+} // namespace xbridge
@@ -10,11 +10,15 @@
 
 #include <xbridge/util/logger.h>
 #include <xbridge/util/xbridgeerror.h>
+#include <xbridge/currencypair.h>
 #include <xbridge/xbridgedef.h>
 
+#include <primitives/transaction.h>
 #include <uint256.h>
 
+#include <ostream>
 #include <string>
+#include <vector>
 
 #include <json/json_spirit_reader_template.h>
 #include <json/json_spirit_writer_template.h>
@@ -112,6 +116,56 @@ namespace xbridge
      */
      json_spirit::Object makeError(const xbridge::Error statusCode, const std::string &function, const std::string &message = "");
 
+    /**
+     * @brief writeJsonrpcRequest - writes the json-rpc request object to the stream. The params
+     * are written directly, without an intermediate json representation.
+     * @param os - output stream
+     * @param method - rpc method
+     * @param params - rpc params
+     * @param id - request id
+     * @param jsonver - json-rpc version, omitted if empty
+     */
+    void writeJsonrpcRequest(std::ostream & os, const std::string & method, const json_spirit::Array & params,
+                             const json_spirit::Value & id, const std::string & jsonver = "");
+
+    /**
+     * @brief jsonrpcRequest - json-rpc request body of a single call
+     * @param method - rpc method
+     * @param params - rpc params
+     * @param id - request id
+     * @param jsonver - json-rpc version, omitted if empty
+     * @return request body
+     */
+    std::string jsonrpcRequest(const std::string & method, const json_spirit::Array & params,
+                               const json_spirit::Value & id, const std::string & jsonver = "");
+
+    /**
+     * @brief findJsonMember - finds the raw json text of a top-level member of a json object
+     * without parsing the object. Used to pass through parts of wallet replies as received.
+     * @param json - json object
+     * @param key - member name
+     * @param member - raw json text of the member value
+     * @return false if the text is not a json object or the member is not found
+     */
+    bool findJsonMember(const std::string & json, const std::string & key, std::string & member);
+
+    /**
+     * @brief splitJsonArray - splits the raw json text of a json array into the raw text of
+     * its elements without parsing them.
+     * @param json - json array
+     * @param elements - raw json text of each element
+     * @return false if the text is not a json array
+     */
+    bool splitJsonArray(const std::string & json, std::vector<std::string> & elements);
+
+    /**
+     * @brief TxOutToCurrencyPair inspects a CTxOut and returns currency pair transaction info
+     * @param tx.vout - transaction outpoints with possible multisig/op_return
+     * @param snode_pubkey - (output) the service node public key
+     * @return - currency pair transaction details
+     */
+    CurrencyPair TxOutToCurrencyPair(const std::vector<CTxOut> & vout, std::string& snode_pubkey);
+
 } // namespace xbridge
 
 #endif // BLOCKNET_XBRIDGE_UTIL_XUTIL_H
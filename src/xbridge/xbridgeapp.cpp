@@ -8,6 +8,7 @@
 #include <xbridge/xbridgeapp.h>
 
 #include <xbridge/util/logger.h>
+#include <xbridge/util/orderbook.h>
 #include <xbridge/util/settings.h>
 #include <xbridge/util/txlog.h>
 #include <xbridge/util/xassert.h>
@@ -24,6 +25,7 @@
 #include <xrouter/xrouterapp.h>
 
 #include <net.h>
+#include <net_processing.h>
 #include <netmessagemaker.h>
 #include <rpc/server.h>
 #include <servicenode/servicenodemgr.h>
@@ -34,6 +36,7 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <condition_variable>
 #include <random>
 #include <regex>
 #include <string.h>
@@ -131,6 +134,44 @@ protected:
      */
     SessionPtr getSession(const std::vector<unsigned char> & address);
 
+    /**
+     * @brief postPacket - queue the packet for processing on the worker assigned to
+     * the packet's order. Packets for the same order are processed in the order they
+     * were received. Waits if the worker queue is full.
+     * @param session - session to process the packet
+     * @param packet - network packet
+     */
+    void postPacket(const SessionPtr & session, const XBridgePacketPtr & packet);
+
+    /**
+     * @brief packetOrderId - returns the order id of an order packet
+     * @param packet
+     * @param id - order id
+     * @return false if the packet isn't associated with an order
+     */
+    static bool packetOrderId(const XBridgePacketPtr & packet, uint256 & id);
+
+protected:
+    /**
+     * @brief Worker thread processing network packets, one thread per io service.
+     */
+    struct PacketWorker
+    {
+        IoServicePtr        io;
+        std::atomic<size_t> depth{0};
+    };
+    typedef std::shared_ptr<PacketWorker> PacketWorkerPtr;
+
+    /**
+     * @brief processQueuedPacket - verify and process a queued network packet
+     * @param worker
+     * @param session
+     * @param packet
+     * @param queued - time in microseconds when the packet was queued
+     */
+    void processQueuedPacket(const PacketWorkerPtr & worker, const SessionPtr & session,
+                             const XBridgePacketPtr & packet, const int64_t queued);
+
 protected:
     /**
      * @brief sendPendingTransaction - check transaction data,
@@ -214,10 +255,22 @@ protected:
     ConnectorsAddrMap                                  m_connectorAddressMap;
     ConnectorsCurrencyMap                              m_connectorCurrencyMap;
 
+    // network packet workers
+    std::vector<PacketWorkerPtr>                       m_packetWorkers;
+    std::atomic<uint32_t>                              m_packetWorkerNext{0};
+    uint32_t                                           m_packetQueueMax{DEFAULT_XBRIDGE_PACKET_QUEUE};
+    Mutex                                              m_packetQueueMu;
+    std::condition_variable                            m_packetQueueCv;
+    std::atomic<uint64_t>                              m_packetsProcessed{0};
+    std::atomic<uint64_t>                              m_packetsThrottled{0};
+    std::atomic<int64_t>                               m_packetWaitTotal{0};
+    std::atomic<int64_t>                               m_packetWaitMax{0};
+    std::atomic<int64_t>                               m_packetProcessTotal{0};
+
     // pending messages (packet processing loop)
     CCriticalSection                                   m_messagesLock;
-    typedef std::set<uint256> ProcessedMessages;
-    ProcessedMessages                                  m_processedMessages;
+    CRollingBloomFilter                                m_processedMessages{DEFAULT_XBRIDGE_SEEN_PACKETS,
+                                                                           sn::DEFAULT_SEEN_PACKETS_FPRATE};
 
     // address book
     CCriticalSection                                   m_addressBookLock;
@@ -228,6 +281,7 @@ protected:
     CCriticalSection                                   m_txLocker;
     std::map<uint256, TransactionDescrPtr>             m_transactions;
     std::map<uint256, TransactionDescrPtr>             m_historicTransactions;
+    OrderBook                                          m_orderBook; // price index of m_transactions
     xSeriesCache                                       m_xSeriesCache;
 
     // network packets queue
@@ -252,7 +306,7 @@ protected:
 App::Impl::Impl()
     : m_timerIoWork(new boost::asio::io_service::work(m_timerIo))
     , m_timerThread(boost::bind(&boost::asio::io_service::run, &m_timerIo))
-    , m_timer(m_timerIo, boost::posix_time::seconds(TIMER_INTERVAL))
+    , m_timer(m_timerIo, boost::posix_time::seconds(static_cast<int>(TIMER_INTERVAL)))
 {
 
 }
@@ -386,6 +440,21 @@ bool App::Impl::start()
             m_works.push_back(WorkPtr(new boost::asio::io_service::work(*ios)));
 
             m_threads.create_thread(boost::bind(&boost::asio::io_service::run, ios));
+
+            PacketWorkerPtr worker(new PacketWorker);
+            worker->io = ios;
+            m_packetWorkers.push_back(worker);
+        }
+        m_packetQueueMax = static_cast<uint32_t>(std::max<int64_t>(1, gArgs.GetArg("-xbridgepacketqueue", DEFAULT_XBRIDGE_PACKET_QUEUE)));
+
+        // size the processed messages filter, the fp rate is validated on init
+        double fpRate{sn::DEFAULT_SEEN_PACKETS_FPRATE};
+        if (gArgs.IsArgSet("-seenpacketsfprate") && !ParseDouble(gArgs.GetArg("-seenpacketsfprate", ""), &fpRate))
+            fpRate = sn::DEFAULT_SEEN_PACKETS_FPRATE;
+        const auto seenPackets = gArgs.GetArg("-xbridgeseenpackets", DEFAULT_XBRIDGE_SEEN_PACKETS);
+        if (seenPackets != DEFAULT_XBRIDGE_SEEN_PACKETS || fpRate != sn::DEFAULT_SEEN_PACKETS_FPRATE) {
+            LOCK(m_messagesLock);
+            m_processedMessages = CRollingBloomFilter(static_cast<unsigned int>(std::max<int64_t>(1, seenPackets)), fpRate);
         }
 
         m_timer.async_wait(boost::bind(&Impl::onTimer, this));
@@ -503,6 +572,8 @@ bool App::Impl::stop(const bool log)
     m_timerIoWork.reset();
     m_timerThread.join();
 
+    m_packetQueueCv.notify_all(); // release the network thread if it's waiting on a full queue
+
 //    for (IoServicePtr & i : m_services)
 //    {
 //        i->stop();
@@ -552,13 +623,7 @@ void App::Impl::onSend(const std::vector<unsigned char> & id, const std::vector<
     App::instance().addToKnown(hash);
 
     // Relay
-    const CNetMsgMaker msgMaker(PROTOCOL_VERSION);
-    g_connman->ForEachNode([&](CNode* pnode) {
-        if (!pnode->fSuccessfullyConnected)
-            return;
-        if (pnode->fSuccessfullyConnected && !pnode->fDisconnect && !pnode->fXRouter) // do not relay to xrouter nodes
-            g_connman->PushMessage(pnode, msgMaker.Make(NetMsgType::XBRIDGE, msg));
-    });
+    RelayXBridgePacket(msg, g_connman.get());
 }
 
 //*****************************************************************************
@@ -603,6 +668,131 @@ SessionPtr App::Impl::getSession(const std::vector<unsigned char> & address)
     return SessionPtr();
 }
 
+//*****************************************************************************
+//*****************************************************************************
+// static
+bool App::Impl::packetOrderId(const XBridgePacketPtr & packet, uint256 & id)
+{
+    // Offset of the order id in the packet body, see XBridgeCommand
+    uint32_t offset = 0;
+    switch (packet->command())
+    {
+        case xbcTransaction:
+        case xbcPendingTransaction:
+        case xbcTransactionCancel:
+        case xbcTransactionFinished:
+            offset = 0;
+            break;
+        case xbcTransactionAccepting:
+        case xbcTransactionHold:
+        case xbcTransactionCreateA:
+        case xbcTransactionCreatedA:
+        case xbcTransactionCreateB:
+        case xbcTransactionCreatedB:
+        case xbcTransactionConfirmA:
+        case xbcTransactionConfirmedA:
+        case xbcTransactionConfirmB:
+        case xbcTransactionConfirmedB:
+            offset = XBridgePacket::addressSize;
+            break;
+        case xbcTransactionHoldApply:
+        case xbcTransactionInit:
+        case xbcTransactionInitialized:
+            offset = XBridgePacket::addressSize * 2;
+            break;
+        default:
+            return false;
+    }
+
+    if (packet->size() < offset + XBridgePacket::hashSize)
+        return false;
+
+    std::vector<unsigned char> sid(packet->data()+offset, packet->data()+offset+XBridgePacket::hashSize);
+    id = uint256(sid);
+    return true;
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void App::Impl::postPacket(const SessionPtr & session, const XBridgePacketPtr & packet)
+{
+    if (m_packetWorkers.empty())
+    {
+        // not started, process on the calling thread
+        if (packet->verify())
+            session->processPacket(packet);
+        return;
+    }
+
+    // Each worker is backed by a single thread, packets for the same order
+    // are assigned to the same worker to preserve their order.
+    PacketWorkerPtr worker;
+    uint256 id;
+    if (packetOrderId(packet, id))
+        worker = m_packetWorkers[id.GetUint64(0) % m_packetWorkers.size()];
+    else
+        worker = m_packetWorkers[m_packetWorkerNext++ % m_packetWorkers.size()];
+
+    // Backpressure: wait for the worker to catch up if its queue is full
+    if (worker->depth >= m_packetQueueMax)
+    {
+        ++m_packetsThrottled;
+        WAIT_LOCK(m_packetQueueMu, lock);
+        while (worker->depth >= m_packetQueueMax && !m_stopped && !ShutdownRequested())
+            m_packetQueueCv.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    if (m_stopped)
+        return;
+
+    ++worker->depth;
+    worker->io->post(boost::bind(&Impl::processQueuedPacket, this, worker, session, packet, GetTimeMicros()));
+}
+
+//*****************************************************************************
+//*****************************************************************************
+void App::Impl::processQueuedPacket(const PacketWorkerPtr & worker, const SessionPtr & session,
+                                    const XBridgePacketPtr & packet, const int64_t queued)
+{
+    const int64_t start = GetTimeMicros();
+    const int64_t wait = start - queued;
+    m_packetWaitTotal += wait;
+    int64_t waitMax = m_packetWaitMax;
+    while (wait > waitMax && !m_packetWaitMax.compare_exchange_weak(waitMax, wait));
+
+    if (!packet->verify())
+        LOG() << "unsigned packet or signature error " << __FUNCTION__;
+    else
+        session->processPacket(packet);
+
+    m_packetProcessTotal += GetTimeMicros() - start;
+    ++m_packetsProcessed;
+    {
+        LOCK(m_packetQueueMu);
+        --worker->depth;
+    }
+    m_packetQueueCv.notify_all();
+}
+
+//*****************************************************************************
+//*****************************************************************************
+App::PacketQueueStats App::packetQueueStats() const
+{
+    PacketQueueStats stats;
+    stats.workers = static_cast<uint32_t>(m_p->m_packetWorkers.size());
+    stats.maxDepth = m_p->m_packetQueueMax;
+    for (const auto & worker : m_p->m_packetWorkers)
+        stats.depth += worker->depth;
+    stats.processed = m_p->m_packetsProcessed;
+    stats.throttled = m_p->m_packetsThrottled;
+    stats.maxWaitMicros = m_p->m_packetWaitMax;
+    if (stats.processed > 0)
+    {
+        stats.avgWaitMicros = m_p->m_packetWaitTotal / static_cast<int64_t>(stats.processed);
+        stats.avgProcessMicros = m_p->m_packetProcessTotal / static_cast<int64_t>(stats.processed);
+    }
+    return stats;
+}
+
 //*****************************************************************************
 //*****************************************************************************
 void App::onMessageReceived(const std::vector<unsigned char> & id,
@@ -629,12 +819,6 @@ void App::onMessageReceived(const std::vector<unsigned char> & id,
         return;
     }
 
-    if (!packet->verify())
-    {
-        LOG() << "unsigned packet or signature error " << __FUNCTION__;
-        return;
-    }
-
     LOG() << "received message to " << HexStr(id)
           << " command " << packet->command();
 
@@ -642,8 +826,7 @@ void App::onMessageReceived(const std::vector<unsigned char> & id,
     SessionPtr ptr = m_p->getSession(id);
     if (ptr)
     {
-        // TODO use post or future
-        ptr->processPacket(packet);
+        m_p->postPacket(ptr, packet);
         return;
     }
     else
@@ -666,8 +849,7 @@ void App::onMessageReceived(const std::vector<unsigned char> & id,
 
         if (ptr)
         {
-            // TODO use post or future
-            ptr->processPacket(packet);
+            m_p->postPacket(ptr, packet);
             return;
         }
 
@@ -688,7 +870,7 @@ void App::onMessageReceived(const std::vector<unsigned char> & id,
         SessionPtr ptr = m_p->getSession();
         if (ptr)
         {
-            ptr->processPacket(packet);
+            m_p->postPacket(ptr, packet);
         }
     }
 }
@@ -719,19 +901,12 @@ void App::onBroadcastReceived(const std::vector<unsigned char> & message,
         return;
     }
 
-    if (!packet->verify())
-    {
-        LOG() << "unsigned packet or signature error " << __FUNCTION__;
-        return;
-    }
-
     LOG() << "broadcast message, command " << packet->command();
 
     SessionPtr ptr = m_p->getSession();
     if (ptr)
     {
-        // TODO use post or future
-        ptr->processPacket(packet);
+        m_p->postPacket(ptr, packet);
     }
 }
 
@@ -1172,7 +1347,7 @@ std::vector<WalletConnectorPtr> App::connectors() const
 bool App::isKnownMessage(const std::vector<unsigned char> & message)
 {
     LOCK(m_p->m_messagesLock);
-    return m_p->m_processedMessages.count(Hash(message.begin(), message.end())) > 0;
+    return m_p->m_processedMessages.contains(Hash(message.begin(), message.end()));
 }
 
 //*****************************************************************************
@@ -1180,17 +1355,15 @@ bool App::isKnownMessage(const std::vector<unsigned char> & message)
 bool App::isKnownMessage(const uint256 & hash)
 {
     LOCK(m_p->m_messagesLock);
-    return m_p->m_processedMessages.count(hash) > 0;
+    return m_p->m_processedMessages.contains(hash);
 }
 
 //*****************************************************************************
 //*****************************************************************************
 void App::addToKnown(const std::vector<unsigned char> & message)
 {
-    // add to known
+    // add to known, oldest messages roll out of the filter
     LOCK(m_p->m_messagesLock);
-    // clear memory if it's larger than mempool threshold
-    clearMempool();
     m_p->m_processedMessages.insert(Hash(message.begin(), message.end()));
 }
 
@@ -1198,10 +1371,8 @@ void App::addToKnown(const std::vector<unsigned char> & message)
 //*****************************************************************************
 void App::addToKnown(const uint256 & hash)
 {
-    // add to known
+    // add to known, oldest messages roll out of the filter
     LOCK(m_p->m_messagesLock);
-    // clear memory if it's larger than mempool threshold
-    clearMempool();
     m_p->m_processedMessages.insert(hash);
 }
 
@@ -1238,6 +1409,16 @@ std::map<uint256, xbridge::TransactionDescrPtr> App::transactions() const
     return m_p->m_transactions;
 }
 
+//******************************************************************************
+//******************************************************************************
+std::vector<TransactionDescrPtr> App::orderBook(const std::string & fromCurrency,
+                                                const std::string & toCurrency,
+                                                const size_t maxOrders) const
+{
+    LOCK(m_p->m_txLocker);
+    return m_p->m_orderBook.best(fromCurrency, toCurrency, maxOrders);
+}
+
 //******************************************************************************
 //******************************************************************************
 std::map<uint256, xbridge::TransactionDescrPtr> App::history() const
@@ -1280,6 +1461,7 @@ App::flushCancelledOrders(bpt::time_duration minAge) const
             if (ptr->state == xbridge::TransactionDescr::trCancelled
                 && ptr->txtime < keepTime) {
                 list.emplace_back(ptr->id,ptr->txtime,ptr.use_count());
+                m_p->m_orderBook.remove(it->first);
                 mp->erase(it++);
             } else {
                 ++it;
@@ -1305,6 +1487,7 @@ void App::appendTransaction(const TransactionDescrPtr & ptr)
     {
         // new transaction, copy data
         m_p->m_transactions[ptr->id] = ptr;
+        m_p->m_orderBook.add(ptr);
     }
     else
     {
@@ -1329,6 +1512,7 @@ void App::moveTransactionToHistory(const uint256 & id)
             xtx = m_p->m_transactions[id];
 
             counter = m_p->m_transactions.erase(id);
+            m_p->m_orderBook.remove(id);
             if(counter > 1) {
                 ERR() << "duplicate transaction id = " << id.GetHex() << " " << __FUNCTION__;
             }
@@ -1578,6 +1762,7 @@ xbridge::Error App::sendXBridgeTransaction(const std::string & from,
     {
         LOCK(m_p->m_txLocker);
         m_p->m_transactions[id] = ptr;
+        m_p->m_orderBook.add(ptr);
     }
 
     LOG() << "order created" << ptr << __FUNCTION__;
@@ -2934,6 +3119,7 @@ void App::Impl::checkAndEraseExpiredTransactions()
         for (const uint256 & id : forErase)
         {
             m_transactions.erase(id);
+            m_orderBook.remove(id);
         }
     }
     // ...and notify
@@ -3023,21 +3209,10 @@ void App::Impl::onTimer()
         }
     }
 
-    m_timer.expires_at(m_timer.expires_at() + boost::posix_time::seconds(TIMER_INTERVAL));
+    m_timer.expires_at(m_timer.expires_at() + boost::posix_time::seconds(static_cast<int>(TIMER_INTERVAL)));
     m_timer.async_wait(boost::bind(&Impl::onTimer, this));
 }
 
-/**
- * Clears the xbridge message mempool. This is not threadsafe, locks required outside this func.
- */
-void App::clearMempool() {
-    auto count = m_p->m_processedMessages.size();
-    auto maxMBytes = static_cast<unsigned int>(gArgs.GetArg("-maxmempoolxbridge", 128)) * 1000000;
-    if (count * 64 > maxMBytes) // estimated 64 bytes per hash
-        m_p->m_processedMessages.clear();
-}
-
-
 std::ostream & operator << (std::ostream& out, const TransactionDescrPtr& tx)
 {
     if(!settings().isFullLog())
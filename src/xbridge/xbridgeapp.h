@@ -49,6 +49,11 @@ class xSeriesCache;
 namespace xbridge
 {
 
+//! Default maximum number of network packets queued per xbridge worker
+static const unsigned int DEFAULT_XBRIDGE_PACKET_QUEUE = 1000;
+//! Default number of recently processed xbridge messages remembered for duplicate detection
+static const unsigned int DEFAULT_XBRIDGE_SEEN_PACKETS = 1000000;
+
 extern bool CanAffordFeePayment(const CAmount & fee);
 extern WalletConnectorPtr ConnectorByCurrency(const std::string & currency);
 
@@ -164,6 +169,21 @@ public:
             : id{id}, txtime{txtime}, use_count{use_count} {}
     };
 
+    /**
+     * @brief network packet processing queue metrics
+     */
+    class PacketQueueStats {
+    public:
+        uint32_t workers{0};         // number of packet workers
+        uint32_t maxDepth{0};        // maximum queued packets per worker
+        uint64_t depth{0};           // currently queued packets
+        uint64_t processed{0};       // total processed packets
+        uint64_t throttled{0};       // number of times the network thread waited on a full queue
+        int64_t avgWaitMicros{0};    // average time packets waited in the queue
+        int64_t maxWaitMicros{0};    // maximum time a packet waited in the queue
+        int64_t avgProcessMicros{0}; // average packet processing time
+    };
+
     // Settings
     /**
      * @brief Load xbridge.conf settings file.
@@ -188,6 +208,17 @@ public:
      * @return map of all transaction
      */
     std::map<uint256, xbridge::TransactionDescrPtr> transactions() const;
+    /**
+     * @brief orderBook - best open orders selling fromCurrency for toCurrency from the order
+     * book index, without copying the list of transactions
+     * @param fromCurrency - maker currency of the orders
+     * @param toCurrency - taker currency of the orders
+     * @param maxOrders - number of orders, orders priced equal to the last order are included
+     * @return - pending orders, lowest price (taker amount per maker amount) first
+     */
+    std::vector<TransactionDescrPtr> orderBook(const std::string & fromCurrency,
+                                               const std::string & toCurrency,
+                                               size_t maxOrders) const;
     /**
      * @brief history
      * @return map of historical transaction (local canceled and finished)
@@ -457,6 +488,12 @@ public:
     void onBroadcastReceived(const std::vector<unsigned char> & message,
                              CValidationState & state);
 
+    /**
+     * @brief packetQueueStats
+     * @return metrics of the network packet processing queue
+     */
+    PacketQueueStats packetQueueStats() const;
+
     /**
      * @brief processLater
      * @param txid
@@ -612,9 +649,6 @@ public:
         utxwallets = services;
     }
 
-protected:
-    void clearMempool();
-
 private:
     std::unique_ptr<Impl> m_p;
     bool m_disconnecting;
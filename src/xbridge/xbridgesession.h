@@ -20,6 +20,7 @@
 #include <script/script.h>
 #include <uint256.h>
 
+#include <atomic>
 #include <memory>
 #include <set>
 
@@ -134,7 +135,7 @@ private:
 
 private:
     std::unique_ptr<Impl> m_p;
-    bool m_isWorking;
+    std::atomic<bool> m_isWorking; // set by packet workers, read by the net thread
 };
 
 } // namespace xbridge
@@ -9,6 +9,8 @@
 #define BLOCKNET_XBRIDGE_XBRIDGEWALLETCONNECTORBTC_H
 
 #include <xbridge/xbridgewalletconnector.h>
+#include <xbridge/util/httpclientpool.h>
+#include <xbridge/util/xutil.h>
 
 #include <event2/buffer.h>
 #include <rpc/protocol.h>
@@ -31,16 +33,6 @@
 //*****************************************************************************
 namespace xbridge
 {
-    /** Reply structure for request_done to fill in */
-    struct HTTPReply
-    {
-        HTTPReply(): status(0), error(-1) {}
-
-        int status;
-        int error;
-        std::string body;
-    };
-
     static const char *http_errorstring(int code)
     {
         switch(code) {
@@ -63,51 +55,6 @@ namespace xbridge
         }
     }
 
-    static void http_request_done(struct evhttp_request *req, void *ctx)
-    {
-        HTTPReply *reply = static_cast<HTTPReply*>(ctx);
-
-        if (req == nullptr) {
-            /* If req is nullptr, it means an error occurred while connecting: the
-             * error code will have been passed to http_error_cb.
-             */
-            reply->status = 0;
-            return;
-        }
-
-        reply->status = evhttp_request_get_response_code(req);
-
-        struct evbuffer *buf = evhttp_request_get_input_buffer(req);
-        if (buf)
-        {
-            size_t size = evbuffer_get_length(buf);
-            const char *data = (const char*)evbuffer_pullup(buf, size);
-            if (data)
-                reply->body = std::string(data, size);
-            evbuffer_drain(buf, size);
-        }
-    }
-
-#if LIBEVENT_VERSION_NUMBER >= 0x02010300
-    static void http_error_cb(enum evhttp_request_error err, void *ctx)
-    {
-        HTTPReply *reply = static_cast<HTTPReply*>(ctx);
-        reply->error = err;
-    }
-#endif
-
-static UniValue XBridgeJSONRPCRequestObj(const std::string& strMethod, const UniValue& params,
-        const UniValue& id, const std::string& jsonver="")
-{
-    UniValue request(UniValue::VOBJ);
-    if (!jsonver.empty())
-        request.pushKV("jsonrpc", jsonver);
-    request.pushKV("method", strMethod);
-    request.pushKV("params", params);
-    request.pushKV("id", id);
-    return request;
-}
-
 static json_spirit::Object CallRPC(const std::string & rpcuser, const std::string & rpcpasswd,
                       const std::string & rpcip, const std::string & rpcport,
                       const std::string & strMethod, const json_spirit::Array & params,
@@ -116,54 +63,22 @@ static json_spirit::Object CallRPC(const std::string & rpcuser, const std::strin
     const std::string & host = rpcip;
     const int port = boost::lexical_cast<int>(rpcport);
 
-    // Obtain event base
-    raii_event_base base = obtain_event_base();
-
-    // Synchronously look up hostname
-    raii_evhttp_connection evcon = obtain_evhttp_connection_base(base.get(), host, port);
-    evhttp_connection_set_timeout(evcon.get(), gArgs.GetArg("-rpcxbridgetimeout", 120));
-
-    HTTPReply response;
-    raii_evhttp_request req = obtain_evhttp_request(http_request_done, (void*)&response);
-    if (req == nullptr)
-        throw std::runtime_error("create http request failed");
-#if LIBEVENT_VERSION_NUMBER >= 0x02010300
-    evhttp_request_set_error_cb(req.get(), http_error_cb);
-#endif
-
-    struct evkeyvalq* output_headers = evhttp_request_get_output_headers(req.get());
-    assert(output_headers);
-    evhttp_add_header(output_headers, "Host", host.c_str());
-    evhttp_add_header(output_headers, "Connection", "close");
+    std::vector<std::pair<std::string, std::string>> headers;
     // Set content type
     if (!contenttype.empty())
-        evhttp_add_header(output_headers, "Content-Type", contenttype.c_str());
+        headers.emplace_back("Content-Type", contenttype);
     // Set credentials
     if (!rpcuser.empty() || !rpcpasswd.empty()) {
         std::string strRPCUserColonPass = rpcuser + ":" + rpcpasswd;
-        evhttp_add_header(output_headers, "Authorization", (std::string("Basic ") + EncodeBase64(strRPCUserColonPass)).c_str());
+        headers.emplace_back("Authorization", std::string("Basic ") + EncodeBase64(strRPCUserColonPass));
     }
 
     // Attach request data
-    const auto tostring = json_spirit::write_string(json_spirit::Value(params), json_spirit::none, 8);
-    UniValue toval;
-    if (!toval.read(tostring))
-        throw std::runtime_error(strprintf("failed to decode json_spirit data: %s", tostring));
-    const auto reqobj = XBridgeJSONRPCRequestObj(strMethod, toval.get_array(), 1, jsonver);
-    std::string strRequest = reqobj.write() + "\n";
-    struct evbuffer* output_buffer = evhttp_request_get_output_buffer(req.get());
-    assert(output_buffer);
-    evbuffer_add(output_buffer, strRequest.data(), strRequest.size());
-
-    // check if we should use a special wallet endpoint
-    std::string endpoint = "/";
-    int r = evhttp_make_request(evcon.get(), req.get(), EVHTTP_REQ_POST, endpoint.c_str());
-    req.release(); // ownership moved to evcon in above call
-    if (r != 0) {
-        throw std::runtime_error("send http request failed");
-    }
+    const std::string strRequest = jsonrpcRequest(strMethod, params, 1, jsonver);
 
-    event_base_dispatch(base.get());
+    // Send on a pooled keep-alive connection to the wallet
+    const auto response = HTTPClientPool::instance().post(host, port, headers, strRequest,
+            static_cast<int>(gArgs.GetArg("-rpcxbridgetimeout", 120)));
 
     if (response.status == 0) {
         std::string responseErrorMessage;
@@ -180,9 +95,10 @@ static json_spirit::Object CallRPC(const std::string & rpcuser, const std::strin
 
     // Parse reply
     json_spirit::Value valReply;
-    if (!json_spirit::read_string(response.body, valReply))
+    if (!json_spirit::read_string(response.body, valReply) || valReply.type() != json_spirit::obj_type)
         throw std::runtime_error("couldn't parse reply from server");
-    const json_spirit::Object& reply = valReply.get_obj();
+    json_spirit::Object reply;
+    reply.swap(valReply.get_obj()); // avoid copying large replies
     if (reply.empty())
         throw std::runtime_error("expected reply to have result, error and id properties");
 
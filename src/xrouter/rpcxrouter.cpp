@@ -1505,6 +1505,57 @@ static UniValue xrStatus(const JSONRPCRequest& request)
     return reply;
 }
 
+static UniValue xrGetRequestQueueStats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || !request.params.empty())
+        throw std::runtime_error(
+            RPCHelpMan{"xrGetRequestQueueStats",
+                "\nReturns metrics of the XRouter request processing queue.\n",
+                {},
+                RPCResult{
+                R"(
+    {
+      "workers": 4,
+      "maxdepth": 500,
+      "depth": 0,
+      "inflight": 1,
+      "processed": 1024,
+      "rejected": 0,
+      "avgwaitmicros": 85,
+      "maxwaitmicros": 2150
+    }
+
+    Key           | Type | Description
+    --------------|------|-------------------------------------------------------------
+    workers       | int  | Number of request worker threads.
+    maxdepth      | int  | Maximum number of requests waiting to be processed.
+    depth         | int  | Number of requests currently waiting to be processed.
+    inflight      | int  | Number of requests currently being processed.
+    processed     | int  | Total number of processed requests.
+    rejected      | int  | Number of requests rejected because the queue was full.
+    avgwaitmicros | int  | Average time requests waited in the queue.
+    maxwaitmicros | int  | Maximum time a request waited in the queue.
+                )"
+                },
+                RPCExamples{
+                    HelpExampleCli("xrGetRequestQueueStats", "")
+                  + HelpExampleRpc("xrGetRequestQueueStats", "")
+                },
+            }.ToString());
+
+    const auto stats = xrouter::App::instance().requestQueueStats();
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("workers", static_cast<int>(stats.workers));
+    result.pushKV("maxdepth", static_cast<int>(stats.maxDepth));
+    result.pushKV("depth", static_cast<int64_t>(stats.depth));
+    result.pushKV("inflight", static_cast<int64_t>(stats.inFlight));
+    result.pushKV("processed", static_cast<int64_t>(stats.processed));
+    result.pushKV("rejected", static_cast<int64_t>(stats.rejected));
+    result.pushKV("avgwaitmicros", stats.avgWaitMicros);
+    result.pushKV("maxwaitmicros", stats.maxWaitMicros);
+    return result;
+}
+
 static UniValue xrConnectedNodes(const JSONRPCRequest& request)
 {
     if (request.fHelp)
@@ -1953,6 +2004,7 @@ static const CRPCCommand commands[] =
     // { "xrouter",      "xrGenerateBloomFilter",           &xrGenerateBloomFilter,          {} },
     { "xrouter",      "xrGetNetworkServices",            &xrGetNetworkServices,           {} },
     { "xrouter",      "xrGetReply",                      &xrGetReply,                     {} },
+    { "xrouter",      "xrGetRequestQueueStats",          &xrGetRequestQueueStats,         {} },
     // { "xrouter",      "xrGetTxBloomFilter",              &xrGetTxBloomFilter,             {} },
     { "xrouter",      "xrReloadConfigs",                 &xrReloadConfigs,                {} },
     { "xrouter",      "xrService",                       &xrService,                      {} },
@@ -6,18 +6,27 @@
 
 #include <xrouter/xrouterdef.h>
 
+#include <xbridge/util/httpclientpool.h>
+#include <xbridge/util/xutil.h>
+
 #include <event2/buffer.h>
+#include <event2/thread.h>
+#include <netbase.h>
 #include <rpc/protocol.h>
 #include <support/events.h>
 #include <tinyformat.h>
 #include <util/strencodings.h>
 #include <util/system.h>
-#include <univalue.h>
 
 #include <array>
+#include <deque>
+#include <functional>
+#include <map>
+#include <sstream>
 #include <stdio.h>
 
 #include <boost/lexical_cast.hpp>
+#include <json/json_spirit_reader_template.h>
 #include <json/json_spirit_writer_template.h>
 
 //*****************************************************************************
@@ -104,78 +113,36 @@ static void http_error_cb(enum evhttp_request_error err, void *ctx)
 }
 #endif
 
-UniValue XRouterJSONRPCRequestObj(const std::string& strMethod, const UniValue& params,
-        const UniValue& id, const std::string& jsonver="")
-{
-    UniValue request(UniValue::VOBJ);
-    if (!jsonver.empty())
-        request.pushKV("jsonrpc", jsonver);
-    request.pushKV("method", strMethod);
-    request.pushKV("params", params);
-    request.pushKV("id", id);
-    return request;
-}
-
 std::string CallRPC(const std::string & rpcip, const std::string & rpcport, const std::string & strMethod,
                     const Array & params, const std::string & jsonver, const std::string & contenttype)
 {
     return std::move(CallRPC("", "", rpcip, rpcport, strMethod, params, jsonver));
 }
 
-std::string CallRPC(const std::string & rpcuser, const std::string & rpcpasswd,
-                      const std::string & rpcip, const std::string & rpcport,
-                      const std::string & strMethod, const json_spirit::Array & params,
-                      const std::string & jsonver, const std::string & contenttype)
+/**
+ * Posts the json-rpc request to the rpc server on a pooled keep-alive connection and
+ * returns the response body.
+ */
+static std::string SendRPCRequest(const std::string & rpcuser, const std::string & rpcpasswd,
+                                  const std::string & rpcip, const std::string & rpcport,
+                                  const std::string & strRequest, const std::string & contenttype)
 {
     const std::string & host = rpcip;
     const int port = boost::lexical_cast<int>(rpcport);
 
-    // Obtain event base
-    raii_event_base base = obtain_event_base();
-
-    // Synchronously look up hostname
-    raii_evhttp_connection evcon = obtain_evhttp_connection_base(base.get(), host, port);
-    evhttp_connection_set_timeout(evcon.get(), gArgs.GetArg("-rpcxroutertimeout", 60));
-
-    HTTPReply response;
-    raii_evhttp_request req = obtain_evhttp_request(http_request_done, (void*)&response);
-    if (req == nullptr)
-        throw std::runtime_error("create http request failed");
-#if LIBEVENT_VERSION_NUMBER >= 0x02010300
-    evhttp_request_set_error_cb(req.get(), http_error_cb);
-#endif
-
-    struct evkeyvalq* output_headers = evhttp_request_get_output_headers(req.get());
-    assert(output_headers);
-    evhttp_add_header(output_headers, "Host", host.c_str());
-    evhttp_add_header(output_headers, "Connection", "close");
+    std::vector<std::pair<std::string, std::string>> headers;
     // Set content type
     if (!contenttype.empty())
-        evhttp_add_header(output_headers, "Content-Type", contenttype.c_str());
+        headers.emplace_back("Content-Type", contenttype);
     // Set credentials
     if (!rpcuser.empty() || !rpcpasswd.empty()) {
         std::string strRPCUserColonPass = rpcuser + ":" + rpcpasswd;
-        evhttp_add_header(output_headers, "Authorization", (std::string("Basic ") + EncodeBase64(strRPCUserColonPass)).c_str());
-    }
-
-    // Attach request data
-    const auto tostring = json_spirit::write_string(json_spirit::Value(params), json_spirit::none, 8);
-    UniValue toval;
-    if (!toval.read(tostring))
-        throw std::runtime_error(strprintf("failed to decode json_spirit data: %s", tostring));
-    const auto reqobj = XRouterJSONRPCRequestObj(strMethod, toval.get_array(), 1, jsonver);
-    std::string strRequest = reqobj.write() + "\n";
-    struct evbuffer* output_buffer = evhttp_request_get_output_buffer(req.get());
-    assert(output_buffer);
-    evbuffer_add(output_buffer, strRequest.data(), strRequest.size());
-
-    int r = evhttp_make_request(evcon.get(), req.get(), EVHTTP_REQ_POST, "/");
-    req.release(); // ownership moved to evcon in above call
-    if (r != 0) {
-        throw std::runtime_error("send http request failed");
+        headers.emplace_back("Authorization", std::string("Basic ") + EncodeBase64(strRPCUserColonPass));
     }
 
-    event_base_dispatch(base.get());
+    // Send on a pooled keep-alive connection to the wallet
+    const auto response = xbridge::HTTPClientPool::instance().post(host, port, headers, strRequest,
+            static_cast<int>(gArgs.GetArg("-rpcxroutertimeout", 60)));
 
     if (response.status == 0) {
         std::string responseErrorMessage;
@@ -193,53 +160,125 @@ std::string CallRPC(const std::string & rpcuser, const std::string & rpcpasswd,
     return response.body;
 }
 
-XRouterReply CallXRouterUrl(const std::string & host, const int & port, const std::string & url, const std::string & data,
-                    const int & timeout, const CKey & signingkey, const CPubKey & serverkey, const std::string & paymentrawtx)
+std::string CallRPC(const std::string & rpcuser, const std::string & rpcpasswd,
+                      const std::string & rpcip, const std::string & rpcport,
+                      const std::string & strMethod, const json_spirit::Array & params,
+                      const std::string & jsonver, const std::string & contenttype)
 {
-    // Obtain event base
-    raii_event_base base = obtain_event_base();
+    return SendRPCRequest(rpcuser, rpcpasswd, rpcip, rpcport,
+                          xbridge::jsonrpcRequest(strMethod, params, 1, jsonver), contenttype);
+}
 
-    // Synchronously look up hostname
-    raii_evhttp_connection evcon = obtain_evhttp_connection_base(base.get(), host, port);
-    evhttp_connection_set_timeout(evcon.get(), timeout > 0 ? timeout
-                                                           : static_cast<int>(gArgs.GetArg("-rpcxroutertimeout", 60)));
+Object CallRPCObject(const std::string & rpcuser, const std::string & rpcpasswd,
+                     const std::string & rpcip, const std::string & rpcport,
+                     const std::string & strMethod, const json_spirit::Array & params,
+                     const std::string & jsonver, const std::string & contenttype)
+{
+    const auto response = CallRPC(rpcuser, rpcpasswd, rpcip, rpcport, strMethod, params, jsonver, contenttype);
+    Value reply;
+    if (!json_spirit::read_string(response, reply) || reply.type() != obj_type)
+        throw std::runtime_error(strprintf("couldn't parse reply from server: %s", response.substr(0, 200)));
+    Object obj;
+    obj.swap(reply.get_obj()); // avoid copying large replies
+    return obj;
+}
 
-    HTTPReply response;
-    raii_evhttp_request req = obtain_evhttp_request(http_request_done, (void*)&response);
-    if (req == nullptr)
-        throw std::runtime_error("create http request failed");
-#if LIBEVENT_VERSION_NUMBER >= 0x02010300
-    evhttp_request_set_error_cb(req.get(), http_error_cb);
-#endif
+std::vector<std::string> CallRPCBatch(const std::string & rpcuser, const std::string & rpcpasswd,
+                                      const std::string & rpcip, const std::string & rpcport,
+                                      const std::vector<std::pair<std::string, json_spirit::Array>> & calls,
+                                      const std::string & jsonver, const std::string & contenttype)
+{
+    std::vector<std::string> replies(calls.size());
+    if (calls.empty())
+        return replies;
+
+    std::ostringstream batch;
+    batch << '[';
+    for (size_t i = 0; i < calls.size(); ++i) {
+        if (i > 0)
+            batch << ',';
+        xbridge::writeJsonrpcRequest(batch, calls[i].first, calls[i].second, static_cast<int64_t>(i), jsonver);
+    }
+    batch << "]\n";
+    const auto response = SendRPCRequest(rpcuser, rpcpasswd, rpcip, rpcport, batch.str(), contenttype);
+
+    // Replies may arrive in any order, match them to calls by id. Replies are
+    // passed through as received, only their ids are read.
+    std::map<int64_t, std::string> received;
+    std::vector<std::string> elements;
+    xbridge::splitJsonArray(response, elements);
+    for (auto & reply : elements) {
+        std::string id;
+        if (!xbridge::findJsonMember(reply, "id", id) || !is_number(id))
+            continue;
+        received[boost::lexical_cast<int64_t>(id)] = std::move(reply);
+    }
 
-    struct evkeyvalq* output_headers = evhttp_request_get_output_headers(req.get());
-    assert(output_headers);
-    evhttp_add_header(output_headers, "Host", host.c_str());
-    evhttp_add_header(output_headers, "Connection", "close");
-    evhttp_add_header(output_headers, "XR-Pubkey", HexStr(signingkey.GetPubKey()).c_str());
+    // Backends that do not support batches reply with a single error, fall back to individual calls
+    for (size_t i = 0; i < calls.size(); ++i) {
+        auto it = received.find(static_cast<int64_t>(i));
+        if (it != received.end())
+            replies[i] = std::move(it->second);
+        else
+            replies[i] = CallRPC(rpcuser, rpcpasswd, rpcip, rpcport, calls[i].first, calls[i].second, jsonver, contenttype);
+    }
+
+    return replies;
+}
+
+/** Headers and body of a signed xrouter request */
+struct XRouterRequest
+{
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+};
 
+/**
+ * Returns the xrouter headers and the request data signed with the signing key.
+ */
+static XRouterRequest makeXRouterRequest(const std::string & host, const std::string & data,
+                                         const CKey & signingkey, const std::string & paymentrawtx)
+{
     CHashWriter hw(SER_GETHASH, 0);
     hw << data;
     std::vector<unsigned char> signature;
     if (!signingkey.SignCompact(hw.GetHash(), signature))
         throw std::runtime_error("failed to produce signature on payload");
-    evhttp_add_header(output_headers, "XR-Signature", HexStr(signature).c_str());
-    evhttp_add_header(output_headers, "XR-Payment", paymentrawtx.c_str());
 
-    // Attach request data
-    std::string strRequest = data + "\n";
-    struct evbuffer *output_buffer = evhttp_request_get_output_buffer(req.get());
-    if (!output_buffer)
-        throw std::runtime_error(strprintf("Internal error in connection to server %s:%d failed to set headers\n", host, port));
-    evbuffer_add(output_buffer, strRequest.data(), strRequest.size());
+    XRouterRequest request;
+    request.headers = {
+        {"Host", host},
+        {"Connection", "close"},
+        {"XR-Pubkey", HexStr(signingkey.GetPubKey())},
+        {"XR-Signature", HexStr(signature)},
+        {"XR-Payment", paymentrawtx},
+    };
+    request.body = data + "\n";
+    return request;
+}
 
-    int r = evhttp_make_request(evcon.get(), req.get(), EVHTTP_REQ_POST, url.c_str());
-    req.release(); // ownership moved to evcon in above call
-    if (r != 0)
-        throw std::runtime_error("send http request failed");
+/**
+ * Adds the headers and the body of the xrouter request to the http request.
+ */
+static void attachXRouterRequest(struct evhttp_request *req, const XRouterRequest & request, const std::string & host)
+{
+    struct evkeyvalq* output_headers = evhttp_request_get_output_headers(req);
+    assert(output_headers);
+    for (const auto & header : request.headers)
+        evhttp_add_header(output_headers, header.first.c_str(), header.second.c_str());
 
-    event_base_dispatch(base.get());
+    // Attach request data
+    struct evbuffer *output_buffer = evhttp_request_get_output_buffer(req);
+    if (!output_buffer)
+        throw std::runtime_error(strprintf("Internal error in connection to server %s failed to set headers\n", host));
+    evbuffer_add(output_buffer, request.body.data(), request.body.size());
+}
 
+/**
+ * Returns the xrouter reply of the http response, throws if the request failed.
+ */
+static XRouterReply toXRouterReply(const HTTPReply & response, const std::string & host, const int & port)
+{
     if (response.status == 0) {
         std::string responseErrorMessage;
         if (response.error != -1) {
@@ -258,7 +297,248 @@ XRouterReply CallXRouterUrl(const std::string & host, const int & port, const st
     reply.result = response.body;
     reply.hdrpubkey = response.hdrpubkey;
     reply.hdrsignature = response.hdrsignature;
-    return std::move(reply);
+    return reply;
+}
+
+static int xrouterTimeout(const int & timeout)
+{
+    return timeout > 0 ? timeout : static_cast<int>(gArgs.GetArg("-rpcxroutertimeout", 60));
+}
+
+XRouterReply CallXRouterUrl(const std::string & host, const int & port, const std::string & url, const std::string & data,
+                    const int & timeout, const CKey & signingkey, const CPubKey & serverkey, const std::string & paymentrawtx)
+{
+    // Obtain event base
+    raii_event_base base = obtain_event_base();
+
+    // Synchronously look up hostname
+    raii_evhttp_connection evcon = obtain_evhttp_connection_base(base.get(), host, port);
+    evhttp_connection_set_timeout(evcon.get(), xrouterTimeout(timeout));
+
+    HTTPReply response;
+    raii_evhttp_request req = obtain_evhttp_request(http_request_done, (void*)&response);
+    if (req == nullptr)
+        throw std::runtime_error("create http request failed");
+#if LIBEVENT_VERSION_NUMBER >= 0x02010300
+    evhttp_request_set_error_cb(req.get(), http_error_cb);
+#endif
+
+    attachXRouterRequest(req.get(), makeXRouterRequest(host, data, signingkey, paymentrawtx), host);
+
+    int r = evhttp_make_request(evcon.get(), req.get(), EVHTTP_REQ_POST, url.c_str());
+    req.release(); // ownership moved to evcon in above call
+    if (r != 0)
+        throw std::runtime_error("send http request failed");
+
+    event_base_dispatch(base.get());
+
+    return toXRouterReply(response, host, port);
+}
+
+/**
+ * Client sending xrouter requests to service node urls. All requests are dispatched on one
+ * event loop thread, a request only holds its connection while it is in flight.
+ */
+class XRouterUrlClient
+{
+public:
+    static XRouterUrlClient & instance() {
+        // never destroyed, requests may complete during static destruction
+        static XRouterUrlClient *client = new XRouterUrlClient;
+        return *client;
+    }
+
+    void call(const std::string & host, const int & port, const std::string & url, const std::string & data,
+              const int & timeout, const CKey & signingkey, const std::string & paymentrawtx,
+              const XRouterReplyHandler & handler)
+    {
+        auto request = std::make_shared<Request>();
+        request->client = this;
+        request->host = host;
+        request->port = port;
+        request->url = url;
+        request->timeout = xrouterTimeout(timeout);
+        request->handler = handler;
+        // Sign the request and resolve the host on the calling thread, the shared
+        // event loop thread only does network io
+        std::string error;
+        try {
+            request->data = makeXRouterRequest(host, data, signingkey, paymentrawtx);
+            CNetAddr addr;
+            if (!LookupHost(host.c_str(), addr, true))
+                throw std::runtime_error(strprintf("Could not resolve host %s", host));
+            request->address = addr.ToStringIP();
+        } catch (std::exception & e) {
+            error = e.what();
+        }
+        auto task = [this,request,error]() {
+            if (error.empty())
+                send(request);
+            else
+                finish(request, XRouterReply{}, error);
+        };
+
+        {
+            LOCK(mu);
+            if (!base) {
+#ifdef WIN32
+                evthread_use_windows_threads();
+#else
+                evthread_use_pthreads();
+#endif
+                base = obtain_event_base();
+                wakeup = event_new(base.get(), -1, EV_PERSIST, onWakeup, this);
+                struct timeval keepAlive{3600, 0}; // keeps the loop running while idle
+                event_add(wakeup, &keepAlive);
+                thread = boost::thread(&XRouterUrlClient::run, this);
+            }
+            tasks.push_back(task);
+            event_active(wakeup, EV_TIMEOUT, 0);
+        }
+    }
+
+    void stop() {
+        {
+            LOCK(mu);
+            if (!base)
+                return;
+            event_base_loopbreak(base.get());
+        }
+        thread.join();
+
+        // Requests still in flight are dropped without calling their handlers
+        LOCK(mu);
+        tasks.clear();
+        requests.clear();
+        finished.clear();
+        event_free(wakeup);
+        wakeup = nullptr;
+        base.reset();
+    }
+
+private:
+    struct Request {
+        XRouterUrlClient *client{nullptr};
+        std::string host;
+        std::string address; // resolved host
+        int port{0};
+        std::string url;
+        int timeout{0};
+        XRouterRequest data;
+        XRouterReplyHandler handler;
+        raii_evhttp_connection evcon;
+        HTTPReply response;
+    };
+
+    void run() {
+        RenameThread("blocknet-xrclient");
+        event_base_dispatch(base.get());
+    }
+
+    static void onWakeup(evutil_socket_t, short, void *ctx) {
+        auto client = static_cast<XRouterUrlClient*>(ctx);
+        std::deque<std::function<void()>> ready;
+        {
+            LOCK(client->mu);
+            ready.swap(client->tasks);
+        }
+        for (auto & task : ready)
+            task();
+    }
+
+    /** Runs on the event loop thread */
+    void send(std::shared_ptr<Request> request)
+    {
+        try {
+            request->evcon = obtain_evhttp_connection_base(base.get(), request->address, request->port);
+            evhttp_connection_set_timeout(request->evcon.get(), request->timeout);
+
+            raii_evhttp_request req = obtain_evhttp_request(onRequestDone, (void*)request.get());
+            if (req == nullptr)
+                throw std::runtime_error("create http request failed");
+#if LIBEVENT_VERSION_NUMBER >= 0x02010300
+            evhttp_request_set_error_cb(req.get(), onRequestError);
+#endif
+            attachXRouterRequest(req.get(), request->data, request->host);
+
+            int r = evhttp_make_request(request->evcon.get(), req.get(), EVHTTP_REQ_POST, request->url.c_str());
+            req.release(); // ownership moved to evcon in above call
+            if (r != 0)
+                throw std::runtime_error("send http request failed");
+        } catch (std::exception & e) {
+            finish(request, XRouterReply{}, e.what());
+            return;
+        }
+        requests[request.get()] = request;
+    }
+
+    static void onRequestDone(struct evhttp_request *req, void *ctx) {
+        auto request = static_cast<Request*>(ctx);
+        http_request_done(req, (void*)&request->response);
+        auto client = request->client;
+        auto it = client->requests.find(request);
+        if (it == client->requests.end())
+            return;
+        auto ptr = it->second;
+        client->requests.erase(it);
+
+        XRouterReply reply;
+        std::string error;
+        try {
+            reply = toXRouterReply(ptr->response, ptr->host, ptr->port);
+        } catch (std::exception & e) {
+            error = e.what();
+        }
+        client->finish(ptr, reply, error);
+    }
+
+#if LIBEVENT_VERSION_NUMBER >= 0x02010300
+    static void onRequestError(enum evhttp_request_error err, void *ctx) {
+        auto request = static_cast<Request*>(ctx);
+        request->response.error = err;
+    }
+#endif
+
+    /** Calls the handler and frees the connection once the loop is out of its callbacks */
+    void finish(std::shared_ptr<Request> request, const XRouterReply & reply, const std::string & error) {
+        try {
+            request->handler(reply, error);
+        } catch (...) { }
+        LOCK(mu);
+        finished.push_back(request);
+        struct timeval now{0, 0};
+        event_base_once(base.get(), -1, EV_TIMEOUT, onCleanup, this, &now);
+    }
+
+    static void onCleanup(evutil_socket_t, short, void *ctx) {
+        auto client = static_cast<XRouterUrlClient*>(ctx);
+        std::vector<std::shared_ptr<Request>> done;
+        {
+            LOCK(client->mu);
+            done.swap(client->finished);
+        }
+    }
+
+private:
+    Mutex mu;
+    raii_event_base base;
+    struct event *wakeup{nullptr};
+    boost::thread thread;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::shared_ptr<Request>> finished;
+    std::map<Request*, std::shared_ptr<Request>> requests; // event loop thread only
+};
+
+void CallXRouterUrlAsync(const std::string & host, const int & port, const std::string & url, const std::string & data,
+                         const int & timeout, const CKey & signingkey, const CPubKey & serverkey,
+                         const std::string & paymentrawtx, const XRouterReplyHandler & handler)
+{
+    XRouterUrlClient::instance().call(host, port, url, data, timeout, signingkey, paymentrawtx, handler);
+}
+
+void StopXRouterUrlClient()
+{
+    XRouterUrlClient::instance().stop();
 }
 
 std::string CallCMD(const std::string & cmd, int & exit) {
@@ -202,19 +202,8 @@ bool sendTransactionBlockchain(const std::string & rawtx, std::string & txid)
     return err == TransactionError::OK;
 }
 
-double checkPayment(const std::string & rawtx, const std::string & address, const CAmount & expectedFee)
+CAmount paymentAmount(const CMutableTransaction & tx, const std::string & address)
 {
-    CMutableTransaction tx;
-    if (!DecodeHexTx(tx, rawtx) || tx.vin.empty() || tx.vout.empty())
-        throw std::runtime_error("Bad fee payment");
-
-    for (const auto & input : tx.vin) {
-        CTransactionRef t;
-        uint256 hashBlock;
-        if (!GetTransaction(input.prevout.hash, t, Params().GetConsensus(), hashBlock))
-            throw std::runtime_error("Bad fee payment, failed to find fee inputs");
-    }
-
     CAmount payment{0};
     for (const auto & output : tx.vout) {
         std::vector<CTxDestination> addresses;
@@ -228,7 +217,23 @@ double checkPayment(const std::string & rawtx, const std::string & address, cons
             }
         }
     }
+    return payment;
+}
+
+double checkPayment(const std::string & rawtx, const std::string & address, const CAmount & expectedFee)
+{
+    CMutableTransaction tx;
+    if (!DecodeHexTx(tx, rawtx) || tx.vin.empty() || tx.vout.empty())
+        throw std::runtime_error("Bad fee payment");
+
+    for (const auto & input : tx.vin) {
+        CTransactionRef t;
+        uint256 hashBlock;
+        if (!GetTransaction(input.prevout.hash, t, Params().GetConsensus(), hashBlock))
+            throw std::runtime_error("Bad fee payment, failed to find fee inputs");
+    }
 
+    const CAmount payment = paymentAmount(tx, address);
     if (payment == 0)
         throw std::runtime_error("Bad fee payment, payment address is missing");
 
@@ -9,6 +9,7 @@
 
 #include <addrman.h>
 #include <bloom.h>
+#include <core_io.h>
 #include <keystore.h>
 #include <net.h>
 #include <script/standard.h>
@@ -124,6 +125,13 @@ bool App::createConf()
                 "#! timeout is the maximum time in seconds you're willing to wait for an XRouter response"          + eol +
                 "timeout=30"                                                                                        + eol +
                 ""                                                                                                  + eol +
+                "#! maxconcurrent is the maximum number of calls a servicenode sends to a wallet at once."          + eol +
+                "#! It can be set for all wallets here or per wallet, e.g. [BTC] maxconcurrent=8"                   + eol +
+                "#! maxconcurrent=4"                                                                                + eol +
+                ""                                                                                                  + eol +
+                "#! rpcbatchsize is the maximum number of calls a servicenode sends to a wallet in one request."    + eol +
+                "#! rpcbatchsize=50"                                                                                + eol +
+                ""                                                                                                  + eol +
                 "#! Optionally set per-call config options:"                                                        + eol +
                 "#! [xrGetBlockCount]"                                                                              + eol +
                 "#! maxfee=0.01"                                                                                    + eol +
@@ -311,6 +319,20 @@ bool App::start()
     } else if (!initKeyPair()) // init on regular xrouter clients (non-snodes)
         return false;
 
+    // Start the request workers
+    if (requestHandlers.size() == 0) {
+        {
+            LOCK(requestQueueMu);
+            requestQueueMax = static_cast<uint32_t>(std::max<int64_t>(1, gArgs.GetArg("-xrouterqueuesize", DEFAULT_XROUTER_REQUEST_QUEUE)));
+        }
+        int threads = static_cast<int>(gArgs.GetArg("-xrouterthreads", DEFAULT_XROUTER_THREADS));
+        if (threads <= 0)
+            threads = std::max<int>(1, boost::thread::hardware_concurrency());
+        for (int i = 0; i < threads; ++i)
+            requestHandlers.create_thread(boost::bind(&App::requestWorker, this));
+        LOG() << "Started " << threads << " xrouter request workers";
+    }
+
     {
         LOCK(mu);
         xrouterIsReady = true;
@@ -451,21 +473,12 @@ bool App::openConnections(enum XRouterCommand command, const std::string & servi
         LOG() << "Requesting config from snode " << EncodeDestination(CTxDestination(snode.getPaymentAddress()))
               << " query " << uuid;
 
-        auto qcond = queryMgr.queryCond(uuid, nodeAddr);
-        if (qcond) {
-            auto l = queryMgr.queryLock(uuid, nodeAddr);
-            boost::mutex::scoped_lock lock(*l);
-            if (qcond->timed_wait(lock, boost::posix_time::seconds(connwait),
-                [this,&uuid,&nodeAddr]() {
-                    return ShutdownRequested() || queryMgr.hasReply(uuid, nodeAddr)
-                                               || boost::this_thread::interruption_requested();
-                }))
-            {
-                if (queryMgr.hasReply(uuid, nodeAddr))
-                    addSelected(nodeAddr);
-            }
-            queryMgr.purge(uuid); // clean up
-        }
+        // Waiting on the future is an interruption point
+        auto replied = queryMgr.replies(uuid, 1);
+        replied.wait_for(boost::chrono::seconds(connwait));
+        if (queryMgr.hasReply(uuid, nodeAddr))
+            addSelected(nodeAddr);
+        queryMgr.purge(uuid); // clean up
     };
 
     auto connect = [this,connwait,&lu,&connectedSnodes,&fetchConfig,&addSelected,&addNode](const std::string & snodeAddr,
@@ -817,13 +830,30 @@ bool App::stop(const bool safeCleanup)
     timerIo.stop();
     timerThread.join();
 
+    // Release callers waiting on query replies
+    queryMgr.cancelAll();
+    StopXRouterUrlClient();
+
     if (safeCleanup && (!isEnabled() || !isReady()))
         return false;
 
     // shutdown threads
+    {
+        LOCK(requestQueueMu); // workers check the stopped flag under this lock
+    }
+    requestQueueCv.notify_all();
     requestHandlers.interrupt_all();
     requestHandlers.join_all();
 
+    // release nodes of requests that were never processed
+    std::set<QueuedRequest> unprocessed;
+    {
+        LOCK(requestQueueMu);
+        unprocessed.swap(requestQueue);
+    }
+    for (const auto & request : unprocessed)
+        request.node->Release();
+
     if (server && !server->stop())
         return false;
 
@@ -1119,97 +1149,259 @@ bool App::processConfigMessage(const sn::ServiceNode & snode) {
 void App::onMessageReceived(CNode* node, const std::vector<unsigned char> & message)
 {
     // If xrouter == 0, xrouter is turned off on this node
-    if (!isEnabled() || !isReady())
+    if (!isEnabled() || !isReady() || stopped)
         return;
 
-    auto retainNode = [](CNode *pnode) {
-        pnode->AddRef();
-    };
-
-    retainNode(node); // retain for thread below
+    XRouterPacketPtr packet(new XRouterPacket);
+    if (!packet->copyFrom(message)) {
+        if (server && server->isStarted()) { // Send error back to client
+            try {
+                Object error;
+                error.emplace_back("error", "XRouter Node reported a protocol error on a received packet. "
+                                            "Unable to deserialize packet, possible bad packet header");
+                error.emplace_back("code", xrouter::BAD_REQUEST);
+                const std::string reply = json_spirit::write_string(Value(error), true);
+                XRouterPacket packet(xrInvalid, "protocol_error");
+                packet.append(reply);
+                packet.sign(server->pubKey(), server->privKey());
+                PushXRouterMessage(node, packet.body());
+            } catch (std::exception & e) { // catch json errors
+                ERR() << "Failed to send error reply to client " << node->GetAddrName() << " error: "
+                      << e.what();
+            }
+        }
 
-    // Handle the xrouter request
-    requestHandlers.create_thread([this, node, message]() {
-        RenameThread("blocknet-xrrequest");
-        boost::this_thread::interruption_point();
         CValidationState state;
+        updateScore(node->GetAddrName(), -10);
+        state.DoS(10, error("XRouter: invalid packet received"), REJECT_INVALID, "xrouter-error");
+        checkDoS(state, node);
+        return;
+    }
+
+    node->AddRef(); // retain for the request worker
+    queueRequest(node, packet);
+}
+
+//*****************************************************************************
+//*****************************************************************************
+int App::requestPriority(CNode *node, XRouterPacketPtr packet)
+{
+    const auto command = packet->command();
+    if (command == xrReply || command == xrConfigReply || command == xrInvalid) // unsolicited replies are ignored
+        return queryMgr.hasQuery(packet->suuid(), node->GetAddrName()) ? REQUEST_PRIORITY_REPLY : REQUEST_PRIORITY_FREE;
+    if (command == xrGetConfig || packet->size() == 0)
+        return REQUEST_PRIORITY_FREE;
+
+    // Paid requests include a fee transaction after the service name that pays
+    // this servicenode at least the fee of the command
+    const auto data = reinterpret_cast<const char*>(packet->data());
+    const auto end = data + packet->size();
+    const auto serviceEnd = static_cast<const char*>(memchr(data, '\0', packet->size()));
+    if (!serviceEnd || serviceEnd + 1 >= end)
+        return REQUEST_PRIORITY_FREE;
+    const auto feeEnd = static_cast<const char*>(memchr(serviceEnd + 1, '\0', end - serviceEnd - 1));
+    if (!feeEnd || feeEnd == serviceEnd + 1)
+        return REQUEST_PRIORITY_FREE;
+    const auto settings = xrSettings();
+    if (!settings)
+        return REQUEST_PRIORITY_FREE;
+    const std::string service(data, serviceEnd);
+    const auto fee = to_amount(settings->commandFee(command, service));
+    const auto address = settings->paymentAddress(command, service);
+    if (fee <= 0 || address.empty())
+        return REQUEST_PRIORITY_FREE;
+    CMutableTransaction feetx;
+    if (!DecodeHexTx(feetx, std::string(serviceEnd + 1, feeEnd)) || feetx.vin.empty())
+        return REQUEST_PRIORITY_FREE;
+    return paymentAmount(feetx, address) >= fee ? REQUEST_PRIORITY_PAID : REQUEST_PRIORITY_FREE;
+}
 
-        bool released{false};
-        auto releaseNode = [&released](CNode *pnode) {
-            if (!released) {
-                released = true;
-                pnode->Release();
+//*****************************************************************************
+//*****************************************************************************
+void App::queueRequest(CNode *node, XRouterPacketPtr packet)
+{
+    QueuedRequest request;
+    request.priority = requestPriority(node, packet);
+    if (request.priority == REQUEST_PRIORITY_REPLY) // prefer replies from reliable snodes
+        request.score = getScore(node->GetAddrName());
+    request.queuedMicros = GetTimeMicros();
+    request.node = node;
+    request.packet = packet;
+
+    bool stopping{false};
+    bool queued{true};
+    bool reject{false};
+    QueuedRequest rejected;
+    {
+        LOCK(requestQueueMu);
+        // Workers check the stopped flag under this lock, requests queued after stop()
+        // released the queue would never be processed
+        stopping = stopped;
+        request.seq = requestSeq++;
+        if (stopping) {
+            queued = false;
+        } else if (requestQueue.size() >= requestQueueMax) {
+            // Replies to our own queries are never rejected, they may exceed the queue size
+            auto lowest = std::prev(requestQueue.end());
+            if (lowest->priority != REQUEST_PRIORITY_REPLY && request < *lowest) { // make room by rejecting the lowest priority request
+                reject = true;
+                rejected = *lowest;
+                requestQueue.erase(lowest);
+            } else if (request.priority != REQUEST_PRIORITY_REPLY) {
+                reject = true;
+                rejected = request;
+                queued = false;
             }
-        };
+        }
+        if (queued)
+            requestQueue.insert(request);
+    }
+
+    if (stopping) {
+        node->Release();
+        return;
+    }
+    if (queued)
+        requestQueueCv.notify_one();
+    if (reject)
+        rejectRequest(rejected);
+}
 
+//*****************************************************************************
+//*****************************************************************************
+void App::rejectRequest(const QueuedRequest & request)
+{
+    ++requestsRejected;
+    CNode *node = request.node;
+    const auto command = request.packet->command();
+    const auto & uuid = request.packet->suuid();
+    LOG() << "XRouter request queue is full, rejecting " << XRouterCommand_ToString(command) << " query: " << uuid
+          << " node: " << node->GetAddrName();
+
+    // Let clients know the request was not processed, config requests are retried by clients
+    const bool isReply = command == xrReply || command == xrConfigReply || command == xrInvalid;
+    if (!isReply && command != xrGetConfig && server && server->isStarted()) {
         try {
-            XRouterPacketPtr packet(new XRouterPacket);
-            if (!packet->copyFrom(message)) {
-                if (server->isStarted()) { // Send error back to client
-                    try {
-                        Object error;
-                        error.emplace_back("error", "XRouter Node reported a protocol error on a received packet. "
-                                                    "Unable to deserialize packet, possible bad packet header");
-                        error.emplace_back("code", xrouter::BAD_REQUEST);
-                        const std::string reply = json_spirit::write_string(Value(error), true);
-                        XRouterPacket packet(xrInvalid, "protocol_error");
-                        packet.append(reply);
-                        packet.sign(server->pubKey(), server->privKey());
-                        PushXRouterMessage(node, packet.body());
-                    } catch (std::exception & e) { // catch json errors
-                        ERR() << "Failed to send error reply to client " << node->GetAddrName() << " error: "
-                              << e.what();
-                    }
-                }
+            Object error;
+            error.emplace_back("error", "XRouter Node is too busy to process the request, please try again later");
+            error.emplace_back("code", xrouter::TOO_MANY_REQUESTS);
+            XRouterPacket rpacket(xrReply, uuid);
+            rpacket.append(json_spirit::write_string(Value(error), true));
+            rpacket.sign(server->pubKey(), server->privKey());
+            PushXRouterMessage(node, rpacket.body());
+        } catch (std::exception & e) { // catch json errors
+            ERR() << "Failed to send error reply to client " << node->GetAddrName() << " error: " << e.what();
+        }
+    }
 
-                updateScore(node->GetAddrName(), -10);
-                state.DoS(10, error("XRouter: invalid packet received"), REJECT_INVALID, "xrouter-error");
-                checkDoS(state, node);
-                releaseNode(node);
+    node->Release();
+}
 
+//*****************************************************************************
+//*****************************************************************************
+void App::requestWorker()
+{
+    RenameThread("blocknet-xrrequest");
+    while (true) {
+        QueuedRequest request;
+        {
+            WAIT_LOCK(requestQueueMu, lock);
+            while (requestQueue.empty() && !stopped)
+                requestQueueCv.wait(lock);
+            if (stopped)
                 return;
-            }
+            request = *requestQueue.begin();
+            requestQueue.erase(requestQueue.begin());
+            ++requestsInFlight;
+        }
 
-            const auto & command = packet->command();
-            const auto & uuid = packet->suuid();
-            const auto & nodeAddr = node->GetAddrName();
-            const auto & commandStr = XRouterCommand_ToString(command);
+        const int64_t wait = GetTimeMicros() - request.queuedMicros;
+        requestWaitTotal += wait;
+        int64_t waitMax = requestWaitMax;
+        while (wait > waitMax && !requestWaitMax.compare_exchange_weak(waitMax, wait));
 
-            if (command == xrService) {
-                auto service = packet->service();
-                if (service.size() > 100) // truncate service name
-                    service = service.substr(0, 100);
-                LOG() << "XRouter command: " << commandStr << xrdelimiter + service << " query: " << uuid << " node: " << nodeAddr;
-            }
-            else
-                LOG() << "XRouter command: " << commandStr << " query: " << uuid << " node: " << nodeAddr;
-
-            if (command == xrInvalid) { // Process invalid packets (protocol error packets)
-                processInvalid(node, packet, state);
-            } else if (command == xrReply) { // Process replies
-                processReply(node, packet, state);
-            } else if (command == xrConfigReply) { // Process config replies
-                processConfigReply(node, packet, state);
-            } else if (canListen() && server->isStarted()) { // Process server requests
-                server->addInFlightQuery(nodeAddr, uuid);
-                try {
-                    server->onMessageReceived(node, packet, state);
-                    server->removeInFlightQuery(nodeAddr, uuid);
-                } catch (...) { // clean up on error
-                    server->removeInFlightQuery(nodeAddr, uuid);
-                }
-            }
+        processRequest(request.node, request.packet);
+
+        ++requestsProcessed;
+        --requestsInFlight;
+    }
+}
+
+//*****************************************************************************
+//*****************************************************************************
+App::RequestQueueStats App::requestQueueStats()
+{
+    RequestQueueStats stats;
+    stats.workers = static_cast<uint32_t>(requestHandlers.size());
+    {
+        LOCK(requestQueueMu);
+        stats.maxDepth = requestQueueMax;
+        stats.depth = requestQueue.size();
+    }
+    stats.inFlight = requestsInFlight;
+    stats.processed = requestsProcessed;
+    stats.rejected = requestsRejected;
+    stats.maxWaitMicros = requestWaitMax;
+    const auto dequeued = stats.processed + stats.inFlight;
+    if (dequeued > 0)
+        stats.avgWaitMicros = requestWaitTotal / static_cast<int64_t>(dequeued);
+    return stats;
+}
 
-            // Done with request, process DoS and release node
-            checkDoS(state, node);
-            releaseNode(node);
+//*****************************************************************************
+//*****************************************************************************
+void App::processRequest(CNode *node, XRouterPacketPtr packet)
+{
+    CValidationState state;
 
-        } catch (...) {
-            ERR() << strprintf("xrouter query from %s processed with error: ", node->GetAddrName());
-            checkDoS(state, node);
-            releaseNode(node);
+    bool released{false};
+    auto releaseNode = [&released](CNode *pnode) {
+        if (!released) {
+            released = true;
+            pnode->Release();
         }
-    });
+    };
+
+    try {
+        const auto & command = packet->command();
+        const auto & uuid = packet->suuid();
+        const auto & nodeAddr = node->GetAddrName();
+        const auto & commandStr = XRouterCommand_ToString(command);
+
+        if (command == xrService) {
+            auto service = packet->service();
+            if (service.size() > 100) // truncate service name
+                service = service.substr(0, 100);
+            LOG() << "XRouter command: " << commandStr << xrdelimiter + service << " query: " << uuid << " node: " << nodeAddr;
+        }
+        else
+            LOG() << "XRouter command: " << commandStr << " query: " << uuid << " node: " << nodeAddr;
+
+        if (command == xrInvalid) { // Process invalid packets (protocol error packets)
+            processInvalid(node, packet, state);
+        } else if (command == xrReply) { // Process replies
+            processReply(node, packet, state);
+        } else if (command == xrConfigReply) { // Process config replies
+            processConfigReply(node, packet, state);
+        } else if (canListen() && server->isStarted()) { // Process server requests
+            server->addInFlightQuery(nodeAddr, uuid);
+            try {
+                server->onMessageReceived(node, packet, state);
+                server->removeInFlightQuery(nodeAddr, uuid);
+            } catch (...) { // clean up on error
+                server->removeInFlightQuery(nodeAddr, uuid);
+            }
+        }
+
+        // Done with request, process DoS and release node
+        checkDoS(state, node);
+        releaseNode(node);
+
+    } catch (...) {
+        ERR() << strprintf("xrouter query from %s processed with error: ", node->GetAddrName());
+        checkDoS(state, node);
+        releaseNode(node);
+    }
 }
 
 //*****************************************************************************
@@ -1354,7 +1546,6 @@ std::string App::xrouterCall(enum XRouterCommand command, std::string & uuidRet,
         }
 
         const int timeout = xrsettings->commandTimeout(command, service);
-        boost::thread_group tg;
 
         // Send xrouter request to each selected node
         for (auto & snode : queryNodes) {
@@ -1383,91 +1574,78 @@ std::string App::xrouterCall(enum XRouterCommand command, std::string & uuidRet,
                 // Set the fully qualified service url to the form /xr/BLOCK/xrGetBlockCount
                 const auto & fqUrl = fqServiceToUrl((command == xrService) ? pluginCommandKey(service) // plugin
                                                        : walletCommandKey(service, commandStr, true)); // spv wallet
-                try {
-                    tg.create_thread([uuid,addr,snode,fqUrl,params,feetx,timeout,this]() {
-                        RenameThread("blocknet-xrclientrequest");
-                        if (ShutdownRequested())
-                            return;
-                        json_spirit::Array jparams;
-                        for (const std::string & p : params)
-                            jparams.push_back(p);
-
-                        CKey clientKey; clientKey.Set(cprivkey.begin(), cprivkey.end(), true);
-                        XRouterReply xrresponse;
-                        try {
-                            std::string data;
-                            if (!jparams.empty())
-                                data = json_spirit::write_string(Value(jparams), json_spirit::none, 8);
-                            xrresponse = xrouter::CallXRouterUrl(snode.getHostAddr().ToStringIP(),
-                                    snode.getHostAddr().GetPort(), fqUrl, data, timeout, clientKey,
-                                    snode.getSnodePubKey(), feetx);
-                        } catch (std::exception & e) {
-                            json_spirit::Object obj;
-                            obj.emplace_back("error", e.what());
-                            obj.emplace_back("code", xrouter::Error::BAD_REQUEST);
-                            obj.emplace_back("reply", "");
-                            queryMgr.addReply(uuid, addr, json_spirit::write_string(Value(obj)));
-                            queryMgr.purge(uuid, addr);
-                            return; // failed to connect
-                        }
-
-                        // Do not process if we aren't expecting a result. Also prevent reply malleability (only first reply is accepted)
-                        if (!queryMgr.hasQuery(uuid, addr) || queryMgr.hasReply(uuid, addr))
-                            return; // done, nothing found
-
-                        // Verify servicenode response
-                        CHashWriter hw(SER_GETHASH, 0);
-                        hw << std::vector<unsigned char>(xrresponse.result.begin(), xrresponse.result.end());
-                        const auto hash = hw.GetHash();
-                        CPubKey sigPubKey;
-                        if (snode.getSnodePubKey() != xrresponse.hdrpubkey
-                        || !sigPubKey.RecoverCompact(hash, xrresponse.hdrsignature)
-                        || snode.getSnodePubKey() != sigPubKey) {
-                            json_spirit::Object obj;
-                            obj.emplace_back("error", "Unable to verify if the service node is valid. Received bad signature on this request.");
-                            obj.emplace_back("code", xrouter::Error::BAD_SIGNATURE);
-                            obj.emplace_back("reply", xrresponse.result);
-                            queryMgr.addReply(uuid, addr, json_spirit::write_string(Value(obj)));
-                            queryMgr.purge(uuid, addr);
-                            return;
-                        }
+                json_spirit::Array jparams;
+                for (const std::string & p : params)
+                    jparams.push_back(p);
+                std::string data;
+                if (!jparams.empty())
+                    data = json_spirit::write_string(Value(jparams), json_spirit::none, 8);
+
+                CKey clientKey; clientKey.Set(cprivkey.begin(), cprivkey.end(), true);
+                CallXRouterUrlAsync(snode.getHostAddr().ToStringIP(), snode.getHostAddr().GetPort(), fqUrl, data,
+                        timeout, clientKey, snode.getSnodePubKey(), feetx,
+                        [uuid,addr,snode,this](const XRouterReply & xrresponse, const std::string & error) {
+                    if (!error.empty()) {
+                        json_spirit::Object obj;
+                        obj.emplace_back("error", error);
+                        obj.emplace_back("code", xrouter::Error::BAD_REQUEST);
+                        obj.emplace_back("reply", "");
+                        queryMgr.addReply(uuid, addr, json_spirit::write_string(Value(obj)));
+                        queryMgr.purge(uuid, addr);
+                        return; // failed to connect
+                    }
 
-                        // Store the reply
-                        queryMgr.addReply(uuid, addr, xrresponse.result);
+                    // Do not process if we aren't expecting a result. Also prevent reply malleability (only first reply is accepted)
+                    if (!queryMgr.hasQuery(uuid, addr) || queryMgr.hasReply(uuid, addr))
+                        return; // done, nothing found
+
+                    // Verify servicenode response
+                    CHashWriter hw(SER_GETHASH, 0);
+                    hw << std::vector<unsigned char>(xrresponse.result.begin(), xrresponse.result.end());
+                    const auto hash = hw.GetHash();
+                    CPubKey sigPubKey;
+                    if (snode.getSnodePubKey() != xrresponse.hdrpubkey
+                    || !sigPubKey.RecoverCompact(hash, xrresponse.hdrsignature)
+                    || snode.getSnodePubKey() != sigPubKey) {
+                        json_spirit::Object obj;
+                        obj.emplace_back("error", "Unable to verify if the service node is valid. Received bad signature on this request.");
+                        obj.emplace_back("code", xrouter::Error::BAD_SIGNATURE);
+                        obj.emplace_back("reply", xrresponse.result);
+                        queryMgr.addReply(uuid, addr, json_spirit::write_string(Value(obj)));
                         queryMgr.purge(uuid, addr);
-                    });
-                } catch (...) { }
+                        return;
+                    }
+
+                    // Store the reply
+                    queryMgr.addReply(uuid, addr, xrresponse.result);
+                    queryMgr.purge(uuid, addr);
+                });
                 updateSentRequest(addr, fqService);
             }
             LOG() << "Sent command " << fqService << " query " << uuid << " to node " << addr;
         }
 
-        // At this point we need to wait for responses
-        int confirmation_count = 0;
-        auto queryCheckStart = GetAdjustedTime();
-        auto queries = queryMgr.allLocks(uuid);
-        std::vector<NodeAddr> review;
-        for (auto & query : queries)
-            review.push_back(query.first);
-
-        // Check that all replies have arrived, only run as long as timeout
-        while (!ShutdownRequested() && confirmation_count < confs
-            && GetAdjustedTime() - queryCheckStart < timeout)
-        {
-            boost::this_thread::sleep_for(boost::chrono::milliseconds(5));
-            for (int i = review.size() - 1; i >= 0; --i)
-                if (queryMgr.hasReply(uuid, review[i])) {
-                    ++confirmation_count;
-                    review.erase(review.begin()+i);
-                }
-        }
+        // At this point we need to wait for responses, only wait as long as timeout. The wait
+        // ends early once enough nodes agree that the remaining replies can't change the result.
+        auto replied = queryMgr.replies(uuid, confs);
+        replied.wait_for(boost::chrono::seconds(timeout));
+        const bool consensus = queryMgr.hasConsensus(uuid);
 
         // Clean up
         queryMgr.purge(uuid);
 
+        int confirmation_count = 0;
+        std::vector<NodeAddr> review; // nodes that didn't reply
+        for (const auto & snode : queryNodes) {
+            if (queryMgr.hasReply(uuid, snode.getHost()))
+                ++confirmation_count;
+            else
+                review.push_back(snode.getHost());
+        }
+
         std::set<NodeAddr> failed;
 
-        if (confirmation_count < confs) {
+        if (confirmation_count < confs && !consensus) {
             failed.insert(review.begin(), review.end());
 
             auto snodes = getServiceNodes();
@@ -1950,17 +2128,13 @@ std::string App::sendXRouterConfigRequestSync(CNode* node) {
     PushXRouterMessage(node, packet.body());
 
     // Wait for response
-    auto qcond = queryMgr.queryCond(uuid, nodeAddr);
-    if (qcond) {
-        int timeout = xrsettings->configSyncTimeout();
-        auto l = queryMgr.queryLock(uuid, nodeAddr);
-        boost::mutex::scoped_lock lock(*l);
-        if (!qcond->timed_wait(lock, boost::posix_time::seconds(timeout),
-                [this,&uuid,&nodeAddr]() { return ShutdownRequested() || queryMgr.hasReply(uuid, nodeAddr); }))
-        {
-            queryMgr.purge(uuid); // clean up
-            return "Could not get XRouter config";
-        }
+    int timeout = xrsettings->configSyncTimeout();
+    auto replied = queryMgr.replies(uuid, 1);
+    if (replied.wait_for(boost::chrono::seconds(timeout)) != boost::future_status::ready
+        || !queryMgr.hasReply(uuid, nodeAddr))
+    {
+        queryMgr.purge(uuid); // clean up
+        return "Could not get XRouter config";
     }
 
     std::string reply;
@@ -23,8 +23,11 @@
 #endif
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <set>
 
 #include <json/json_spirit.h>
 #include <json/json_spirit_reader_template.h>
@@ -35,6 +38,7 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/thread.hpp>
+#include <boost/thread/future.hpp>
 
 //*****************************************************************************
 //*****************************************************************************
@@ -44,6 +48,18 @@ namespace xrouter
 typedef std::shared_ptr<XRouterSettings> XRouterSettingsPtr;
 typedef std::shared_ptr<XRouterServer> XRouterServerPtr;
 
+//! Default number of xrouter request worker threads
+static const int DEFAULT_XROUTER_THREADS = 4;
+//! Default maximum number of xrouter requests waiting for a worker
+static const unsigned int DEFAULT_XROUTER_REQUEST_QUEUE = 500;
+
+//! Service priority of queued requests
+enum RequestPriority {
+    REQUEST_PRIORITY_FREE  = 0,
+    REQUEST_PRIORITY_PAID  = 1,
+    REQUEST_PRIORITY_REPLY = 2,
+};
+
 template <typename T>
 bool PushXRouterMessage(CNode *pnode, const T & message);
 
@@ -326,6 +342,27 @@ public:
      * @brief returns status json object
      */
     std::string getStatus();
+
+    /**
+     * @brief xrouter request processing queue metrics
+     */
+    class RequestQueueStats {
+    public:
+        uint32_t workers{0};        // number of request workers
+        uint32_t maxDepth{0};       // maximum queued requests
+        uint64_t depth{0};          // currently queued requests
+        uint64_t inFlight{0};       // requests currently being processed
+        uint64_t processed{0};      // total processed requests
+        uint64_t rejected{0};       // requests rejected because the queue was full
+        int64_t avgWaitMicros{0};   // average time requests waited in the queue
+        int64_t maxWaitMicros{0};   // maximum time a request waited in the queue
+    };
+
+    /**
+     * @brief requestQueueStats
+     * @return metrics of the xrouter request processing queue
+     */
+    RequestQueueStats requestQueueStats();
     
     /**
      * @brief gets address for comission payment
@@ -798,10 +835,9 @@ private:
     class QueryMgr {
     public:
         typedef std::string QueryReply;
-        typedef std::pair<std::shared_ptr<boost::mutex>, std::shared_ptr<boost::condition_variable> > QueryCondition;
-        QueryMgr() : queriesLocks(), queries() {}
+        QueryMgr() : queries() {}
         /**
-         * Add a query. This stores interal state including condition variables and associated mutexes.
+         * Add a query. Replies are only accepted from nodes added to the query.
          * @param id uuid of query, can't be empty
          * @param node address of node associated with query, can't be empty
          */
@@ -810,21 +846,17 @@ private:
                 return;
 
             LOCK(mu);
-
-            if (!queries.count(id))
-                queries[id] = std::map<NodeAddr, std::string>{};
-
-            std::shared_ptr<boost::mutex> m(new boost::mutex());
-            std::shared_ptr<boost::condition_variable> cond(new boost::condition_variable());
-
-            if (!queriesLocks.count(id))
-                queriesLocks[id] = std::map<NodeAddr, QueryCondition>{};
-
-            auto qc = QueryCondition{m, cond};
-            queriesLocks[id][node] = qc;
+            auto & query = queries[id];
+            if (!query.done) {
+                query.done = std::make_shared<boost::promise<void>>();
+                query.future = boost::shared_future<void>(query.done->get_future());
+            }
+            query.pending.insert(node);
         }
         /**
-         * Store a query reply.
+         * Store a query reply. Only the first reply of a node is accepted. The reply is
+         * canonicalized and hashed on arrival so that matching replies are counted as they
+         * come in.
          * @param id
          * @param node
          * @param reply
@@ -834,36 +866,31 @@ private:
             if (id.empty() || node.empty())
                 return 0;
 
-            int replies{0};
-            QueryCondition qcond;
-
-            {
-                LOCK(mu);
-
-                if (!queries.count(id))
-                    return 0; // done, no query found with id
-
-                // Total replies
-                replies = queriesLocks.count(id);
-                // Query condition
-                if (replies)
-                    qcond = queriesLocks[id][node];
-                // If invalid query condition return
-                if (!qcond.first || !qcond.second)
-                    return 0;
-            }
-
-            if (replies) { // only handle locks if they exist for this query
-                boost::mutex::scoped_lock l(*qcond.first);
-                queries[id][node] = reply; // Assign reply
-                qcond.second->notify_all();
-            }
+            // Parse outside the lock, replies can be large
+            bool error{false};
+            const auto hash = replyHash(reply, error);
 
             LOCK(mu);
-            return queries.count(id);
+            auto it = queries.find(id);
+            if (it == queries.end())
+                return 0; // done, no query found with id
+            auto & query = it->second;
+            if (!query.pending.count(node) || query.replies.count(node))
+                return 0; // not expecting a reply from this node
+
+            query.replies[node] = reply;
+            query.pending.erase(node);
+            auto & group = query.groups[hash];
+            if (group.nodes.empty()) {
+                group.reply = reply;
+                group.error = error;
+            }
+            group.nodes.insert(node);
+            complete(query);
+            return static_cast<int>(query.replies.size());
         }
         /**
-         * Fetch a reply. This method returns the number of matching replies.
+         * Fetch a reply. This method returns the number of replies.
          * @param id
          * @param reply
          * @return
@@ -871,12 +898,45 @@ private:
         int reply(const std::string & id, const NodeAddr & node, std::string & reply) {
             LOCK(mu);
 
-            int consensus = queries.count(id);
-            if (!consensus)
+            auto it = queries.find(id);
+            if (it == queries.end() || !it->second.replies.count(node))
                 return 0;
 
-            reply = queries[id][node];
-            return consensus;
+            reply = it->second.replies[node];
+            return static_cast<int>(it->second.replies.size());
+        }
+        /**
+         * Returns a future that becomes ready when the query has the specified number of replies,
+         * when the most common reply can no longer change, when no more replies are expected or
+         * when the query is purged or cancelled.
+         * @param id
+         * @param count Number of replies
+         * @return
+         */
+        boost::shared_future<void> replies(const std::string & id, const int count) {
+            LOCK(mu);
+            auto it = queries.find(id);
+            if (it == queries.end() || !it->second.done) {
+                boost::promise<void> ready;
+                ready.set_value();
+                return boost::shared_future<void>(ready.get_future());
+            }
+            auto & query = it->second;
+            query.expected = std::max(count, 1);
+            complete(query);
+            return query.future;
+        }
+        /**
+         * Returns true if the most common reply of the query can not change anymore, i.e. it
+         * was received from more nodes than any other reply could reach with the nodes that
+         * have yet to reply.
+         * @param id
+         * @return
+         */
+        bool hasConsensus(const std::string & id) {
+            LOCK(mu);
+            auto it = queries.find(id);
+            return it != queries.end() && decided(it->second);
         }
         /**
          * Fetch the most common reply for a specific query. If a group of nodes return results and 2 of 3 are
@@ -893,91 +953,73 @@ private:
         {
             LOCK(mu);
 
-            int consensus = queries.count(id);
-            if (!consensus || queries[id].empty())
+            auto it = queries.find(id);
+            if (it == queries.end() || it->second.replies.empty())
                 return 0;
 
             // all replies
-            replies = queries[id];
-
-            std::map<uint256, std::string> hashes;
-            std::map<uint256, int> counts;
-            std::map<uint256, std::set<NodeAddr> > nodes;
-            for (auto & item : queries[id]) {
-                auto result = item.second;
-                try {
-                    Value j; read_string(result, j);
-                    if (j.type() == obj_type)
-                        result = write_string(j, false);
-                } catch (...) {
-                    result = item.second;
-                }
-                auto hash = Hash(result.begin(), result.end());
-                hashes[hash] = item.second;
-                counts[hash] = counts.count(hash) + 1; // update counts for common replies
-                nodes[hash].insert(item.first);
-            }
+            replies = it->second.replies;
+            const auto & groups = it->second.groups;
 
             // sort reply counts descending (most similar replies are more valuable)
-            std::vector<std::pair<uint256, int> > tmp(counts.begin(), counts.end());
-            std::sort(tmp.begin(), tmp.end(),
-                      [](const std::pair<uint256, int> & a, const std::pair<uint256, int> & b) {
-                          return a.second > b.second;
-                      });
+            typedef std::map<uint256, ReplyGroup>::const_iterator Group;
+            std::vector<Group> tmp;
+            for (auto g = groups.begin(); g != groups.end(); ++g)
+                tmp.push_back(g);
+            std::sort(tmp.begin(), tmp.end(), [](const Group & a, const Group & b) {
+                return a->second.nodes.size() > b->second.nodes.size();
+            });
 
             diff.clear();
             if (tmp.size() > 1) {
-                if (tmp[0].second == tmp[1].second) { // Check for errors and re-sort if there's a tie and highest rank has error
-                    const auto &r = hashes[tmp[0].first];
-                    if (hasError(r)) { // in tie arrangements we don't want errors to take precendence
+                if (tmp[0]->second.nodes.size() == tmp[1]->second.nodes.size()) { // Check for errors and re-sort if there's a tie and highest rank has error
+                    if (tmp[0]->second.error) { // in tie arrangements we don't want errors to take precendence
                         std::sort(tmp.begin(), tmp.end(), // sort descending
-                            [this, &hashes](const std::pair<uint256, int> & a, const std::pair<uint256, int> & b) {
-                                const auto & ae = hasError(hashes[a.first]);
-                                const auto & be = hasError(hashes[b.first]);
-                                if ((!ae && !be) || (ae && be))
-                                    return a.second > b.second;
+                            [](const Group & a, const Group & b) {
+                                const auto ae = a->second.error;
+                                const auto be = b->second.error;
+                                if (ae == be)
+                                    return a->second.nodes.size() > b->second.nodes.size();
                                 return be;
                             });
                     }
                 }
                 // Filter nodes that responded with different results
                 for (int i = 1; i < static_cast<int>(tmp.size()); ++i) {
-                    const auto & hash = tmp[i].first;
-                    if (!nodes.count(hash) || tmp[i].second >= tmp[0].second) // do not penalize equal counts, only fewer
+                    const auto & ns = tmp[i]->second.nodes;
+                    if (ns.size() >= tmp[0]->second.nodes.size()) // do not penalize equal counts, only fewer
                         continue;
-                    auto ns = nodes[hash];
                     diff.insert(ns.begin(), ns.end());
                 }
             }
 
-            auto selhash = tmp[0].first;
-
             // store agreeing nodes
-            agree.clear();
-            agree = nodes[selhash];
+            agree = tmp[0]->second.nodes;
 
             // select the most common replies
-            reply = hashes[selhash];
-            return tmp[0].second;
+            reply = tmp[0]->second.reply;
+            return static_cast<int>(agree.size());
         }
         /**
-         * Returns true if the query with specified id.
+         * Returns true if the query with specified id is expecting replies.
          * @param id
          * @return
          */
         bool hasQuery(const std::string & id) {
             LOCK(mu);
-            return queriesLocks.count(id);
+            auto it = queries.find(id);
+            return it != queries.end() && !it->second.pending.empty();
         }
         /**
-         * Returns true if the query with specified id and node address is valid.
+         * Returns true if the query with specified id is expecting a reply from the node.
          * @param id
          * @param node
          * @return
          */
         bool hasQuery(const std::string & id, const NodeAddr & node) {
             LOCK(mu);
-            return queriesLocks.count(id) && queriesLocks[id].count(node);
+            auto it = queries.find(id);
+            return it != queries.end() && it->second.pending.count(node);
         }
         /**
          * Returns true if a query for the specified node exists.
@@ -986,8 +1028,8 @@ private:
          */
         bool hasNodeQuery(const NodeAddr & node) {
             LOCK(mu);
-            for (const auto & item : queriesLocks) {
-                if (item.second.count(node))
+            for (const auto & item : queries) {
+                if (item.second.pending.count(node))
                     return true;
             }
             return false;
@@ -1000,84 +1042,128 @@ private:
          */
         bool hasReply(const std::string & id, const NodeAddr & node) {
             LOCK(mu);
-            return queries.count(id) && queries[id].count(node);
+            auto it = queries.find(id);
+            return it != queries.end() && it->second.replies.count(node);
         }
         /**
-         * Returns the query's mutex.
-         * @param id
-         * @param node
-         * @return
-         */
-        std::shared_ptr<boost::mutex> queryLock(const std::string & id, const NodeAddr & node) {
-            LOCK(mu);
-            if (!queriesLocks.count(id))
-                return nullptr;
-            if (!queriesLocks[id].count(node))
-                return nullptr;
-            return queriesLocks[id][node].first;
-        }
-        /**
-         * Returns the queries condition variable.
+         * Return all replies associated with a query.
          * @param id
-         * @param node
          * @return
          */
-        std::shared_ptr<boost::condition_variable> queryCond(const std::string & id, const NodeAddr & node) {
+        std::map<std::string, QueryReply> allReplies(const std::string & id) {
             LOCK(mu);
-            if (!queriesLocks.count(id))
-                return nullptr;
-            if (!queriesLocks[id].count(node))
-                return nullptr;
-            return queriesLocks[id][node].second;
+            auto it = queries.find(id);
+            if (it == queries.end())
+                return {};
+            return it->second.replies;
         }
         /**
-         * Return all replies associated with a query.
+         * Purges the ephemeral state of a query with specified id. Replies are kept,
+         * further replies are rejected.
          * @param id
-         * @return
          */
-        std::map<std::string, QueryReply> allReplies(const std::string & id) {
+        void purge(const std::string & id) {
             LOCK(mu);
-            return queries[id];
+            auto it = queries.find(id);
+            if (it == queries.end())
+                return;
+            it->second.pending.clear();
+            it->second.closed = true;
+            complete(it->second);
         }
         /**
-         * Return all query locks associated with an id.
+         * Purges the ephemeral state of a query with specified id and node address.
          * @param id
-         * @return
+         * @param node
          */
-        std::map<std::string, QueryCondition> allLocks(const std::string & id) {
+        void purge(const std::string & id, const NodeAddr & node) {
             LOCK(mu);
-            return queriesLocks[id];
+            auto it = queries.find(id);
+            if (it == queries.end())
+                return;
+            it->second.pending.erase(node);
+            complete(it->second);
         }
         /**
-         * Purges the ephemeral state of a query with specified id.
-         * @param id
+         * Completes all queries, waiting callers return with the replies received so far.
          */
-        void purge(const std::string & id) {
+        void cancelAll() {
             LOCK(mu);
-            queriesLocks.erase(id);
+            for (auto & item : queries) {
+                item.second.pending.clear();
+                item.second.closed = true;
+                complete(item.second);
+            }
         }
+    private:
         /**
-         * Purges the ephemeral state of a query with specified id and node address.
-         * @param id
-         * @param node
+         * Hash of the canonical form of a reply. Json replies of any type (objects, arrays and
+         * scalars) are compared regardless of formatting, e.g. the number of decimals of reals.
+         * Other replies are hashed as is.
+         * @param reply
+         * @param error Set to true if the reply is a json object with an error field
+         * @return
          */
-        void purge(const std::string & id, const NodeAddr & node) {
-            LOCK(mu);
-            if (queriesLocks.count(id))
-                queriesLocks[id].erase(node);
+        static uint256 replyHash(const std::string & reply, bool & error) {
+            error = false;
+            try {
+                Value j;
+                auto begin = reply.begin();
+                if (json_spirit::read_range(begin, reply.end(), j)
+                    && std::all_of(begin, reply.end(), [](const char c) { return std::isspace(static_cast<unsigned char>(c)); }))
+                {
+                    if (j.type() == json_spirit::obj_type)
+                        error = json_spirit::find_value(j.get_obj(), "error").type() != json_spirit::null_type;
+                    const auto result = json_spirit::write_string(j, false);
+                    return Hash(result.begin(), result.end());
+                }
+            } catch (...) { }
+            return Hash(reply.begin(), reply.end());
         }
     private:
-        bool hasError(const std::string & reply) {
-            Value v; json_spirit::read_string(reply, v);
-            if (v.type() != json_spirit::obj_type)
-                return false;
-            const auto & err_v = json_spirit::find_value(v.get_obj(), "error");
-            return err_v.type() != json_spirit::null_type;
+        /** Nodes that returned the same canonical reply */
+        struct ReplyGroup {
+            QueryReply reply; // first reply received
+            bool error{false};
+            std::set<NodeAddr> nodes;
+        };
+        struct Query {
+            std::map<NodeAddr, QueryReply> replies;
+            std::map<uint256, ReplyGroup> groups; // replies by canonical hash
+            std::set<NodeAddr> pending; // nodes expected to reply
+            int expected{0}; // replies completing the query, 0 until waited on
+            bool closed{false}; // purged, no more replies are accepted
+            std::shared_ptr<boost::promise<void>> done; // set once when the query completes
+            boost::shared_future<void> future;
+        };
+        /** Returns true if the pending replies can not change the most common reply. Requires mu. */
+        static bool decided(const Query & query) {
+            size_t first{0}, second{0};
+            for (const auto & item : query.groups) {
+                const auto n = item.second.nodes.size();
+                if (n > first) {
+                    second = first;
+                    first = n;
+                } else if (n > second)
+                    second = n;
+            }
+            return first > second + query.pending.size();
+        }
+        /** Completes the query if enough replies arrived or no more replies are expected. Requires mu. */
+        static void complete(Query & query) {
+            if (!query.done)
+                return;
+            const bool ready = query.expected > 0 && (query.pending.empty()
+                                                      || static_cast<int>(query.replies.size()) >= query.expected
+                                                      || decided(query));
+            if (query.closed || ready) {
+                query.done->set_value();
+                query.done.reset();
+            }
         }
     private:
         Mutex mu;
-        std::map<std::string, std::map<NodeAddr, QueryCondition> > queriesLocks;
-        std::map<std::string, std::map<NodeAddr, QueryReply> > queries;
+        std::map<std::string, Query> queries;
     };
 
 private:
@@ -1096,7 +1182,74 @@ private:
     boost::filesystem::path xrouterpath;
     bool xrouterIsReady{false};
 
+    /**
+     * Request waiting for a worker. Requests are served by priority, then by the
+     * sending node's score, then in arrival order.
+     */
+    struct QueuedRequest {
+        int priority{0};
+        int score{0};
+        uint64_t seq{0};
+        int64_t queuedMicros{0};
+        CNode *node{nullptr};
+        XRouterPacketPtr packet;
+        bool operator<(const QueuedRequest & o) const {
+            if (priority != o.priority)
+                return priority > o.priority;
+            if (score != o.score)
+                return score > o.score;
+            return seq < o.seq;
+        }
+    };
+
+    /**
+     * @brief Returns the service priority of a packet. Replies to our own outstanding queries
+     *        are served first, followed by requests with a well-formed fee transaction and then
+     *        free requests.
+     * @param node
+     * @param packet
+     * @return
+     */
+    int requestPriority(CNode *node, XRouterPacketPtr packet);
+
+    /**
+     * @brief Queues the request for the worker pool. If the queue is full the lowest priority
+     *        request is rejected, which may be the specified request. Replies to our own queries
+     *        are never rejected. The node must be retained.
+     * @param node
+     * @param packet
+     */
+    void queueRequest(CNode *node, XRouterPacketPtr packet);
+
+    /**
+     * @brief Replies to a request that was not admitted to the queue and releases the node.
+     * @param request
+     */
+    void rejectRequest(const QueuedRequest & request);
+
+    /**
+     * @brief Processes a received packet on a worker thread.
+     * @param node
+     * @param packet
+     */
+    void processRequest(CNode *node, XRouterPacketPtr packet);
+
+    /**
+     * @brief Worker thread loop serving the request queue.
+     */
+    void requestWorker();
+
     boost::thread_group requestHandlers;
+    Mutex requestQueueMu;
+    std::condition_variable requestQueueCv;
+    std::set<QueuedRequest> requestQueue;
+    uint32_t requestQueueMax{DEFAULT_XROUTER_REQUEST_QUEUE};
+    uint64_t requestSeq{0};
+    std::atomic<uint64_t> requestsInFlight{0};
+    std::atomic<uint64_t> requestsProcessed{0};
+    std::atomic<uint64_t> requestsRejected{0};
+    std::atomic<int64_t> requestWaitTotal{0};
+    std::atomic<int64_t> requestWaitMax{0};
     std::deque<std::shared_ptr<boost::asio::io_service> > ioservices;
     std::deque<std::shared_ptr<boost::asio::io_service::work> > ioworkers;
 
@@ -5,6 +5,7 @@
 #ifndef BLOCKNET_XROUTER_XROUTERCONNECTOR_H
 #define BLOCKNET_XROUTER_XROUTERCONNECTOR_H
 
+#include <xrouter/xrouterdef.h>
 #include <xrouter/xrouterutils.h>
 
 #include <cstdint>
@@ -62,6 +63,7 @@ public:
         , serviceNodeFee(.015)
         , txWithTimeField(false)
         , isLockCoinsSupported(false)
+        , rpcBatchSize(XROUTER_DEFAULT_RPCBATCHSIZE)
     {
         addrPrefix.resize(1, '\0');
         scriptPrefix.resize(1, '\0');
@@ -96,6 +98,7 @@ public:
         isLockCoinsSupported    = other.isLockCoinsSupported;
         jsonver                 = other.jsonver;
         contenttype             = other.contenttype;
+        rpcBatchSize            = other.rpcBatchSize;
 
         return *this;
     }
@@ -146,6 +149,8 @@ public:
     std::string                  jsonver;
     // content type
     std::string                  contenttype;
+    // maximum number of calls in a json-rpc batch request
+    uint32_t                     rpcBatchSize;
 };
 
 class WalletConnectorXRouter : public WalletParam
@@ -18,20 +18,8 @@ using namespace json_spirit;
 namespace xrouter
 {
 
-static Value getResult(const std::string & obj)
+static bool hasError(const Value & val)
 {
-    Value obj_val; read_string(obj, obj_val);
-    if (obj_val.type() == null_type)
-        return Value(obj);
-    const Value & r = find_value(obj_val.get_obj(), "result");
-    if (r.type() == null_type)
-        return Value(obj);
-    return r;
-}
-
-static bool hasError(const std::string & data)
-{
-    Value val; read_string(data, val);
     if (val.type() != obj_type)
         return false;
 
@@ -40,6 +28,17 @@ static bool hasError(const std::string & data)
     return error.type() != null_type;
 }
 
+/**
+ * Result of a parsed reply without copying it, null if the reply has no result.
+ */
+static const Value & findResult(const Value & reply)
+{
+    static const Value null;
+    if (reply.type() != obj_type)
+        return null;
+    return find_value(reply.get_obj(), "result");
+}
+
 static std::string checkError(const std::string & data, int code)
 {
     Value val; read_string(data, val);
@@ -102,8 +101,14 @@ std::vector<std::string> BtcWalletConnectorXRouter::getBlocks(const std::vector<
     std::map<std::string, std::string> results;
     std::vector<std::string> list;
 
+    std::vector<std::pair<std::string, Array>> calls;
+    for (const auto & hash : unique)
+        calls.emplace_back(commandGB, Array{ hash });
+    const auto & replies = callBatch(calls);
+
+    size_t n{0};
     for (const auto & hash : unique)
-        results[hash] = getBlock(hash);
+        results[hash] = replies[n++];
 
     for (const auto & hash : blockHashes)
         list.push_back(results[hash]);
@@ -116,16 +121,15 @@ std::string BtcWalletConnectorXRouter::getTransaction(const std::string & hash)
     static const std::string commandGRT("getrawtransaction");
     const auto & rawTr = CallRPC(m_user, m_passwd, m_ip, m_port, commandGRT, { hash }, jsonver, contenttype);
 
-    if (hasError(rawTr)) {
+    Value rawTrReply; read_string(rawTr, rawTrReply);
+    if (hasError(rawTrReply)) {
         return rawTr;
     } else {
-        const auto & rawTr_val = getResult(rawTr);
-        std::string hex;
+        const auto & rawTr_val = findResult(rawTrReply);
         if (rawTr_val.type() != str_type)
             return "";
-        hex = rawTr_val.get_str();
         static const std::string commandDRT("decoderawtransaction");
-        return CallRPC(m_user, m_passwd, m_ip, m_port, commandDRT, { hex }, jsonver, contenttype);
+        return CallRPC(m_user, m_passwd, m_ip, m_port, commandDRT, { rawTr_val }, jsonver, contenttype);
     }
 }
 
@@ -138,8 +142,33 @@ std::vector<std::string> BtcWalletConnectorXRouter::getTransactions(const std::v
     std::map<std::string, std::string> results;
     std::vector<std::string> list;
 
+    std::vector<std::pair<std::string, Array>> rawCalls;
     for (const auto & hash : unique)
-        results[hash] = getTransaction(hash);
+        rawCalls.emplace_back(commandGRT, Array{ hash });
+    const auto & rawReplies = callBatch(rawCalls);
+
+    // Decode the raw transactions that were found
+    std::vector<std::pair<std::string, Array>> decodeCalls;
+    std::vector<std::string> decodeHashes;
+    size_t n{0};
+    for (const auto & hash : unique) {
+        const auto & rawTr = rawReplies[n++];
+        Value rawTrReply; read_string(rawTr, rawTrReply);
+        if (hasError(rawTrReply)) {
+            results[hash] = rawTr;
+            continue;
+        }
+        const auto & rawTr_val = findResult(rawTrReply);
+        if (rawTr_val.type() != str_type) {
+            results[hash] = "";
+            continue;
+        }
+        decodeCalls.emplace_back(commandDRT, Array{ rawTr_val });
+        decodeHashes.push_back(hash);
+    }
+    const auto & decoded = callBatch(decodeCalls);
+    for (size_t i = 0; i < decodeHashes.size(); ++i)
+        results[decodeHashes[i]] = decoded[i];
 
     for (const auto & hash : txHashes)
         list.push_back(results[hash]);
@@ -158,8 +187,6 @@ std::vector<std::string> BtcWalletConnectorXRouter::getTransactionsBloomFilter(c
     static const std::string commandGBC("getblockcount");
     static const std::string commandGBH("getblockhash");
     static const std::string commandGB("getblock");
-    static const std::string commandGRT("getrawtransaction");
-    static const std::string commandDRT("decoderawtransaction");
 
     CBloomFilter ft;
     stream >> ft;
@@ -168,35 +195,46 @@ std::vector<std::string> BtcWalletConnectorXRouter::getTransactionsBloomFilter(c
 
     std::vector<std::string> results;
 
-    const auto & blockCountObj = CallRPC(m_user, m_passwd, m_ip, m_port, commandGBC, Array(), jsonver, contenttype);
-    int blockcount = getResult(blockCountObj).get_int();
+    const auto & blockCountObj = CallRPCObject(m_user, m_passwd, m_ip, m_port, commandGBC, Array(), jsonver, contenttype);
+    int blockcount = find_value(blockCountObj, "result").get_int();
 
     if ((fetchlimit > 0) && (blockcount - number > fetchlimit)) {
         throw XRouterError("Too many blocks requested", xrouter::INVALID_PARAMETERS);
     }
     
-    for (int id = number; id <= blockcount; id++)
+    // Fetch verbose blocks in batches, verbose blocks include the raw transactions
+    const int batchSize = std::max<int>(1, static_cast<int>(rpcBatchSize));
+    for (int from = number; from <= blockcount; from += batchSize)
     {
-        const auto & blockHashObj = CallRPC(m_user, m_passwd, m_ip, m_port, commandGBH, { id }, jsonver, contenttype);
-        const auto & hash = getResult(blockHashObj).get_str();
-        const auto & blockObj = CallRPC(m_user, m_passwd, m_ip, m_port, commandGB, { hash }, jsonver, contenttype);
-        Object block = getResult(blockObj).get_obj();
-
-        Array txs = find_value(block, "tx").get_array();
-
-        for (const auto & j : txs) {
-            const auto & txid = Value(j).get_str();
-            const auto & rawTrObj = CallRPC(m_user, m_passwd, m_ip, m_port, commandGRT, { txid }, jsonver, contenttype);
-            const auto & txData_str = getResult(rawTrObj).get_str();
-
-            std::vector<unsigned char> txData(ParseHex(txData_str));
-            CDataStream ssData(txData, SER_NETWORK, PROTOCOL_VERSION);
-            CMutableTransaction mtx;
-            ssData >> mtx;
-
-            const CTransaction ctx(mtx);
-            if (filter.IsRelevantAndUpdate(ctx)) {
-                results.push_back(txData_str);
+        const int to = std::min(blockcount, from + batchSize - 1);
+        std::vector<std::pair<std::string, Array>> hashCalls;
+        for (int id = from; id <= to; ++id)
+            hashCalls.emplace_back(commandGBH, Array{ id });
+
+        std::vector<std::pair<std::string, Array>> blockCalls;
+        for (const auto & blockHashObj : CallRPCBatch(m_user, m_passwd, m_ip, m_port, hashCalls, jsonver, contenttype)) {
+            Value blockHashReply; read_string(blockHashObj, blockHashReply);
+            blockCalls.emplace_back(commandGB, Array{ findResult(blockHashReply).get_str(), 2 });
+        }
+
+        for (const auto & blockObj : CallRPCBatch(m_user, m_passwd, m_ip, m_port, blockCalls, jsonver, contenttype)) {
+            // Verbose blocks are large, parse once and read the transactions in place
+            Value blockReply; read_string(blockObj, blockReply);
+            const Object & block = findResult(blockReply).get_obj();
+            const Array & txs = find_value(block, "tx").get_array();
+
+            for (const auto & j : txs) {
+                const auto & txData_str = find_value(j.get_obj(), "hex").get_str();
+
+                std::vector<unsigned char> txData(ParseHex(txData_str));
+                CDataStream ssData(txData, SER_NETWORK, PROTOCOL_VERSION);
+                CMutableTransaction mtx;
+                ssData >> mtx;
+
+                const CTransaction ctx(mtx);
+                if (filter.IsRelevantAndUpdate(ctx)) {
+                    results.push_back(txData_str);
+                }
             }
         }
     }
@@ -287,4 +325,18 @@ std::string BtcWalletConnectorXRouter::getBalance(const std::string & address) c
     return "0"; // TODO Implement
 }
 
+std::vector<std::string> BtcWalletConnectorXRouter::callBatch(const std::vector<std::pair<std::string, Array>> & calls) const
+{
+    std::vector<std::string> replies;
+    replies.reserve(calls.size());
+    const size_t batchSize = std::max<size_t>(1, rpcBatchSize);
+    for (size_t i = 0; i < calls.size(); i += batchSize) {
+        const std::vector<std::pair<std::string, Array>> batch(calls.begin() + i,
+                                                               calls.begin() + std::min(calls.size(), i + batchSize));
+        const auto & batchReplies = CallRPCBatch(m_user, m_passwd, m_ip, m_port, batch, jsonver, contenttype);
+        replies.insert(replies.end(), batchReplies.begin(), batchReplies.end());
+    }
+    return replies;
+}
+
 } // namespace xrouter
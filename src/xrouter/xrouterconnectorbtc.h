@@ -27,6 +27,14 @@ public:
     std::string              decodeRawTransaction(const std::string & hex) const override;
     std::string              convertTimeToBlockCount(const std::string & timestamp) const override;
     std::string              getBalance(const std::string & address) const override;
+
+protected:
+    /**
+     * Sends the calls to the wallet in json-rpc batches of at most rpcBatchSize calls.
+     * @param calls Pairs of rpc method and parameters
+     * @return Reply of each call, in the same order as the calls
+     */
+    std::vector<std::string> callBatch(const std::vector<std::pair<std::string, Array>> & calls) const;
 };
 
 } // namespace xrouter
@@ -13,6 +13,8 @@
 #define XROUTER_DEFAULT_TIMEOUT 30   // seconds
 #define XROUTER_CONFIGSYNC_TIMEOUT 3 // seconds
 #define XROUTER_DEFAULT_FETCHLIMIT 50
+#define XROUTER_DEFAULT_MAXCONCURRENT 4 // concurrent rpc calls per wallet backend
+#define XROUTER_DEFAULT_RPCBATCHSIZE 50 // rpc calls per json-rpc batch request
 #define XROUTER_DEFAULT_CONFIRMATIONS 1
 #define XROUTER_TIMER_SECONDS 15
 
@@ -4,13 +4,13 @@
 
 #include <xrouter/xrouterlogger.h>
 
-#include <util/system.h>
+#include <xbridge/util/logwriter.h>
 
-#include <sstream>
+#include <map>
+#include <memory>
 #include <string>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/thread.hpp>
@@ -18,28 +18,43 @@
 namespace xrouter
 {
 
-boost::mutex logLocker;
+//******************************************************************************
+//******************************************************************************
+static xbridge::AsyncLogWriter & logWriter()
+{
+    // never destroyed, messages may be logged during static destruction
+    static xbridge::AsyncLogWriter * writer = new xbridge::AsyncLogWriter("log", "xrouter_");
+    return *writer;
+}
 
 //******************************************************************************
 //******************************************************************************
-// static
-std::string LOG::m_logFileName;
+static xbridge::AsyncLogWriter & logWriter(const std::string & filename)
+{
+    static boost::mutex lock;
+    static auto writers = new std::map<std::string, std::unique_ptr<xbridge::AsyncLogWriter>>;
+
+    boost::lock_guard<boost::mutex> l(lock);
+    auto & writer = (*writers)[filename];
+    if (!writer)
+        writer.reset(new xbridge::AsyncLogWriter("log", filename, false));
+    return *writer;
+}
 
 //******************************************************************************
 //******************************************************************************
 LOG::LOG(const char reason, std::string filename)
     : std::basic_stringstream<char, std::char_traits<char>,
                     boost::pool_allocator<char> >()
-    , m_r(reason), filenameOverride("")
+    , m_r(reason), filenameOverride(filename)
 {
-    // 'D' is turned on when debug=1 in blocknet.conf
-    if (reason == 'D')
-        if (!gArgs.GetBoolArg("-debug", false))
-            return;
+    // skip formatting of disabled messages
+    if (!enabled(m_r))
+    {
+        setstate(std::ios_base::badbit);
+        return;
+    }
 
-    if (!filename.empty())
-        filenameOverride = filename;
-        
     *this << "\n" << "[" << (char)std::toupper(m_r) << "] "
           << boost::posix_time::second_clock::local_time()
           << " [0x" << boost::this_thread::get_id() << "] ";
@@ -49,55 +64,33 @@ LOG::LOG(const char reason, std::string filename)
 //******************************************************************************
 // static
 std::string LOG::logFileName() {
-    return m_logFileName;
+    return logWriter().fileName();
+}
+
+//******************************************************************************
+//******************************************************************************
+// static
+bool LOG::enabled(const char reason) {
+    return xbridge::logLevelEnabled(reason);
 }
 
 //******************************************************************************
 //******************************************************************************
 LOG::~LOG()
 {
-    boost::lock_guard<boost::mutex> lock(logLocker);
+    if (bad())
+        return;
 
     try
     {
-        static boost::gregorian::date day = boost::gregorian::day_clock::local_day();
-        if (m_logFileName.empty())
-            m_logFileName = makeFileName();
-
-        if (!filenameOverride.empty()) {
-            boost::filesystem::path directory = GetDataDir(false) / "log";
-            boost::filesystem::create_directory(directory);
-
-            std::ofstream file(directory.string() + "/" + filenameOverride, std::ios_base::app);
-            file << str().c_str();
-            return;
-        }
-
-        boost::gregorian::date tmpday = boost::gregorian::day_clock::local_day();
-        if (day != tmpday) {
-            m_logFileName = makeFileName();
-            day = tmpday;
-        }
-
-        std::ofstream file(m_logFileName.c_str(), std::ios_base::app);
-        file << str().c_str();
+        const auto & s = rdbuf()->str();
+        std::string message(s.begin(), s.end());
+        if (!filenameOverride.empty())
+            logWriter(filenameOverride).write(std::move(message));
+        else
+            logWriter().write(std::move(message));
     }
     catch (...) { }
 }
 
-//******************************************************************************
-//******************************************************************************
-std::string LOG::makeFileName()
-{
-    static boost::filesystem::path directory = GetDataDir(false) / "log";
-    boost::filesystem::create_directory(directory);
-
-    auto lt = boost::posix_time::second_clock::local_time();
-    auto df = new boost::gregorian::date_facet("%Y%m%d");
-    std::ostringstream ss;
-    ss.imbue(std::locale(ss.getloc(), df));
-    ss << lt.date();
-    return directory.string() + "/" + "xrouter_" + ss.str() + ".log";
-}
-
 } // namespace
@@ -9,11 +9,12 @@
 
 #include <boost/pool/pool_alloc.hpp>
 
-#define WARN()  LOG('W')
-#define ERR()   LOG('E')
-#define TRACE() LOG('T')
+// messages below the log level are not formatted
+#define WARN()  if (!LOG::enabled('W')) {} else LOG('W')
+#define ERR()   if (!LOG::enabled('E')) {} else LOG('E')
+#define TRACE() if (!LOG::enabled('T')) {} else LOG('T')
 #define TESTLOG() LOG('I',"test_xrouter.log")
-#define DEBUGLOG() LOG('D')
+#define DEBUGLOG() if (!LOG::enabled('D')) {} else LOG('D')
 
 #define LOG_KEYPAIR_VALUES
 
@@ -31,13 +32,13 @@ public:
 
     static std::string logFileName();
 
-private:
-    static std::string makeFileName();
+    /**
+     * Checks the log level. Debug messages also require debug=1.
+     */
+    static bool enabled(const char reason);
 
 private:
     char m_r;
-
-    static std::string m_logFileName;
     std::string filenameOverride;
 };
 
@@ -6,6 +6,7 @@
 
 #include <servicenode/servicenodemgr.h>
 #include <xbridge/util/settings.h>
+#include <xbridge/util/xutil.h>
 #include <xrouter/xrouterapp.h>
 #include <xrouter/xroutererror.h>
 #include <xrouter/xrouterlogger.h>
@@ -47,6 +48,7 @@ bool XRouterServer::stop()
 {
     LOCK(_lock);
     connectors.clear();
+    connectorSlots.clear();
     connectorLocks.clear();
     return true;
 }
@@ -77,6 +79,7 @@ bool XRouterServer::createConnectors() {
             wp.requiredConfirmations       = s.get<int>(*i + ".Confirmations", 0);
             wp.jsonver                     = s.get<std::string>(*i + ".JSONVersion", "");
             wp.contenttype                 = s.get<std::string>(*i + ".ContentType", "");
+            wp.rpcBatchSize                = App::instance().xrSettings()->rpcBatchSize(*i);
 
             if (wp.m_user.empty() || wp.m_passwd.empty())
                 LOG() << "Warning currency " << wp.method << " has empty credentials";
@@ -112,8 +115,10 @@ bool XRouterServer::createConnectors() {
 
 void XRouterServer::addConnector(const WalletConnectorXRouterPtr & conn)
 {
+    const auto maxConcurrent = App::instance().xrSettings()->maxConcurrent(conn->currency);
     LOCK(_lock);
     connectors[conn->currency] = conn;
+    connectorSlots[conn->currency] = std::make_shared<CSemaphore>(maxConcurrent);
     connectorLocks[conn->currency] = std::make_shared<boost::mutex>();
 }
 
@@ -427,8 +432,9 @@ void XRouterServer::onMessageReceived(CNode* node, XRouterPacketPtr packet, CVal
 //*****************************************************************************
 std::string XRouterServer::processGetBlockCount(const std::string & currency, const std::vector<std::string> & params) {
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->getBlockCount();
     }
 
@@ -439,8 +445,9 @@ std::string XRouterServer::processGetBlockHash(const std::string & currency, con
     const auto & blockId = params[0];
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         uint32_t block_n{0};
         if (boost::algorithm::starts_with(blockId, "0x")) { // handle hex values (specifically for eth)
             try {
@@ -465,8 +472,9 @@ std::string XRouterServer::processGetBlock(const std::string & currency, const s
     const auto & blockHash = params[0];
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->getBlock(blockHash);
     }
 
@@ -484,8 +492,9 @@ std::vector<std::string> XRouterServer::processGetBlocks(const std::string & cur
                            std::to_string(fetchlimit) + " received " + std::to_string(params.size()), xrouter::BAD_REQUEST);
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->getBlocks(params);
     }
 
@@ -497,8 +506,9 @@ std::string XRouterServer::processGetTransaction(const std::string & currency, c
     const auto & hash = params[0];
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->getTransaction(hash);
     }
 
@@ -516,8 +526,9 @@ std::vector<std::string> XRouterServer::processGetTransactions(const std::string
                            std::to_string(fetchlimit) + " received " + std::to_string(params.size()), xrouter::BAD_REQUEST);
     
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->getTransactions(params);
     }
 
@@ -528,8 +539,9 @@ std::string XRouterServer::processDecodeRawTransaction(const std::string & curre
     const auto & hex = params[0];
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->decodeRawTransaction(hex);
     }
 
@@ -540,8 +552,10 @@ std::string XRouterServer::processSendTransaction(const std::string & currency,
     const auto & transaction = params[0];
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots && hasConnectorLock(currency)) {
+        boost::mutex::scoped_lock l(*getConnectorLock(currency)); // submit transactions one at a time
+        CSemaphoreGrant grant(*slots);
         return conn->sendTransaction(transaction);
     }
 
@@ -572,8 +586,9 @@ std::vector<std::string> XRouterServer::processGetTxBloomFilter(const std::strin
     int fetchlimit = app.xrSettings()->commandFetchLimit(xrGetTxBloomFilter, currency);
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->getTransactionsBloomFilter(number, stream, fetchlimit);
     }
 
@@ -624,8 +639,9 @@ std::string XRouterServer::processConvertTimeToBlockCount(const std::string & cu
     const std::string timestamp(params[0]);
 
     xrouter::WalletConnectorXRouterPtr conn = connectorByCurrency(currency);
-    if (conn && hasConnectorLock(currency)) {
-        boost::mutex::scoped_lock l(*getConnectorLock(currency));
+    auto slots = getConnectorSlots(currency);
+    if (conn && slots) {
+        CSemaphoreGrant grant(*slots);
         return conn->convertTimeToBlockCount(timestamp);
     }
 
@@ -971,6 +987,11 @@ bool XRouterServer::initKeyPair() {
 }
 
 std::string XRouterServer::parseResult(const std::string & res) {
+    // Pass the result through as received by the wallet
+    std::string result;
+    if (xbridge::findJsonMember(res, "result", result))
+        return result == "null" ? res : result;
+
     Value res_val; read_string(res, res_val);
     if (res_val.type() == obj_type) {
         const auto & r_val = find_value(res_val.get_obj(), "result");
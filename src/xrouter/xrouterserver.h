@@ -321,7 +321,8 @@ private:
     bool started{false};
 
     std::map<std::string, WalletConnectorXRouterPtr> connectors;
-    std::map<std::string, std::shared_ptr<boost::mutex> > connectorLocks;
+    std::map<std::string, std::shared_ptr<CSemaphore> > connectorSlots; // limits concurrent backend calls
+    std::map<std::string, std::shared_ptr<boost::mutex> > connectorLocks; // serializes backend writes
 
     std::map<std::string, std::pair<std::string, CAmount> > hashedQueries;
     std::map<std::string, std::chrono::time_point<std::chrono::system_clock> > hashedQueriesDeadlines;
@@ -352,6 +353,11 @@ private:
         LOCK(_lock);
         return connectorLocks.count(currency);
     }
+    std::shared_ptr<CSemaphore> getConnectorSlots(const std::string & currency) {
+        LOCK(_lock);
+        auto it = connectorSlots.find(currency);
+        return it != connectorSlots.end() ? it->second : nullptr;
+    }
 
 };
 
@@ -408,6 +408,22 @@ int XRouterSettings::clientRequestLimit(XRouterCommand c, const std::string & se
     return res;
 }
 
+int XRouterSettings::maxConcurrent(const std::string & wallet, int def)
+{
+    auto res = get<int>("Main.maxconcurrent", def);
+    if (!wallet.empty())
+        res = get<int>(wallet + ".maxconcurrent", res);
+    return std::max(1, res);
+}
+
+int XRouterSettings::rpcBatchSize(const std::string & wallet, int def)
+{
+    auto res = get<int>("Main.rpcbatchsize", def);
+    if (!wallet.empty())
+        res = get<int>(wallet + ".rpcbatchsize", res);
+    return std::max(1, res);
+}
+
 std::string XRouterSettings::paymentAddress(XRouterCommand c, const std::string & service) {
     std::string def;
     static const auto s_paymentaddress = "paymentaddress";
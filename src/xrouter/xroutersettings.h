@@ -197,6 +197,8 @@ public:
     int commandFetchLimit(XRouterCommand c, const std::string & service, int def=XROUTER_DEFAULT_FETCHLIMIT);
     double maxFee(XRouterCommand c, const std::string& currency="", double def=0.0);
     int clientRequestLimit(XRouterCommand c, const std::string & service, int def=-1); // -1 is no limit
+    int maxConcurrent(const std::string & wallet, int def=XROUTER_DEFAULT_MAXCONCURRENT);
+    int rpcBatchSize(const std::string & wallet, int def=XROUTER_DEFAULT_RPCBATCHSIZE);
     int confirmations(XRouterCommand c, std::string currency="", int def=XROUTER_DEFAULT_CONFIRMATIONS); // 1 confirmation default
     std::string paymentAddress(XRouterCommand c, const std::string & service="");
     int configSyncTimeout();
@@ -10,6 +10,7 @@
 
 #include <streams.h>
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -100,6 +101,18 @@ struct XRouterReply {
 XRouterReply CallXRouterUrl(const std::string & host, const int & port, const std::string & url, const std::string & data,
                             const int & timeout, const CKey & signingkey, const CPubKey & serverkey,
                             const std::string & paymentrawtx);
+/** Called with the reply, or with the error message if the request failed */
+typedef std::function<void(const XRouterReply & reply, const std::string & error)> XRouterReplyHandler;
+/**
+ * Sends the request to the service node url without waiting for the reply. The request is
+ * signed and the host resolved on the calling thread, then dispatched on a shared client
+ * thread. The handler is called on that thread.
+ */
+void CallXRouterUrlAsync(const std::string & host, const int & port, const std::string & url, const std::string & data,
+                         const int & timeout, const CKey & signingkey, const CPubKey & serverkey,
+                         const std::string & paymentrawtx, const XRouterReplyHandler & handler);
+/** Stops the shared client thread, handlers of requests in flight are not called */
+void StopXRouterUrlClient();
 // Network and RPC interface
 std::string CallCMD(const std::string & cmd, int & exit);
 std::string CallRPC(const std::string & rpcip, const std::string & rpcport,
@@ -109,12 +122,30 @@ std::string CallRPC(const std::string & rpcuser, const std::string & rpcpasswd,
                            const std::string & rpcip, const std::string & rpcport,
                            const std::string & strMethod, const Array & params,
                            const std::string & jsonver="", const std::string & contenttype="");
+/**
+ * Calls the rpc server and returns the parsed reply, for replies that are inspected
+ * rather than passed through. Throws if the reply is not a json object.
+ */
+Object CallRPCObject(const std::string & rpcuser, const std::string & rpcpasswd,
+                     const std::string & rpcip, const std::string & rpcport,
+                     const std::string & strMethod, const Array & params,
+                     const std::string & jsonver="", const std::string & contenttype="");
+/**
+ * Sends the calls to the rpc server in a single json-rpc batch request.
+ * @return Reply object of each call, in the same order as the calls
+ */
+std::vector<std::string> CallRPCBatch(const std::string & rpcuser, const std::string & rpcpasswd,
+                                      const std::string & rpcip, const std::string & rpcport,
+                                      const std::vector<std::pair<std::string, Array>> & calls,
+                                      const std::string & jsonver="", const std::string & contenttype="");
 
 // Payment functions
 bool createAndSignTransaction(const std::string & address, const CAmount & amount, std::string & raw_tx);
 void unlockOutputs(const std::string & tx);
 bool sendTransactionBlockchain(const std::string & rawtx, std::string & txid);
 CMutableTransaction decodeTransaction(const std::string & tx);
+/** Total amount of the transaction outputs paying the address. */
+CAmount paymentAmount(const CMutableTransaction & tx, const std::string & address);
 double checkPayment(const std::string & rawtx, const std::string & address, const CAmount & expectedFee);
 
 // Miscellaneous functions